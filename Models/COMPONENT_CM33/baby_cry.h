@@ -3,32 +3,20 @@
 * Copyright © 2023- Imagimob AB, All Rights Reserved.
 * 
 * Generated at 04/29/2025 06:24:17 UTC. Any changes will be lost.
+* The export was adapted by hand for this application, regenerating
+* drops those changes. See "Regenerating the Model" in DEVELOPER_GUIDE.md.
 * 
 * Model ID  720d4320-4059-462e-a0c6-c47fd3bc4a60
 * 
 * Memory    Size                      Efficiency
-* Buffers   10256 bytes (RAM)         80 %
-* State     24792 bytes (RAM)         100 %
-* Readonly  107124 bytes (Flash)      100 %
+* Buffers   6000 bytes (RAM)          100 %
+* State     5008 bytes (RAM)          100 %
+* Arena     16384 bytes (RAM, NPU)    100 %
+* Readonly  105032 bytes (Flash)      100 %
 * 
-* Exported functions:
+* Exported model (see imai_model.h):
 * 
-*  @description: Try read data from model.
-*  @param data_out Output features. Output float[2].
-*  @return IPWIN_RET_SUCCESS (0) or IPWIN_RET_NODATA (-1), IPWIN_RET_ERROR (-2), IPWIN_RET_STREAMEND (-3)
-*  int IMAI_dequeue(float *data_out);
-* 
-*  @description: Try write data to model.
-*  @param data_in Input features. Input float[1].
-*  @return IPWIN_RET_SUCCESS (0) or IPWIN_RET_NODATA (-1), IPWIN_RET_ERROR (-2), IPWIN_RET_STREAMEND (-3)
-*  int IMAI_enqueue(const float *data_in);
-* 
-*  @description: Closes and flushes streams, free any heap allocated memory.
-*  void IMAI_finalize(void);
-* 
-*  @description: Initializes buffers to initial state.
-*  @return IPWIN_RET_SUCCESS (0) or IPWIN_RET_NODATA (-1), IPWIN_RET_ERROR (-2), IPWIN_RET_STREAMEND (-3)
-*  int IMAI_init(void);
+*  const imai_model_def_t baby_cry_model;
 * 
 * 
 * Disclaimer:
@@ -39,7 +27,11 @@
 *   tl;dr Compile using gcc with -O3 or -Ofast
 */
 
+#ifndef BABY_CRY_H_
+#define BABY_CRY_H_
+
 #include <stdint.h>
+#include "imai_model.h"
 #define IMAI_API_QUEUE
 
 typedef int8_t q7_t;         // 8-bit fractional data type in Q1.7 format.
@@ -82,10 +74,10 @@ typedef int64_t q63_t;       // 64-bit fractional data type in Q1.63 format.
 #define IMAI_DATA_OUT_SCALE 1
 #define IMAI_DATA_OUT_SYMBOLS {"unlabelled", "baby_cry"}
 
-// data_in [1] (4 bytes)
+// data_in [20] (80 bytes), one log-mel frame from the shared front end
 #define IMAI_DATA_IN_RANK (1)
-#define IMAI_DATA_IN_SHAPE (((int[]){1})
-#define IMAI_DATA_IN_COUNT (1)
+#define IMAI_DATA_IN_SHAPE (((int[]){20})
+#define IMAI_DATA_IN_COUNT (20)
 #define IMAI_DATA_IN_TYPE float
 #define IMAI_DATA_IN_TYPE_ID IMAGINET_TYPES_FLOAT32
 #define IMAI_DATA_IN_SHIFT 0
@@ -106,11 +98,31 @@ typedef int64_t q63_t;       // 64-bit fractional data type in Q1.63 format.
 #define IPWIN_RET_ERROR -2
 #define IPWIN_RET_STREAMEND -3
 
-// Exported methods
-int IMAI_dequeue(float *restrict data_out);
-int IMAI_enqueue(const float *restrict data_in);
-void IMAI_finalize(void);
-int IMAI_init(void);
+// Streaming input: every frame is quantized once when it is enqueued and
+// the windows are cut from a ring of int8 frames, so the frames the windows
+// overlap by are not quantized again. 0 keeps the float window and quantizes
+// it per inference as exported; the model input is the same bit for bit.
+#ifndef BABY_CRY_STREAMING
+#define BABY_CRY_STREAMING (1)
+#endif
+
+// Instance memory requirements
+#if BABY_CRY_STREAMING
+#define BABY_CRY_BUFFER_SIZE (1200)
+#define BABY_CRY_STATE_SIZE (1408)
+#else
+#define BABY_CRY_BUFFER_SIZE (6000)
+#define BABY_CRY_STATE_SIZE (5008)
+#endif
+#define BABY_CRY_ARENA_SIZE (16384)
+#define BABY_CRY_WEIGHTS_SIZE (105032)
+
+// Feature window in log-mel frames
+#define BABY_CRY_WINDOW_FRAMES (60)
+#define BABY_CRY_WINDOW_STRIDE (33)
+
+// Exported model
+extern const imai_model_def_t baby_cry_model;
 
 
 #ifdef IMAI_REFLECTION
@@ -189,3 +201,5 @@ typedef struct {
 IMAI_api_def *IMAI_api(void);
 #endif /* IMAI_REFLECTION */
 
+#endif /* BABY_CRY_H_ */
+
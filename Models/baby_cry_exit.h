@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Early exit stage of the baby cry model (shared/audio/early_exit.h).
+ *
+ * Not calibrated: the threshold lets every window through to the model.
+ * Replace this file with the output of host/early_exit_calib for a corpus
+ * recorded with the board, see DEVELOPER_GUIDE.md.
+ */
+
+#ifndef BABY_CRY_EXIT_H_
+#define BABY_CRY_EXIT_H_
+
+#include <math.h>
+#include "early_exit.h"
+
+static const early_exit_params_t baby_cry_exit =
+{
+    .weights = { 0.0f },
+    .bias = 0.0f,
+    .threshold = -INFINITY,
+    .recall = 0.0f,
+};
+
+#endif /* BABY_CRY_EXIT_H_ */
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include "mtb_ml.h"
+#include "imai_model.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Number of model instances currently using the ML runtime */
+static uint32_t runtime_users = 0;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: imai_runtime_acquire
+********************************************************************************
+* Summary:
+*  Initializes the ML runtime (and NPU) for the first model instance. Later
+*  instances only take a reference.
+*
+* Parameters:
+*  npu_priority: NPU interrupt priority
+*
+* Return:
+*  IMAI_MODEL_RET_SUCCESS or IMAI_MODEL_RET_ERROR
+*
+*******************************************************************************/
+int imai_runtime_acquire(int npu_priority)
+{
+    if (0 == runtime_users)
+    {
+        if (CY_RSLT_SUCCESS != mtb_ml_init(npu_priority))
+        {
+            return IMAI_MODEL_RET_ERROR;
+        }
+    }
+    runtime_users++;
+    return IMAI_MODEL_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: imai_runtime_release
+********************************************************************************
+* Summary:
+*  Drops a reference to the ML runtime and deinitializes it after the last
+*  model instance has been finalized.
+*
+*******************************************************************************/
+void imai_runtime_release(void)
+{
+    if (runtime_users > 0)
+    {
+        runtime_users--;
+        if (0 == runtime_users)
+        {
+            mtb_ml_deinit();
+        }
+    }
+}
+
+/* [] END OF FILE */
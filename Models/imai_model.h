@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Instance based interface to the DEEPCRAFT generated models.
+ *
+ * Every generated model file exports a single model definition (for example
+ * baby_cry_model) instead of the global IMAI_init/IMAI_enqueue/IMAI_dequeue/
+ * IMAI_finalize symbols, so that several models can be linked into one image.
+ * The memory of a model is supplied by the caller through an imai_ctx_t:
+ *   - buffer: scratch memory that is only live inside dequeue(). Instances that
+ *     are driven from the same task may share one scratch buffer.
+ *   - state:  persistent CPU memory (feature windows). One per instance.
+ *   - arena:  persistent NPU tensor arena. One per instance, must be NPU
+ *     accessible.
+ * The weights are const and executed in place unless the caller supplies a
+ * RAM copy.
+ *
+ * The models consume log-mel frames of the shared front end (logmel.h):
+ * enqueue() takes one frame of in_count values and dequeue() succeeds once per
+ * window_stride frames after the first window_frames frames. The stride is a
+ * property of the instance, def->window_stride is its default.
+ *
+ * dequeue() is prepare() followed by run(). prepare() copies the complete
+ * window into the buffer and run() classifies it, so the two can run in
+ * different tasks: enqueue() may go on while run() works on the buffer.
+ * run_q() is run() without the dequantization of the scores: it returns the
+ * int8 output of the model, score = (q - output_zero_point) * output_scale
+ * of ctx->model, so that the caller can decide in the quantized domain and
+ * dequantize only what it reports (score_q.h).
+ */
+
+#ifndef IMAI_MODEL_H_
+#define IMAI_MODEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_utils.h"
+#include "mtb_ml_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifdef __GNUC__
+#define IMAI_ALIGNED(x)             __attribute__((aligned(x)))
+#else
+#define IMAI_ALIGNED(x)             __declspec(align(x))
+#endif
+
+/* Section used for the persistent model state, which includes the NPU arena */
+#ifdef CY_ML_ARENA_MEM
+ #define IMAI_ARENA_MEM             CY_SECTION(EXPAND_AND_STRINGIFY(CY_ML_ARENA_MEM))
+#else
+ #define IMAI_ARENA_MEM             CY_SECTION(".cy_socmem_data")
+#endif
+
+/* Upper bound of the output count of all linked models */
+#define IMAI_MODEL_MAX_OUTPUTS      (8)
+
+/* Return codes, same values as the generated IMAI_RET_xxx */
+#define IMAI_MODEL_RET_SUCCESS      (0)
+#define IMAI_MODEL_RET_NODATA       (-1)
+#define IMAI_MODEL_RET_ERROR        (-2)
+#define IMAI_MODEL_RET_STREAMEND    (-3)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+struct imai_model_def;
+
+/* One model instance */
+typedef struct
+{
+    const struct imai_model_def* def;
+    int8_t*                      buffer;  /* def->buffer_size bytes, 16-byte aligned */
+    int8_t*                      state;   /* def->state_size bytes, 16-byte aligned */
+    int8_t*                      arena;   /* def->arena_size bytes, 16-byte aligned */
+    const uint8_t*               weights; /* def->weights or a copy of it */
+    mtb_ml_model_t*              model;   /* Set by init() */
+    int                          window_stride; /* 1 .. def->window_frames */
+} imai_ctx_t;
+
+/* Model definition exported by each generated model file */
+typedef struct imai_model_def
+{
+    const char*         name;
+    uint32_t            buffer_size;
+    uint32_t            state_size;
+    uint32_t            arena_size;
+    const uint8_t*      weights;
+    uint32_t            weights_size;
+    int                 in_count;
+    int                 out_count;
+    int                 window_frames;
+    int                 window_stride;
+    const char* const*  labels;
+
+    int  (*init)(imai_ctx_t* ctx);
+    int  (*enqueue)(imai_ctx_t* ctx, const float* restrict data_in);
+    int  (*dequeue)(imai_ctx_t* ctx, float* restrict data_out);
+    int  (*prepare)(imai_ctx_t* ctx);
+    int  (*run)(imai_ctx_t* ctx, float* restrict data_out);
+    int  (*run_q)(imai_ctx_t* ctx, const int8_t** data_out);
+    void (*finalize)(imai_ctx_t* ctx);
+} imai_model_def_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Reference counted NPU/ML runtime start and stop, used by the generated code
+ * so that each instance can be initialized and finalized independently. */
+int  imai_runtime_acquire(int npu_priority);
+void imai_runtime_release(void);
+
+/*******************************************************************************
+* Inline Functions
+*******************************************************************************/
+/* Binds memory to an instance and initializes it. weights may be NULL to use
+ * def->weights in place. */
+static inline int imai_model_init(imai_ctx_t* ctx, const imai_model_def_t* def,
+                                  const uint8_t* weights, int8_t* buffer,
+                                  int8_t* state, int8_t* arena)
+{
+    ctx->def = def;
+    ctx->buffer = buffer;
+    ctx->state = state;
+    ctx->arena = arena;
+    ctx->weights = (NULL != weights) ? weights : def->weights;
+    ctx->model = NULL;
+    ctx->window_stride = def->window_stride;
+    return def->init(ctx);
+}
+
+static inline int imai_model_enqueue(imai_ctx_t* ctx, const float* restrict data_in)
+{
+    return ctx->def->enqueue(ctx, data_in);
+}
+
+static inline int imai_model_dequeue(imai_ctx_t* ctx, float* restrict data_out)
+{
+    return ctx->def->dequeue(ctx, data_out);
+}
+
+static inline int imai_model_prepare(imai_ctx_t* ctx)
+{
+    return ctx->def->prepare(ctx);
+}
+
+static inline int imai_model_run(imai_ctx_t* ctx, float* restrict data_out)
+{
+    return ctx->def->run(ctx, data_out);
+}
+
+static inline int imai_model_run_q(imai_ctx_t* ctx, const int8_t** data_out)
+{
+    return ctx->def->run_q(ctx, data_out);
+}
+
+static inline void imai_model_finalize(imai_ctx_t* ctx)
+{
+    ctx->def->finalize(ctx);
+}
+
+#endif /* IMAI_MODEL_H_ */
@@ -71,5 +71,51 @@ COMBINE_SIGN_JSON?=configs/boot_with_extended_boot.json
 # cm55
 #ML_DEEPCRAFT_CPU=cm55
 
+# Audio clips around detections: the CM55 keeps a pre-roll ring of PCM in
+# shared memory (shared/audio/clip_capture.h) and the CM33 uploads every clip
+# as IMA ADPCM chunks to the HTTP server of proj_cm33_ns/app_config.h.
+# Applies to both projects, so that the IPC layout matches.
+CLIP_UPLOAD?=0
+ifeq (1, $(CLIP_UPLOAD))
+DEFINES+=APP_CLIP_UPLOAD
+endif
+
+# Recording mode for training data: every raw PDM frame goes from a ring in
+# shared memory (shared/include/record_stream.h) to host/record_receiver, in
+# frames with a sequence number and a CRC (proj_cm33_ns/record_frame.h).
+# RECORD=TCP streams to RECORD_HOST of proj_cm33_ns/app_config.h over Wi-Fi,
+# RECORD=UART over the debug UART. Applies to both projects.
+RECORD?=
+ifneq (,$(RECORD))
+DEFINES+=APP_RECORD APP_RECORD_$(RECORD)
+endif
+
+# Per task CPU load, stack and heap high-water marks of both cores, counted
+# with the LPTimer of each core (shared/log/rt_stats.h) and published as
+# telemetry by the CM33 every RT_STATS_PERIOD_MS. Applies to both projects.
+RUNTIME_STATS?=1
+ifeq (1, $(RUNTIME_STATS))
+DEFINES+=APP_RUNTIME_STATS
+endif
+
+# Health of the audio input: RMS, noise floor, peak, DC offset and clipping
+# of every microphone and the PDM FIFO errors (shared/include/audio_health.h),
+# published as telemetry by the CM33 every AUDIO_HEALTH_PERIOD_MS. Applies to
+# both projects.
+AUDIO_HEALTH?=1
+ifeq (1, $(AUDIO_HEALTH))
+DEFINES+=APP_AUDIO_HEALTH
+endif
+
+# Operator level profile of the model (shared/include/model_profile.h): the
+# CM55 runs the model MODEL_PROFILE_RUNS times at boot in a TFLM interpreter
+# with the micro profiler and reports the latency and NPU or CPU placement
+# of every operator and the arena use. The CM33 logs the report and
+# publishes it once as telemetry. Applies to both projects.
+MODEL_PROFILE?=0
+ifeq (1, $(MODEL_PROFILE))
+DEFINES+=APP_MODEL_PROFILE
+endif
+
 
 include ../common_app.mk
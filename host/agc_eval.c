@@ -0,0 +1,415 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Evaluation of the input AGC (agc.h) against the former fixed boost of 10.
+ *
+ * Plays a synthetic cry corpus (or the given WAV files) at input levels from
+ * very quiet to very loud through both input stages and the log-mel front
+ * end. The features of every level are compared with the features of the
+ * same clip at the nominal level, which the fixed boost maps to the AGC
+ * target. Reported per level and stage:
+ *
+ *   clipped    samples hard clipped at +-1
+ *   limited    samples compressed by the soft limiter
+ *   gain       mean input gain
+ *   error      mean absolute log-mel error of the event frames
+ *   recall     event frames within EVAL_TOLERANCE of the nominal features
+ *
+ * The host NPU is a mock, so recall is measured on the features the model
+ * sees rather than on its decisions. Also reports the cost per hop of both
+ * input stages on this host. See DEVELOPER_GUIDE.md.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "agc.h"
+#include "cycle_counter.h"
+#include "logmel.h"
+#include "test_util.h"
+#include "wav_reader.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define EVAL_SECONDS                (12)
+#define EVAL_MAX_SAMPLES            (EVAL_SECONDS * LOGMEL_SAMPLE_RATE)
+#define EVAL_MAX_FRAMES             (EVAL_MAX_SAMPLES / LOGMEL_HOP_SIZE)
+
+/* The former input stage */
+#define EVAL_FIXED_BOOST            (10.0f)
+
+/* Event RMS of the nominal level: the fixed boost maps it to the AGC target */
+#define EVAL_NOMINAL_DBFS           (AGC_TARGET_DBFS - 20.0)
+
+/* Frames within this many dB of the loudest frame are event frames */
+#define EVAL_EVENT_RANGE_DB         (20.0)
+
+/* Mean absolute log-mel error of a frame that still counts as recalled */
+#define EVAL_TOLERANCE              (1.0)
+
+/* Passes over the clip per cost measurement, the fastest one counts */
+#define EVAL_TIMING_RUNS            (20)
+
+/* Synthetic cries: bursts of a harmonic tone with a wandering pitch over a
+ * steady background */
+#define EVAL_CRY_ON_S               (1.0)
+#define EVAL_CRY_OFF_S              (0.5)
+#define EVAL_CRY_RAMP_S             (0.05)
+#define EVAL_CRY_F0                 (420.0)
+#define EVAL_CRY_HARMONICS          (6)
+#define EVAL_BACKGROUND_DB          (-30.0)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    EVAL_FIXED = 0,
+    EVAL_AGC,
+    EVAL_STAGE_COUNT
+} eval_stage_t;
+
+typedef struct
+{
+    uint64_t    clipped;
+    uint64_t    limited;
+    double      gain_db;
+    double      error;
+    double      recall;
+    double      hop_ns;
+    uint32_t    hops;
+} eval_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const double levels_dbfs[] = { -70.0, -60.0, -50.0, -40.0, -30.0, -20.0, -10.0 };
+static const char* const stage_names[EVAL_STAGE_COUNT] = { "fixed", "agc" };
+
+static float clip[EVAL_MAX_SAMPLES];        /* Unit event RMS */
+static int16_t pcm[EVAL_MAX_SAMPLES];
+static int clip_samples;
+static bool event_frame[EVAL_MAX_FRAMES];
+static int event_count;
+
+static float reference[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static float features[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static int frame_count;
+
+static logmel_t frontend;
+static logmel_scratch_t frontend_scratch;
+static logmel_consumer_t collector;
+static agc_t agc;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void render_cries(void)
+{
+    const double period = EVAL_CRY_ON_S + EVAL_CRY_OFF_S;
+    const double background = pow(10.0, EVAL_BACKGROUND_DB / 20.0);
+    uint32_t noise = 1u;
+    double phase = 0.0;
+
+    clip_samples = EVAL_MAX_SAMPLES;
+    for (int i = 0; i < clip_samples; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double in_cry = fmod(t, period);
+        double envelope = 0.0;
+        double f0 = EVAL_CRY_F0 * (1.0 + 0.15 * sin(2.0 * M_PI * 0.8 * t) + 0.03 * sin(2.0 * M_PI * 6.0 * t));
+        double v = 0.0;
+
+        if (in_cry < EVAL_CRY_ON_S)
+        {
+            double edge = fmin(in_cry, EVAL_CRY_ON_S - in_cry);
+            envelope = (edge < EVAL_CRY_RAMP_S) ? 0.5 - 0.5 * cos(M_PI * edge / EVAL_CRY_RAMP_S) : 1.0;
+        }
+        phase += 2.0 * M_PI * f0 / LOGMEL_SAMPLE_RATE;
+        for (int k = 1; k <= EVAL_CRY_HARMONICS; k++)
+        {
+            v += sin(k * phase) / k;
+        }
+        clip[i] = (float)(envelope * v + background * sqrt(12.0) * (next_uniform(&noise) - 0.5));
+    }
+}
+
+static int load_wav(const char* path)
+{
+    wav_reader_t reader;
+
+    if ((WAV_READER_RET_SUCCESS != wav_reader_open(&reader, path, false, 0)) ||
+        (LOGMEL_SAMPLE_RATE != reader.sample_rate))
+    {
+        return -1;
+    }
+    clip_samples = (int)wav_reader_read(&reader, pcm, EVAL_MAX_SAMPLES);
+    wav_reader_close(&reader);
+    for (int i = 0; i < clip_samples; i++)
+    {
+        clip[i] = (float)pcm[i];
+    }
+    return 0;
+}
+
+/* Marks the event frames and scales the clip to an event RMS of 1 */
+static int prepare_clip(void)
+{
+    double frame_power[EVAL_MAX_FRAMES];
+    double loudest = 0.0, event_power = 0.0;
+    uint64_t event_samples = 0;
+
+    frame_count = (clip_samples < LOGMEL_FFT_SIZE) ? 0 :
+                  (clip_samples - LOGMEL_FFT_SIZE) / LOGMEL_HOP_SIZE + 1;
+    for (int f = 0; f < frame_count; f++)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < LOGMEL_FFT_SIZE; i++)
+        {
+            double v = clip[f * LOGMEL_HOP_SIZE + i];
+            sum += v * v;
+        }
+        frame_power[f] = sum / LOGMEL_FFT_SIZE;
+        loudest = fmax(loudest, frame_power[f]);
+    }
+    if (0.0 == loudest)
+    {
+        return -1;
+    }
+    event_count = 0;
+    for (int f = 0; f < frame_count; f++)
+    {
+        event_frame[f] = (10.0 * log10(loudest / fmax(frame_power[f], 1e-30)) < EVAL_EVENT_RANGE_DB);
+        if (event_frame[f])
+        {
+            event_count++;
+            event_power += frame_power[f] * LOGMEL_FFT_SIZE;
+            event_samples += LOGMEL_FFT_SIZE;
+        }
+    }
+    float scale = (float)(1.0 / sqrt(event_power / (double)event_samples));
+    for (int i = 0; i < clip_samples; i++)
+    {
+        clip[i] *= scale;
+    }
+    return 0;
+}
+
+static int collect_frame(void* arg, const float* frame)
+{
+    float (*frames)[LOGMEL_BANDS] = arg;
+    uint32_t index = collector.frames;
+
+    if (index < EVAL_MAX_FRAMES)
+    {
+        memcpy(frames[index], frame, sizeof(frames[index]));
+    }
+    return 0;
+}
+
+/* Renders the clip at an event RMS of level_dbfs into 16 bit PCM */
+static void render_level(double level_dbfs)
+{
+    const double gain = 32768.0 * pow(10.0, level_dbfs / 20.0);
+
+    for (int i = 0; i < clip_samples; i++)
+    {
+        double v = round(gain * clip[i]);
+        pcm[i] = (int16_t)((v > 32767.0) ? 32767.0 : (v < -32768.0) ? -32768.0 : v);
+    }
+}
+
+static void reset_agc(void)
+{
+    agc_config_t config;
+
+    agc_default_config(&config);
+    agc_init(&agc, &config, LOGMEL_SAMPLE_RATE, LOGMEL_HOP_SIZE);
+}
+
+/* A block through an input stage. Not inlined, so that the block size is not
+ * a constant, as in the pipeline. */
+static __attribute__((noinline)) void input_stage(eval_stage_t stage, const int16_t* hop, int count, float* samples)
+{
+    if (EVAL_FIXED == stage)
+    {
+        /* The former audio_pipeline_normalize() loop */
+        for (int i = 0; i < count; i++)
+        {
+            float sample = ((float)hop[i] / 32768.0f) * EVAL_FIXED_BOOST;
+            if (sample > 1.0)
+            {
+                sample = 1.0;
+            }
+            else if (sample < -1.0)
+            {
+                sample = -1.0;
+            }
+            samples[i] = sample;
+        }
+    }
+    else
+    {
+        agc_process_q15(&agc, hop, count, samples);
+    }
+}
+
+/* Cost of an input stage per hop, the fastest of EVAL_TIMING_RUNS passes */
+static double time_stage(eval_stage_t stage)
+{
+    static float samples[LOGMEL_HOP_SIZE];
+    uint32_t best = UINT32_MAX;
+    int hops = clip_samples / LOGMEL_HOP_SIZE;
+
+    for (int run = 0; run < EVAL_TIMING_RUNS; run++)
+    {
+        reset_agc();
+        uint32_t start = cycle_counter_get();
+        for (int h = 0; h < hops; h++)
+        {
+            input_stage(stage, &pcm[h * LOGMEL_HOP_SIZE], LOGMEL_HOP_SIZE, samples);
+        }
+        uint32_t elapsed = cycle_counter_get() - start;
+        best = (elapsed < best) ? elapsed : best;
+    }
+    return (0 != hops) ? (double)best / hops : 0.0;
+}
+
+/*******************************************************************************
+* Function Name: run_stage
+********************************************************************************
+* Summary:
+*  Runs the PCM of render_level() through one input stage and the front end
+*  and collects the features in frames.
+*
+*******************************************************************************/
+static void run_stage(eval_stage_t stage, float (*frames)[LOGMEL_BANDS], eval_result_t* result)
+{
+    float samples[LOGMEL_HOP_SIZE];
+    double gain_db_sum = 0.0;
+
+    memset(result, 0, sizeof(*result));
+    logmel_init(&frontend, &frontend_scratch);
+    memset(&collector, 0, sizeof(collector));
+    collector.name = "eval";
+    collector.window_frames = 1;
+    collector.window_stride = 1;
+    collector.push = collect_frame;
+    collector.arg = frames;
+    logmel_add_consumer(&frontend, &collector);
+    reset_agc();
+
+    for (int offset = 0; offset + LOGMEL_HOP_SIZE <= clip_samples; offset += LOGMEL_HOP_SIZE)
+    {
+        input_stage(stage, &pcm[offset], LOGMEL_HOP_SIZE, samples);
+        result->hops++;
+        for (int i = 0; i < LOGMEL_HOP_SIZE; i++)
+        {
+            result->clipped += (fabsf(samples[i]) >= 1.0f);
+        }
+        gain_db_sum += (EVAL_FIXED == stage) ? 20.0 * log10(EVAL_FIXED_BOOST) : agc_gain_db(&agc);
+        logmel_process(&frontend, samples, LOGMEL_HOP_SIZE);
+    }
+
+    result->limited = (EVAL_AGC == stage) ? agc.limited_samples : 0u;
+    result->gain_db = (0u != result->hops) ? gain_db_sum / result->hops : 0.0;
+    result->hop_ns = time_stage(stage);
+}
+
+/* Compares the features with the reference over the event frames */
+static void score(eval_result_t* result)
+{
+    double error_sum = 0.0;
+    int events = 0, recalled = 0;
+
+    for (int f = 0; (f < frame_count) && (f < (int)collector.frames); f++)
+    {
+        double error = 0.0;
+        if (!event_frame[f])
+        {
+            continue;
+        }
+        for (int b = 0; b < LOGMEL_BANDS; b++)
+        {
+            error += fabs((double)features[f][b] - reference[f][b]);
+        }
+        error /= LOGMEL_BANDS;
+        error_sum += error;
+        recalled += (error < EVAL_TOLERANCE);
+        events++;
+    }
+    result->error = (0 != events) ? error_sum / events : 0.0;
+    result->recall = (0 != events) ? 100.0 * recalled / events : 0.0;
+}
+
+static void evaluate(const char* name)
+{
+    eval_result_t results[EVAL_STAGE_COUNT];
+    eval_result_t nominal;
+    double hop_ns[EVAL_STAGE_COUNT] = { 0.0 };
+    const int level_count = (int)(sizeof(levels_dbfs) / sizeof(levels_dbfs[0]));
+
+    render_level(EVAL_NOMINAL_DBFS);
+    run_stage(EVAL_FIXED, reference, &nominal);
+
+    printf("%s: %.1f s, %d event frames of %d, nominal level %.0f dBFS\n", name,
+           (double)clip_samples / LOGMEL_SAMPLE_RATE,
+           event_count, frame_count, EVAL_NOMINAL_DBFS);
+    printf("level_dbfs  stage  clipped_pct  limited_pct  gain_db  error  recall_pct\n");
+
+    for (int l = 0; l < level_count; l++)
+    {
+        render_level(levels_dbfs[l]);
+        for (int stage = 0; stage < EVAL_STAGE_COUNT; stage++)
+        {
+            eval_result_t* r = &results[stage];
+            run_stage((eval_stage_t)stage, features, r);
+            score(r);
+            hop_ns[stage] += r->hop_ns / level_count;
+            printf("%10.0f  %5s  %11.3f  %11.3f  %7.1f  %5.2f  %10.1f\n", levels_dbfs[l],
+                   stage_names[stage], 100.0 * (double)r->clipped / ((double)r->hops * LOGMEL_HOP_SIZE),
+                   100.0 * (double)r->limited / ((double)r->hops * LOGMEL_HOP_SIZE),
+                   r->gain_db, r->error, r->recall);
+        }
+    }
+    printf("cost per hop: fixed %.0f ns, agc %.0f ns\n\n", hop_ns[EVAL_FIXED], hop_ns[EVAL_AGC]);
+}
+
+int main(int argc, char* argv[])
+{
+    int ret = EXIT_SUCCESS;
+
+    cycle_counter_init();
+    if (argc < 2)
+    {
+        render_cries();
+        if (0 != prepare_clip())
+        {
+            return EXIT_FAILURE;
+        }
+        evaluate("synthetic cries");
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 != load_wav(argv[i])) || (0 != prepare_clip()))
+        {
+            fprintf(stderr, "%s: not a usable 16 bit PCM WAV file at %d Hz\n", argv[i],
+                    LOGMEL_SAMPLE_RATE);
+            ret = EXIT_FAILURE;
+            continue;
+        }
+        evaluate(argv[i]);
+    }
+    return ret;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the deferred log, shared/log/app_log.h.
+ *
+ * Checks that every drained record reads as snprintf() would have written
+ * it at the time of the call, also when a %s argument changes before the
+ * drain, that a full ring drops and counts records instead of blocking,
+ * that the level filter works and that records of concurrent producers
+ * arrive complete and in the order of each producer. Reports the cost of
+ * a call and of a drained record. Exits with 1 on failure.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "app_log.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_NOW_MS                 (12345u)
+#define TEST_PREFIX                 "[   12.345] cm33 I "
+
+#define TEST_PRODUCERS              (4)
+#define TEST_RECORDS_PER_PRODUCER   (20000)
+
+#define TEST_COST_ROUNDS            (2000)
+#define TEST_COST_BURST             (32)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static char output[1 << 16];
+static size_t output_size;
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static uint32_t test_now_ms(void)
+{
+    return TEST_NOW_MS;
+}
+
+static void test_write(const char* text, uint32_t size)
+{
+    if (output_size + size < sizeof(output))
+    {
+        memcpy(&output[output_size], text, size);
+        output_size += size;
+    }
+    output[output_size] = '\0';
+}
+
+static void drain_all(void)
+{
+    output_size = 0;
+    output[0] = '\0';
+    app_log_drain(0);
+}
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return (double)(end->tv_sec - start->tv_sec) * 1e9 + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+/*******************************************************************************
+* Function Name: check_format
+********************************************************************************
+* Summary:
+*  Logs one record, changes the string argument and compares the drained line
+*  with snprintf() at the time of the call.
+*
+*******************************************************************************/
+#define check_format(...)                                                       \
+    do                                                                          \
+    {                                                                           \
+        char expected[APP_LOG_LINE_SIZE];                                       \
+        int length = snprintf(expected, sizeof(expected), TEST_PREFIX);         \
+        snprintf(&expected[length], sizeof(expected) - length, __VA_ARGS__);    \
+        if ('\n' != expected[strlen(expected) - 1])                             \
+        {                                                                       \
+            strcat(expected, "\n");                                             \
+        }                                                                       \
+        app_log(APP_LOG_LEVEL_INFO, __VA_ARGS__);                               \
+        strcpy(changing, "changed");                                            \
+        drain_all();                                                            \
+        CHECK(0 == strcmp(output, expected), "got \"%s\", expected \"%s\"", output, expected); \
+        strcpy(changing, "dynamic");                                            \
+    } while (0)
+
+static void test_formats(void)
+{
+    char changing[16] = "dynamic";
+
+    check_format("plain");
+    check_format("int %d neg %i u %u x %08x X %#X o %o c %c", 42, -7, 4000000000u, 0xbeef, 255, 8, 'z');
+    check_format("long %ld %lu long long %lld %llx", -123456789L, 99UL, -1234567890123LL, 0xabcdef0123ULL);
+    check_format("size %zu %5.2f %e %-8.3g|", (size_t)1234, 3.14159, 1e-9, 2.5);
+    check_format("string %s %10s|%-6.3s|", changing, "right", "abcdef");
+    check_format("star %*d %.*f %*.*f", 6, 42, 2, 1.23456, 9, 3, 2.71828);
+    check_format("percent 100%% %c%%", 'x');
+    check_format("short %hhd %hd", 300, 70000);
+    check_format("pointer %p", (void*)0x1234);
+    check_format("label: %-11s: score: %.4f\r\n", "baby_cry", 0.87654);
+}
+
+static void test_filter_and_overflow(void)
+{
+    app_log_stats_t before;
+    app_log_stats_t after;
+    uint32_t lines = 0;
+
+    app_log_get_stats(&before);
+    app_log(APP_LOG_LEVEL_DEBUG, "filtered %d", 1);
+    drain_all();
+    CHECK(0 == output_size, "a debug record passed the info level");
+
+    for (uint32_t i = 0; i < APP_LOG_RING_SIZE + 36u; i++)
+    {
+        app_log(APP_LOG_LEVEL_WARN, "overflow %lu", (unsigned long)i);
+    }
+    drain_all();
+    app_log_get_stats(&after);
+    for (const char* c = output; *c != '\0'; c++)
+    {
+        lines += ('\n' == *c);
+    }
+
+    /* The kept records plus the line that reports the dropped ones */
+    CHECK(APP_LOG_RING_SIZE + 1u == lines, "%lu lines after an overflow", (unsigned long)lines);
+    CHECK(36u == after.dropped - before.dropped, "%lu records dropped, expected 36",
+          (unsigned long)(after.dropped - before.dropped));
+    CHECK(1u == after.filtered - before.filtered, "filtered count not updated");
+    CHECK(NULL != strstr(output, "36 messages dropped"), "no report of the dropped records");
+    printf("overflow: %lu records kept, %lu dropped\n", (unsigned long)APP_LOG_RING_SIZE,
+           (unsigned long)(after.dropped - before.dropped));
+}
+
+static void* producer(void* arg)
+{
+    long id = (long)arg;
+
+    for (int i = 0; i < TEST_RECORDS_PER_PRODUCER; i++)
+    {
+        /* Full ring: wait for the drain, as a test only */
+        while (!app_log(APP_LOG_LEVEL_INFO, "producer %ld record %d", id, i))
+        {
+        }
+    }
+    return NULL;
+}
+
+static void test_concurrency(void)
+{
+    pthread_t threads[TEST_PRODUCERS];
+    int next[TEST_PRODUCERS] = { 0 };
+    long total = 0;
+    int errors = 0;
+
+    for (long i = 0; i < TEST_PRODUCERS; i++)
+    {
+        pthread_create(&threads[i], NULL, producer, (void*)i);
+    }
+
+    while (total < TEST_PRODUCERS * TEST_RECORDS_PER_PRODUCER)
+    {
+        output_size = 0;
+        output[0] = '\0';
+        total += app_log_drain(APP_LOG_RING_SIZE);
+
+        for (char* line = output; '\0' != *line; line = strchr(line, '\n') + 1)
+        {
+            long id;
+            int record;
+            if (0 == strncmp(&line[sizeof(TEST_PREFIX) - 3u], "W log:", 6))
+            {
+                /* The spinning producers found the ring full */
+                continue;
+            }
+            if ((2 != sscanf(line, TEST_PREFIX "producer %ld record %d", &id, &record))
+                || (id < 0) || (id >= TEST_PRODUCERS) || (record != next[id]))
+            {
+                errors++;
+                continue;
+            }
+            next[id] = record + 1;
+        }
+    }
+
+    for (int i = 0; i < TEST_PRODUCERS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        CHECK(TEST_RECORDS_PER_PRODUCER == next[i], "producer %d ended at %d", i, next[i]);
+    }
+    CHECK(0 == errors, "%d records lost, damaged or out of order", errors);
+    printf("concurrency: %d producers, %ld records\n", TEST_PRODUCERS, total);
+}
+
+static void test_cost(void)
+{
+    struct timespec start;
+    struct timespec end;
+    double log_ns = 0.0;
+    double drain_ns = 0.0;
+
+    for (int round = 0; round < TEST_COST_ROUNDS; round++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < TEST_COST_BURST; i++)
+        {
+            app_log(APP_LOG_LEVEL_INFO, "window %d label %s score %.2f", i, "baby_cry", 0.87);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        log_ns += elapsed_ns(&start, &end);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        drain_all();
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        drain_ns += elapsed_ns(&start, &end);
+    }
+
+    printf("cost: %.0f ns per call, %.0f ns per drained record\n",
+           log_ns / (TEST_COST_ROUNDS * TEST_COST_BURST), drain_ns / (TEST_COST_ROUNDS * TEST_COST_BURST));
+}
+
+int main(void)
+{
+    static const app_log_port_t port = { test_now_ms, test_write, APP_LOG_CORE_CM33 };
+
+    /* Before the init a record is dropped, not stored */
+    CHECK(!app_log(APP_LOG_LEVEL_ERROR, "before init"), "record accepted before the init");
+
+    app_log_init(&port, APP_LOG_LEVEL_INFO);
+    drain_all();
+
+    test_formats();
+    test_filter_and_overflow();
+    test_concurrency();
+    test_cost();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,197 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the asynchronous inference of the audio pipeline,
+ * audio_pipeline_set_executor().
+ *
+ * Replays synthetic audio in PDM sized blocks through the pipeline twice:
+ * once classifying every window in place, once with an executor that defers
+ * the classification until the next block went through the front end, as
+ * the inference task of the CM55 overlaps it. With the model stride the
+ * window in flight is collected between blocks; with a stride of one frame
+ * the next window is complete first and the pipeline has to wait for it.
+ * The mock NPU is a linear probe of the window, so every decision of the two
+ * runs must agree bit for bit, which also checks that the front end does not
+ * write into the model scratch while it is in flight. Built with
+ * AUDIO_ASYNC_INFERENCE=1, exits with 1 on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "host_platform.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SECONDS                (6)
+#define TEST_SAMPLES                (TEST_SECONDS * LOGMEL_SAMPLE_RATE)
+#define TEST_BLOCK                  (1024u)
+#define TEST_MAX_RESULTS            (TEST_SAMPLES / LOGMEL_HOP_SIZE)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    audio_result_t  results[TEST_MAX_RESULTS];
+    int             count;
+} test_run_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+static int16_t pcm[TEST_SAMPLES];
+static test_run_t in_place;
+static test_run_t deferred;
+
+/* Deferred executor: a started window is classified with the next block */
+static int started;
+static int waits;
+static int pending;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Tone bursts with a rising pitch over noise, so that the windows differ */
+static void render_pcm(void)
+{
+    uint32_t state = 7u;
+    double phase = 0.0;
+
+    for (int i = 0; i < TEST_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double envelope = (fmod(t, 1.5) < 0.8) ? 0.3 : 0.02;
+        double noise;
+
+        noise = next_uniform(&state) - 0.5;
+        phase += 2.0 * M_PI * (300.0 + 200.0 * t) / LOGMEL_SAMPLE_RATE;
+        pcm[i] = (int16_t)lrint(32767.0 * (envelope * sin(phase) + 0.01 * noise));
+    }
+}
+
+static void record_result(const audio_result_t* result, void* arg)
+{
+    test_run_t* run = (test_run_t*)arg;
+
+    if (run->count < TEST_MAX_RESULTS)
+    {
+        run->results[run->count] = *result;
+    }
+    run->count++;
+}
+
+static void deferred_start(void* arg)
+{
+    (void)arg;
+    CHECK(0 == pending, "window started while one is in flight");
+    pending = 1;
+    started++;
+}
+
+static void deferred_wait(void* arg)
+{
+    (void)arg;
+    CHECK(1 == pending, "wait without a window in flight");
+    waits++;
+    pending = 0;
+    audio_pipeline_infer();
+}
+
+static const audio_executor_t deferred_executor = { deferred_start, deferred_wait, NULL };
+
+/* Replays the audio, classifying the window in flight after each block */
+static void replay(uint16_t stride, test_run_t* run, const audio_executor_t* executor)
+{
+    memset(run, 0, sizeof(*run));
+    pending = 0;
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_restart(stride, record_result, run), "restart");
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_set_executor(executor), "executor");
+    CHECK(!audio_pipeline_collect(false), "decision without a window");
+
+    for (uint32_t offset = 0; offset < TEST_SAMPLES; offset += TEST_BLOCK)
+    {
+        uint32_t count = ((TEST_SAMPLES - offset) < TEST_BLOCK) ? (TEST_SAMPLES - offset) : TEST_BLOCK;
+
+        audio_pipeline_process(&pcm[offset], count);
+        if (pending)
+        {
+            CHECK(!audio_pipeline_collect(false), "decision before the window was classified");
+            pending = 0;
+            audio_pipeline_infer();
+        }
+        (void)audio_pipeline_collect(false);
+    }
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_set_executor(NULL), "executor reset");
+}
+
+static void compare(const char* name)
+{
+    int count = (in_place.count < TEST_MAX_RESULTS) ? in_place.count : TEST_MAX_RESULTS;
+    int mismatches = 0;
+
+    CHECK(in_place.count == deferred.count, "%s: %d decisions in place, %d deferred", name,
+          in_place.count, deferred.count);
+    CHECK(in_place.count > 2, "%s: only %d decisions", name, in_place.count);
+    for (int i = 0; (i < count) && (i < deferred.count); i++)
+    {
+        const audio_result_t* a = &in_place.results[i];
+        const audio_result_t* b = &deferred.results[i];
+
+        if ((a->window != b->window) || (a->frame != b->frame) || (a->sample != b->sample) ||
+            (a->label_id != b->label_id) || (a->gain_db != b->gain_db) ||
+            (0 != memcmp(a->scores_q, b->scores_q, (size_t)a->score_count)))
+        {
+            mismatches++;
+        }
+    }
+    CHECK(0 == mismatches, "%s: %d decisions differ", name, mismatches);
+    printf("%-13s %d windows, %d started, %d waits\n", name, deferred.count, started, waits);
+}
+
+int main(void)
+{
+    render_pcm();
+    host_ml_set_probe(baby_cry_model.in_count * baby_cry_model.window_frames);
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, NULL, NULL))
+    {
+        printf("FAIL: pipeline init\n");
+        return 1;
+    }
+
+    /* Model stride: the window in flight is collected between blocks */
+    replay(0, &in_place, NULL);
+    started = 0;
+    waits = 0;
+    replay(0, &deferred, &deferred_executor);
+    CHECK(started == deferred.count, "%d started for %d decisions", started, deferred.count);
+    CHECK(0 == waits, "%d waits at the model stride", waits);
+    compare("model stride");
+
+    /* One frame: several windows per block, each waits for the previous */
+    replay(1, &in_place, NULL);
+    started = 0;
+    waits = 0;
+    replay(1, &deferred, &deferred_executor);
+    CHECK(waits > 0, "no waits at a stride of one frame");
+    compare("stride 1");
+
+    audio_pipeline_deinit();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host driver of the audio pipeline throughput benchmark (audio_bench.h).
+ * Runs the benchmark on a thread with a painted stack so that the stack
+ * high-water mark can be reported, and writes the JSON document to stdout.
+ * `make bench` runs it for several FFT sizes and hops, see host/Makefile.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "audio_bench.h"
+#include "audio_pipeline.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_STACK_SIZE            (256u * 1024u)
+#define BENCH_STACK_PAINT           (0xA5u)
+#define BENCH_MAX_CONFIGS           (16)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t* bench_stack;
+static audio_bench_config_t configs[BENCH_MAX_CONFIGS];
+static int config_count;
+static uint32_t seconds = AUDIO_BENCH_SECONDS;
+static int bench_result = AUDIO_BENCH_RET_ERROR;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* The stack grows down, the lowest overwritten byte marks the high-water */
+static uint32_t bench_stack_used(void)
+{
+    uint32_t untouched = 0;
+
+    while ((untouched < BENCH_STACK_SIZE) && (BENCH_STACK_PAINT == bench_stack[untouched]))
+    {
+        untouched++;
+    }
+    return BENCH_STACK_SIZE - untouched;
+}
+
+static void* bench_thread(void* arg)
+{
+    (void)arg;
+
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, NULL, NULL))
+    {
+        fprintf(stderr, "audio pipeline initialization failed\n");
+        return NULL;
+    }
+    bench_result = audio_bench_run("host",
+                                   (0 != config_count) ? configs : audio_bench_configs,
+                                   (0 != config_count) ? config_count : audio_bench_config_count,
+                                   seconds, bench_stack_used, printf);
+    audio_pipeline_deinit();
+    return NULL;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-s seconds] [-c block:stride ...]\n"
+            "  -s seconds       audio per configuration (default %d)\n"
+            "  -c block:stride  samples per call and model stride (0 = model default),\n"
+            "                   repeatable, replaces the default configurations\n",
+            name, AUDIO_BENCH_SECONDS);
+}
+
+int main(int argc, char* argv[])
+{
+    pthread_attr_t attr;
+    pthread_t thread;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "s:c:h")))
+    {
+        unsigned long block, stride;
+
+        switch (opt)
+        {
+            case 's':
+                seconds = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                if ((BENCH_MAX_CONFIGS == config_count) ||
+                    (2 != sscanf(optarg, "%lu:%lu", &block, &stride)))
+                {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                configs[config_count].block_samples = (uint32_t)block;
+                configs[config_count].window_stride = (uint16_t)stride;
+                config_count++;
+                break;
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if ((0u == seconds) || (optind != argc))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_stack = aligned_alloc(4096, BENCH_STACK_SIZE);
+    if (NULL == bench_stack)
+    {
+        return EXIT_FAILURE;
+    }
+    memset(bench_stack, BENCH_STACK_PAINT, BENCH_STACK_SIZE);
+
+    if ((0 != pthread_attr_init(&attr)) ||
+        (0 != pthread_attr_setstack(&attr, bench_stack, BENCH_STACK_SIZE)) ||
+        (0 != pthread_create(&thread, &attr, bench_thread, NULL)))
+    {
+        fprintf(stderr, "cannot start the benchmark thread\n");
+        return EXIT_FAILURE;
+    }
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+    free(bench_stack);
+
+    return (AUDIO_BENCH_RET_SUCCESS == bench_result) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,599 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Golden feature regression check of the DEEPCRAFT preprocessing chain.
+ *
+ * Pushes a fixed set of synthetic clips (and optionally WAV files) through
+ * the audio pipeline and compares the magnitude spectrum, the mel energies,
+ * the log-mel features and the model scores against the golden vectors in
+ * host/golden, each stage with its own tolerance. The model is the linear
+ * probe of host_platform.c, so the scores follow the quantized model input.
+ * Also reports the throughput in frames per second. See DEVELOPER_GUIDE.md.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "audio.h"
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "host_platform.h"
+#include "test_util.h"
+#include "wav_reader.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CLIP_SECONDS                (2)
+#define CLIP_SAMPLES                (CLIP_SECONDS * LOGMEL_SAMPLE_RATE)
+
+/* Frames whose stages are recorded */
+#define GOLDEN_SPECTRUM_EVERY       (64)
+#define GOLDEN_MEL_EVERY            (8)
+
+#define GOLDEN_MAX_VALUES           (LOGMEL_BINS)
+#define GOLDEN_LINE_SIZE            (8192)
+#define GOLDEN_PATH_SIZE            (512)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    GOLDEN_MAGNITUDE = 0,
+    GOLDEN_MEL,
+    GOLDEN_LOGMEL,
+    GOLDEN_SCORES,
+    GOLDEN_LABEL,
+    GOLDEN_STAGE_COUNT
+} golden_stage_t;
+
+/* Allowed error: abs_tol + rel_tol * largest magnitude of the golden vector */
+typedef struct
+{
+    const char* name;
+    double      abs_tol;
+    double      rel_tol;
+} golden_tolerance_t;
+
+typedef struct
+{
+    golden_stage_t  stage;
+    uint32_t        index;          /* Frame or window */
+    int             count;
+    float           values[GOLDEN_MAX_VALUES];
+} golden_record_t;
+
+typedef struct
+{
+    golden_record_t*    records;
+    int                 count;
+    int                 size;
+} golden_set_t;
+
+typedef void (*clip_fn)(int16_t* pcm, int count);
+
+typedef struct
+{
+    const char* name;
+    clip_fn     generate;
+} clip_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const golden_tolerance_t tolerances[GOLDEN_STAGE_COUNT] =
+{
+    [GOLDEN_MAGNITUDE] = { "magnitude", 1e-6, 1e-4 },
+    [GOLDEN_MEL]       = { "mel",       1e-7, 1e-4 },
+    [GOLDEN_LOGMEL]    = { "logmel",    1e-4, 0.0 },
+    [GOLDEN_SCORES]    = { "scores",    1.0 / 256.0 + 1e-6, 0.0 },   /* One output LSB */
+    [GOLDEN_LABEL]     = { "label",     0.0, 0.0 },
+};
+
+/* Recording of the clip being processed */
+static golden_set_t capture;
+static bool capturing;
+static uint32_t tap_frame;
+static uint32_t windows;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static int16_t to_pcm(double value)
+{
+    value = round(value * 32767.0);
+    return (int16_t)((value > 32767.0) ? 32767.0 : (value < -32768.0) ? -32768.0 : value);
+}
+
+static void clip_silence(int16_t* pcm, int count)
+{
+    memset(pcm, 0, (size_t)count * sizeof(int16_t));
+}
+
+static void clip_tone(int16_t* pcm, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        pcm[i] = to_pcm(0.05 * sin(2.0 * M_PI * 1000.0 * i / LOGMEL_SAMPLE_RATE));
+    }
+}
+
+static void clip_sweep(int16_t* pcm, int count)
+{
+    /* Exponential sweep from 100 Hz to 7 kHz */
+    const double f0 = 100.0, f1 = 7000.0;
+    const double k = log(f1 / f0) / ((double)count / LOGMEL_SAMPLE_RATE);
+
+    for (int i = 0; i < count; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        pcm[i] = to_pcm(0.05 * sin(2.0 * M_PI * f0 * (exp(k * t) - 1.0) / k));
+    }
+}
+
+static void clip_noise(int16_t* pcm, int count)
+{
+    uint32_t state = 12345u;
+
+    for (int i = 0; i < count; i++)
+    {
+        pcm[i] = (int16_t)((int32_t)(next_random(&state) >> 8) % 1000 - 500);
+    }
+}
+
+static void clip_saturated(int16_t* pcm, int count)
+{
+    /* Saturates after the digital boost of the pipeline */
+    for (int i = 0; i < count; i++)
+    {
+        pcm[i] = to_pcm(0.5 * sin(2.0 * M_PI * 300.0 * i / LOGMEL_SAMPLE_RATE));
+    }
+}
+
+static void clip_bursts(int16_t* pcm, int count)
+{
+    uint32_t state = 777u;
+
+    /* 100 ms noise bursts every 250 ms */
+    for (int i = 0; i < count; i++)
+    {
+        bool on = (i % (LOGMEL_SAMPLE_RATE / 4)) < (LOGMEL_SAMPLE_RATE / 10);
+        int32_t noise = (int32_t)(next_random(&state) >> 8) % 5000 - 2500;
+        pcm[i] = on ? (int16_t)noise : 0;
+    }
+}
+
+static const clip_t clips[] =
+{
+    { "silence",   clip_silence },
+    { "tone_1k",   clip_tone },
+    { "sweep",     clip_sweep },
+    { "noise",     clip_noise },
+    { "saturated", clip_saturated },
+    { "bursts",    clip_bursts },
+};
+
+static double seconds_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static golden_record_t* golden_add(golden_set_t* set, golden_stage_t stage, uint32_t index,
+                                   const float* values, int count)
+{
+    if (set->count == set->size)
+    {
+        int size = (0 != set->size) ? 2 * set->size : 256;
+        golden_record_t* grown = realloc(set->records, (size_t)size * sizeof(golden_record_t));
+        if (NULL == grown)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        set->records = grown;
+        set->size = size;
+    }
+
+    golden_record_t* r = &set->records[set->count++];
+    r->stage = stage;
+    r->index = index;
+    r->count = (count > GOLDEN_MAX_VALUES) ? GOLDEN_MAX_VALUES : count;
+    memcpy(r->values, values, (size_t)r->count * sizeof(float));
+    return r;
+}
+
+/*******************************************************************************
+* Function Name: logmel_tap
+********************************************************************************
+* Summary:
+*  Front end stage tap, records the stages of the selected frames.
+*
+*******************************************************************************/
+void logmel_tap(logmel_stage_t stage, const float* data, int count)
+{
+    if (!capturing)
+    {
+        return;
+    }
+
+    switch (stage)
+    {
+        case LOGMEL_STAGE_MAGNITUDE:
+            if (0 == tap_frame % GOLDEN_SPECTRUM_EVERY)
+            {
+                golden_add(&capture, GOLDEN_MAGNITUDE, tap_frame, data, count);
+            }
+            break;
+        case LOGMEL_STAGE_MEL:
+            if (0 == tap_frame % GOLDEN_MEL_EVERY)
+            {
+                golden_add(&capture, GOLDEN_MEL, tap_frame, data, count);
+            }
+            break;
+        case LOGMEL_STAGE_LOGMEL:
+            if (0 == tap_frame % GOLDEN_MEL_EVERY)
+            {
+                golden_add(&capture, GOLDEN_LOGMEL, tap_frame, data, count);
+            }
+            tap_frame++;
+            break;
+        default:
+            break;
+    }
+}
+
+static void record_result(const audio_result_t* result, void* arg)
+{
+    float label = (float)result->label_id;
+    float scores[AUDIO_PIPELINE_MAX_SCORES];
+
+    (void)arg;
+    windows++;
+    if (capturing)
+    {
+        for (int i = 0; i < result->score_count; i++)
+        {
+            scores[i] = audio_result_score(result, i);
+        }
+        golden_add(&capture, GOLDEN_SCORES, result->window, scores, result->score_count);
+        golden_add(&capture, GOLDEN_LABEL, result->window, &label, 1);
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_clip
+********************************************************************************
+* Summary:
+*  Runs one clip through a freshly initialized pipeline.
+*
+* Return:
+*  Seconds the processing took
+*
+*******************************************************************************/
+static double run_clip(const int16_t* pcm, int count, bool record)
+{
+    double start;
+
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, record_result, NULL))
+    {
+        fprintf(stderr, "audio pipeline initialization failed\n");
+        exit(EXIT_FAILURE);
+    }
+    capturing = record;
+    tap_frame = 0;
+    windows = 0;
+
+    start = seconds_now();
+    for (int offset = 0; offset < count; offset += FRAME_SIZE)
+    {
+        int block = (count - offset < FRAME_SIZE) ? count - offset : FRAME_SIZE;
+        audio_pipeline_process(&pcm[offset], (uint32_t)block);
+    }
+    start = seconds_now() - start;
+
+    capturing = false;
+    audio_pipeline_deinit();
+    return start;
+}
+
+static int golden_write(const char* path, const char* clip, const golden_set_t* set)
+{
+    FILE* f = fopen(path, "w");
+
+    if (NULL == f)
+    {
+        return -1;
+    }
+    fprintf(f, "# Golden vectors of clip %s, written by audio_golden -u\n", clip);
+    fprintf(f, "# stage index values...\n");
+    for (int i = 0; i < set->count; i++)
+    {
+        const golden_record_t* r = &set->records[i];
+        fprintf(f, "%s %lu", tolerances[r->stage].name, (unsigned long)r->index);
+        for (int j = 0; j < r->count; j++)
+        {
+            fprintf(f, " %.7g", r->values[j]);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int golden_read(const char* path, golden_set_t* set)
+{
+    static char line[GOLDEN_LINE_SIZE];
+    FILE* f = fopen(path, "r");
+
+    if (NULL == f)
+    {
+        return -1;
+    }
+    while (NULL != fgets(line, sizeof(line), f))
+    {
+        float values[GOLDEN_MAX_VALUES];
+        char name[32];
+        unsigned long index;
+        int consumed;
+        int count = 0;
+        int stage;
+        char* p;
+
+        if (('#' == line[0]) || (2 != sscanf(line, "%31s %lu%n", name, &index, &consumed)))
+        {
+            continue;
+        }
+        for (stage = 0; stage < GOLDEN_STAGE_COUNT; stage++)
+        {
+            if (0 == strcmp(name, tolerances[stage].name))
+            {
+                break;
+            }
+        }
+        if (GOLDEN_STAGE_COUNT == stage)
+        {
+            fclose(f);
+            return -1;
+        }
+        p = &line[consumed];
+        while (count < GOLDEN_MAX_VALUES)
+        {
+            char* end;
+            values[count] = strtof(p, &end);
+            if (end == p)
+            {
+                break;
+            }
+            count++;
+            p = end;
+        }
+        golden_add(set, (golden_stage_t)stage, (uint32_t)index, values, count);
+    }
+    fclose(f);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: golden_compare
+********************************************************************************
+* Summary:
+*  Compares a recording with the golden set and prints the largest error of
+*  every stage relative to its tolerance.
+*
+* Return:
+*  true if every value is within its tolerance
+*
+*******************************************************************************/
+static bool golden_compare(const golden_set_t* golden, const golden_set_t* actual)
+{
+    double worst[GOLDEN_STAGE_COUNT] = { 0 };
+    int failures[GOLDEN_STAGE_COUNT] = { 0 };
+    bool pass = (golden->count == actual->count);
+
+    if (!pass)
+    {
+        printf("    record count %d, golden %d\n", actual->count, golden->count);
+    }
+
+    for (int i = 0; (i < golden->count) && (i < actual->count); i++)
+    {
+        const golden_record_t* g = &golden->records[i];
+        const golden_record_t* a = &actual->records[i];
+        const golden_tolerance_t* tol = &tolerances[g->stage];
+        double scale = 0.0;
+
+        if ((g->stage != a->stage) || (g->index != a->index) || (g->count != a->count))
+        {
+            printf("    record %d: %s %lu, golden %s %lu\n", i, tolerances[a->stage].name,
+                   (unsigned long)a->index, tol->name, (unsigned long)g->index);
+            return false;
+        }
+        for (int j = 0; j < g->count; j++)
+        {
+            scale = fmax(scale, fabs(g->values[j]));
+        }
+        double allowed = tol->abs_tol + tol->rel_tol * scale;
+        for (int j = 0; j < g->count; j++)
+        {
+            double err = fabs((double)a->values[j] - (double)g->values[j]);
+            double ratio = (allowed > 0.0) ? err / allowed : ((err > 0.0) ? INFINITY : 0.0);
+            worst[g->stage] = fmax(worst[g->stage], ratio);
+            if (err > allowed)
+            {
+                failures[g->stage]++;
+            }
+        }
+    }
+
+    for (int s = 0; s < GOLDEN_STAGE_COUNT; s++)
+    {
+        printf("    %-10s worst %.3f of tolerance, %d outside\n", tolerances[s].name, worst[s], failures[s]);
+        pass = pass && (0 == failures[s]);
+    }
+    return pass;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-u] [-g dir] [input.wav ...]\n"
+            "  -u      write the golden vectors instead of comparing\n"
+            "  -g dir  golden vector directory (default golden)\n"
+            "Runs the built-in clips and every given 16 kHz 16 bit PCM WAV file.\n",
+            name);
+}
+
+/*******************************************************************************
+* Function Name: check_clip
+********************************************************************************
+* Summary:
+*  Times one clip, records its stages and compares them with, or writes them
+*  to, the golden file of the clip.
+*
+* Return:
+*  true if the clip passed
+*
+*******************************************************************************/
+static bool check_clip(const char* name, const int16_t* pcm, int count, const char* dir,
+                       bool update, double* total_seconds, uint64_t* total_frames)
+{
+    char path[GOLDEN_PATH_SIZE];
+    golden_set_t golden = { 0 };
+    uint32_t frames;
+    double seconds;
+    bool pass = true;
+
+    /* Timed pass without recording, then the recorded pass */
+    seconds = run_clip(pcm, count, false);
+    capture.count = 0;
+    run_clip(pcm, count, true);
+    frames = tap_frame;
+    *total_seconds += seconds;
+    *total_frames += frames;
+
+    printf("%-12s frames %4lu, windows %2lu, %9.0f frames/s\n", name, (unsigned long)frames,
+           (unsigned long)windows, (seconds > 0.0) ? frames / seconds : 0.0);
+
+    snprintf(path, sizeof(path), "%s/%s.txt", dir, name);
+    if (update)
+    {
+        if (0 != golden_write(path, name, &capture))
+        {
+            printf("    cannot write %s\n", path);
+            pass = false;
+        }
+    }
+    else if (0 != golden_read(path, &golden))
+    {
+        printf("    cannot read %s\n", path);
+        pass = false;
+    }
+    else
+    {
+        pass = golden_compare(&golden, &capture);
+        printf("    %s\n", pass ? "PASS" : "FAIL");
+    }
+
+    free(golden.records);
+    return pass;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* dir = "golden";
+    bool update = false;
+    bool pass = true;
+    double total_seconds = 0.0;
+    uint64_t total_frames = 0;
+    int16_t* pcm;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "ug:h")))
+    {
+        switch (opt)
+        {
+            case 'u': update = true; break;
+            case 'g': dir = optarg; break;
+            default:  usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    host_ml_set_probe(baby_cry_model.in_count * baby_cry_model.window_frames);
+
+    pcm = malloc(CLIP_SAMPLES * sizeof(int16_t));
+    if (NULL == pcm)
+    {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < CY_ARRAY_SIZE(clips); i++)
+    {
+        clips[i].generate(pcm, CLIP_SAMPLES);
+        pass &= check_clip(clips[i].name, pcm, CLIP_SAMPLES, dir, update, &total_seconds, &total_frames);
+    }
+    free(pcm);
+
+    for (int i = optind; i < argc; i++)
+    {
+        wav_reader_t reader;
+        const char* base = strrchr(argv[i], '/');
+        char name[GOLDEN_PATH_SIZE];
+        uint32_t count = 0;
+        uint32_t size = 0;
+
+        pcm = NULL;
+        if ((WAV_READER_RET_SUCCESS != wav_reader_open(&reader, argv[i], false, 0)) ||
+            (LOGMEL_SAMPLE_RATE != reader.sample_rate))
+        {
+            printf("%s: not a 16 kHz 16 bit PCM WAV file\n", argv[i]);
+            pass = false;
+            continue;
+        }
+        do
+        {
+            size += CLIP_SAMPLES;
+            int16_t* grown = realloc(pcm, size * sizeof(int16_t));
+            if (NULL == grown)
+            {
+                free(pcm);
+                wav_reader_close(&reader);
+                return EXIT_FAILURE;
+            }
+            pcm = grown;
+            count += wav_reader_read(&reader, &pcm[count], size - count);
+        } while (count == size);
+        wav_reader_close(&reader);
+
+        snprintf(name, sizeof(name), "%s", (NULL != base) ? base + 1 : argv[i]);
+        char* ext = strrchr(name, '.');
+        if (NULL != ext)
+        {
+            *ext = '\0';
+        }
+        pass &= check_clip(name, pcm, (int)count, dir, update, &total_seconds, &total_frames);
+        free(pcm);
+    }
+
+    printf("total: %llu frames, %.0f frames/s, %.1fx real time\n",
+           (unsigned long long)total_frames,
+           (total_seconds > 0.0) ? total_frames / total_seconds : 0.0,
+           (total_seconds > 0.0) ? (total_frames * (double)LOGMEL_HOP_SIZE / LOGMEL_SAMPLE_RATE) / total_seconds : 0.0);
+    printf("%s\n", update ? "golden vectors written" : (pass ? "PASS" : "FAIL"));
+
+    free(capture.records);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
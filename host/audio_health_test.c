@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the audio input health, shared/include/audio_health.h.
+ *
+ * Checks the levels of a tone with a DC offset, the noise floor of the
+ * quietest frame, the count of clipped samples at both rails, a dead
+ * microphone next to a live one in an interleaved capture and the reset
+ * between periods. Exits with 1 on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "audio_health.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NEAR(a, b, tolerance)       (fabsf((a) - (b)) <= (tolerance))
+
+#define TEST_RATE                   (16000u)
+#define TEST_FRAME                  (1024u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* One channel of an interleaved frame: a 1 kHz tone of the given peak plus dc */
+static void make_tone(int16_t* pcm, uint32_t channels, uint32_t channel, float peak, float dc)
+{
+    for (uint32_t i = 0; i < TEST_FRAME; i++)
+    {
+        float value = peak * sinf(2.0f * 3.14159265f * 1000.0f * (float)i / (float)TEST_RATE) + dc;
+        pcm[i * channels + channel] = (int16_t)lrintf(value);
+    }
+}
+
+static void test_tone(void)
+{
+    static int16_t pcm[TEST_FRAME];
+    audio_health_t health;
+    audio_health_report_t report;
+
+    CHECK(AUDIO_HEALTH_RET_SUCCESS == audio_health_init(&health, 1u), "init");
+
+    /* A half scale tone on a DC offset of 1%: peak -5.8 dBFS with the
+     * offset, RMS -9.3 dBFS; a frame with the tone 20 dB down sets the floor */
+    make_tone(pcm, 1u, 0u, 16384.0f, 328.0f);
+    for (uint32_t frame = 0; frame < 15u; frame++)
+    {
+        audio_health_frame(&health, pcm, TEST_FRAME);
+    }
+    make_tone(pcm, 1u, 0u, 1638.4f, 328.0f);
+    audio_health_frame(&health, pcm, TEST_FRAME);
+
+    audio_health_summarize(&health, TEST_RATE, &report);
+    CHECK(1024u == report.period_ms, "period %lu ms", (unsigned long)report.period_ms);
+    CHECK(NEAR(report.ch[0].peak_dbfs, -5.8f, 0.1f), "peak %.2f dBFS", report.ch[0].peak_dbfs);
+    CHECK(NEAR(report.ch[0].rms_dbfs, -9.3f, 0.2f), "rms %.2f dBFS", report.ch[0].rms_dbfs);
+    CHECK(NEAR(report.ch[0].floor_dbfs, -28.7f, 0.2f), "floor %.2f dBFS", report.ch[0].floor_dbfs);
+    CHECK(NEAR(report.ch[0].dc_offset, 0.01f, 0.0005f), "dc %.5f", report.ch[0].dc_offset);
+    CHECK(0u == report.ch[0].clipped, "%lu clipped", (unsigned long)report.ch[0].clipped);
+
+    audio_health_reset(&health);
+    audio_health_summarize(&health, TEST_RATE, &report);
+    CHECK((0u == report.samples) && (AUDIO_HEALTH_MIN_DBFS == report.ch[0].rms_dbfs), "reset");
+}
+
+static uint32_t count_clipped(const int16_t* pcm, uint32_t count)
+{
+    uint32_t clipped = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        clipped += ((pcm[i] >= 32767) || (pcm[i] <= -32767)) ? 1u : 0u;
+    }
+    return clipped;
+}
+
+static void test_clipping(void)
+{
+    static int16_t pcm[TEST_FRAME];
+    audio_health_t health;
+    audio_health_report_t report;
+    uint32_t expected;
+
+    /* A tone driven well past full scale and clamped, as the PDM saturates */
+    for (uint32_t i = 0; i < TEST_FRAME; i++)
+    {
+        float value = 65536.0f * sinf(2.0f * 3.14159265f * 1000.0f * (float)i / (float)TEST_RATE);
+        value = (value > 32767.0f) ? 32767.0f : ((value < -32768.0f) ? -32768.0f : value);
+        pcm[i] = (int16_t)lrintf(value);
+    }
+    expected = count_clipped(pcm, TEST_FRAME) + count_clipped(pcm, TEST_FRAME - 3u);
+
+    audio_health_init(&health, 1u);
+    audio_health_frame(&health, pcm, TEST_FRAME);
+    audio_health_frame(&health, pcm, TEST_FRAME - 3u);
+    audio_health_summarize(&health, TEST_RATE, &report);
+    CHECK(0u != expected, "test tone does not clip");
+    CHECK(expected == report.ch[0].clipped, "%lu clipped, %lu expected", (unsigned long)report.ch[0].clipped,
+          (unsigned long)expected);
+    CHECK(NEAR(report.ch[0].peak_dbfs, 0.0f, 0.01f), "peak %.2f dBFS", report.ch[0].peak_dbfs);
+}
+
+static void test_dead_channel(void)
+{
+    static int16_t pcm[2u * TEST_FRAME];
+    audio_health_t health;
+    audio_health_report_t report;
+
+    CHECK(AUDIO_HEALTH_RET_ERROR == audio_health_init(&health, AUDIO_HEALTH_MAX_CHANNELS + 1u), "too many channels");
+    CHECK(AUDIO_HEALTH_RET_SUCCESS == audio_health_init(&health, 2u), "init of two channels");
+
+    /* Microphone 0 silent, microphone 1 a tone at -20 dBFS */
+    make_tone(pcm, 2u, 0u, 0.0f, 0.0f);
+    make_tone(pcm, 2u, 1u, 3277.0f, 0.0f);
+    audio_health_frame(&health, pcm, TEST_FRAME);
+    audio_health_summarize(&health, TEST_RATE, &report);
+    audio_health_print(&report, printf);
+
+    CHECK(2u == report.channels, "%lu channels", (unsigned long)report.channels);
+    CHECK(AUDIO_HEALTH_MIN_DBFS == report.ch[0].rms_dbfs, "dead rms %.2f dBFS", report.ch[0].rms_dbfs);
+    CHECK(AUDIO_HEALTH_MIN_DBFS == report.ch[0].floor_dbfs, "dead floor %.2f dBFS", report.ch[0].floor_dbfs);
+    CHECK(NEAR(report.ch[1].peak_dbfs, -20.0f, 0.1f), "live peak %.2f dBFS", report.ch[1].peak_dbfs);
+    CHECK(NEAR(report.ch[1].rms_dbfs, -23.0f, 0.2f), "live rms %.2f dBFS", report.ch[1].rms_dbfs);
+}
+
+int main(void)
+{
+    test_tone();
+    test_clipping();
+    test_dead_channel();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
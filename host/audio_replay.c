@@ -0,0 +1,423 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Replays a recording through the audio pipeline of the CM55 as fast as the
+ * host allows and writes the log-mel features and the model decisions as CSV.
+ * With -l it also replays the timing of the device on a simulated clock and
+ * prints the microphone to cloud latency of latency_trace.h: the PDM frames,
+ * the passes of cm55_task, the telemetry messages of app_task. The compute
+ * hops take as long as on the host. The audio health of audio_health.h of the
+ * whole recording is printed with the statistics. With -e the early exit
+ * stage of Models/baby_cry_exit.h runs ahead of the model.
+ * See host/Makefile and DEVELOPER_GUIDE.md.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "audio.h"
+#include "audio_health.h"
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "baby_cry_exit.h"
+#include "prof.h"
+#include "latency_trace.h"
+#include "host_platform.h"
+#include "wav_reader.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Timing of the device: the default reporting_interval of app_task */
+#define REPLAY_REPORT_INTERVAL_MS   (2000u)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Simulated clock of the device, in ms since the capture started */
+typedef struct
+{
+    bool            enabled;
+    uint32_t        report_interval_ms;
+    uint32_t        publish_ms;         /* Duration of an MQTT publish */
+    double          task_ms;            /* cm55_task done with the last frame */
+    double          pickup_ms;          /* Frame in process */
+    double          frame_end_ms;
+    uint32_t        frame_end_sample;
+    double          pickup_s;           /* Host time of the pickup */
+    double          next_report_ms;
+    latency_trace_t last;               /* Decisions as cached by the CM33 */
+    latency_trace_t detection;
+    bool            has_last;
+    bool            has_detection;
+    uint32_t        last_sample;
+    latency_stats_t stats;
+} replay_latency_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static FILE* features_csv;
+static FILE* decisions_csv;
+static logmel_consumer_t features_consumer;
+static replay_latency_t latency;
+static uint32_t decided_windows;
+static uint32_t model_runs;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static int print_stderr(const char* format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vfprintf(stderr, format, args);
+    va_end(args);
+    return ret;
+}
+
+static double seconds_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*******************************************************************************
+* Function Name: write_features
+********************************************************************************
+* Summary:
+*  Front end consumer writing every log-mel frame as one CSV row.
+*
+*******************************************************************************/
+static int write_features(void* arg, const float* frame)
+{
+    logmel_consumer_t* consumer = (logmel_consumer_t*)arg;
+
+    fprintf(features_csv, "%lu", (unsigned long)consumer->frames);
+    for (int i = 0; i < LOGMEL_BANDS; i++)
+    {
+        fprintf(features_csv, ",%.6f", frame[i]);
+    }
+    fputc('\n', features_csv);
+    return LOGMEL_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: latency_report_until
+********************************************************************************
+* Summary:
+*  Publishes the telemetry messages of app_task due before a time: the
+*  detection cached since the last message, else the last decision.
+*
+*******************************************************************************/
+static void latency_report_until(double now_ms)
+{
+    while (latency.has_last && (latency.next_report_ms < now_ms))
+    {
+        latency_trace_t trace = latency.has_detection ? latency.detection : latency.last;
+
+        latency.has_detection = false;
+        trace.stamps[LATENCY_STAMP_REPORT] = (uint32_t)latency.next_report_ms;
+        trace.stamps[LATENCY_STAMP_PUBLISHED] = (uint32_t)latency.next_report_ms + latency.publish_ms;
+        if (trace.sample != latency.last_sample)
+        {
+            latency_stats_record(&latency.stats, &trace);
+            latency.last_sample = trace.sample;
+        }
+        latency.next_report_ms += latency.report_interval_ms;
+    }
+}
+
+/*******************************************************************************
+* Function Name: latency_process_frame
+********************************************************************************
+* Summary:
+*  Feeds one PDM frame to the pipeline when cm55_task would take it up: as
+*  soon as the frame is complete, or once done with the previous one.
+*
+*******************************************************************************/
+static void latency_process_frame(const int16_t* block, uint32_t count)
+{
+    latency.frame_end_sample += count;
+    latency.frame_end_ms = (double)latency.frame_end_sample * 1000.0 / LOGMEL_SAMPLE_RATE;
+    latency.pickup_ms = (latency.task_ms > latency.frame_end_ms) ? latency.task_ms : latency.frame_end_ms;
+    latency.pickup_s = seconds_now();
+
+    audio_pipeline_process(block, count);
+
+    latency.task_ms = latency.pickup_ms + (seconds_now() - latency.pickup_s) * 1000.0;
+}
+
+/*******************************************************************************
+* Function Name: latency_trace_decision
+********************************************************************************
+* Summary:
+*  Stamps a decision like audio.c does, on the simulated clock, and hands it
+*  to the CM33 without delay.
+*
+*******************************************************************************/
+static void latency_trace_decision(const audio_result_t* result)
+{
+    double result_ms = latency.pickup_ms + (seconds_now() - latency.pickup_s) * 1000.0;
+    latency_trace_t trace;
+
+    memset(&trace, 0, sizeof(trace));
+    trace.sample = result->sample;
+    trace.synced = true;
+    trace.stamps[LATENCY_STAMP_CAPTURE] = latency_capture_ms((uint32_t)latency.frame_end_ms,
+                                                             latency.frame_end_sample, result->sample,
+                                                             LOGMEL_SAMPLE_RATE);
+    trace.stamps[LATENCY_STAMP_PICKUP] = (uint32_t)latency.pickup_ms;
+    trace.stamps[LATENCY_STAMP_WINDOW] = (uint32_t)(result_ms - result->elapsed_cycles / 1e6);
+    trace.stamps[LATENCY_STAMP_RESULT] = (uint32_t)result_ms;
+    trace.stamps[LATENCY_STAMP_RECEIVED] = (uint32_t)result_ms;
+
+    /* app_task reports on its own schedule, from the first decision on */
+    while (!latency.has_last && (latency.next_report_ms < result_ms))
+    {
+        latency.next_report_ms += latency.report_interval_ms;
+    }
+    latency_report_until(result_ms);
+    latency.last = trace;
+    latency.has_last = true;
+    if (0 != result->label_id)
+    {
+        latency.detection = trace;
+        latency.has_detection = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: write_decision
+********************************************************************************
+* Summary:
+*  Pipeline result callback writing every model decision as one CSV row.
+*
+*******************************************************************************/
+static void write_decision(const audio_result_t* result, void* arg)
+{
+    (void)arg;
+
+    decided_windows = result->window + 1u;
+    model_runs = result->model_runs;
+    if (latency.enabled)
+    {
+        latency_trace_decision(result);
+    }
+    fprintf(decisions_csv, "%s,%lu,%lu,%.3f,%d,%s,%.6f,%.2f", result->model,
+            (unsigned long)result->window, (unsigned long)result->frame,
+            (double)result->frame * LOGMEL_HOP_SIZE / LOGMEL_SAMPLE_RATE,
+            result->label_id, result->label, result->confidence, (double)result->gain_db);
+    for (int i = 0; i < result->score_count; i++)
+    {
+        fprintf(decisions_csv, ",%.6f", audio_result_score(result, i));
+    }
+    fputc('\n', decisions_csv);
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [options] input.wav\n"
+            "  -f file  write the log-mel features of every frame to a CSV file\n"
+            "  -d file  write the model decisions to a CSV file (default stdout)\n"
+            "  -o file  replay recorded model outputs, one line of int8 values per window\n"
+            "  -m file  export the model flatbuffer (.tflite) and exit\n"
+            "  -r       input is raw 16 bit little endian mono PCM at %d Hz\n"
+            "  -e       reject background windows with the early exit stage\n"
+            "  -l       print the latency of the decisions with the timing of the device\n"
+            "  -i ms    reporting interval of the telemetry with -l (default %u)\n"
+            "  -p ms    duration of an MQTT publish with -l (default 0)\n"
+            "  -q       no statistics on stderr\n",
+            name, LOGMEL_SAMPLE_RATE, REPLAY_REPORT_INTERVAL_MS);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* features_path = NULL;
+    const char* decisions_path = NULL;
+    const char* outputs_path = NULL;
+    const char* model_path = NULL;
+    bool raw = false;
+    bool quiet = false;
+    bool early_exit = false;
+    wav_reader_t reader;
+    audio_health_t health;
+    audio_health_report_t health_report;
+    int16_t block[FRAME_SIZE];
+    uint64_t samples = 0;
+    uint32_t count;
+    double start, elapsed;
+    int opt;
+
+    latency.report_interval_ms = REPLAY_REPORT_INTERVAL_MS;
+    while (-1 != (opt = getopt(argc, argv, "f:d:o:m:reli:p:qh")))
+    {
+        switch (opt)
+        {
+            case 'f': features_path = optarg; break;
+            case 'd': decisions_path = optarg; break;
+            case 'o': outputs_path = optarg; break;
+            case 'm': model_path = optarg; break;
+            case 'r': raw = true; break;
+            case 'e': early_exit = true; break;
+            case 'l': latency.enabled = true; break;
+            case 'i': latency.report_interval_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'p': latency.publish_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'q': quiet = true; break;
+            default:  usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if (NULL != model_path)
+    {
+        FILE* f = fopen(model_path, "wb");
+        if ((NULL == f) ||
+            (1 != fwrite(baby_cry_model.weights, baby_cry_model.weights_size, 1, f)))
+        {
+            fprintf(stderr, "cannot write %s\n", model_path);
+            return EXIT_FAILURE;
+        }
+        fclose(f);
+        return EXIT_SUCCESS;
+    }
+
+    if ((optind + 1 != argc) || (0u == latency.report_interval_ms))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (WAV_READER_RET_SUCCESS != wav_reader_open(&reader, argv[optind], raw, LOGMEL_SAMPLE_RATE))
+    {
+        fprintf(stderr, "%s: not a 16 bit PCM WAV file\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    if (LOGMEL_SAMPLE_RATE != reader.sample_rate)
+    {
+        fprintf(stderr, "%s: sample rate %lu Hz, the pipeline needs %d Hz\n", argv[optind],
+                (unsigned long)reader.sample_rate, LOGMEL_SAMPLE_RATE);
+        return EXIT_FAILURE;
+    }
+    if ((NULL != outputs_path) && (HOST_PLATFORM_RET_SUCCESS != host_ml_load_outputs(outputs_path)))
+    {
+        fprintf(stderr, "%s: cannot load the recorded outputs\n", outputs_path);
+        return EXIT_FAILURE;
+    }
+
+    decisions_csv = (NULL != decisions_path) ? fopen(decisions_path, "w") : stdout;
+    if (NULL == decisions_csv)
+    {
+        fprintf(stderr, "cannot write %s\n", decisions_path);
+        return EXIT_FAILURE;
+    }
+    fprintf(decisions_csv, "model,window,frame,time_s,label_id,label,confidence,gain_db");
+    for (int i = 0; i < baby_cry_model.out_count; i++)
+    {
+        fprintf(decisions_csv, ",score%d", i);
+    }
+    fputc('\n', decisions_csv);
+
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, write_decision, NULL))
+    {
+        fprintf(stderr, "audio pipeline initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    if (early_exit && (CY_RSLT_SUCCESS != audio_pipeline_set_early_exit(&baby_cry_exit)))
+    {
+        fprintf(stderr, "early exit stage initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    if (NULL != features_path)
+    {
+        features_csv = fopen(features_path, "w");
+        if (NULL == features_csv)
+        {
+            fprintf(stderr, "cannot write %s\n", features_path);
+            return EXIT_FAILURE;
+        }
+        fprintf(features_csv, "frame");
+        for (int i = 0; i < LOGMEL_BANDS; i++)
+        {
+            fprintf(features_csv, ",mel%d", i);
+        }
+        fputc('\n', features_csv);
+
+        features_consumer.name = "features";
+        features_consumer.window_frames = 1;
+        features_consumer.window_stride = 1;
+        features_consumer.push = write_features;
+        features_consumer.arg = &features_consumer;
+        audio_pipeline_add_consumer(&features_consumer);
+    }
+
+    /* Feed the recording in PDM sized blocks, without pacing */
+    (void)audio_health_init(&health, 1u);
+    start = seconds_now();
+    while (0 != (count = wav_reader_read(&reader, block, FRAME_SIZE)))
+    {
+        audio_health_frame(&health, block, count);
+        if (latency.enabled)
+        {
+            latency_process_frame(block, count);
+        }
+        else
+        {
+            audio_pipeline_process(block, count);
+        }
+        samples += count;
+    }
+    elapsed = seconds_now() - start;
+    wav_reader_close(&reader);
+
+    if (!quiet)
+    {
+        double audio_s = (double)samples / LOGMEL_SAMPLE_RATE;
+        fprintf(stderr, "%.2f s of audio in %.3f s, %.1fx real time\n",
+                audio_s, elapsed, (elapsed > 0.0) ? audio_s / elapsed : 0.0);
+        audio_pipeline_print_stats(print_stderr);
+        fprintf(stderr, "model: %lu of %lu windows, %.1f inferences per minute\n", (unsigned long)model_runs,
+                (unsigned long)decided_windows, (audio_s > 0.0) ? model_runs * 60.0 / audio_s : 0.0);
+
+        audio_health_summarize(&health, LOGMEL_SAMPLE_RATE, &health_report);
+        health_report.agc_limited = audio_pipeline_limited_samples();
+        audio_health_print(&health_report, print_stderr);
+
+        if (latency.enabled)
+        {
+            fprintf(stderr, "latency, reporting every %lu ms:\n", (unsigned long)latency.report_interval_ms);
+            latency_stats_print(&latency.stats, print_stderr);
+        }
+
+        #ifdef APP_PROFILING
+        prof_summary_t summary[PROF_STAGE_COUNT];
+        prof_summarize(summary);
+        fprintf(stderr, "profile (ns):\n");
+        prof_print(summary, print_stderr);
+        #endif
+    }
+
+    if (NULL != features_csv)
+    {
+        fclose(features_csv);
+    }
+    if (stdout != decisions_csv)
+    {
+        fclose(decisions_csv);
+    }
+    host_ml_free_outputs();
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
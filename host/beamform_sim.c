@@ -0,0 +1,241 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Simulation of the two microphone beamformer (beamform.h).
+ *
+ * A harmonic target in the look direction, a broadband interferer from a
+ * second direction and uncorrelated sensor noise are rendered as plane waves
+ * at both microphones. The three parts run through the beamformer separately,
+ * so the SNR at one microphone can be compared with the SNR after the
+ * beamformer for every interferer angle. Also reports the beamformer time per
+ * hop on this host. See DEVELOPER_GUIDE.md.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "beamform.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_SECONDS                 (4)
+#define SIM_SAMPLES                 (SIM_SECONDS * LOGMEL_SAMPLE_RATE)
+
+/* Samples skipped before measuring, the FIR has to fill first */
+#define SIM_SETTLE                  (4 * BEAMFORM_TAPS)
+
+#define SIM_TARGET_F0               (450.0)
+#define SIM_TARGET_HARMONICS        (8)
+#define SIM_NOISE_TONES             (64)
+#define SIM_NOISE_MIN_HZ            (100.0)
+#define SIM_NOISE_MAX_HZ            (6000.0)
+
+/* Levels in PCM units */
+#define SIM_TARGET_LEVEL            (2000.0)
+#define SIM_INTERFERER_LEVEL        (2000.0)
+#define SIM_SENSOR_LEVEL            (300.0)
+
+#define SIM_PARTS                   (3)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    SIM_TARGET = 0,
+    SIM_INTERFERER,
+    SIM_SENSOR,
+} sim_part_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int16_t parts[SIM_PARTS][SIM_SAMPLES * BEAMFORM_CHANNELS];
+static float beam[SIM_SAMPLES];
+static beamform_t bf;
+static uint32_t lcg = 1u;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static int16_t to_pcm(double value)
+{
+    value = round(value);
+    return (int16_t)((value > 32767.0) ? 32767.0 : (value < -32768.0) ? -32768.0 : value);
+}
+
+/* Arrival time of a plane wave from angle_deg at the microphone of channel,
+ * channel 0 sits at +spacing/2 towards positive angles */
+static double arrival_s(int channel, double spacing_m, double angle_deg)
+{
+    double x = (0 == channel) ? spacing_m / 2.0 : -spacing_m / 2.0;
+    return -x * sin(angle_deg * M_PI / 180.0) / BEAMFORM_SPEED_OF_SOUND;
+}
+
+static void render_target(double spacing_m, double angle_deg)
+{
+    for (int ch = 0; ch < BEAMFORM_CHANNELS; ch++)
+    {
+        double t0 = arrival_s(ch, spacing_m, angle_deg);
+        for (int i = 0; i < SIM_SAMPLES; i++)
+        {
+            double t = (double)i / LOGMEL_SAMPLE_RATE - t0;
+            double v = 0.0;
+            for (int k = 1; k <= SIM_TARGET_HARMONICS; k++)
+            {
+                v += sin(2.0 * M_PI * k * SIM_TARGET_F0 * t) / k;
+            }
+            parts[SIM_TARGET][BEAMFORM_CHANNELS * i + ch] = to_pcm(SIM_TARGET_LEVEL * v / 2.0);
+        }
+    }
+}
+
+/* Broadband noise as a sum of random tones, so that the delays are exact */
+static void render_interferer(double spacing_m, double angle_deg)
+{
+    static double freq[SIM_NOISE_TONES], phase[SIM_NOISE_TONES];
+    const double amplitude = SIM_INTERFERER_LEVEL * sqrt(2.0 / SIM_NOISE_TONES);
+
+    lcg = 7u;
+    for (int n = 0; n < SIM_NOISE_TONES; n++)
+    {
+        freq[n] = SIM_NOISE_MIN_HZ + (SIM_NOISE_MAX_HZ - SIM_NOISE_MIN_HZ) * next_uniform(&lcg);
+        phase[n] = 2.0 * M_PI * next_uniform(&lcg);
+    }
+    for (int ch = 0; ch < BEAMFORM_CHANNELS; ch++)
+    {
+        double t0 = arrival_s(ch, spacing_m, angle_deg);
+        for (int i = 0; i < SIM_SAMPLES; i++)
+        {
+            double t = (double)i / LOGMEL_SAMPLE_RATE - t0;
+            double v = 0.0;
+            for (int n = 0; n < SIM_NOISE_TONES; n++)
+            {
+                v += sin(2.0 * M_PI * freq[n] * t + phase[n]);
+            }
+            parts[SIM_INTERFERER][BEAMFORM_CHANNELS * i + ch] = to_pcm(amplitude * v);
+        }
+    }
+}
+
+static void render_sensor_noise(void)
+{
+    lcg = 99u;
+    for (int i = 0; i < SIM_SAMPLES * BEAMFORM_CHANNELS; i++)
+    {
+        /* Uniform noise with SIM_SENSOR_LEVEL RMS */
+        parts[SIM_SENSOR][i] = to_pcm(SIM_SENSOR_LEVEL * sqrt(12.0) * (next_uniform(&lcg) - 0.5));
+    }
+}
+
+static double power_pcm(const int16_t* pcm, int channel)
+{
+    double sum = 0.0;
+    for (int i = SIM_SETTLE; i < SIM_SAMPLES; i++)
+    {
+        double v = pcm[BEAMFORM_CHANNELS * i + channel];
+        sum += v * v;
+    }
+    return sum / (SIM_SAMPLES - SIM_SETTLE);
+}
+
+/* Power of one part after the beamformer */
+static double power_beam(const int16_t* pcm, double spacing_m, double look_deg)
+{
+    double sum = 0.0;
+
+    beamform_init(&bf, (float)spacing_m, (float)look_deg, 0);
+    for (int offset = 0; offset < SIM_SAMPLES; offset += BEAMFORM_BLOCK_MAX)
+    {
+        beamform_process(&bf, &pcm[BEAMFORM_CHANNELS * offset], BEAMFORM_BLOCK_MAX, &beam[offset]);
+    }
+    for (int i = SIM_SETTLE; i < SIM_SAMPLES; i++)
+    {
+        sum += (double)beam[i] * beam[i];
+    }
+    return sum / (SIM_SAMPLES - SIM_SETTLE);
+}
+
+static double db(double ratio)
+{
+    return 10.0 * log10(ratio);
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [-d spacing_mm] [-l look_deg]\n"
+            "  -d  microphone spacing in mm (default 20)\n"
+            "  -l  look direction of the target in degrees (default 0)\n",
+            name);
+}
+
+int main(int argc, char* argv[])
+{
+    double spacing_m = 0.020;
+    double look_deg = 0.0;
+    double target_in, target_out, sensor_in, sensor_out;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "d:l:h")))
+    {
+        switch (opt)
+        {
+            case 'd': spacing_m = atof(optarg) / 1000.0; break;
+            case 'l': look_deg = atof(optarg); break;
+            default:  usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (BEAMFORM_RET_SUCCESS != beamform_init(&bf, (float)spacing_m, (float)look_deg, 0))
+    {
+        fprintf(stderr, "steering delay of %.1f mm at %.0f deg does not fit the filters\n",
+                spacing_m * 1000.0, look_deg);
+        return EXIT_FAILURE;
+    }
+
+    render_target(spacing_m, look_deg);
+    render_sensor_noise();
+    target_in = power_pcm(parts[SIM_TARGET], 0);
+    target_out = power_beam(parts[SIM_TARGET], spacing_m, look_deg);
+    sensor_in = power_pcm(parts[SIM_SENSOR], 0);
+    sensor_out = power_beam(parts[SIM_SENSOR], spacing_m, look_deg);
+
+    printf("spacing %.1f mm, look %.0f deg, steering delay %.3f samples\n",
+           spacing_m * 1000.0, look_deg, (double)bf.steer_delay);
+    printf("target gain %+.2f dB, sensor noise gain %+.2f dB\n",
+           db(target_out / target_in), db(sensor_out / sensor_in));
+    printf("interferer_deg  snr_in_db  snr_out_db  snr_gain_db  interferer_gain_db\n");
+
+    for (int angle = -90; angle <= 90; angle += 15)
+    {
+        double interferer_in, interferer_out, snr_in, snr_out;
+
+        render_interferer(spacing_m, angle);
+        interferer_in = power_pcm(parts[SIM_INTERFERER], 0);
+        interferer_out = power_beam(parts[SIM_INTERFERER], spacing_m, look_deg);
+        snr_in = db(target_in / (interferer_in + sensor_in));
+        snr_out = db(target_out / (interferer_out + sensor_out));
+        printf("%14d  %9.2f  %10.2f  %11.2f  %18.2f\n", angle, snr_in, snr_out,
+               snr_out - snr_in, db(interferer_out / interferer_in));
+    }
+
+    printf("beamformer: %lu blocks of %d samples, avg %llu max %lu ns per block (%.2f%% of a hop)\n",
+           (unsigned long)bf.blocks, BEAMFORM_BLOCK_MAX,
+           (unsigned long long)(bf.cycles_total / bf.blocks), (unsigned long)bf.cycles_max,
+           100.0 * (double)bf.cycles_total / bf.blocks /
+           (1e9 * BEAMFORM_BLOCK_MAX / LOGMEL_SAMPLE_RATE));
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
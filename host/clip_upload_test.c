@@ -0,0 +1,481 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the audio clips around detections, from the CM55 ring to a server.
+ *
+ * Feeds synthetic audio in PDM frames through the clip capture of the CM55
+ * (clip_capture.h) and fires detections at fixed times. Every frozen clip is
+ * uploaded with the CM33 uploader (clip_upload.h) over HTTP to a stand-in
+ * server on the loopback interface, which decodes and reassembles the
+ * chunks. While a clip uploads the ring stays frozen for the upload time,
+ * as on the device. The server rejects one chunk once to exercise the retry.
+ *
+ * Checks that every clip arrives complete and in place, that the ring holds
+ * the expected samples, that detections during the post-roll merge and
+ * detections while frozen are dropped, and that the upload rate stays below
+ * the cap. Reports the memory of both sides, the compression, the coding
+ * SNR and the throughput. The sleeps of the rate cap advance a virtual
+ * clock, so the test runs faster than real time. Exits with 1 on failure.
+ */
+
+#define _GNU_SOURCE                 /* memmem() */
+
+#include <arpa/inet.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "clip_capture.h"
+#include "clip_upload.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SAMPLE_RATE            (16000u)
+#define TEST_SECONDS                (24u)
+#define TEST_SAMPLES                (TEST_SECONDS * TEST_SAMPLE_RATE)
+#define TEST_FRAME_SIZE             (1600u)     /* One PDM buffer */
+#define TEST_RING_SAMPLES           CLIP_RING_SAMPLES(TEST_SAMPLE_RATE)
+#define TEST_POSTROLL               ((TEST_SAMPLE_RATE / 1000u) * CLIP_POSTROLL_MS)
+
+#define TEST_MAX_CLIPS              (8)
+
+/* Chunk the server rejects once: clip sequence and chunk index */
+#define TEST_REJECT_CLIP            (3u)
+#define TEST_REJECT_CHUNK           (1u)
+
+/* Coding SNR every clip has to reach */
+#define TEST_MIN_SNR_DB             (20.0)
+
+#define TEST_HTTP_MAX_REQUEST       (CLIP_CHUNK_MAX_SIZE + 1024u)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* A clip as reassembled by the server */
+typedef struct
+{
+    uint32_t    sequence;
+    uint32_t    length;
+    uint32_t    trigger;
+    uint16_t    count;
+    uint16_t    received;
+    bool        seen[64];
+    int16_t     pcm[TEST_RING_SAMPLES];
+} server_clip_t;
+
+/* What the capture side expects of a clip */
+typedef struct
+{
+    uint32_t    sequence;
+    uint32_t    end;            /* Absolute sample index after the clip */
+    uint32_t    length;
+    int16_t     pcm[TEST_RING_SAMPLES];
+} expected_clip_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Detections in ms: a clip, a merged detection in its post-roll, a dropped
+ * detection during its upload, a clip with a short pre-roll right after the
+ * upload, and a clip whose upload hits the rejected chunk */
+static const uint32_t detections_ms[] = { 3000u, 3500u, 4800u, 6400u, 15000u };
+
+static int16_t source[TEST_SAMPLES];
+static int16_t ring[TEST_RING_SAMPLES];
+static clip_capture_t capture;
+static clip_uploader_t uploader;
+
+static server_clip_t server_clips[TEST_MAX_CLIPS];
+static int server_clip_count;
+static uint32_t server_requests;
+static uint32_t server_rejected;
+static int server_socket;
+static uint16_t server_port;
+
+static expected_clip_t expected[TEST_MAX_CLIPS];
+static int expected_count;
+
+static uint32_t virtual_ms;
+static struct timespec start_time;
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+
+/* Cry like bursts over a noise floor */
+static void render_source(void)
+{
+    uint32_t noise = 1u;
+    double phase = 0.0;
+
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++)
+    {
+        double t = (double)i / TEST_SAMPLE_RATE;
+        double burst = (fmod(t, 1.5) < 0.8) ? 1.0 : 0.0;
+        double v = 0.0;
+
+        phase += 2.0 * M_PI * 450.0 * (1.0 + 0.1 * sin(2.0 * M_PI * 0.7 * t)) / TEST_SAMPLE_RATE;
+        for (int k = 1; k <= 5; k++)
+        {
+            v += sin(k * phase) / k;
+        }
+        v = 6000.0 * burst * v + 300.0 * (next_uniform(&noise) - 0.5);
+        source[i] = (int16_t)lrint(v);
+    }
+}
+
+/*******************************************************************************
+* Function Name: server_handle
+********************************************************************************
+* Summary:
+*  HTTP stand-in of the clip server: reads POST requests of one connection,
+*  decodes each chunk into its clip and answers 200, or 503 for the rejected
+*  chunk on its first attempt.
+*
+*******************************************************************************/
+static void server_handle(int connection)
+{
+    static uint8_t request[TEST_HTTP_MAX_REQUEST];
+    static int16_t pcm[CLIP_CHUNK_SAMPLES];
+    size_t fill = 0;
+
+    for (;;)
+    {
+        char* end = NULL;
+        ssize_t got;
+
+        while ((NULL == (end = memmem(request, fill, "\r\n\r\n", 4))) && (fill < sizeof(request)))
+        {
+            if ((got = recv(connection, &request[fill], sizeof(request) - fill, 0)) <= 0)
+            {
+                return;
+            }
+            fill += (size_t)got;
+        }
+        if (NULL == end)
+        {
+            return;
+        }
+
+        size_t header_size = (size_t)(end + 4 - (char*)request);
+        char* length_field = memmem(request, header_size, "Content-Length:", 15);
+        size_t body_size = (NULL != length_field) ? strtoul(length_field + 15, NULL, 10) : 0u;
+        if ((0 != strncmp((char*)request, "POST /clips ", 12)) || (header_size + body_size > sizeof(request)))
+        {
+            return;
+        }
+        while (fill < header_size + body_size)
+        {
+            if ((got = recv(connection, &request[fill], sizeof(request) - fill, 0)) <= 0)
+            {
+                return;
+            }
+            fill += (size_t)got;
+        }
+
+        clip_chunk_info_t info;
+        const char* status = "400 Bad Request";
+        server_requests++;
+        if (CLIP_CODEC_RET_SUCCESS == clip_chunk_decode(&request[header_size], (uint32_t)body_size, &info, pcm))
+        {
+            server_clip_t* clip = NULL;
+            for (int i = 0; i < server_clip_count; i++)
+            {
+                clip = (server_clips[i].sequence == info.sequence) ? &server_clips[i] : clip;
+            }
+            if ((NULL == clip) && (server_clip_count < TEST_MAX_CLIPS))
+            {
+                clip = &server_clips[server_clip_count++];
+                clip->sequence = info.sequence;
+                clip->length = info.clip_samples;
+                clip->trigger = info.trigger;
+                clip->count = info.count;
+            }
+
+            if ((TEST_REJECT_CLIP == info.sequence) && (TEST_REJECT_CHUNK == info.index) &&
+                (0u == server_rejected))
+            {
+                server_rejected++;
+                status = "503 Service Unavailable";
+            }
+            else if ((NULL != clip) && (info.index < 64u) &&
+                     ((uint32_t)info.index * CLIP_CHUNK_SAMPLES + info.samples <= TEST_RING_SAMPLES))
+            {
+                memcpy(&clip->pcm[info.index * CLIP_CHUNK_SAMPLES], pcm, info.samples * sizeof(int16_t));
+                clip->received += !clip->seen[info.index];
+                clip->seen[info.index] = true;
+                status = "200 OK";
+            }
+        }
+
+        char response[128];
+        int size = snprintf(response, sizeof(response), "HTTP/1.1 %s\r\nContent-Length: 0\r\n\r\n", status);
+        if (send(connection, response, (size_t)size, 0) != size)
+        {
+            return;
+        }
+        memmove(request, &request[header_size + body_size], fill - header_size - body_size);
+        fill -= header_size + body_size;
+    }
+}
+
+static void* server_main(void* arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        int connection = accept(server_socket, NULL, NULL);
+        if (connection < 0)
+        {
+            return NULL;
+        }
+        server_handle(connection);
+        close(connection);
+    }
+}
+
+static int server_start(pthread_t* thread)
+{
+    struct sockaddr_in address;
+    socklen_t size = sizeof(address);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    server_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if ((server_socket < 0) || (0 != bind(server_socket, (struct sockaddr*)&address, sizeof(address))) ||
+        (0 != listen(server_socket, 1)) ||
+        (0 != getsockname(server_socket, (struct sockaddr*)&address, &size)))
+    {
+        return -1;
+    }
+    server_port = ntohs(address.sin_port);
+    return pthread_create(thread, NULL, server_main, NULL);
+}
+
+/* Transport of the uploader: one HTTP POST per chunk on a connection per
+ * clip, as clip_task.c does with the HTTP client of the CM33 */
+static int http_send(void* arg, const uint8_t* chunk, uint32_t size)
+{
+    int connection = *(int*)arg;
+    char header[256];
+    char response[256];
+    size_t fill = 0;
+    int length = snprintf(header, sizeof(header),
+                          "POST /clips HTTP/1.1\r\nHost: 127.0.0.1:%u\r\n"
+                          "Content-Type: application/octet-stream\r\nContent-Length: %u\r\n\r\n",
+                          (unsigned)server_port, (unsigned)size);
+
+    if ((send(connection, header, (size_t)length, 0) != length) ||
+        (send(connection, chunk, size, 0) != (ssize_t)size))
+    {
+        return -1;
+    }
+    while ((fill < sizeof(response) - 1u) && (NULL == memmem(response, fill, "\r\n\r\n", 4)))
+    {
+        ssize_t got = recv(connection, &response[fill], sizeof(response) - 1u - fill, 0);
+        if (got <= 0)
+        {
+            return -1;
+        }
+        fill += (size_t)got;
+    }
+    response[fill] = '\0';
+    return (0 == strncmp(response, "HTTP/1.1 2", 10)) ? 0 : -1;
+}
+
+static void virtual_sleep_ms(uint32_t ms)
+{
+    virtual_ms += ms;
+}
+
+static uint32_t virtual_now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return virtual_ms + (uint32_t)((now.tv_sec - start_time.tv_sec) * 1000 +
+                                   (now.tv_nsec - start_time.tv_nsec) / 1000000);
+}
+
+/* Uploads a clip over a new connection, returns the upload time */
+static uint32_t upload(const clip_t* clip)
+{
+    struct sockaddr_in address;
+    clip_source_t source_clip =
+    {
+        clip->ring, clip->capacity, clip->start, clip->length, TEST_SAMPLE_RATE,
+        clip->trigger, clip->sequence, 1u
+    };
+    int connection = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(server_port);
+    CHECK(0 == connect(connection, (struct sockaddr*)&address, sizeof(address)), "connect");
+
+    uploader.port.arg = &connection;
+    CHECK(CLIP_UPLOAD_RET_SUCCESS == clip_upload(&uploader, &source_clip), "upload of clip %u",
+          (unsigned)clip->sequence);
+    close(connection);
+    return uploader.last_ms;
+}
+
+static double snr_db(const int16_t* reference, const int16_t* decoded, uint32_t count)
+{
+    double signal = 0.0, error = 0.0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        double e = (double)decoded[i] - reference[i];
+        signal += (double)reference[i] * reference[i];
+        error += e * e;
+    }
+    return 10.0 * log10(signal / fmax(error, 1.0));
+}
+
+/*******************************************************************************
+* Function Name: run_capture
+********************************************************************************
+* Summary:
+*  The CM55 side: feeds the source frame by frame, fires the detections and
+*  uploads each frozen clip. The ring stays frozen for the upload time.
+*
+*******************************************************************************/
+static void run_capture(void)
+{
+    const uint32_t detection_count = (uint32_t)(sizeof(detections_ms) / sizeof(detections_ms[0]));
+    uint32_t next_detection = 0u;
+    uint32_t release_at = 0u;       /* Sample index at which the ring is released */
+    uint32_t resumed_at = 0u;       /* Sample index at which recording resumed */
+    uint32_t trigger_at = 0u;
+    clip_t clip;
+
+    for (uint32_t position = 0; position + TEST_FRAME_SIZE <= TEST_SAMPLES; position += TEST_FRAME_SIZE)
+    {
+        if ((CLIP_STATE_HANDED == capture.state) && (position >= release_at))
+        {
+            clip_capture_release(&capture);
+            resumed_at = position;
+        }
+
+        clip_capture_write(&capture, &source[position], TEST_FRAME_SIZE, 1u);
+
+        /* The pipeline decides after the frame is written */
+        while ((next_detection < detection_count) &&
+               ((uint64_t)detections_ms[next_detection] * TEST_SAMPLE_RATE / 1000u <= position))
+        {
+            if (CLIP_STATE_RECORDING == capture.state)
+            {
+                trigger_at = position + TEST_FRAME_SIZE;
+            }
+            clip_capture_trigger(&capture);
+            next_detection++;
+        }
+
+        if (clip_capture_take(&capture, &clip) && (expected_count < TEST_MAX_CLIPS))
+        {
+            expected_clip_t* e = &expected[expected_count++];
+            uint32_t ms;
+
+            e->sequence = clip.sequence;
+            e->end = trigger_at + TEST_POSTROLL;
+            e->length = e->end - resumed_at;
+            e->length = (e->length < TEST_RING_SAMPLES) ? e->length : TEST_RING_SAMPLES;
+            for (uint32_t i = 0; i < clip.length; i++)
+            {
+                e->pcm[i] = clip.ring[(clip.start + i) % clip.capacity];
+            }
+
+            CHECK(clip.length == e->length, "clip %u: %u samples, expected %u", (unsigned)clip.sequence,
+                  (unsigned)clip.length, (unsigned)e->length);
+            CHECK((clip.length == e->length) &&
+                  (0 == memcmp(e->pcm, &source[e->end - e->length], e->length * sizeof(int16_t))),
+                  "clip %u: ring does not hold the source around the detection", (unsigned)clip.sequence);
+
+            ms = upload(&clip);
+            release_at = position + (uint32_t)(((uint64_t)ms * TEST_SAMPLE_RATE) / 1000u);
+            printf("clip %u: %.2f s around %.2f s, pre-roll %.2f s, uploaded in %u ms\n",
+                   (unsigned)clip.sequence, (double)clip.length / TEST_SAMPLE_RATE,
+                   (double)(e->end - TEST_POSTROLL) / TEST_SAMPLE_RATE,
+                   (double)clip.trigger / TEST_SAMPLE_RATE, (unsigned)ms);
+        }
+    }
+}
+
+static void check_server(void)
+{
+    CHECK(server_clip_count == expected_count, "server has %d clips, expected %d", server_clip_count,
+          expected_count);
+    for (int i = 0; (i < server_clip_count) && (i < expected_count); i++)
+    {
+        const server_clip_t* s = &server_clips[i];
+        const expected_clip_t* e = &expected[i];
+        double snr = snr_db(e->pcm, s->pcm, e->length);
+
+        CHECK(s->sequence == e->sequence, "clip %d has sequence %u", i, (unsigned)s->sequence);
+        CHECK((s->length == e->length) && (s->trigger == e->length - TEST_POSTROLL),
+              "clip %u: server got %u samples, detection at %u", (unsigned)s->sequence,
+              (unsigned)s->length, (unsigned)s->trigger);
+        CHECK(s->received == s->count, "clip %u: %u of %u chunks", (unsigned)s->sequence,
+              (unsigned)s->received, (unsigned)s->count);
+        CHECK(snr >= TEST_MIN_SNR_DB, "clip %u: coding SNR %.1f dB", (unsigned)s->sequence, snr);
+        printf("clip %u: %u chunks, coding SNR %.1f dB\n", (unsigned)s->sequence, (unsigned)s->count, snr);
+    }
+}
+
+int main(void)
+{
+    const clip_upload_port_t port = { http_send, virtual_sleep_ms, virtual_now_ms, NULL };
+    pthread_t server;
+    uint32_t throughput;
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    if (0 != server_start(&server))
+    {
+        printf("FAIL: no loopback server\n");
+        return 1;
+    }
+    render_source();
+    clip_capture_init(&capture, ring, TEST_RING_SAMPLES, TEST_POSTROLL);
+    clip_upload_init(&uploader, &port, CLIP_UPLOAD_MAX_BYTES_PER_S);
+
+    run_capture();
+    check_server();
+
+    throughput = clip_upload_bytes_per_s(&uploader);
+    CHECK((3 == expected_count) && (1u == capture.merged) && (1u == capture.dropped),
+          "%d clips, %u merged, %u dropped, expected 3, 1, 1", expected_count,
+          (unsigned)capture.merged, (unsigned)capture.dropped);
+    CHECK(1u == uploader.retries, "%u retries, expected 1", (unsigned)uploader.retries);
+    CHECK(throughput <= CLIP_UPLOAD_MAX_BYTES_PER_S, "throughput %u above the cap", (unsigned)throughput);
+
+    clip_capture_print_stats(&capture, printf);
+    clip_upload_print_stats(&uploader, printf);
+    printf("memory: CM55 ring %u bytes, CM33 uploader %u bytes; compression %.2f:1, %u requests\n",
+           (unsigned)sizeof(ring), (unsigned)sizeof(uploader),
+           (double)uploader.pcm_bytes / (double)uploader.sent_bytes, (unsigned)server_requests);
+
+    shutdown(server_socket, SHUT_RDWR);
+    close(server_socket);
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,337 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Evaluation of the DC blocker of the capture path (dc_block.h).
+ *
+ * Renders a synthetic cry clip over a quiet background as 16 bit PCM, adds
+ * DC offsets as a PDM microphone may have them and runs it through the three
+ * input stages of AUDIO_DC_BLOCK, the AGC and the log-mel front end. The
+ * features of every case are compared with the clip without offset through
+ * the input stage without DC blocker, the features the models were trained
+ * on. Reported per offset and stage:
+ *
+ *   gain       mean AGC gain difference, in dB
+ *   error      mean absolute log-mel error of the event frames
+ *   gap_error  same for the background between the events
+ *   band0      mean absolute error of the lowest mel band, all frames
+ *
+ * Also reports the cost per hop of every input stage on this host. See
+ * DEVELOPER_GUIDE.md.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "agc.h"
+#include "cycle_counter.h"
+#include "dc_block.h"
+#include "logmel.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define EVAL_SECONDS                (12)
+#define EVAL_SAMPLES                (EVAL_SECONDS * LOGMEL_SAMPLE_RATE)
+#define EVAL_MAX_FRAMES             (EVAL_SAMPLES / LOGMEL_HOP_SIZE)
+
+/* Synthetic cries: bursts of a harmonic tone with a wandering pitch over a
+ * steady background */
+#define EVAL_CRY_DBFS               (-35.0)
+#define EVAL_BACKGROUND_DBFS        (-65.0)
+#define EVAL_CRY_ON_S               (1.0)
+#define EVAL_CRY_OFF_S              (1.0)
+#define EVAL_CRY_RAMP_S             (0.05)
+#define EVAL_CRY_F0                 (420.0)
+#define EVAL_CRY_HARMONICS          (6)
+
+/* The first frames let the AGC and the filter settle and are not scored */
+#define EVAL_SETTLE_S               (1.0)
+
+/* Passes over the clip per cost measurement, the fastest one counts */
+#define EVAL_TIMING_RUNS            (20)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* The input stages of AUDIO_DC_BLOCK */
+typedef enum
+{
+    EVAL_OFF = 0,
+    EVAL_SEPARATE,
+    EVAL_FUSED,
+    EVAL_STAGE_COUNT
+} eval_stage_t;
+
+typedef struct
+{
+    const char* name;
+    double      offset;             /* Constant part, fraction of full scale */
+    double      drift;              /* Amplitude of a slow wander */
+    double      drift_hz;
+} eval_offset_t;
+
+typedef struct
+{
+    double      gain_db;
+    double      error;
+    double      gap_error;
+    double      band0;
+} eval_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char* const stage_names[EVAL_STAGE_COUNT] = { "off", "separate", "fused" };
+
+static const eval_offset_t offsets[] =
+{
+    { "none",   0.0,   0.0,   0.0 },
+    { "0.5%",   0.005, 0.0,   0.0 },
+    { "2%",     0.02,  0.0,   0.0 },
+    { "10%",    0.10,  0.0,   0.0 },
+    { "drift",  0.02,  0.02,  0.5 },
+};
+
+static float clip[EVAL_SAMPLES];            /* Cries and background, full scale 1 */
+static bool cry_frame[EVAL_MAX_FRAMES];
+static int16_t pcm[EVAL_SAMPLES];
+
+static float reference[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static float features[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static float reference_gain[EVAL_MAX_FRAMES];
+static float gain[EVAL_MAX_FRAMES];
+
+static agc_t agc;
+static dc_block_t dc;
+static logmel_t frontend;
+static logmel_scratch_t frontend_scratch;
+static logmel_consumer_t collector;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Cry bursts over white noise, and which frames lie inside a cry */
+static void render_clip(void)
+{
+    const double period = EVAL_CRY_ON_S + EVAL_CRY_OFF_S;
+    const double cry_gain = pow(10.0, EVAL_CRY_DBFS / 20.0) * sqrt(2.0);
+    const double noise_gain = pow(10.0, EVAL_BACKGROUND_DBFS / 20.0) * sqrt(12.0);
+    uint32_t state = 11u;
+    double phase = 0.0;
+
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double in_cry = fmod(t, period) - EVAL_CRY_OFF_S;
+        double f0 = EVAL_CRY_F0 * (1.0 + 0.15 * sin(2.0 * M_PI * 0.8 * t));
+        double envelope = 0.0, v = 0.0;
+
+        if (in_cry >= 0.0)
+        {
+            double edge = fmin(in_cry, EVAL_CRY_ON_S - in_cry);
+            envelope = (edge < EVAL_CRY_RAMP_S) ? 0.5 - 0.5 * cos(M_PI * edge / EVAL_CRY_RAMP_S) : 1.0;
+        }
+        phase += 2.0 * M_PI * f0 / LOGMEL_SAMPLE_RATE;
+        for (int k = 1; k <= EVAL_CRY_HARMONICS; k++)
+        {
+            v += sin(k * phase) / k;
+        }
+        clip[i] = (float)(cry_gain * envelope * v + noise_gain * (next_uniform(&state) - 0.5));
+    }
+
+    for (int f = 0; f < EVAL_MAX_FRAMES; f++)
+    {
+        double first = (double)(f * LOGMEL_HOP_SIZE) / LOGMEL_SAMPLE_RATE;
+        double last = first + (double)(LOGMEL_FFT_SIZE - 1) / LOGMEL_SAMPLE_RATE;
+        cry_frame[f] = (fmod(first, period) >= EVAL_CRY_OFF_S) && (fmod(last, period) >= EVAL_CRY_OFF_S) &&
+                       ((int)(first / period) == (int)(last / period));
+    }
+}
+
+static void render_pcm(const eval_offset_t* offset)
+{
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double v = clip[i] + offset->offset + offset->drift * sin(2.0 * M_PI * offset->drift_hz * t);
+        v = round(32768.0 * v);
+        pcm[i] = (int16_t)((v > 32767.0) ? 32767.0 : (v < -32768.0) ? -32768.0 : v);
+    }
+}
+
+static void reset_stage(void)
+{
+    agc_config_t config;
+
+    agc_default_config(&config);
+    agc_init(&agc, &config, LOGMEL_SAMPLE_RATE, LOGMEL_HOP_SIZE);
+    dc_block_init(&dc, DC_BLOCK_CUTOFF_HZ, LOGMEL_SAMPLE_RATE);
+}
+
+/* A hop through an input stage, as audio_pipeline_process() runs it. Not
+ * inlined, so that the block size is not a constant, as in the pipeline. */
+static __attribute__((noinline)) void input_stage(eval_stage_t stage, const int16_t* hop, int count, float* samples)
+{
+    float power;
+    float peak;
+
+    switch (stage)
+    {
+        case EVAL_SEPARATE:
+            for (int i = 0; i < count; i++)
+            {
+                samples[i] = (float)hop[i] / 32768.0f;
+            }
+            dc_block_process(&dc, samples, count);
+            agc_process(&agc, samples, count);
+            break;
+
+        case EVAL_FUSED:
+            dc_block_q15(&dc, hop, count, samples, &power, &peak);
+            agc_process_stats(&agc, samples, count, power, peak);
+            break;
+
+        default:
+            agc_process_q15(&agc, hop, count, samples);
+            break;
+    }
+}
+
+static int collect_frame(void* arg, const float* frame)
+{
+    float (*frames)[LOGMEL_BANDS] = arg;
+    uint32_t index = collector.frames;
+
+    if (index < EVAL_MAX_FRAMES)
+    {
+        memcpy(frames[index], frame, sizeof(frames[index]));
+    }
+    return 0;
+}
+
+/* Runs the PCM through an input stage and the front end, collecting the
+ * features and the AGC gain of every frame */
+static void run_stage(eval_stage_t stage, float (*frames)[LOGMEL_BANDS], float* gains)
+{
+    float samples[LOGMEL_HOP_SIZE];
+
+    reset_stage();
+    logmel_init(&frontend, &frontend_scratch);
+    memset(&collector, 0, sizeof(collector));
+    collector.name = "eval";
+    collector.window_frames = 1;
+    collector.window_stride = 1;
+    collector.push = collect_frame;
+    collector.arg = frames;
+    logmel_add_consumer(&frontend, &collector);
+
+    for (int offset = 0; offset + LOGMEL_HOP_SIZE <= EVAL_SAMPLES; offset += LOGMEL_HOP_SIZE)
+    {
+        input_stage(stage, &pcm[offset], LOGMEL_HOP_SIZE, samples);
+        logmel_process(&frontend, samples, LOGMEL_HOP_SIZE);
+        if (frontend.frames > 0u && frontend.frames <= EVAL_MAX_FRAMES)
+        {
+            gains[frontend.frames - 1u] = agc_gain_db(&agc);
+        }
+    }
+}
+
+static void score(eval_result_t* result)
+{
+    const int first = (int)(EVAL_SETTLE_S * LOGMEL_SAMPLE_RATE / LOGMEL_HOP_SIZE);
+    const int frames = ((int)collector.frames < EVAL_MAX_FRAMES) ? (int)collector.frames : EVAL_MAX_FRAMES;
+    int cries = 0, gaps = 0;
+
+    memset(result, 0, sizeof(*result));
+    for (int f = first; f < frames; f++)
+    {
+        double error = 0.0;
+
+        for (int b = 0; b < LOGMEL_BANDS; b++)
+        {
+            error += fabs((double)features[f][b] - reference[f][b]);
+        }
+        error /= LOGMEL_BANDS;
+        if (cry_frame[f])
+        {
+            result->error += error;
+            cries++;
+        }
+        else
+        {
+            result->gap_error += error;
+            gaps++;
+        }
+        result->gain_db += gain[f] - reference_gain[f];
+        result->band0 += fabs((double)features[f][0] - reference[f][0]);
+    }
+    result->error /= cries;
+    result->gap_error /= gaps;
+    result->gain_db /= (frames - first);
+    result->band0 /= (frames - first);
+}
+
+/* Cost of an input stage per hop, the fastest of EVAL_TIMING_RUNS passes */
+static double time_stage(eval_stage_t stage)
+{
+    static float samples[LOGMEL_HOP_SIZE];
+    uint32_t best = UINT32_MAX;
+    const int hops = EVAL_SAMPLES / LOGMEL_HOP_SIZE;
+
+    for (int run = 0; run < EVAL_TIMING_RUNS; run++)
+    {
+        reset_stage();
+        uint32_t start = cycle_counter_get();
+        for (int h = 0; h < hops; h++)
+        {
+            input_stage(stage, &pcm[h * LOGMEL_HOP_SIZE], LOGMEL_HOP_SIZE, samples);
+        }
+        uint32_t elapsed = cycle_counter_get() - start;
+        best = (elapsed < best) ? elapsed : best;
+    }
+    return (double)best / hops;
+}
+
+int main(void)
+{
+    eval_result_t result;
+
+    cycle_counter_init();
+    render_clip();
+    render_pcm(&offsets[0]);
+    run_stage(EVAL_OFF, reference, reference_gain);
+
+    printf("dc blocker: first order, %.0f Hz corner\n", (double)DC_BLOCK_CUTOFF_HZ);
+    printf("offset  stage     gain_db  error   gap_error  band0\n");
+    for (int o = 0; o < (int)(sizeof(offsets) / sizeof(offsets[0])); o++)
+    {
+        render_pcm(&offsets[o]);
+        for (int s = 0; s < EVAL_STAGE_COUNT; s++)
+        {
+            run_stage((eval_stage_t)s, features, gain);
+            score(&result);
+            printf("%-6s  %-8s  %7.2f  %6.3f  %9.3f  %6.3f\n", offsets[o].name, stage_names[s],
+                   result.gain_db, result.error, result.gap_error, result.band0);
+        }
+    }
+
+    render_pcm(&offsets[2]);
+    printf("cost per hop:");
+    for (int s = 0; s < EVAL_STAGE_COUNT; s++)
+    {
+        printf(" %s %.0f ns%s", stage_names[s], time_stage((eval_stage_t)s), (s + 1 < EVAL_STAGE_COUNT) ? "," : "\n");
+    }
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
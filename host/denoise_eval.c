@@ -0,0 +1,370 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Evaluation of the noise suppression of the front end (denoise.h).
+ *
+ * Mixes a synthetic cry clip with stationary noises at several signal to
+ * noise ratios and runs it through the log-mel front end with and without
+ * noise suppression. A frame detector on the features, calibrated on the
+ * clip in a quiet room, stands in for the model. Reported per noise, SNR and
+ * setting:
+ *
+ *   fp         gap frames the detector fires on
+ *   tp         cry frames the detector fires on
+ *   gap_db     mean log-mel of the gap frames above the quiet room, in dB
+ *   cry_error  mean absolute log-mel error of the cry frames against the
+ *              quiet room
+ *
+ * The host NPU is a mock, so false positives are counted on the features the
+ * model sees rather than on its decisions. Also reports the cost of the
+ * noise suppression per frame on this host. See DEVELOPER_GUIDE.md.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cycle_counter.h"
+#include "denoise.h"
+#include "logmel.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define EVAL_SECONDS                (30)
+#define EVAL_SAMPLES                (EVAL_SECONDS * LOGMEL_SAMPLE_RATE)
+#define EVAL_MAX_FRAMES             (EVAL_SAMPLES / LOGMEL_HOP_SIZE)
+
+/* Cry RMS, the level the AGC of agc.h settles at */
+#define EVAL_CRY_DBFS               (-20.0)
+
+/* Synthetic cries: bursts of a harmonic tone with a wandering pitch. The
+ * clip starts with a gap, as a recording of a quiet room would. */
+#define EVAL_CRY_ON_S               (1.0)
+#define EVAL_CRY_OFF_S              (2.0)
+#define EVAL_CRY_RAMP_S             (0.05)
+#define EVAL_CRY_F0                 (420.0)
+#define EVAL_CRY_HARMONICS          (6)
+
+/* Reference: the cries over white noise this far below them */
+#define EVAL_QUIET_SNR_DB           (40.0)
+
+/* The first seconds let the noise estimate settle and are not scored */
+#define EVAL_SETTLE_S               (2.0)
+
+/* Detector threshold between the quiet room gap and cry levels, as a
+ * fraction of the distance from the gap level */
+#define EVAL_THRESHOLD_POINT        (0.5)
+
+/* Passes over the clip per cost measurement, the fastest one counts */
+#define EVAL_TIMING_RUNS            (10)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    EVAL_NOISE_WHITE = 0,           /* Flat spectrum, white noise machines */
+    EVAL_NOISE_HVAC,                /* Low frequency rumble, mains hum and a fan tone */
+    EVAL_NOISE_COUNT
+} eval_noise_t;
+
+typedef enum
+{
+    EVAL_FRAME_SETTLE = 0,
+    EVAL_FRAME_GAP,
+    EVAL_FRAME_CRY,
+    EVAL_FRAME_EDGE                 /* Partly overlaps a cry, not scored */
+} eval_frame_t;
+
+typedef struct
+{
+    double      fp;
+    double      tp;
+    double      gap_db;
+    double      cry_error;
+} eval_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const double snrs_db[] = { 20.0, 10.0, 5.0, 0.0 };
+static const char* const noise_names[EVAL_NOISE_COUNT] = { "white", "hvac" };
+
+static float cry[EVAL_SAMPLES];             /* Unit cry RMS */
+static float noise[EVAL_SAMPLES];           /* Unit RMS */
+static float mix[EVAL_SAMPLES];
+static eval_frame_t frame_class[EVAL_MAX_FRAMES];
+
+static float clean[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static float features[EVAL_MAX_FRAMES][LOGMEL_BANDS];
+static double threshold;
+
+static logmel_t frontend;
+static logmel_scratch_t frontend_scratch;
+static logmel_consumer_t collector;
+static denoise_t suppressor;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Cry bursts scaled to a cry RMS of 1, and the class of every frame */
+static void render_cries(void)
+{
+    const double period = EVAL_CRY_ON_S + EVAL_CRY_OFF_S;
+    double phase = 0.0, power = 0.0;
+    int on = 0;
+
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double in_cry = fmod(t, period) - EVAL_CRY_OFF_S;
+        double f0 = EVAL_CRY_F0 * (1.0 + 0.15 * sin(2.0 * M_PI * 0.8 * t) + 0.03 * sin(2.0 * M_PI * 6.0 * t));
+        double envelope = 0.0, v = 0.0;
+
+        if (in_cry >= 0.0)
+        {
+            double edge = fmin(in_cry, EVAL_CRY_ON_S - in_cry);
+            envelope = (edge < EVAL_CRY_RAMP_S) ? 0.5 - 0.5 * cos(M_PI * edge / EVAL_CRY_RAMP_S) : 1.0;
+            on++;
+        }
+        phase += 2.0 * M_PI * f0 / LOGMEL_SAMPLE_RATE;
+        for (int k = 1; k <= EVAL_CRY_HARMONICS; k++)
+        {
+            v += sin(k * phase) / k;
+        }
+        cry[i] = (float)(envelope * v);
+        power += cry[i] * cry[i];
+    }
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        cry[i] *= (float)(1.0 / sqrt(power / on));
+    }
+
+    for (int f = 0; f < EVAL_MAX_FRAMES; f++)
+    {
+        int first = f * LOGMEL_HOP_SIZE, last = first + LOGMEL_FFT_SIZE - 1;
+        bool first_on = (fmod((double)first / LOGMEL_SAMPLE_RATE, period) >= EVAL_CRY_OFF_S);
+        bool last_on = (fmod((double)last / LOGMEL_SAMPLE_RATE, period) >= EVAL_CRY_OFF_S);
+        bool spans = ((int)((double)first / LOGMEL_SAMPLE_RATE / period) !=
+                      (int)((double)last / LOGMEL_SAMPLE_RATE / period));
+
+        frame_class[f] = ((double)first < EVAL_SETTLE_S * LOGMEL_SAMPLE_RATE) ? EVAL_FRAME_SETTLE :
+                         (first_on && last_on && !spans) ? EVAL_FRAME_CRY :
+                         (!first_on && !last_on && !spans) ? EVAL_FRAME_GAP : EVAL_FRAME_EDGE;
+    }
+}
+
+/* Stationary noise of unit RMS */
+static void render_noise(eval_noise_t type)
+{
+    uint32_t state = 7u;
+    double rumble = 0.0, power = 0.0;
+
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double white = sqrt(12.0) * (next_uniform(&state) - 0.5);
+        double v = white;
+
+        if (EVAL_NOISE_HVAC == type)
+        {
+            /* Integrated white noise with a leak, about 20 Hz corner */
+            rumble = 0.992 * rumble + 0.1 * white;
+            v = rumble + 0.3 * sin(2.0 * M_PI * 60.0 * t) + 0.15 * sin(2.0 * M_PI * 180.0 * t) +
+                0.1 * sin(2.0 * M_PI * 1210.0 * t) + 0.05 * white;
+        }
+        noise[i] = (float)v;
+    }
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        power += noise[i] * noise[i];
+    }
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        noise[i] *= (float)(1.0 / sqrt(power / EVAL_SAMPLES));
+    }
+}
+
+static void render_mix(double snr_db)
+{
+    const double cry_gain = pow(10.0, EVAL_CRY_DBFS / 20.0);
+    const double noise_gain = cry_gain * pow(10.0, -snr_db / 20.0);
+
+    for (int i = 0; i < EVAL_SAMPLES; i++)
+    {
+        mix[i] = (float)(cry_gain * cry[i] + noise_gain * noise[i]);
+    }
+}
+
+static int collect_frame(void* arg, const float* frame)
+{
+    float (*frames)[LOGMEL_BANDS] = arg;
+    uint32_t index = collector.frames;
+
+    if (index < EVAL_MAX_FRAMES)
+    {
+        memcpy(frames[index], frame, sizeof(frames[index]));
+    }
+    return 0;
+}
+
+/* Runs the mix through the front end, with or without noise suppression */
+static void run_frontend(bool suppress, float (*frames)[LOGMEL_BANDS])
+{
+    denoise_config_t config;
+
+    logmel_init(&frontend, &frontend_scratch);
+    memset(&collector, 0, sizeof(collector));
+    collector.name = "eval";
+    collector.window_frames = 1;
+    collector.window_stride = 1;
+    collector.push = collect_frame;
+    collector.arg = frames;
+    logmel_add_consumer(&frontend, &collector);
+    if (suppress)
+    {
+        denoise_default_config(&config);
+        denoise_init(&suppressor, &config);
+        logmel_set_denoise(&frontend, &suppressor);
+    }
+
+    for (int offset = 0; offset + LOGMEL_HOP_SIZE <= EVAL_SAMPLES; offset += LOGMEL_HOP_SIZE)
+    {
+        logmel_process(&frontend, &mix[offset], LOGMEL_HOP_SIZE);
+    }
+}
+
+static double frame_level(const float* frame)
+{
+    double sum = 0.0;
+
+    for (int b = 0; b < LOGMEL_BANDS; b++)
+    {
+        sum += frame[b];
+    }
+    return sum / LOGMEL_BANDS;
+}
+
+/* Collects the quiet room features and places the detector threshold
+ * between their gap and cry levels */
+static void calibrate(void)
+{
+    double gap = 0.0, cry_level = 0.0;
+    int gaps = 0, cries = 0;
+
+    render_noise(EVAL_NOISE_WHITE);
+    render_mix(EVAL_QUIET_SNR_DB);
+    run_frontend(false, clean);
+    for (int f = 0; f < (int)collector.frames; f++)
+    {
+        if (EVAL_FRAME_GAP == frame_class[f])
+        {
+            gap += frame_level(clean[f]);
+            gaps++;
+        }
+        else if (EVAL_FRAME_CRY == frame_class[f])
+        {
+            cry_level += frame_level(clean[f]);
+            cries++;
+        }
+    }
+    gap /= gaps;
+    cry_level /= cries;
+    threshold = gap + EVAL_THRESHOLD_POINT * (cry_level - gap);
+    printf("quiet room: gap level %.2f, cry level %.2f, threshold %.2f (mean ln mel)\n",
+           gap, cry_level, threshold);
+}
+
+static void score(eval_result_t* result)
+{
+    int gaps = 0, cries = 0;
+
+    memset(result, 0, sizeof(*result));
+    for (int f = 0; f < (int)collector.frames; f++)
+    {
+        bool detected = (frame_level(features[f]) > threshold);
+
+        if (EVAL_FRAME_GAP == frame_class[f])
+        {
+            result->fp += detected;
+            result->gap_db += 10.0 / log(10.0) * (frame_level(features[f]) - frame_level(clean[f]));
+            gaps++;
+        }
+        else if (EVAL_FRAME_CRY == frame_class[f])
+        {
+            double error = 0.0;
+            for (int b = 0; b < LOGMEL_BANDS; b++)
+            {
+                error += fabs((double)features[f][b] - clean[f][b]);
+            }
+            result->cry_error += error / LOGMEL_BANDS;
+            result->tp += detected;
+            cries++;
+        }
+    }
+    result->fp = 100.0 * result->fp / gaps;
+    result->gap_db /= gaps;
+    result->tp = 100.0 * result->tp / cries;
+    result->cry_error /= cries;
+}
+
+/* Cost of the front end per frame. The difference with and without noise
+ * suppression is its cost, measured where it runs. */
+static double time_frontend(bool suppress)
+{
+    uint32_t best = UINT32_MAX;
+
+    for (int run = 0; run < EVAL_TIMING_RUNS; run++)
+    {
+        uint32_t start = cycle_counter_get();
+        run_frontend(suppress, features);
+        uint32_t elapsed = cycle_counter_get() - start;
+        best = (elapsed < best) ? elapsed : best;
+    }
+    return (0u != collector.frames) ? (double)best / collector.frames : 0.0;
+}
+
+int main(void)
+{
+    eval_result_t results[2];
+
+    cycle_counter_init();
+    render_cries();
+    calibrate();
+
+    printf("noise  snr_db  denoise  fp_pct  tp_pct  gap_db  cry_error\n");
+    for (int n = 0; n < EVAL_NOISE_COUNT; n++)
+    {
+        render_noise((eval_noise_t)n);
+        for (int s = 0; s < (int)(sizeof(snrs_db) / sizeof(snrs_db[0])); s++)
+        {
+            render_mix(snrs_db[s]);
+            for (int suppress = 0; suppress < 2; suppress++)
+            {
+                eval_result_t* r = &results[suppress];
+                run_frontend(suppress, features);
+                score(r);
+                printf("%5s  %6.0f  %7s  %6.1f  %6.1f  %6.1f  %9.2f\n", noise_names[n], snrs_db[s],
+                       suppress ? "on" : "off", r->fp, r->tp, r->gap_db, r->cry_error);
+            }
+        }
+    }
+
+    double without = time_frontend(false);
+    double with = time_frontend(true);
+    printf("cost per frame: front end %.0f ns without, %.0f ns with denoise, denoise %.0f ns\n",
+           without, with, with - without);
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
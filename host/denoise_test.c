@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the noise floor tracking of denoise.h after silence.
+ *
+ * A recording that starts with digital silence seeds the estimate with 0,
+ * which the rise by a factor per frame cannot leave. Feeds a zero frame,
+ * then a stationary noise spectrum, and checks that the estimate of every
+ * bin reaches the noise and the noise is suppressed, also with the largest
+ * fall of the configuration. Exits with 1 on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "denoise.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_FRAMES_PER_S           (LOGMEL_SAMPLE_RATE / LOGMEL_HOP_SIZE)
+
+/* Noise magnitude per bin, 40 dB above DENOISE_ESTIMATE_MIN */
+#define TEST_NOISE                  (1e-3f)
+
+/* 40 dB at the default rise of 3 dB per second takes 13.3 s */
+#define TEST_NOISE_S                (20)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void test_after_silence(float fall)
+{
+    denoise_config_t config;
+    denoise_t dn;
+    float magnitude[LOGMEL_BINS];
+
+    denoise_default_config(&config);
+    config.fall = fall;
+    CHECK(DENOISE_RET_SUCCESS == denoise_init(&dn, &config), "init with fall %.2f", (double)fall);
+
+    for (int i = 0; i < LOGMEL_BINS; i++)
+    {
+        magnitude[i] = 0.0f;
+    }
+    denoise_process(&dn, magnitude);
+    for (int i = 0; i < LOGMEL_BINS; i++)
+    {
+        CHECK(dn.estimate[i] >= DENOISE_ESTIMATE_MIN, "fall %.2f: bin %d at %g after silence", (double)fall, i,
+              (double)dn.estimate[i]);
+    }
+
+    for (int frame = 0; frame < TEST_NOISE_S * TEST_FRAMES_PER_S; frame++)
+    {
+        for (int i = 0; i < LOGMEL_BINS; i++)
+        {
+            magnitude[i] = TEST_NOISE;
+        }
+        denoise_process(&dn, magnitude);
+    }
+
+    /* Settled within one rise of the noise, which is left at the floor */
+    for (int i = 0; i < LOGMEL_BINS; i++)
+    {
+        CHECK((dn.estimate[i] >= TEST_NOISE) && (dn.estimate[i] <= TEST_NOISE * dn.rise),
+              "fall %.2f: bin %d estimate %g of noise %g", (double)fall, i, (double)dn.estimate[i],
+              (double)TEST_NOISE);
+        CHECK(fabsf(magnitude[i] - dn.floor * TEST_NOISE) <= 1e-9f, "fall %.2f: bin %d left at %g",
+              (double)fall, i, (double)magnitude[i]);
+    }
+}
+
+int main(void)
+{
+    test_after_silence(DENOISE_FALL);
+    test_after_silence(1.0f);
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
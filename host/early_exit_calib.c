@@ -0,0 +1,580 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Calibration of the early exit stage of early_exit.h on a labeled corpus.
+ *
+ *   early_exit_calib [-r recall] [-o baby_cry_exit.h] corpus.csv
+ *   early_exit_calib -c corpus.csv
+ *
+ * corpus.csv lists one 16 kHz WAV file per line with its label, either the
+ * index or the name of a label of the model: "clips/cry_001.wav,baby_cry".
+ * Relative paths are relative to the list, lines starting with # are
+ * skipped. Every window of a file gets the label of the file, so positive
+ * clips should be cut to the event.
+ *
+ * Each file runs through the front end of the pipeline from a fresh start,
+ * at the window and stride of the model. The tool fits the logistic model of
+ * early_exit.h to tell the windows of the first label (background) from the
+ * rest, by Newton iterations with both classes weighted equally, and sets
+ * the threshold to the lowest logit that keeps the target recall of the
+ * positive windows. It writes the parameters as a header in place of
+ * Models/baby_cry_exit.h and prints the recall, the windows that exit and
+ * the model inferences per minute of audio with and without the stage.
+ *
+ * With -c the parameters built in (Models/baby_cry_exit.h) are checked on a
+ * corpus instead, through the pipeline as the device runs it, e.g. on a
+ * corpus held out of the calibration. Exits with 1 on errors, with 2 if -c
+ * misses the recall the parameters were calibrated for.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "audio.h"
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "baby_cry_exit.h"
+#include "early_exit.h"
+#include "wav_reader.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CALIB_RECALL                (0.99)
+#define CALIB_ITERATIONS            (50)
+#define CALIB_L2                    (1e-3)
+#define CALIB_PARAMS                (EARLY_EXIT_FEATURES + 1)
+#define CALIB_PATH_SIZE             (1024)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Windows of the corpus: features, label and reference logit */
+typedef struct
+{
+    float*      features;           /* count * EARLY_EXIT_FEATURES */
+    uint8_t*    positive;
+    double*     logit;
+    uint32_t    count;
+    uint32_t    capacity;
+    uint32_t    positives;
+    double      audio_s;
+    double      positive_s;
+} calib_set_t;
+
+/* Decisions of the pipeline with the stage, for -c */
+typedef struct
+{
+    uint32_t    windows[2];         /* Background, positive */
+    uint32_t    exits[2];
+    double      audio_s[2];
+} calib_check_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static calib_set_t set;
+static calib_check_t check;
+static bool file_positive;
+
+/* Frames of the window being collected */
+static logmel_consumer_t window_consumer;
+static float window_ring[BABY_CRY_WINDOW_FRAMES][LOGMEL_BANDS];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Front end consumer keeping the last window of frames */
+static int window_push(void* arg, const float* frame)
+{
+    logmel_consumer_t* consumer = (logmel_consumer_t*)arg;
+
+    memcpy(window_ring[consumer->frames % BABY_CRY_WINDOW_FRAMES], frame, sizeof(window_ring[0]));
+    return LOGMEL_RET_SUCCESS;
+}
+
+/* Window of the consumer complete, adds its features to the set */
+static void window_features(void* arg)
+{
+    logmel_consumer_t* consumer = (logmel_consumer_t*)arg;
+    float window[BABY_CRY_WINDOW_FRAMES][LOGMEL_BANDS];
+
+    /* frames already counts the newest frame, the oldest one is next in the ring */
+    for (uint32_t t = 0; t < BABY_CRY_WINDOW_FRAMES; t++)
+    {
+        memcpy(window[t], window_ring[(consumer->frames + t) % BABY_CRY_WINDOW_FRAMES], sizeof(window[0]));
+    }
+    if (set.count == set.capacity)
+    {
+        set.capacity = (0u != set.capacity) ? (2u * set.capacity) : 1024u;
+        set.features = realloc(set.features, (size_t)set.capacity * EARLY_EXIT_FEATURES * sizeof(float));
+        set.positive = realloc(set.positive, set.capacity);
+        if ((NULL == set.features) || (NULL == set.positive))
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    early_exit_features(&window[0][0], BABY_CRY_WINDOW_FRAMES, &set.features[(size_t)set.count * EARLY_EXIT_FEATURES]);
+    set.positive[set.count] = file_positive ? 1u : 0u;
+    set.positives += file_positive ? 1u : 0u;
+    set.count++;
+}
+
+/* Pipeline result callback of -c */
+static void check_decision(const audio_result_t* result, void* arg)
+{
+    (void)arg;
+
+    check.windows[file_positive]++;
+    check.exits[file_positive] += result->early_exit ? 1u : 0u;
+}
+
+/* Label of a list entry, the index or the name of a model label */
+static int parse_label(const char* text)
+{
+    char* end;
+    long index = strtol(text, &end, 10);
+
+    if ((end != text) && ('\0' == *end))
+    {
+        return ((index >= 0) && (index < baby_cry_model.out_count)) ? (int)index : -1;
+    }
+    for (int i = 0; i < baby_cry_model.out_count; i++)
+    {
+        if (0 == strcmp(text, baby_cry_model.labels[i]))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Runs one file through a fresh pipeline, returns its seconds or -1 */
+static double process_file(const char* path, bool with_stage)
+{
+    wav_reader_t reader;
+    int16_t block[FRAME_SIZE];
+    uint64_t samples = 0;
+    uint32_t count;
+
+    if (WAV_READER_RET_SUCCESS != wav_reader_open(&reader, path, false, LOGMEL_SAMPLE_RATE))
+    {
+        fprintf(stderr, "%s: not a 16 bit PCM WAV file\n", path);
+        return -1.0;
+    }
+    if (LOGMEL_SAMPLE_RATE != reader.sample_rate)
+    {
+        fprintf(stderr, "%s: sample rate %lu Hz, the pipeline needs %d Hz\n", path,
+                (unsigned long)reader.sample_rate, LOGMEL_SAMPLE_RATE);
+        wav_reader_close(&reader);
+        return -1.0;
+    }
+
+    if ((CY_RSLT_SUCCESS != audio_pipeline_restart(0, with_stage ? check_decision : NULL, NULL)) ||
+        (with_stage && (CY_RSLT_SUCCESS != audio_pipeline_set_early_exit(&baby_cry_exit))))
+    {
+        fprintf(stderr, "audio pipeline initialization failed\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!with_stage)
+    {
+        window_consumer.name = "early_exit_calib";
+        window_consumer.window_frames = baby_cry_model.window_frames;
+        window_consumer.window_stride = baby_cry_model.window_stride;
+        window_consumer.push = window_push;
+        window_consumer.window = window_features;
+        window_consumer.arg = &window_consumer;
+        (void)audio_pipeline_add_consumer(&window_consumer);
+    }
+
+    while (0 != (count = wav_reader_read(&reader, block, FRAME_SIZE)))
+    {
+        audio_pipeline_process(block, count);
+        samples += count;
+    }
+    wav_reader_close(&reader);
+    return (double)samples / LOGMEL_SAMPLE_RATE;
+}
+
+/* Processes every file of the list, returns the number of files or -1 */
+static int process_list(const char* list_path, bool with_stage)
+{
+    FILE* list = fopen(list_path, "r");
+    const char* slash = strrchr(list_path, '/');
+    int dir_length = (NULL != slash) ? (int)(slash - list_path + 1) : 0;
+    char line[CALIB_PATH_SIZE];
+    char path[2 * CALIB_PATH_SIZE];
+    int files = 0;
+
+    if (NULL == list)
+    {
+        fprintf(stderr, "%s: cannot open\n", list_path);
+        return -1;
+    }
+    while (NULL != fgets(line, sizeof(line), list))
+    {
+        char* comma = strrchr(line, ',');
+        int label;
+        double seconds;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (('\0' == line[0]) || ('#' == line[0]))
+        {
+            continue;
+        }
+        if ((NULL == comma) || ((label = parse_label(comma + 1)) < 0))
+        {
+            fprintf(stderr, "%s: no label of the model in \"%s\"\n", list_path, line);
+            fclose(list);
+            return -1;
+        }
+        *comma = '\0';
+        if ('/' == line[0])
+        {
+            snprintf(path, sizeof(path), "%s", line);
+        }
+        else
+        {
+            snprintf(path, sizeof(path), "%.*s%s", dir_length, list_path, line);
+        }
+
+        file_positive = (0 != label);
+        if ((seconds = process_file(path, with_stage)) < 0.0)
+        {
+            fclose(list);
+            return -1;
+        }
+        set.audio_s += seconds;
+        set.positive_s += file_positive ? seconds : 0.0;
+        check.audio_s[file_positive] += seconds;
+        files++;
+    }
+    fclose(list);
+    return files;
+}
+
+/* Solves a * x = b of CALIB_PARAMS unknowns in place, a is positive definite */
+static void solve(double a[CALIB_PARAMS][CALIB_PARAMS], double* b)
+{
+    for (int k = 0; k < CALIB_PARAMS; k++)
+    {
+        for (int i = k + 1; i < CALIB_PARAMS; i++)
+        {
+            double f = a[i][k] / a[k][k];
+            for (int j = k; j < CALIB_PARAMS; j++)
+            {
+                a[i][j] -= f * a[k][j];
+            }
+            b[i] -= f * b[k];
+        }
+    }
+    for (int k = CALIB_PARAMS - 1; k >= 0; k--)
+    {
+        for (int j = k + 1; j < CALIB_PARAMS; j++)
+        {
+            b[k] -= a[k][j] * b[j];
+        }
+        b[k] /= a[k][k];
+    }
+}
+
+/* Fits the logistic model on standardized features, then folds the
+ * standardization into the weights of the raw features */
+static void fit(early_exit_params_t* params)
+{
+    double mean[EARLY_EXIT_FEATURES] = { 0.0 };
+    double scale[EARLY_EXIT_FEATURES] = { 0.0 };
+    double w[CALIB_PARAMS] = { 0.0 };       /* Bias last */
+    double class_weight[2];
+    double x[CALIB_PARAMS];
+
+    for (uint32_t n = 0; n < set.count; n++)
+    {
+        for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+        {
+            mean[i] += set.features[(size_t)n * EARLY_EXIT_FEATURES + i];
+        }
+    }
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        mean[i] /= set.count;
+    }
+    for (uint32_t n = 0; n < set.count; n++)
+    {
+        for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+        {
+            double d = set.features[(size_t)n * EARLY_EXIT_FEATURES + i] - mean[i];
+            scale[i] += d * d;
+        }
+    }
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        scale[i] = sqrt(scale[i] / set.count);
+        scale[i] = (scale[i] > 1e-6) ? scale[i] : 1.0;
+    }
+    class_weight[0] = 0.5 * set.count / (set.count - set.positives);
+    class_weight[1] = 0.5 * set.count / set.positives;
+
+    for (int iteration = 0; iteration < CALIB_ITERATIONS; iteration++)
+    {
+        double hessian[CALIB_PARAMS][CALIB_PARAMS] = { { 0.0 } };
+        double gradient[CALIB_PARAMS] = { 0.0 };
+        double step = 0.0;
+
+        for (uint32_t n = 0; n < set.count; n++)
+        {
+            double z = 0.0;
+            double p, c;
+
+            for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+            {
+                x[i] = (set.features[(size_t)n * EARLY_EXIT_FEATURES + i] - mean[i]) / scale[i];
+            }
+            x[EARLY_EXIT_FEATURES] = 1.0;
+            for (int i = 0; i < CALIB_PARAMS; i++)
+            {
+                z += w[i] * x[i];
+            }
+            p = 1.0 / (1.0 + exp(-z));
+            c = class_weight[set.positive[n]];
+            for (int i = 0; i < CALIB_PARAMS; i++)
+            {
+                gradient[i] += c * (set.positive[n] - p) * x[i];
+                for (int j = 0; j <= i; j++)
+                {
+                    hessian[i][j] += c * p * (1.0 - p) * x[i] * x[j];
+                }
+            }
+        }
+        for (int i = 0; i < CALIB_PARAMS; i++)
+        {
+            for (int j = 0; j < i; j++)
+            {
+                hessian[j][i] = hessian[i][j];
+            }
+            hessian[i][i] += CALIB_L2 * set.count;
+            gradient[i] -= CALIB_L2 * set.count * w[i];
+        }
+        solve(hessian, gradient);
+        for (int i = 0; i < CALIB_PARAMS; i++)
+        {
+            w[i] += gradient[i];
+            step += fabs(gradient[i]);
+        }
+        if (step < 1e-9)
+        {
+            break;
+        }
+    }
+
+    memset(params, 0, sizeof(*params));
+    params->bias = (float)w[EARLY_EXIT_FEATURES];
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        params->weights[i] = (float)(w[i] / scale[i]);
+        params->bias -= (float)(w[i] * mean[i] / scale[i]);
+    }
+}
+
+static int compare_double(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Threshold keeping the recall of the positive windows. The logits of the
+ * device differ from the reference in the last bits, so it goes a little
+ * below the logit of the last positive window to keep. */
+static void set_threshold(early_exit_params_t* params, double recall)
+{
+    double* positive = malloc((size_t)set.positives * sizeof(double));
+    uint32_t count = 0;
+    uint32_t drop;
+
+    set.logit = malloc((size_t)set.count * sizeof(double));
+    if ((NULL == positive) || (NULL == set.logit))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t n = 0; n < set.count; n++)
+    {
+        set.logit[n] = early_exit_logit(params, &set.features[(size_t)n * EARLY_EXIT_FEATURES]);
+        if (set.positive[n])
+        {
+            positive[count++] = set.logit[n];
+        }
+    }
+    qsort(positive, count, sizeof(double), compare_double);
+    drop = (uint32_t)floor((1.0 - recall) * count);
+    params->threshold = (float)(positive[drop] - 1e-4 * (1.0 + fabs(positive[drop])));
+    params->recall = (float)recall;
+    free(positive);
+}
+
+static int write_params(const char* path, const early_exit_params_t* params, const char* corpus)
+{
+    FILE* out = fopen(path, "w");
+
+    if (NULL == out)
+    {
+        fprintf(stderr, "cannot write %s\n", path);
+        return -1;
+    }
+    fprintf(out,
+            "/* SPDX-License-Identifier: MIT\n"
+            " * Copyright (C) 2025 Avnet\n"
+            " * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.\n"
+            " */\n\n"
+            "/* Early exit stage of the baby cry model (shared/audio/early_exit.h).\n"
+            " *\n"
+            " * Written by host/early_exit_calib from %s: %lu windows, %lu positive,\n"
+            " * target recall %.4f.\n"
+            " */\n\n"
+            "#ifndef BABY_CRY_EXIT_H_\n"
+            "#define BABY_CRY_EXIT_H_\n\n"
+            "#include <math.h>\n"
+            "#include \"early_exit.h\"\n\n"
+            "static const early_exit_params_t baby_cry_exit =\n"
+            "{\n"
+            "    .weights =\n"
+            "    {\n",
+            corpus, (unsigned long)set.count, (unsigned long)set.positives, (double)params->recall);
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        fprintf(out, "%s%.9gf,%s", ((i % 4) == 0) ? "        " : " ", (double)params->weights[i],
+                (((i % 4) == 3) || (i == EARLY_EXIT_FEATURES - 1)) ? "\n" : "");
+    }
+    fprintf(out,
+            "    },\n"
+            "    .bias = %.9gf,\n"
+            "    .threshold = %.9gf,\n"
+            "    .recall = %.4ff,\n"
+            "};\n\n"
+            "#endif /* BABY_CRY_EXIT_H_ */\n",
+            (double)params->bias, (double)params->threshold, (double)params->recall);
+    fclose(out);
+    return 0;
+}
+
+/* Recall, exits and inferences per minute of the reference logits */
+static void report_fit(const early_exit_params_t* params)
+{
+    uint32_t exits[2] = { 0u, 0u };
+    uint32_t windows[2] = { set.count - set.positives, set.positives };
+    double background_s = set.audio_s - set.positive_s;
+
+    for (uint32_t n = 0; n < set.count; n++)
+    {
+        exits[set.positive[n]] += (set.logit[n] < params->threshold) ? 1u : 0u;
+    }
+    printf("windows:    %lu background, %lu positive, %.1f s of audio\n", (unsigned long)windows[0],
+           (unsigned long)windows[1], set.audio_s);
+    printf("recall:     %.4f of the positive windows reach the model\n",
+           1.0 - (double)exits[1] / windows[1]);
+    printf("exits:      %.1f%% of the background windows, %.1f%% of all\n",
+           100.0 * exits[0] / windows[0], 100.0 * (exits[0] + exits[1]) / set.count);
+    printf("inferences: %.1f per minute without the stage, %.1f with it\n",
+           set.count * 60.0 / set.audio_s, (set.count - exits[0] - exits[1]) * 60.0 / set.audio_s);
+    if (background_s > 0.0)
+    {
+        printf("            %.1f per minute of background audio\n",
+               (windows[0] - exits[0]) * 60.0 / background_s);
+    }
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [options] corpus.csv\n"
+            "  -r recall  of the positive windows to keep (default %.2f)\n"
+            "  -o file    write the parameters to a header, e.g. ../Models/baby_cry_exit.h\n"
+            "  -c         check the parameters built in instead of calibrating\n",
+            name, CALIB_RECALL);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* out_path = NULL;
+    double recall = CALIB_RECALL;
+    bool check_only = false;
+    early_exit_params_t params;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "r:o:ch")))
+    {
+        switch (opt)
+        {
+            case 'r': recall = strtod(optarg, NULL); break;
+            case 'o': out_path = optarg; break;
+            case 'c': check_only = true; break;
+            default:  usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if ((optind + 1 != argc) || !(recall > 0.0) || !(recall <= 1.0))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, NULL, NULL))
+    {
+        fprintf(stderr, "audio pipeline initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    if (check_only)
+    {
+        uint32_t windows, runs;
+        double audio_s;
+
+        if (process_list(argv[optind], true) <= 0)
+        {
+            return EXIT_FAILURE;
+        }
+        windows = check.windows[0] + check.windows[1];
+        runs = windows - check.exits[0] - check.exits[1];
+        audio_s = check.audio_s[0] + check.audio_s[1];
+        recall = (0u != check.windows[1]) ? 1.0 - (double)check.exits[1] / check.windows[1] : 1.0;
+        printf("windows:    %lu background, %lu positive, %.1f s of audio\n", (unsigned long)check.windows[0],
+               (unsigned long)check.windows[1], audio_s);
+        printf("recall:     %.4f of the positive windows reach the model, calibrated for %.4f\n", recall,
+               (double)baby_cry_exit.recall);
+        printf("exits:      %.1f%% of the background windows\n",
+               (0u != check.windows[0]) ? 100.0 * check.exits[0] / check.windows[0] : 0.0);
+        printf("inferences: %.1f per minute without the stage, %.1f with it\n",
+               (audio_s > 0.0) ? windows * 60.0 / audio_s : 0.0, (audio_s > 0.0) ? runs * 60.0 / audio_s : 0.0);
+        return (recall < baby_cry_exit.recall) ? 2 : EXIT_SUCCESS;
+    }
+
+    if (process_list(argv[optind], false) <= 0)
+    {
+        return EXIT_FAILURE;
+    }
+    if ((0u == set.positives) || (set.positives == set.count))
+    {
+        fprintf(stderr, "%s: needs windows of the background label and of the others\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    fit(&params);
+    set_threshold(&params, recall);
+    report_fit(&params);
+    if ((NULL != out_path) && (0 != write_params(out_path, &params, argv[optind])))
+    {
+        return EXIT_FAILURE;
+    }
+
+    free(set.features);
+    free(set.positive);
+    free(set.logit);
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,263 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the early exit stage of early_exit.h.
+ *
+ * First the logit early_exit_window() keeps up frame by frame must match the
+ * reference on the whole window, early_exit_features(), which the
+ * calibration fits, for random frames and weights. Then synthetic audio of
+ * silence and tone bursts runs through the pipeline, once without the stage
+ * and once with a stage on the peak frame energy set between the two. Every
+ * quiet window must exit with the background label, every other window must
+ * get the scores of the run without the stage, and the model runs must count
+ * the windows that did not exit. Exits with 1 on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "audio.h"
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "early_exit.h"
+#include "host_platform.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_FRAMES                 (500)
+#define TEST_WINDOW_STRIDE          (7u)
+#define TEST_SECONDS                (12)
+#define TEST_SAMPLES                (TEST_SECONDS * LOGMEL_SAMPLE_RATE)
+#define TEST_MAX_WINDOWS            (TEST_SAMPLES / LOGMEL_HOP_SIZE)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    audio_result_t  results[TEST_MAX_WINDOWS];
+    int             count;
+} test_run_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+static float frames[TEST_FRAMES][LOGMEL_BANDS];
+static int16_t pcm[TEST_SAMPLES];
+static test_run_t plain;
+static test_run_t gated;
+
+/* Reference features of the windows of the run without the stage */
+static logmel_consumer_t window_consumer;
+static float window_ring[BABY_CRY_WINDOW_FRAMES][LOGMEL_BANDS];
+static float window_peak[TEST_MAX_WINDOWS];
+static int window_count;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void test_logit(void)
+{
+    early_exit_params_t params;
+    early_exit_t ee;
+    float features[EARLY_EXIT_FEATURES];
+    uint32_t state = 3u;
+    float worst = 0.0f;
+    int windows = 0;
+
+    memset(&params, 0, sizeof(params));
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        params.weights[i] = (float)next_random(&state) / (float)(1u << 24) - 0.5f;
+    }
+    params.bias = 1.5f;
+    params.threshold = 0.0f;
+    for (int t = 0; t < TEST_FRAMES; t++)
+    {
+        for (int i = 0; i < LOGMEL_BANDS; i++)
+        {
+            frames[t][i] = (float)next_random(&state) / (float)(1u << 24) * 20.0f - 16.0f;
+        }
+    }
+
+    CHECK(EARLY_EXIT_RET_ERROR == early_exit_init(&ee, &params, EARLY_EXIT_MAX_FRAMES + 1u), "window too long accepted");
+    CHECK(EARLY_EXIT_RET_SUCCESS == early_exit_init(&ee, &params, BABY_CRY_WINDOW_FRAMES), "init");
+    for (int t = 0; t < TEST_FRAMES; t++)
+    {
+        early_exit_push(&ee, frames[t]);
+        if ((t + 1) % (int)TEST_WINDOW_STRIDE != 0)
+        {
+            continue;
+        }
+        if (t + 1 < BABY_CRY_WINDOW_FRAMES)
+        {
+            CHECK(!early_exit_window(&ee), "frame %d: exit before the window is full", t);
+            continue;
+        }
+
+        bool exit = early_exit_window(&ee);
+        float logit;
+
+        early_exit_features(&frames[t + 1 - BABY_CRY_WINDOW_FRAMES][0], BABY_CRY_WINDOW_FRAMES, features);
+        logit = early_exit_logit(&params, features);
+        worst = fmaxf(worst, fabsf(ee.logit - logit) / (1.0f + fabsf(logit)));
+        CHECK(exit == (ee.logit < params.threshold), "frame %d: exit %d at logit %f", t, exit, (double)ee.logit);
+        windows++;
+    }
+    printf("logit: %d windows, %lu exits, largest relative error %.2e\n", windows, (unsigned long)ee.exits,
+           (double)worst);
+    CHECK(worst < 1e-5f, "logit differs from the reference by %.2e", (double)worst);
+    CHECK((ee.exits > 0u) && ((int)ee.exits < windows), "no mix of exits: %lu", (unsigned long)ee.exits);
+
+    float scores[3];
+    early_exit_scores(&ee, scores, 3);
+    CHECK(fabsf(scores[0] + scores[1] + scores[2] - 1.0f) < 1e-6f, "scores do not add up to 1");
+}
+
+/* Silence with 1.5 s tone bursts of a rising pitch every 3 s */
+static void render_pcm(void)
+{
+    double phase = 0.0;
+
+    for (int i = 0; i < TEST_SAMPLES; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        double f = 400.0 + 150.0 * t;
+
+        phase += 2.0 * M_PI * f / LOGMEL_SAMPLE_RATE;
+        pcm[i] = (fmod(t, 3.0) >= 1.5) ? (int16_t)(0.25 * 32767.0 * sin(phase)) : 0;
+    }
+}
+
+static int window_push(void* arg, const float* frame)
+{
+    logmel_consumer_t* consumer = (logmel_consumer_t*)arg;
+
+    memcpy(window_ring[consumer->frames % BABY_CRY_WINDOW_FRAMES], frame, sizeof(window_ring[0]));
+    return LOGMEL_RET_SUCCESS;
+}
+
+static void window_features(void* arg)
+{
+    logmel_consumer_t* consumer = (logmel_consumer_t*)arg;
+    float window[BABY_CRY_WINDOW_FRAMES][LOGMEL_BANDS];
+    float features[EARLY_EXIT_FEATURES];
+
+    for (uint32_t t = 0; t < BABY_CRY_WINDOW_FRAMES; t++)
+    {
+        memcpy(window[t], window_ring[(consumer->frames + t) % BABY_CRY_WINDOW_FRAMES], sizeof(window[0]));
+    }
+    early_exit_features(&window[0][0], BABY_CRY_WINDOW_FRAMES, features);
+    window_peak[window_count++] = features[EARLY_EXIT_FEATURE_MAX];
+}
+
+static void record_result(const audio_result_t* result, void* arg)
+{
+    test_run_t* run = (test_run_t*)arg;
+
+    if (run->count < TEST_MAX_WINDOWS)
+    {
+        run->results[run->count++] = *result;
+    }
+}
+
+static void replay(void)
+{
+    for (int i = 0; i < TEST_SAMPLES; i += FRAME_SIZE)
+    {
+        audio_pipeline_process(&pcm[i], (TEST_SAMPLES - i < FRAME_SIZE) ? (uint32_t)(TEST_SAMPLES - i) : FRAME_SIZE);
+    }
+}
+
+static void test_pipeline(void)
+{
+    early_exit_params_t params;
+    float low = INFINITY;
+    float high = -INFINITY;
+    int exits = 0;
+    uint32_t runs = 0;
+
+    render_pcm();
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_restart(0, record_result, &plain), "restart");
+    window_consumer.name = "early_exit_test";
+    window_consumer.window_frames = BABY_CRY_WINDOW_FRAMES;
+    window_consumer.window_stride = BABY_CRY_WINDOW_STRIDE;
+    window_consumer.push = window_push;
+    window_consumer.window = window_features;
+    window_consumer.arg = &window_consumer;
+    CHECK(LOGMEL_RET_SUCCESS == audio_pipeline_add_consumer(&window_consumer), "consumer");
+    replay();
+    CHECK(window_count == plain.count, "%d windows, %d decisions", window_count, plain.count);
+
+    for (int i = 0; i < window_count; i++)
+    {
+        low = fminf(low, window_peak[i]);
+        high = fmaxf(high, window_peak[i]);
+    }
+
+    /* Exit below the middle of the peak energies */
+    memset(&params, 0, sizeof(params));
+    params.weights[EARLY_EXIT_FEATURE_MAX] = 1.0f;
+    params.bias = -0.5f * (low + high);
+    params.threshold = 0.0f;
+    params.recall = 1.0f;
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_restart(0, record_result, &gated), "restart");
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_set_early_exit(&params), "set early exit");
+    replay();
+    CHECK(plain.count == gated.count, "%d windows, %d with the stage", plain.count, gated.count);
+
+    for (int i = 0; (i < gated.count) && (i < plain.count); i++)
+    {
+        const audio_result_t* r = &gated.results[i];
+        bool quiet = (window_peak[i] < 0.5f * (low + high));
+
+        if (r->early_exit)
+        {
+            exits++;
+            CHECK(0 == r->label_id, "window %d exited with label %d", i, r->label_id);
+        }
+        else
+        {
+            runs++;
+            CHECK(0 == memcmp(r->scores_q, plain.results[i].scores_q, (size_t)r->score_count), "window %d: scores differ", i);
+        }
+        CHECK(quiet == r->early_exit, "window %d: exit %d at peak %f", i, r->early_exit, (double)window_peak[i]);
+        CHECK(runs == r->model_runs, "window %d: %lu model runs, %lu expected", i, (unsigned long)r->model_runs,
+              (unsigned long)runs);
+    }
+    printf("pipeline: %d windows, %d exited, peak energy %.2f .. %.2f\n", gated.count, exits, (double)low,
+           (double)high);
+    CHECK((exits > 0) && (exits < gated.count), "no mix of exits: %d", exits);
+    CHECK(plain.results[plain.count - 1].model_runs == (uint32_t)plain.count, "model runs without the stage");
+    audio_pipeline_print_stats(printf);
+
+    CHECK(CY_RSLT_SUCCESS == audio_pipeline_set_early_exit(NULL), "stage off");
+}
+
+int main(void)
+{
+    test_logit();
+
+    host_ml_set_probe(BABY_CRY_WINDOW_FRAMES * LOGMEL_BANDS);
+    if (CY_RSLT_SUCCESS != audio_pipeline_init(0, NULL, 0, NULL, NULL, NULL))
+    {
+        printf("FAIL: audio pipeline initialization\n");
+        return 1;
+    }
+    test_pipeline();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
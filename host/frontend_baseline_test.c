@@ -0,0 +1,692 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Comparison of the shared front end (logmel.c) with the per-model front end
+ * it replaced.
+ *
+ * The baseline below is the pre-processing the ImagiNet Compiler generated
+ * into baby_cry.c before the front end was shared: one float sample per
+ * IMAI_enqueue() into a 512 sample fixwin, dequeued with a stride of 160,
+ * then Hann window, FFT, magnitude, mel, clip and log into a 60 frame fixwin
+ * dequeued with a stride of 33. Its tables and kernels are copied unchanged
+ * from the generated file, only the FFT comes from rdft.c, which is the
+ * generated rdft() moved out of the model files.
+ *
+ * The same PCM clips go through both, logmel.c in irregular chunks. Every
+ * frame must match bin for bin and every model window must complete after
+ * the same sample and hold the same frames. Exits with 1 on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "logmel.h"
+#include "rdft.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CLIP_SAMPLES                (3 * LOGMEL_SAMPLE_RATE)
+#define MAX_FRAMES                  (CLIP_SAMPLES / LOGMEL_HOP_SIZE)
+#define MAX_WINDOWS                 (MAX_FRAMES)
+
+/* Generated model constants */
+#define BASE_FFT_SIZE               (512)
+#define BASE_HOP_SIZE               (160)
+#define BASE_BINS                   (BASE_FFT_SIZE / 2 + 1)
+#define BASE_BANDS                  (20)
+#define BASE_WINDOW_FRAMES          (60)
+#define BASE_WINDOW_STRIDE          (33)
+
+#define IPWIN_RET_SUCCESS           (0)
+#define IPWIN_RET_NODATA            (-1)
+#define IPWIN_RET_ERROR             (-2)
+
+#define CBUFFER_SUCCESS             (0)
+#define CBUFFER_NOMEM               (-1)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+#if (LOGMEL_FFT_SIZE != BASE_FFT_SIZE) || (LOGMEL_HOP_SIZE != BASE_HOP_SIZE)
+#error "The baseline only exists for the 512 point FFT with a 160 sample hop"
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    char *buf;
+    int size;
+    int used;
+    int read;
+    int write;
+} cbuffer_t;
+
+typedef struct
+{
+    cbuffer_t data_buffer;
+    int input_size;
+} fixwin_t;
+
+/* State and buffers of the generated model, without the network */
+typedef struct
+{
+    fixwin_t    sample_win;
+    float       sample_mem[BASE_FFT_SIZE];
+    fixwin_t    frame_win;
+    float       frame_mem[BASE_WINDOW_FRAMES * BASE_BANDS];
+    int32_t     fft_ip[24];
+    float       fft_w[BASE_BINS + 1];
+    float       fft_work[BASE_FFT_SIZE * 2 + 2];
+    float       samples[BASE_FFT_SIZE];
+    float       windowed[BASE_FFT_SIZE];
+    float       spectrum[BASE_BINS * 2];
+    float       magnitude[BASE_BINS];
+    float       mel[BASE_BANDS];
+    float       clipped[BASE_BANDS];
+    float       frame[BASE_BANDS];
+} baseline_t;
+
+typedef struct
+{
+    int         frames;
+    int         windows;
+    float       frame[MAX_FRAMES][LOGMEL_BANDS];
+    int32_t     window_sample[MAX_WINDOWS];     /* Samples in when the window completed */
+    float       window[MAX_WINDOWS][BASE_WINDOW_FRAMES * LOGMEL_BANDS];
+} capture_t;
+
+typedef void (*clip_fn)(int16_t* pcm, int count);
+
+typedef struct
+{
+    const char* name;
+    clip_fn     generate;
+} clip_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Generated Hann window (_K11) */
+static const uint32_t base_hann[BASE_FFT_SIZE] = {
+    0x00000000, 0x381e87c4, 0x391e863b, 0x39b25423, 0x3a1e8019, 0x3a77a0f6, 0x3ab2449b, 0x3af29a52,
+    0x3b1e6790, 0x3b487014, 0x3b776514, 0x3b95a260, 0x3bb2068a, 0x3bd0ddef, 0x3bf2275e, 0x3c0af0c6,
+    0x3c1e058c, 0x3c325144, 0x3c47d325, 0x3c5e8a59, 0x3c767600, 0x3c87ca96, 0x3c94f373, 0x3ca2b513,
+    0x3cb10eef, 0x3cc00079, 0x3ccf891c, 0x3cdfa83e, 0x3cf05d41, 0x3d00d3bf, 0x3d09c324, 0x3d12fc79,
+    0x3d1c7f61, 0x3d264b7e, 0x3d306070, 0x3d3abdd2, 0x3d45633d, 0x3d505049, 0x3d5b8488, 0x3d66ff8d,
+    0x3d72c0e4, 0x3d7ec81a, 0x3d858a5c, 0x3d8bd322, 0x3d923e20, 0x3d98cb17, 0x3d9f79c6, 0x3da649eb,
+    0x3dad3b42, 0x3db44d87, 0x3dbb8073, 0x3dc2d3c0, 0x3dca4724, 0x3dd1da56, 0x3dd98d0a, 0x3de15ef5,
+    0x3de94fc9, 0x3df15f37, 0x3df98cef, 0x3e00ec51, 0x3e0520fd, 0x3e096453, 0x3e0db62a, 0x3e121654,
+    0x3e1684a9, 0x3e1b00fb, 0x3e1f8b1e, 0x3e2422e6, 0x3e28c824, 0x3e2d7aab, 0x3e323a4b, 0x3e3706d7,
+    0x3e3be01f, 0x3e40c5f2, 0x3e45b820, 0x3e4ab678, 0x3e4fc0c8, 0x3e54d6df, 0x3e59f88a, 0x3e5f2596,
+    0x3e645dd0, 0x3e69a105, 0x3e6eeeff, 0x3e74478b, 0x3e79aa74, 0x3e7f1784, 0x3e824743, 0x3e8507a1,
+    0x3e87ccc2, 0x3e8a968a, 0x3e8d64dd, 0x3e9037a0, 0x3e930eb6, 0x3e95ea04, 0x3e98c96d, 0x3e9bacd4,
+    0x3e9e941e, 0x3ea17f2c, 0x3ea46de3, 0x3ea76026, 0x3eaa55d6, 0x3ead4ed8, 0x3eb04b0c, 0x3eb34a56,
+    0x3eb64c99, 0x3eb951b5, 0x3ebc598e, 0x3ebf6406, 0x3ec270fd, 0x3ec58056, 0x3ec891f3, 0x3ecba5b5,
+    0x3ecebb7e, 0x3ed1d32f, 0x3ed4ecaa, 0x3ed807cf, 0x3edb2480, 0x3ede429f, 0x3ee1620c, 0x3ee482a8,
+    0x3ee7a455, 0x3eeac6f2, 0x3eedea63, 0x3ef10e86, 0x3ef4333d, 0x3ef7586a, 0x3efa7dec, 0x3efda3a4,
+    0x3f0064ba, 0x3f01f79e, 0x3f038a6f, 0x3f051d1d, 0x3f06af97, 0x3f0841d0, 0x3f09d3b7, 0x3f0b653c,
+    0x3f0cf651, 0x3f0e86e5, 0x3f1016e9, 0x3f11a64e, 0x3f133504, 0x3f14c2fc, 0x3f165025, 0x3f17dc72,
+    0x3f1967d3, 0x3f1af237, 0x3f1c7b91, 0x3f1e03d0, 0x3f1f8ae6, 0x3f2110c4, 0x3f22955a, 0x3f241899,
+    0x3f259a73, 0x3f271ad8, 0x3f2899b9, 0x3f2a1709, 0x3f2b92b7, 0x3f2d0cb6, 0x3f2e84f6, 0x3f2ffb69,
+    0x3f317001, 0x3f32e2af, 0x3f345365, 0x3f35c214, 0x3f372eaf, 0x3f389927, 0x3f3a016e, 0x3f3b6776,
+    0x3f3ccb32, 0x3f3e2c94, 0x3f3f8b8d, 0x3f40e811, 0x3f424212, 0x3f439982, 0x3f44ee55, 0x3f46407c,
+    0x3f478fec, 0x3f48dc96, 0x3f4a266f, 0x3f4b6d69, 0x3f4cb177, 0x3f4df28e, 0x3f4f30a0, 0x3f506ba2,
+    0x3f51a386, 0x3f52d842, 0x3f5409c9, 0x3f553810, 0x3f56630a, 0x3f578aac, 0x3f58aeeb, 0x3f59cfbb,
+    0x3f5aed11, 0x3f5c06e2, 0x3f5d1d24, 0x3f5e2fcb, 0x3f5f3ecc, 0x3f604a1e, 0x3f6151b6, 0x3f62558a,
+    0x3f63558f, 0x3f6451bc, 0x3f654a07, 0x3f663e67, 0x3f672ed2, 0x3f681b3e, 0x3f6903a2, 0x3f69e7f7,
+    0x3f6ac831, 0x3f6ba44a, 0x3f6c7c39, 0x3f6d4ff4, 0x3f6e1f74, 0x3f6eeab2, 0x3f6fb1a4, 0x3f707443,
+    0x3f713289, 0x3f71ec6c, 0x3f72a1e7, 0x3f7352f3, 0x3f73ff87, 0x3f74a79e, 0x3f754b32, 0x3f75ea3b,
+    0x3f7684b4, 0x3f771a97, 0x3f77abdd, 0x3f783882, 0x3f78c080, 0x3f7943d1, 0x3f79c270, 0x3f7a3c5a,
+    0x3f7ab188, 0x3f7b21f6, 0x3f7b8da1, 0x3f7bf483, 0x3f7c5699, 0x3f7cb3df, 0x3f7d0c52, 0x3f7d5fee,
+    0x3f7daeaf, 0x3f7df893, 0x3f7e3d97, 0x3f7e7db8, 0x3f7eb8f4, 0x3f7eef48, 0x3f7f20b3, 0x3f7f4d32,
+    0x3f7f74c3, 0x3f7f9766, 0x3f7fb519, 0x3f7fcdda, 0x3f7fe1a9, 0x3f7ff085, 0x3f7ffa6d, 0x3f7fff61,
+    0x3f7fff61, 0x3f7ffa6d, 0x3f7ff085, 0x3f7fe1a9, 0x3f7fcdda, 0x3f7fb519, 0x3f7f9766, 0x3f7f74c3,
+    0x3f7f4d32, 0x3f7f20b3, 0x3f7eef48, 0x3f7eb8f4, 0x3f7e7db8, 0x3f7e3d97, 0x3f7df893, 0x3f7daeaf,
+    0x3f7d5fee, 0x3f7d0c52, 0x3f7cb3df, 0x3f7c5699, 0x3f7bf483, 0x3f7b8da1, 0x3f7b21f6, 0x3f7ab188,
+    0x3f7a3c5a, 0x3f79c270, 0x3f7943d1, 0x3f78c080, 0x3f783882, 0x3f77abdd, 0x3f771a97, 0x3f7684b4,
+    0x3f75ea3b, 0x3f754b32, 0x3f74a79e, 0x3f73ff87, 0x3f7352f3, 0x3f72a1e7, 0x3f71ec6c, 0x3f713289,
+    0x3f707443, 0x3f6fb1a4, 0x3f6eeab2, 0x3f6e1f74, 0x3f6d4ff4, 0x3f6c7c39, 0x3f6ba44a, 0x3f6ac831,
+    0x3f69e7f7, 0x3f6903a2, 0x3f681b3e, 0x3f672ed2, 0x3f663e67, 0x3f654a07, 0x3f6451bc, 0x3f63558f,
+    0x3f62558a, 0x3f6151b6, 0x3f604a1e, 0x3f5f3ecc, 0x3f5e2fcb, 0x3f5d1d24, 0x3f5c06e2, 0x3f5aed11,
+    0x3f59cfbb, 0x3f58aeeb, 0x3f578aac, 0x3f56630a, 0x3f553810, 0x3f5409c9, 0x3f52d842, 0x3f51a386,
+    0x3f506ba2, 0x3f4f30a0, 0x3f4df28e, 0x3f4cb177, 0x3f4b6d69, 0x3f4a266f, 0x3f48dc96, 0x3f478fec,
+    0x3f46407c, 0x3f44ee55, 0x3f439982, 0x3f424212, 0x3f40e811, 0x3f3f8b8d, 0x3f3e2c94, 0x3f3ccb32,
+    0x3f3b6776, 0x3f3a016e, 0x3f389927, 0x3f372eaf, 0x3f35c214, 0x3f345365, 0x3f32e2af, 0x3f317001,
+    0x3f2ffb69, 0x3f2e84f6, 0x3f2d0cb6, 0x3f2b92b7, 0x3f2a1709, 0x3f2899b9, 0x3f271ad8, 0x3f259a73,
+    0x3f241899, 0x3f22955a, 0x3f2110c4, 0x3f1f8ae6, 0x3f1e03d0, 0x3f1c7b91, 0x3f1af237, 0x3f1967d3,
+    0x3f17dc72, 0x3f165025, 0x3f14c2fc, 0x3f133504, 0x3f11a64e, 0x3f1016e9, 0x3f0e86e5, 0x3f0cf651,
+    0x3f0b653c, 0x3f09d3b7, 0x3f0841d0, 0x3f06af97, 0x3f051d1d, 0x3f038a6f, 0x3f01f79e, 0x3f0064ba,
+    0x3efda3a4, 0x3efa7dec, 0x3ef7586a, 0x3ef4333d, 0x3ef10e86, 0x3eedea63, 0x3eeac6f2, 0x3ee7a455,
+    0x3ee482a8, 0x3ee1620c, 0x3ede429f, 0x3edb2480, 0x3ed807cf, 0x3ed4ecaa, 0x3ed1d32f, 0x3ecebb7e,
+    0x3ecba5b5, 0x3ec891f3, 0x3ec58056, 0x3ec270fd, 0x3ebf6406, 0x3ebc598e, 0x3eb951b5, 0x3eb64c99,
+    0x3eb34a56, 0x3eb04b0c, 0x3ead4ed8, 0x3eaa55d6, 0x3ea76026, 0x3ea46de3, 0x3ea17f2c, 0x3e9e941e,
+    0x3e9bacd4, 0x3e98c96d, 0x3e95ea04, 0x3e930eb6, 0x3e9037a0, 0x3e8d64dd, 0x3e8a968a, 0x3e87ccc2,
+    0x3e8507a1, 0x3e824743, 0x3e7f1784, 0x3e79aa74, 0x3e74478b, 0x3e6eeeff, 0x3e69a105, 0x3e645dd0,
+    0x3e5f2596, 0x3e59f88a, 0x3e54d6df, 0x3e4fc0c8, 0x3e4ab678, 0x3e45b820, 0x3e40c5f2, 0x3e3be01f,
+    0x3e3706d7, 0x3e323a4b, 0x3e2d7aab, 0x3e28c824, 0x3e2422e6, 0x3e1f8b1e, 0x3e1b00fb, 0x3e1684a9,
+    0x3e121654, 0x3e0db62a, 0x3e096453, 0x3e0520fd, 0x3e00ec51, 0x3df98cef, 0x3df15f37, 0x3de94fc9,
+    0x3de15ef5, 0x3dd98d0a, 0x3dd1da56, 0x3dca4724, 0x3dc2d3c0, 0x3dbb8073, 0x3db44d87, 0x3dad3b42,
+    0x3da649eb, 0x3d9f79c6, 0x3d98cb17, 0x3d923e20, 0x3d8bd322, 0x3d858a5c, 0x3d7ec81a, 0x3d72c0e4,
+    0x3d66ff8d, 0x3d5b8488, 0x3d505049, 0x3d45633d, 0x3d3abdd2, 0x3d306070, 0x3d264b7e, 0x3d1c7f61,
+    0x3d12fc79, 0x3d09c324, 0x3d00d3bf, 0x3cf05d41, 0x3cdfa83e, 0x3ccf891c, 0x3cc00079, 0x3cb10eef,
+    0x3ca2b513, 0x3c94f373, 0x3c87ca96, 0x3c767600, 0x3c5e8a59, 0x3c47d325, 0x3c325144, 0x3c1e058c,
+    0x3c0af0c6, 0x3bf2275e, 0x3bd0ddef, 0x3bb2068a, 0x3b95a260, 0x3b776514, 0x3b487014, 0x3b1e6790,
+    0x3af29a52, 0x3ab2449b, 0x3a77a0f6, 0x3a1e8019, 0x39b25423, 0x391e863b, 0x381e87c4, 0x00000000
+};
+
+/* Generated mel filter points (_K23) */
+static const uint32_t base_mel_points[] = {
+    0x000d0009, 0x00150010, 0x001f0019, 0x002b0025, 0x003a0032, 0x004d0043, 0x00630057, 0x007f0071,
+    0x00a20090, 0x00cc00b6, 0x010000e5
+};
+
+static int failures;
+static baseline_t base;
+static capture_t base_out;
+static capture_t shared_out;
+static logmel_t frontend;
+static logmel_scratch_t scratch;
+static float window_frames[BASE_WINDOW_FRAMES][LOGMEL_BANDS];
+static int window_fill;
+static int16_t pcm[CLIP_SAMPLES];
+static float samples[CLIP_SAMPLES];
+
+/*******************************************************************************
+* Generated code (ImagiNet Compiler), the fixwin handle typed, kernels unchanged
+*******************************************************************************/
+static inline void cbuffer_init(cbuffer_t *dest, void *mem, int size) {
+	dest->buf = mem;
+	dest->size = size;
+	dest->used = 0;
+	dest->read = 0;
+	dest->write = 0;
+}
+
+static inline int cbuffer_get_free(cbuffer_t *buf) {
+	return buf->size - buf->used;
+}
+
+static inline int cbuffer_get_used(cbuffer_t *buf) {
+	return buf->used;
+}
+
+static inline int cbuffer_enqueue(cbuffer_t *buf, const void *data, int data_size) {
+	int free = cbuffer_get_free(buf);
+
+	if (free < data_size)
+		return CBUFFER_NOMEM;
+
+	if (buf->write + data_size > buf->size) {
+		int first_size = buf->size - buf->write;
+		memcpy(buf->buf + buf->write, data, first_size);
+		memcpy(buf->buf, ((char *)data) + first_size, data_size - first_size);
+	}
+	else {
+		memcpy(buf->buf + buf->write, data, data_size);
+	}
+	buf->write += data_size;
+	if (buf->write >= buf->size)
+		buf->write -= buf->size;
+
+	buf->used += data_size;
+	return CBUFFER_SUCCESS;
+}
+
+static inline int cbuffer_advance(cbuffer_t *buf, int count) {
+	int used = cbuffer_get_used(buf);
+
+	if (count > used)
+		return CBUFFER_NOMEM;
+
+	buf->read += count;
+	if (buf->read >= buf->size)
+		buf->read -= buf->size;
+
+	if (buf->read == buf->write) {
+		buf->read = 0;
+		buf->write = 0;
+	}
+
+	buf->used -= count;
+	return CBUFFER_SUCCESS;
+}
+
+static inline int cbuffer_copyto(cbuffer_t *buf, void *dst, int count, int offset) {
+
+	if (count > cbuffer_get_used(buf))
+		return CBUFFER_NOMEM;
+
+	int a0 = buf->read + offset;
+	if (a0 >= buf->size)
+		a0 -= buf->size;
+
+	int c0 = count;
+	if (a0 + c0 > buf->size)
+		c0 = buf->size - a0;
+
+	memcpy(dst, buf->buf + a0, c0);
+
+	int c1 = count - c0;
+
+	if (c1 > 0)
+		memcpy(((char *)dst) + c0, buf->buf, c1);
+
+	return CBUFFER_SUCCESS;
+}
+
+static inline void fixwin_init(fixwin_t* fep, void* mem, int input_size, int count)
+{
+	fep->input_size = input_size;
+	cbuffer_init(&fep->data_buffer, mem, input_size * count);
+}
+
+static inline int fixwin_enqueue(fixwin_t* fep, const void* restrict data)
+{
+	if (cbuffer_enqueue(&fep->data_buffer, data, fep->input_size) != 0)
+		return IPWIN_RET_ERROR;
+
+	return IPWIN_RET_SUCCESS;
+}
+
+static inline int fixwin_dequeue(fixwin_t* fep, void* restrict dst, int count, int stride_count)
+{
+	const int stride_bytes = stride_count * fep->input_size;
+	const int size = count * fep->input_size;
+	if (cbuffer_get_used(&fep->data_buffer) >= size) {
+		if (cbuffer_copyto(&fep->data_buffer, dst, size, 0) != 0)
+			return IPWIN_RET_ERROR;
+
+		if (cbuffer_advance(&fep->data_buffer, stride_bytes) != 0)
+			return IPWIN_RET_ERROR;
+
+		return IPWIN_RET_SUCCESS;
+	}
+	return IPWIN_RET_NODATA;
+}
+
+static inline void hannmul_f32(const float* restrict input, const float* restrict w, int d0, int d1, int d2, float* restrict output)
+{
+	const int d3 = d0 * d1;
+
+	const float* ip = input;
+	float* op = output;
+
+	for (int j = 0; j < d2; j++) {
+		for (int i = 0; i < d0; i++) {
+			for (int k = 0; k < d1; k++) {
+				op[k * d0 + i] = ip[k * d0 + i] * w[k];
+			}
+		}
+
+		ip += d3;
+		op += d3;
+	}
+}
+
+static inline void rfft_libfft_f32(
+    const float* restrict input,
+    float* restrict output,
+    int d0, int d1, int d2,
+    int32_t* restrict temp_ip, float* restrict temp_w, float* restrict temp_a)
+{
+    int d3 = d0 * d1;
+    int d_out = (d1 >> 1) + 1;
+
+    for (int k = 0; k < d2; k++)
+    {
+        int dk = k * d3;
+        int dm = k * 2 * d_out * d0;
+        for (int i = 0; i < d0; i++)
+        {
+            for (int j = 0; j < d1; j++)
+            {
+                temp_a[j] = input[dk + j * d0 + i];
+            }
+            rdft_f32(d1, 1, temp_a, (int *)temp_ip, temp_w);
+
+            for (int m = 2; m < d1; m+=2)
+            {
+                int index = (m * d0) + 2 * i + dm;
+                output[index] = temp_a[m];
+                output[index + 1] = -temp_a[m + 1];
+            }
+            int beta = dm + 2 * i;
+            output[beta] = temp_a[0];
+            output[beta + 1] = 0;
+            output[beta + d3] = temp_a[1];
+            output[beta + d3 + 1] = 0;
+        }
+    }
+}
+
+static inline float __norm_sqrt_sum_f32(const float* restrict input, int count)
+{
+	float sum = 0;
+	for (int j = 0; j < count; j++) {
+		float item = *input++;
+		sum += item * item;
+	}
+	return sqrtf(sum);
+}
+
+static inline void norm_f32(const float* restrict input, int d1, int d2, float* restrict output)
+{
+	for (int k = 0; k < d2; k++) {
+		*output++ = __norm_sqrt_sum_f32(input, d1);
+		input += d1;
+	}
+}
+
+static inline float __mel_f32(const float* restrict input, const short* restrict filter_points, int filter)
+{
+	short n0 = filter_points[filter];
+	short n1 = filter_points[filter+1];
+	short n2 = filter_points[filter+2];
+	short c0 = n1 - n0;
+	short c1 = n2 - n1;
+	float sum = 0;
+
+	for (int i = 0; i <= c0; i++) {
+		float rate = i / (float)c0;
+		float value = input[i + n0];
+		sum += value * rate;
+	}
+
+	for (int i = 1; i <= c1; i++) {
+		float rate = i / (float)c1;
+		float value = input[i + n1];
+		sum += value * (1.0 - rate);
+	}
+
+	return sum;
+}
+
+static inline void mel_f32(const float* restrict input, const short* restrict filter_points, int size, int slot, int num_filter, float* restrict output)
+{
+	for (int k = 0; k < slot; k++) {
+		const float *ip = input + k * size;
+		for (int i = 0; i < num_filter; i++) {
+			*output++ = __mel_f32(ip, filter_points, i);
+		}
+	}
+}
+
+static inline void clip_f32(const float* restrict input, int count, float min, float max, float* restrict output)
+{
+	for (int i = 0; i < count; i++) {
+		float value = input[i];
+		if (value > max)
+			value = max;
+		if (value < min)
+			value = min;
+
+		output[i] = value;
+	}
+}
+
+static inline void ln_f32(const float* restrict x, int count, float* restrict result)
+{
+	for (int i = 0; i < count; i++) {
+		*result++ = logf(*x++);
+	}
+}
+
+/*******************************************************************************
+* Baseline model front end
+*******************************************************************************/
+
+static void baseline_init(baseline_t* b)
+{
+    memset(b, 0, sizeof(*b));
+    fixwin_init(&b->sample_win, b->sample_mem, sizeof(float), BASE_FFT_SIZE);
+    fixwin_init(&b->frame_win, b->frame_mem, BASE_BANDS * sizeof(float), BASE_WINDOW_FRAMES);
+}
+
+/* IMAI_enqueue() */
+static int baseline_enqueue(baseline_t* b, const float* sample)
+{
+    return fixwin_enqueue(&b->sample_win, sample);
+}
+
+/* IMAI_dequeue() up to the model input, every computed frame is recorded */
+static int baseline_dequeue(baseline_t* b, float* window)
+{
+    while (1)
+    {
+        int ret = fixwin_dequeue(&b->sample_win, b->samples, BASE_FFT_SIZE, BASE_HOP_SIZE);
+        if (IPWIN_RET_NODATA == ret)
+        {
+            break;
+        }
+        if (ret < 0)
+        {
+            return ret;
+        }
+        hannmul_f32(b->samples, (const float*)base_hann, 1, BASE_FFT_SIZE, 1, b->windowed);
+        rfft_libfft_f32(b->windowed, b->spectrum, 1, BASE_FFT_SIZE, 1, b->fft_ip, b->fft_w, b->fft_work);
+        norm_f32(b->spectrum, 2, BASE_BINS, b->magnitude);
+        mel_f32(b->magnitude, (const short*)base_mel_points, BASE_BINS, 1, BASE_BANDS, b->mel);
+        clip_f32(b->mel, BASE_BANDS, 0.000316227766016, 3.40282347E+38, b->clipped);
+        ln_f32(b->clipped, BASE_BANDS, b->frame);
+        ret = fixwin_enqueue(&b->frame_win, b->frame);
+        if (base_out.frames < MAX_FRAMES)
+        {
+            memcpy(base_out.frame[base_out.frames++], b->frame, sizeof(b->frame));
+        }
+        if (IPWIN_RET_NODATA == ret)
+        {
+            break;
+        }
+        if (ret < 0)
+        {
+            return ret;
+        }
+    }
+    return fixwin_dequeue(&b->frame_win, window, BASE_WINDOW_FRAMES, BASE_WINDOW_STRIDE);
+}
+
+/*******************************************************************************
+* Shared front end consumer, windows the frames like the model would
+*******************************************************************************/
+
+static int shared_push(void* arg, const float* frame)
+{
+    (void)arg;
+    if (shared_out.frames < MAX_FRAMES)
+    {
+        memcpy(shared_out.frame[shared_out.frames++], frame, LOGMEL_BANDS * sizeof(float));
+    }
+    if (BASE_WINDOW_FRAMES == window_fill)
+    {
+        memmove(window_frames[0], window_frames[1], (BASE_WINDOW_FRAMES - 1) * sizeof(window_frames[0]));
+        window_fill--;
+    }
+    memcpy(window_frames[window_fill++], frame, sizeof(window_frames[0]));
+    return 0;
+}
+
+static void shared_window(void* arg)
+{
+    (void)arg;
+    if (shared_out.windows < MAX_WINDOWS)
+    {
+        /* The window completes with the frame just pushed */
+        shared_out.window_sample[shared_out.windows] = BASE_FFT_SIZE + (shared_out.frames - 1) * BASE_HOP_SIZE;
+        memcpy(shared_out.window[shared_out.windows++], window_frames, sizeof(window_frames));
+    }
+}
+
+/*******************************************************************************
+* Test clips
+*******************************************************************************/
+
+static int16_t to_pcm(double value)
+{
+    value = round(value * 32767.0);
+    return (int16_t)((value > 32767.0) ? 32767.0 : (value < -32768.0) ? -32768.0 : value);
+}
+
+static void clip_silence(int16_t* out, int count)
+{
+    memset(out, 0, (size_t)count * sizeof(int16_t));
+}
+
+static void clip_sweep(int16_t* out, int count)
+{
+    const double f0 = 100.0, f1 = 7000.0;
+    const double duration = (double)count / LOGMEL_SAMPLE_RATE;
+    const double k = log(f1 / f0);
+
+    for (int i = 0; i < count; i++)
+    {
+        double t = (double)i / LOGMEL_SAMPLE_RATE;
+        out[i] = to_pcm(0.3 * sin(2.0 * M_PI * f0 * duration / k * (exp(t * k / duration) - 1.0)));
+    }
+}
+
+static void clip_noise(int16_t* out, int count)
+{
+    uint32_t state = 12345u;
+
+    for (int i = 0; i < count; i++)
+    {
+        out[i] = (int16_t)(next_random(&state) >> 8);
+    }
+}
+
+static void clip_bursts(int16_t* out, int count)
+{
+    uint32_t state = 777u;
+
+    /* Tone bursts over low noise, on and off every 0.25 s */
+    for (int i = 0; i < count; i++)
+    {
+        double noise = ((double)next_random(&state) / (double)(1u << 24) - 0.5) * 0.002;
+        double tone = ((i / 4000) & 1) ? 0.2 * sin(2.0 * M_PI * 450.0 * i / LOGMEL_SAMPLE_RATE) : 0.0;
+        out[i] = to_pcm(tone + noise);
+    }
+}
+
+static const clip_t clips[] =
+{
+    { "silence", clip_silence },
+    { "sweep",   clip_sweep },
+    { "noise",   clip_noise },
+    { "bursts",  clip_bursts },
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void test_clip(const clip_t* clip)
+{
+    static const int chunks[] = { 1, 160, 7, 512, 333, 64, 1000 };
+    static float window[BASE_WINDOW_FRAMES * BASE_BANDS];
+    logmel_consumer_t consumer =
+    {
+        .name = clip->name,
+        .window_frames = BASE_WINDOW_FRAMES,
+        .window_stride = BASE_WINDOW_STRIDE,
+        .push = shared_push,
+        .window = shared_window,
+    };
+    double max_error = 0.0;
+    int chunk = 0;
+
+    clip->generate(pcm, CLIP_SAMPLES);
+    for (int i = 0; i < CLIP_SAMPLES; i++)
+    {
+        samples[i] = (float)pcm[i] / 32768.0f;
+    }
+
+    /* Baseline, one sample at a time like the application fed the model */
+    memset(&base_out, 0, sizeof(base_out));
+    baseline_init(&base);
+    for (int i = 0; i < CLIP_SAMPLES; i++)
+    {
+        int ret;
+
+        CHECK(IPWIN_RET_SUCCESS == baseline_enqueue(&base, &samples[i]), "%s: baseline enqueue", clip->name);
+        ret = baseline_dequeue(&base, window);
+        if (IPWIN_RET_SUCCESS == ret)
+        {
+            base_out.window_sample[base_out.windows] = i + 1;
+            memcpy(base_out.window[base_out.windows++], window, sizeof(window));
+        }
+        else
+        {
+            CHECK(IPWIN_RET_NODATA == ret, "%s: baseline dequeue %d", clip->name, ret);
+        }
+    }
+
+    /* Shared front end, in irregular chunks */
+    memset(&shared_out, 0, sizeof(shared_out));
+    window_fill = 0;
+    logmel_init(&frontend, &scratch);
+    CHECK(LOGMEL_RET_SUCCESS == logmel_add_consumer(&frontend, &consumer), "%s: consumer", clip->name);
+    for (int i = 0; i < CLIP_SAMPLES; )
+    {
+        int n = chunks[chunk++ % (int)(sizeof(chunks) / sizeof(chunks[0]))];
+        if (n > CLIP_SAMPLES - i)
+        {
+            n = CLIP_SAMPLES - i;
+        }
+        logmel_process(&frontend, &samples[i], n);
+        i += n;
+    }
+
+    CHECK(shared_out.frames == base_out.frames, "%s: %d frames, baseline %d", clip->name, shared_out.frames,
+          base_out.frames);
+    for (int f = 0; (f < shared_out.frames) && (f < base_out.frames); f++)
+    {
+        for (int b = 0; b < LOGMEL_BANDS; b++)
+        {
+            double error = fabs((double)shared_out.frame[f][b] - (double)base_out.frame[f][b]);
+            if (error > max_error)
+            {
+                max_error = error;
+            }
+            if (0 != memcmp(&shared_out.frame[f][b], &base_out.frame[f][b], sizeof(float)))
+            {
+                CHECK(0, "%s: frame %d bin %d: %.9g, baseline %.9g", clip->name, f, b,
+                      (double)shared_out.frame[f][b], (double)base_out.frame[f][b]);
+                f = shared_out.frames;
+                break;
+            }
+        }
+    }
+
+    CHECK(shared_out.windows == base_out.windows, "%s: %d windows, baseline %d", clip->name, shared_out.windows,
+          base_out.windows);
+    for (int w = 0; (w < shared_out.windows) && (w < base_out.windows); w++)
+    {
+        CHECK(shared_out.window_sample[w] == base_out.window_sample[w], "%s: window %d after sample %d, baseline %d",
+              clip->name, w, (int)shared_out.window_sample[w], (int)base_out.window_sample[w]);
+        CHECK(0 == memcmp(shared_out.window[w], base_out.window[w], sizeof(shared_out.window[w])),
+              "%s: window %d differs", clip->name, w);
+    }
+
+    printf("%-8s frames %d, windows %d, largest difference %g\n", clip->name, shared_out.frames, shared_out.windows,
+           max_error);
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(clips) / sizeof(clips[0]); i++)
+    {
+        test_clip(&clips[i]);
+    }
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,295 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cybsp.h"
+#include "mtb_ml.h"
+#include "host_platform.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Quantization of the mock. The input side only scales the quantized window,
+ * the output side maps -128..127 to 0..1 like an int8 softmax. */
+#define HOST_ML_INPUT_SCALE         (0.1f)
+#define HOST_ML_INPUT_ZERO_POINT    (0)
+#define HOST_ML_OUTPUT_SCALE        (1.0f / 256.0f)
+#define HOST_ML_OUTPUT_ZERO_POINT   (-128)
+
+#define HOST_ML_LINE_SIZE           (256)
+
+/* Right shift of the probe sums into the int8 output range */
+#define HOST_ML_PROBE_SHIFT         (6)
+
+/* Largest input of the probe */
+#define HOST_ML_PROBE_INPUT_MAX     (4096)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* cycle_counter.h counts nanoseconds on the host */
+uint32_t SystemCoreClock = 1000000000u;
+
+static mtb_ml_model_t host_models[HOST_ML_MAX_MODELS];
+static int host_model_used[HOST_ML_MAX_MODELS];
+
+/* Recorded outputs, rows of MTB_ML_MODEL_OUTPUT_MAX values */
+static int8_t* recorded;
+static int recorded_rows;
+static int recorded_cols;
+
+/* Input values of the linear probe, 0 when not used */
+static int probe_input_count;
+
+/* Input of the last probe run */
+static MTB_ML_DATA_T probe_last_input[HOST_ML_PROBE_INPUT_MAX];
+
+/* mtb_ml_init() fails, for the error paths of the model init */
+static int runtime_init_fails;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: host_ml_load_outputs
+********************************************************************************
+* Summary:
+*  Loads the recorded model outputs replayed by mtb_ml_model_run().
+*
+* Parameters:
+*  path: text file, one line of comma separated int8 values per inference
+*
+* Return:
+*  HOST_PLATFORM_RET_SUCCESS or HOST_PLATFORM_RET_ERROR
+*
+*******************************************************************************/
+int host_ml_load_outputs(const char* path)
+{
+    char line[HOST_ML_LINE_SIZE];
+    FILE* f = fopen(path, "r");
+
+    if (NULL == f)
+    {
+        return HOST_PLATFORM_RET_ERROR;
+    }
+
+    host_ml_free_outputs();
+    while (NULL != fgets(line, sizeof(line), f))
+    {
+        int8_t row[MTB_ML_MODEL_OUTPUT_MAX];
+        int cols = 0;
+        char* p = line;
+        char* end;
+
+        while (cols < MTB_ML_MODEL_OUTPUT_MAX)
+        {
+            long value = strtol(p, &end, 10);
+            if (end == p)
+            {
+                break;
+            }
+            row[cols++] = (int8_t)((value > 127) ? 127 : (value < -128) ? -128 : value);
+            p = end + strspn(end, ", \t");
+        }
+        if (0 == cols)
+        {
+            continue;
+        }
+        if ((0 != recorded_cols) && (cols != recorded_cols))
+        {
+            fclose(f);
+            host_ml_free_outputs();
+            return HOST_PLATFORM_RET_ERROR;
+        }
+
+        int8_t* grown = realloc(recorded, (size_t)(recorded_rows + 1) * MTB_ML_MODEL_OUTPUT_MAX);
+        if (NULL == grown)
+        {
+            fclose(f);
+            host_ml_free_outputs();
+            return HOST_PLATFORM_RET_ERROR;
+        }
+        recorded = grown;
+        memcpy(&recorded[recorded_rows * MTB_ML_MODEL_OUTPUT_MAX], row, (size_t)cols);
+        recorded_cols = cols;
+        recorded_rows++;
+    }
+    fclose(f);
+
+    return (0 != recorded_rows) ? HOST_PLATFORM_RET_SUCCESS : HOST_PLATFORM_RET_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: host_ml_free_outputs
+********************************************************************************
+* Summary:
+*  Drops the recorded outputs.
+*
+*******************************************************************************/
+void host_ml_free_outputs(void)
+{
+    free(recorded);
+    recorded = NULL;
+    recorded_rows = 0;
+    recorded_cols = 0;
+}
+
+/*******************************************************************************
+* Function Name: host_ml_set_probe
+********************************************************************************
+* Summary:
+*  Makes mtb_ml_model_run() compute a fixed random linear probe of the input
+*  window instead of replaying outputs.
+*
+* Parameters:
+*  input_count: int8 values of the model input, 0 to disable the probe
+*
+*******************************************************************************/
+void host_ml_set_probe(int input_count)
+{
+    probe_input_count = (input_count < HOST_ML_PROBE_INPUT_MAX) ? input_count : HOST_ML_PROBE_INPUT_MAX;
+}
+
+/*******************************************************************************
+* Function Name: host_ml_fail_runtime_init
+********************************************************************************
+* Summary:
+*  Makes mtb_ml_init() fail, as a runtime or NPU that does not come up would.
+*
+* Parameters:
+*  fail: nonzero to fail, 0 to succeed again
+*
+*******************************************************************************/
+void host_ml_fail_runtime_init(int fail)
+{
+    runtime_init_fails = fail;
+}
+
+/*******************************************************************************
+* Function Name: host_ml_last_input
+********************************************************************************
+* Summary:
+*  Input of the last mtb_ml_model_run() with the probe, the int8 window the
+*  model would have classified.
+*
+* Return:
+*  The input_count values of host_ml_set_probe()
+*
+*******************************************************************************/
+const int8_t* host_ml_last_input(void)
+{
+    return probe_last_input;
+}
+
+/*******************************************************************************
+* Function Name: host_ml_probe
+********************************************************************************
+* Summary:
+*  Output k is the sum of the inputs with a pseudo random sign per input and
+*  output, scaled into the int8 range.
+*
+*******************************************************************************/
+static void host_ml_probe(const MTB_ML_DATA_T* input, MTB_ML_DATA_T* output)
+{
+    for (int k = 0; k < MTB_ML_MODEL_OUTPUT_MAX; k++)
+    {
+        uint32_t seed = 0x9E3779B9u * (uint32_t)(k + 1);
+        int32_t sum = 0;
+
+        for (int i = 0; i < probe_input_count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            sum += (0 != (seed & 0x80000000u)) ? input[i] : -input[i];
+        }
+        sum >>= HOST_ML_PROBE_SHIFT;
+        output[k] = (MTB_ML_DATA_T)((sum > INT8_MAX) ? INT8_MAX : (sum < INT8_MIN) ? INT8_MIN : sum);
+    }
+}
+
+cy_rslt_t mtb_ml_init(int npu_priority)
+{
+    (void)npu_priority;
+    return (0 != runtime_init_fails) ? (cy_rslt_t)HOST_PLATFORM_RET_ERROR : CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_deinit(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_init(const mtb_ml_model_bin_t* bin, const mtb_ml_model_buffer_t* buffer,
+                            mtb_ml_model_t** object)
+{
+    int slot = 0;
+
+    while ((slot < HOST_ML_MAX_MODELS) && (0 != host_model_used[slot]))
+    {
+        slot++;
+    }
+    if ((NULL == bin) || (NULL == bin->model_bin) || (NULL == buffer) || (NULL == object) ||
+        (HOST_ML_MAX_MODELS == slot))
+    {
+        return (cy_rslt_t)HOST_PLATFORM_RET_ERROR;
+    }
+
+    mtb_ml_model_t* model = &host_models[slot];
+    memset(model, 0, sizeof(*model));
+    model->input_scale = HOST_ML_INPUT_SCALE;
+    model->input_zero_point = HOST_ML_INPUT_ZERO_POINT;
+    model->output_scale = HOST_ML_OUTPUT_SCALE;
+    model->output_zero_point = HOST_ML_OUTPUT_ZERO_POINT;
+    model->output = model->output_data;
+    model->output_size = MTB_ML_MODEL_OUTPUT_MAX;
+    host_model_used[slot] = 1;
+
+    *object = model;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_deinit(mtb_ml_model_t* object)
+{
+    if ((object >= host_models) && (object < &host_models[HOST_ML_MAX_MODELS]))
+    {
+        host_model_used[object - host_models] = 0;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mtb_ml_model_run
+********************************************************************************
+* Summary:
+*  Mock inference: runs the probe, copies the next recorded output row,
+*  repeating the last row once the recording is exhausted, or reports the
+*  first class.
+*
+*******************************************************************************/
+cy_rslt_t mtb_ml_model_run(mtb_ml_model_t* object, MTB_ML_DATA_T* input)
+{
+    if (0 != probe_input_count)
+    {
+        memcpy(probe_last_input, input, (size_t)probe_input_count);
+        host_ml_probe(input, object->output_data);
+    }
+    else if (0 != recorded_rows)
+    {
+        int row = ((int)object->runs < recorded_rows) ? (int)object->runs : recorded_rows - 1;
+        memset(object->output_data, HOST_ML_OUTPUT_ZERO_POINT, sizeof(object->output_data));
+        memcpy(object->output_data, &recorded[row * MTB_ML_MODEL_OUTPUT_MAX], (size_t)recorded_cols);
+    }
+    else
+    {
+        memset(object->output_data, HOST_ML_OUTPUT_ZERO_POINT, sizeof(object->output_data));
+        object->output_data[0] = INT8_MAX;
+    }
+    object->runs++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host platform of the audio pipeline: the cycle counter clock and a mock of
+ * the ML runtime.
+ *
+ * The mock does not evaluate the network. Every mtb_ml_model_run() returns
+ * the next row of a recorded output file (one line of comma separated int8
+ * output values per inference, e.g. logged on the target or produced by a
+ * TFLite reference run of the exported model). Without a recording every
+ * inference returns the first class with full confidence.
+ *
+ * For regression tests the mock can instead act as a fixed random linear
+ * probe of the quantized input window, so the outputs follow every change of
+ * the features and of the input quantization. host_ml_last_input() returns
+ * the window of the last probe run.
+ *
+ * Up to four model instances can be initialized at the same time, each with
+ * its own output and run count.
+ */
+
+#ifndef HOST_PLATFORM_H_
+#define HOST_PLATFORM_H_
+
+#include <stdint.h>
+
+#define HOST_PLATFORM_RET_SUCCESS   (0)
+#define HOST_PLATFORM_RET_ERROR     (-2)
+
+/* Model instances initialized at the same time */
+#define HOST_ML_MAX_MODELS          (4)
+
+int  host_ml_load_outputs(const char* path);
+void host_ml_free_outputs(void);
+void host_ml_set_probe(int input_count);
+void host_ml_fail_runtime_init(int fail);
+const int8_t* host_ml_last_input(void);
+
+#endif /* HOST_PLATFORM_H_ */
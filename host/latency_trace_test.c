@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the latency statistics, shared/log/latency_trace.h.
+ *
+ * Checks the capture time derived from a sample, across a wrap of the
+ * clock, the hops and the total of a trace, that a negative hop between the
+ * clocks of the cores counts as 0, that an unsynchronized trace is ignored
+ * and the percentiles against a known distribution. Exits with 1 on
+ * failure.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "latency_trace.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void make_trace(latency_trace_t* trace, uint32_t start_ms, const uint32_t hops[LATENCY_HOP_TOTAL])
+{
+    memset(trace, 0, sizeof(*trace));
+    trace->synced = true;
+    trace->stamps[0] = start_ms;
+    for (uint32_t i = 0; i < LATENCY_HOP_TOTAL; i++)
+    {
+        trace->stamps[i + 1u] = trace->stamps[i] + hops[i];
+    }
+}
+
+static void test_capture(void)
+{
+    /* A 1024 sample frame complete at 5000 ms, the window ends 160 samples
+     * before its end: 10 ms earlier at 16 kHz */
+    CHECK(4990u == latency_capture_ms(5000u, 20480u, 20320u, 16000u), "capture %lu",
+          (unsigned long)latency_capture_ms(5000u, 20480u, 20320u, 16000u));
+    CHECK(5000u == latency_capture_ms(5000u, 20480u, 20480u, 16000u), "capture at the frame end");
+
+    /* Both counters wrapped */
+    CHECK(UINT32_MAX - 9u == latency_capture_ms(0u, 100u, (uint32_t)(100u - 160u), 16000u),
+          "capture across the wrap");
+}
+
+static void test_hops(void)
+{
+    static const uint32_t hops[LATENCY_HOP_TOTAL] = { 60u, 3u, 2u, 1u, 1200u, 150u };
+    latency_stats_t stats;
+    latency_summary_t summary[LATENCY_HOP_COUNT];
+    latency_trace_t trace;
+
+    latency_stats_reset(&stats);
+    make_trace(&trace, UINT32_MAX - 100u, hops);
+    latency_stats_record(&stats, &trace);
+
+    /* The CM55 clock a millisecond ahead of the CM33 clock */
+    trace.stamps[LATENCY_STAMP_RECEIVED] = trace.stamps[LATENCY_STAMP_RESULT] - 1u;
+    latency_stats_record(&stats, &trace);
+
+    trace.synced = false;
+    latency_stats_record(&stats, &trace);
+
+    latency_stats_summarize(&stats, summary);
+    CHECK(2u == summary[LATENCY_HOP_TOTAL].count, "%lu traces recorded", (unsigned long)summary[LATENCY_HOP_TOTAL].count);
+    CHECK(1416u == summary[LATENCY_HOP_TOTAL].max, "total %lu", (unsigned long)summary[LATENCY_HOP_TOTAL].max);
+    /* 1200 and 1202 ms, the second trace arrived 2 ms earlier */
+    CHECK(1201u == summary[LATENCY_HOP_REPORT].mean, "report %lu", (unsigned long)summary[LATENCY_HOP_REPORT].mean);
+    CHECK(0u == summary[LATENCY_HOP_IPC].min, "negative hop %lu", (unsigned long)summary[LATENCY_HOP_IPC].min);
+    CHECK(1u == summary[LATENCY_HOP_IPC].max, "ipc %lu", (unsigned long)summary[LATENCY_HOP_IPC].max);
+}
+
+static void test_percentiles(void)
+{
+    latency_stats_t stats;
+    latency_summary_t summary[LATENCY_HOP_COUNT];
+    latency_trace_t trace;
+
+    /* Report waits of 1 to 1000 ms */
+    latency_stats_reset(&stats);
+    for (uint32_t ms = 1u; ms <= 1000u; ms++)
+    {
+        const uint32_t hops[LATENCY_HOP_TOTAL] = { 0u, 0u, 0u, 0u, ms, 0u };
+        make_trace(&trace, 1000u, hops);
+        latency_stats_record(&stats, &trace);
+    }
+    latency_stats_summarize(&stats, summary);
+    latency_stats_print(&stats, printf);
+
+    /* The median 500 is a bucket bound, 990 falls into the bucket up to 1000 */
+    CHECK(500u == summary[LATENCY_HOP_REPORT].p50, "p50 %lu", (unsigned long)summary[LATENCY_HOP_REPORT].p50);
+    CHECK(1000u == summary[LATENCY_HOP_REPORT].p99, "p99 %lu", (unsigned long)summary[LATENCY_HOP_REPORT].p99);
+    CHECK(500u == summary[LATENCY_HOP_REPORT].mean, "mean %lu", (unsigned long)summary[LATENCY_HOP_REPORT].mean);
+    CHECK(0u == summary[LATENCY_HOP_FRAME].p99, "p99 of zeros %lu", (unsigned long)summary[LATENCY_HOP_FRAME].p99);
+}
+
+int main(void)
+{
+    test_capture();
+    test_hops();
+    test_percentiles();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,276 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test and benchmark of the log forwarding from the CM55 to the CM33,
+ * shared/log/log_stream.h.
+ *
+ * Checks the clock synchronization and that a forwarded record reads as on
+ * the writer core, tagged cm55 and with the time of the reader. Then one
+ * thread plays cm55_task: every pass it logs a burst of records and
+ * forwards them, as proj_cm55/log_forward.c does. Another thread plays the
+ * CM33 log task and writes the lines at the speed of the debug UART at
+ * 115200 baud. Once with a load the UART keeps up with, once with more
+ * than it can carry. Checks that every accepted record arrives once and in
+ * order, that the dropped ones are all reported and that the writer never
+ * waits for the reader. Reports the cost of a forwarded record and the
+ * longest forwarding pass. Exits with 1 on failure.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "app_log.h"
+#include "log_stream.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Reader clock ahead of the writer clock */
+#define TEST_OFFSET_MS              (7000u)
+
+/* Passes of the writer and their period, faster than cm55_task */
+#define TEST_PASSES                 (100u)
+#define TEST_PASS_US                (10000u)
+#define TEST_FORWARD_BATCH          (16u)
+
+/* Time of a byte on the UART: 10 bits at 115200 baud */
+#define TEST_UART_NS_PER_BYTE       (86806u)
+
+/* Longest pass of the writer that still counts as not waiting */
+#define TEST_MAX_PASS_US            (2000.0)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static log_stream_t stream;
+static struct timespec start;
+static volatile uint32_t fixed_ms;      /* Writer clock of the first tests */
+static volatile bool use_fixed_clock = true;
+static volatile bool writer_done;
+static int failures;
+
+static char last_line[APP_LOG_LINE_SIZE];
+static uint32_t lines;
+static uint32_t next_record;
+static uint32_t delivered_records;
+static uint32_t order_errors;
+static uint32_t reported_drops;
+static uint32_t forwarded_records;
+static bool uart_speed;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static double elapsed_us(const struct timespec* from, const struct timespec* to)
+{
+    return (double)(to->tv_sec - from->tv_sec) * 1e6 + (double)(to->tv_nsec - from->tv_nsec) / 1e3;
+}
+
+static uint32_t writer_now_ms(void)
+{
+    struct timespec now;
+
+    if (use_fixed_clock)
+    {
+        return fixed_ms;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)elapsed_us(&start, &now) / 1000u;
+}
+
+static void sleep_ns(uint64_t ns)
+{
+    struct timespec delay = { (time_t)(ns / 1000000000u), (long)(ns % 1000000000u) };
+    nanosleep(&delay, NULL);
+}
+
+/* The output of the reader: keeps the line, checks the order of the records */
+static void reader_write(const char* text, uint32_t size)
+{
+    unsigned long record;
+    unsigned long dropped;
+    const char* message = strstr(text, "cm55 ");
+
+    memcpy(last_line, text, size);
+    last_line[size] = '\0';
+    lines++;
+
+    if ((NULL != message) && (1 == sscanf(message, "cm55 I record %lu", &record)))
+    {
+        order_errors += (record < next_record);
+        delivered_records++;
+        next_record = (uint32_t)record + 1u;
+    }
+    else if ((NULL != message) && (1 == sscanf(message, "cm55 W log: %lu messages dropped", &dropped)))
+    {
+        reported_drops += (uint32_t)dropped;
+    }
+
+    if (uart_speed)
+    {
+        sleep_ns((uint64_t)size * TEST_UART_NS_PER_BYTE);
+    }
+}
+
+static void test_sync_and_format(void)
+{
+    uint32_t request;
+    char changing[16] = "dynamic";
+
+    /* Not synchronized yet: the record stays with the writer */
+    fixed_ms = 1000u;
+    app_log(APP_LOG_LEVEL_INFO, "held %d", 1);
+    CHECK(0u == app_log_forward(log_stream_write, &stream, 0u), "forwarded before the sync");
+
+    /* The reader answers from the interrupt of the request, at its time 8000 */
+    request = log_stream_sync_begin(&stream);
+    CHECK(!log_stream_sync_end(&stream, request, 1000u), "sync without an answer");
+    log_stream_sync_reply(&stream, 1000u + TEST_OFFSET_MS);
+    CHECK(log_stream_sync_end(&stream, request, 1000u), "answer not taken");
+    CHECK(TEST_OFFSET_MS == (uint32_t)stream.offset_ms, "offset %ld", (long)stream.offset_ms);
+
+    /* An answer to an old request is ignored */
+    request = log_stream_sync_begin(&stream);
+    CHECK(!log_stream_sync_end(&stream, request + 1u, 1000u), "stale answer taken");
+
+    forwarded_records = app_log_forward(log_stream_write, &stream, 0u);
+    CHECK(1u == forwarded_records, "held record not forwarded");
+    log_stream_drain(&stream, reader_write, 0u);
+    CHECK(0 == strcmp(last_line, "[    8.000] cm55 I held 1\n"), "got \"%s\"", last_line);
+
+    fixed_ms = 2500u;
+    app_log(APP_LOG_LEVEL_WARN, "label %s score %.3f", changing, 0.875);
+    forwarded_records += app_log_forward(log_stream_write, &stream, 0u);
+    strcpy(changing, "changed");
+    log_stream_drain(&stream, reader_write, 0u);
+    CHECK(0 == strcmp(last_line, "[    9.500] cm55 W label dynamic score 0.875\n"), "got \"%s\"", last_line);
+}
+
+/* cm55_task: a burst of records per pass, then the forwarding */
+static void* writer(void* arg)
+{
+    const uint32_t burst = *(const uint32_t*)arg;
+    static uint32_t record;
+    double forward_us = 0.0;
+    double worst_us = 0.0;
+    uint32_t forwarded = 0u;
+    uint32_t accepted = 0u;
+
+    for (uint32_t pass = 0; pass < TEST_PASSES; pass++)
+    {
+        struct timespec t0;
+        struct timespec t1;
+        app_log_stats_t stats;
+
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            accepted += app_log(APP_LOG_LEVEL_INFO, "record %lu", (unsigned long)record++) ? 1u : 0u;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        app_log_get_stats(&stats);
+        log_stream_report_drops(&stream, stats.dropped, writer_now_ms());
+        uint32_t n = app_log_forward(log_stream_write, &stream, TEST_FORWARD_BATCH);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        forwarded += n;
+        forwarded_records += n;
+        forward_us += elapsed_us(&t0, &t1);
+        worst_us = (elapsed_us(&t0, &t1) > worst_us) ? elapsed_us(&t0, &t1) : worst_us;
+        sleep_ns(TEST_PASS_US * 1000u);
+    }
+
+    printf("  writer: %lu records logged, %lu accepted, %.0f ns per forwarded record, longest pass %.1f us\n",
+           (unsigned long)(TEST_PASSES * burst), (unsigned long)accepted,
+           (forwarded > 0u) ? forward_us * 1000.0 / forwarded : 0.0, worst_us);
+    CHECK(worst_us < TEST_MAX_PASS_US, "a forwarding pass took %.1f us", worst_us);
+    return NULL;
+}
+
+/* The CM33 log task */
+static void* reader(void* arg)
+{
+    (void)arg;
+
+    while (!writer_done || (stream.consumed != stream.written))
+    {
+        if (0u == log_stream_drain(&stream, reader_write, 8u))
+        {
+            sleep_ns(1000000u);
+        }
+    }
+    return NULL;
+}
+
+static void run_load(const char* name, uint32_t burst, bool expect_drops)
+{
+    pthread_t threads[2];
+    app_log_stats_t before;
+    app_log_stats_t after;
+    uint32_t delivered_before = delivered_records;
+    uint32_t reported_before = reported_drops;
+
+    printf("%s: %lu records per %lu ms pass\n", name, (unsigned long)burst,
+           (unsigned long)(TEST_PASS_US / 1000u));
+    app_log_get_stats(&before);
+    writer_done = false;
+    uart_speed = true;
+    pthread_create(&threads[1], NULL, reader, NULL);
+    pthread_create(&threads[0], NULL, writer, &burst);
+    pthread_join(threads[0], NULL);
+
+    /* What is left in the app_log ring once the load is over */
+    app_log_get_stats(&after);
+    while (forwarded_records != after.logged)
+    {
+        forwarded_records += app_log_forward(log_stream_write, &stream, 0u);
+        sleep_ns(1000000u);
+    }
+    while (after.dropped != stream.reported)
+    {
+        log_stream_report_drops(&stream, after.dropped, writer_now_ms());
+        sleep_ns(1000000u);
+    }
+    writer_done = true;
+    pthread_join(threads[1], NULL);
+    uart_speed = false;
+
+    uint32_t dropped = after.dropped - before.dropped;
+    uint32_t delivered = delivered_records - delivered_before;
+    printf("  reader: %lu delivered, %lu dropped and reported\n", (unsigned long)delivered,
+           (unsigned long)(reported_drops - reported_before));
+    CHECK(after.logged - before.logged == delivered, "%lu accepted, %lu delivered",
+          (unsigned long)(after.logged - before.logged), (unsigned long)delivered);
+    CHECK(reported_drops - reported_before == dropped, "%lu dropped, %lu reported",
+          (unsigned long)dropped, (unsigned long)(reported_drops - reported_before));
+    CHECK(expect_drops == (0u != dropped), "%lu records dropped", (unsigned long)dropped);
+}
+
+int main(void)
+{
+    static const app_log_port_t port = { writer_now_ms, NULL, APP_LOG_CORE_CM55 };
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    log_stream_init(&stream);
+    app_log_init(&port, APP_LOG_LEVEL_INFO);
+
+    test_sync_and_format();
+
+    use_fixed_clock = false;
+    run_load("sustained", 1u, false);
+    run_load("overload", 8u, true);
+    CHECK(0u == order_errors, "%lu records out of order", (unsigned long)order_errors);
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,198 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of two instances of one model (imai_model.h) on the same stream.
+ *
+ * Two streams of random log-mel frames are first classified by one instance
+ * each, on its own. Then two instances of baby_cry_model with their own
+ * state and arena but one shared scratch buffer take up the two streams frame
+ * by frame, interleaved, with different strides. The host runtime acts as a
+ * linear probe of the input window, so every output depends on the window
+ * the instance cut. Each instance must produce exactly the outputs of its
+ * run on its own, and finalizing one must leave the other running. An
+ * instance whose runtime fails to come up must release its model. Exits
+ * with 1 on failure.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "baby_cry.h"
+#include "host_platform.h"
+#include "imai_model.h"
+#include "logmel.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_FRAMES                 (400)
+#define TEST_MAX_WINDOWS            (TEST_FRAMES)
+#define TEST_INSTANCES              (2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    imai_ctx_t  ctx;
+    int         stride;
+    int         windows;
+    float       scores[TEST_MAX_WINDOWS][IMAI_DATA_OUT_COUNT];
+} test_instance_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+static float frames[TEST_INSTANCES][TEST_FRAMES][LOGMEL_BANDS];
+
+static IMAI_ALIGNED(16) int8_t scratch[BABY_CRY_BUFFER_SIZE];
+static IMAI_ALIGNED(16) int8_t state[TEST_INSTANCES][BABY_CRY_STATE_SIZE];
+static IMAI_ALIGNED(16) int8_t arena[TEST_INSTANCES][BABY_CRY_ARENA_SIZE];
+
+static test_instance_t alone[TEST_INSTANCES];
+static test_instance_t together[TEST_INSTANCES];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static int instance_init(test_instance_t* inst, int index, int stride)
+{
+    memset(inst, 0, sizeof(*inst));
+    inst->stride = stride;
+    if (IMAI_MODEL_RET_SUCCESS != imai_model_init(&inst->ctx, &baby_cry_model, NULL, scratch,
+                                                  state[index], arena[index]))
+    {
+        return IMAI_MODEL_RET_ERROR;
+    }
+    inst->ctx.window_stride = stride;
+    return IMAI_MODEL_RET_SUCCESS;
+}
+
+/* Takes up one frame and classifies a complete window */
+static void instance_frame(test_instance_t* inst, const float* frame)
+{
+    int status;
+
+    CHECK(IMAI_MODEL_RET_SUCCESS == imai_model_enqueue(&inst->ctx, frame), "enqueue");
+    status = imai_model_dequeue(&inst->ctx, inst->scores[inst->windows]);
+    if (IMAI_MODEL_RET_SUCCESS == status)
+    {
+        inst->windows++;
+    }
+    else
+    {
+        CHECK(IMAI_MODEL_RET_NODATA == status, "dequeue: %d", status);
+    }
+}
+
+static void test_instances(void)
+{
+    const int strides[TEST_INSTANCES] = { BABY_CRY_WINDOW_STRIDE, 7 };
+
+    /* Each stream on an instance of its own */
+    for (int i = 0; i < TEST_INSTANCES; i++)
+    {
+        CHECK(IMAI_MODEL_RET_SUCCESS == instance_init(&alone[i], i, strides[i]), "init of instance %d", i);
+        for (int t = 0; t < TEST_FRAMES; t++)
+        {
+            instance_frame(&alone[i], frames[i][t]);
+        }
+        imai_model_finalize(&alone[i].ctx);
+    }
+
+    /* Both instances at once, the second one stops half way */
+    for (int i = 0; i < TEST_INSTANCES; i++)
+    {
+        CHECK(IMAI_MODEL_RET_SUCCESS == instance_init(&together[i], i, strides[i]), "init of instance %d", i);
+    }
+    CHECK(together[0].ctx.model != together[1].ctx.model, "the instances share the runtime model");
+    for (int t = 0; t < TEST_FRAMES; t++)
+    {
+        instance_frame(&together[0], frames[0][t]);
+        if (t < TEST_FRAMES / 2)
+        {
+            instance_frame(&together[1], frames[1][t]);
+        }
+        else if (t == TEST_FRAMES / 2)
+        {
+            imai_model_finalize(&together[1].ctx);
+        }
+    }
+    imai_model_finalize(&together[0].ctx);
+
+    for (int i = 0; i < TEST_INSTANCES; i++)
+    {
+        int expected = alone[i].windows;
+
+        if (1 == i)
+        {
+            /* Windows complete within the first half of the stream */
+            expected = 0;
+            for (int t = 1; t <= TEST_FRAMES / 2; t++)
+            {
+                expected += ((t >= BABY_CRY_WINDOW_FRAMES) && (0 == (t - BABY_CRY_WINDOW_FRAMES) % strides[i]));
+            }
+        }
+        printf("instance %d: stride %d, %d windows alone, %d together\n", i, strides[i], alone[i].windows,
+               together[i].windows);
+        CHECK(together[i].windows == expected, "instance %d: %d windows, %d expected", i, together[i].windows,
+              expected);
+        CHECK(together[i].windows > 2, "instance %d: only %d windows", i, together[i].windows);
+        for (int w = 0; (w < together[i].windows) && (w < alone[i].windows); w++)
+        {
+            CHECK(0 == memcmp(together[i].scores[w], alone[i].scores[w], sizeof(alone[i].scores[w])),
+                  "instance %d window %d: %f %f, alone %f %f", i, w, (double)together[i].scores[w][0],
+                  (double)together[i].scores[w][1], (double)alone[i].scores[w][0], (double)alone[i].scores[w][1]);
+        }
+    }
+
+    /* The probe must tell the two streams apart, or the test proves nothing */
+    CHECK(0 != memcmp(alone[0].scores, alone[1].scores, sizeof(alone[0].scores[0]) * 3u),
+          "both streams give the same scores");
+}
+
+/* A model whose runtime does not come up must give its slot back */
+static void test_init_failure(void)
+{
+    test_instance_t* inst = &alone[0];
+
+    host_ml_fail_runtime_init(1);
+    for (int i = 0; i <= HOST_ML_MAX_MODELS; i++)
+    {
+        CHECK(IMAI_MODEL_RET_SUCCESS != instance_init(inst, 0, BABY_CRY_WINDOW_STRIDE),
+              "init %d without a runtime succeeded", i);
+    }
+    host_ml_fail_runtime_init(0);
+    CHECK(IMAI_MODEL_RET_SUCCESS == instance_init(inst, 0, BABY_CRY_WINDOW_STRIDE),
+          "no model left after the failed inits");
+    imai_model_finalize(&inst->ctx);
+}
+
+int main(void)
+{
+    uint32_t seed = 11u;
+
+    for (int i = 0; i < TEST_INSTANCES; i++)
+    {
+        for (int t = 0; t < TEST_FRAMES; t++)
+        {
+            for (int b = 0; b < LOGMEL_BANDS; b++)
+            {
+                frames[i][t][b] = (float)next_random(&seed) / (float)(1u << 24) * 12.0f - 10.0f;
+            }
+        }
+    }
+    host_ml_set_probe(BABY_CRY_WINDOW_FRAMES * LOGMEL_BANDS);
+
+    test_instances();
+    test_init_failure();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
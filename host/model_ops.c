@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Operators of a TFLite model and where they run (model_profile.h).
+ *
+ *   model_ops                    the model linked into the CM55 build
+ *   model_ops [-n] a.tflite ...  exported models, e.g. the output of Vela
+ *
+ * Prints one line per operator of the main subgraph: the ethos-u operator
+ * runs on the NPU, every other operator falls back to the CPU. With -n the
+ * exit status is 2 if any operator falls back, so that an export can be
+ * checked for full NPU offload before it is built in. Exits with 1 if a file
+ * is not a TFLite model.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "baby_cry.h"
+#include "model_profile.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static model_profile_t profile;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Prints the operators of one model, returns the exit status of it */
+static int dump(const char* name, const uint8_t* model, uint32_t size, uint32_t arena_size, bool npu_only)
+{
+    printf("%s:\n", name);
+    if (MODEL_PROFILE_RET_SUCCESS != model_profile_init(&profile, model, size, arena_size))
+    {
+        printf("  not a TFLite model\n");
+        return 1;
+    }
+    model_profile_print(&profile.report, printf);
+    if (profile.report.op_count > MODEL_PROFILE_MAX_OPS)
+    {
+        printf("  ... %lu more\n", (unsigned long)(profile.report.op_count - MODEL_PROFILE_MAX_OPS));
+    }
+    return (npu_only && (profile.report.npu_ops < profile.report.op_count)) ? 2 : 0;
+}
+
+static int dump_file(const char* path, bool npu_only)
+{
+    FILE* file = fopen(path, "rb");
+    uint8_t* model;
+    long size;
+    int status;
+
+    if (NULL == file)
+    {
+        printf("%s: cannot open\n", path);
+        return 1;
+    }
+    if ((0 != fseek(file, 0, SEEK_END)) || ((size = ftell(file)) <= 0) || (0 != fseek(file, 0, SEEK_SET)) ||
+        (NULL == (model = malloc((size_t)size))))
+    {
+        fclose(file);
+        printf("%s: cannot read\n", path);
+        return 1;
+    }
+    if (fread(model, 1, (size_t)size, file) != (size_t)size)
+    {
+        free(model);
+        fclose(file);
+        printf("%s: cannot read\n", path);
+        return 1;
+    }
+    fclose(file);
+
+    status = dump(path, model, (uint32_t)size, 0, npu_only);
+    free(model);
+    return status;
+}
+
+int main(int argc, char** argv)
+{
+    bool npu_only = false;
+    int status = 0;
+    int first = 1;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "-n")))
+    {
+        npu_only = true;
+        first = 2;
+    }
+    if (first >= argc)
+    {
+        return dump(baby_cry_model.name, baby_cry_model.weights, baby_cry_model.weights_size,
+                    baby_cry_model.arena_size, npu_only);
+    }
+    for (int i = first; i < argc; i++)
+    {
+        int file_status = dump_file(argv[i], npu_only);
+        status = (file_status > status) ? file_status : status;
+    }
+    return status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,279 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the operator profile of model_profile.h.
+ *
+ * Lists the operators of the model linked into the CM55 build, which Vela
+ * compiled into one ethos-u operator, and of a small flatbuffer built here
+ * with an operator code in the deprecated field only, a custom ethos-u code
+ * and a code past the deprecated range. Every truncation of both and a few
+ * broken offsets must be rejected or parsed without reading past the end.
+ * Then checks the statistics of the operators and inferences. Exits with 1
+ * on failure.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "baby_cry.h"
+#include "model_profile.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_MODEL_SIZE             (256u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+static model_profile_t profile;
+
+/* Flatbuffer of the test model and the position of its opcode index of the
+ * last operator */
+static uint8_t test_model[TEST_MODEL_SIZE];
+static uint32_t test_model_size;
+static uint32_t test_opcode_index;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static uint32_t put_u32(uint32_t value)
+{
+    uint32_t pos = test_model_size;
+
+    test_model[pos] = (uint8_t)value;
+    test_model[pos + 1u] = (uint8_t)(value >> 8);
+    test_model[pos + 2u] = (uint8_t)(value >> 16);
+    test_model[pos + 3u] = (uint8_t)(value >> 24);
+    test_model_size += 4u;
+    return pos;
+}
+
+static void set_u32(uint32_t pos, uint32_t value)
+{
+    test_model[pos] = (uint8_t)value;
+    test_model[pos + 1u] = (uint8_t)(value >> 8);
+    test_model[pos + 2u] = (uint8_t)(value >> 16);
+    test_model[pos + 3u] = (uint8_t)(value >> 24);
+}
+
+/* Points the offset at pos to target, which must follow it */
+static void set_offset(uint32_t pos, uint32_t target)
+{
+    set_u32(pos, target - pos);
+}
+
+/* Vtable of a table of 4 byte fields; present[i] selects field i */
+static uint32_t put_vtable(const int* present, uint32_t fields)
+{
+    uint32_t pos = test_model_size;
+    uint32_t slot = 4u;
+    uint32_t size = 4u + 2u * fields;
+
+    test_model[pos] = (uint8_t)size;
+    test_model[pos + 2u] = (uint8_t)(4u + 4u * fields);
+    for (uint32_t i = 0; i < fields; i++)
+    {
+        test_model[pos + 4u + 2u * i] = present[i] ? (uint8_t)slot : 0u;
+        slot += present[i] ? 4u : 0u;
+    }
+    test_model_size += (size + 3u) & ~3u;
+    return pos;
+}
+
+/* Table of the vtable, its fields follow with put_u32() */
+static uint32_t put_table(uint32_t vtable)
+{
+    return put_u32(test_model_size - vtable);
+}
+
+/* Model with the operators CONV_2D, ethos-u and BUILTIN_150 */
+static void build_test_model(void)
+{
+    static const int model_fields[] = { 0, 1, 1 };
+    static const int deprecated_fields[] = { 1 };
+    static const int custom_fields[] = { 1, 1, 0, 1 };
+    static const int builtin_fields[] = { 1, 0, 0, 1 };
+    static const int subgraph_fields[] = { 0, 0, 0, 1 };
+    static const int op_fields[] = { 1 };
+    uint32_t root, codes_field, subgraphs_field, codes, code[3], custom_name;
+    uint32_t subgraphs, subgraph, ops_field, ops, op[3], vtable;
+
+    memset(test_model, 0, sizeof(test_model));
+    test_model_size = 0;
+    root = put_u32(0);
+    memcpy(&test_model[put_u32(0)], "TFL3", 4u);
+
+    vtable = put_vtable(model_fields, 3u);
+    set_offset(root, put_table(vtable));
+    codes_field = put_u32(0);
+    subgraphs_field = put_u32(0);
+
+    codes = put_u32(3u);
+    set_offset(codes_field, codes);
+    code[0] = put_u32(0);
+    code[1] = put_u32(0);
+    code[2] = put_u32(0);
+
+    /* CONV_2D in the deprecated int8 field only, as older converters write it */
+    vtable = put_vtable(deprecated_fields, 1u);
+    set_offset(code[0], put_table(vtable));
+    (void)put_u32(3u);
+
+    vtable = put_vtable(custom_fields, 4u);
+    set_offset(code[1], put_table(vtable));
+    (void)put_u32(32u);
+    custom_name = put_u32(0);
+    (void)put_u32(32u);
+
+    /* Past the int8 range the deprecated field holds the placeholder 127 */
+    vtable = put_vtable(builtin_fields, 4u);
+    set_offset(code[2], put_table(vtable));
+    (void)put_u32(127u);
+    (void)put_u32(150u);
+
+    set_offset(custom_name, put_u32(7u));
+    memcpy(&test_model[test_model_size], "ethos-u", 8u);
+    test_model_size += 8u;
+
+    subgraphs = put_u32(1u);
+    set_offset(subgraphs_field, subgraphs);
+    subgraph = put_u32(0);
+    vtable = put_vtable(subgraph_fields, 4u);
+    set_offset(subgraph, put_table(vtable));
+    ops_field = put_u32(0);
+
+    ops = put_u32(3u);
+    set_offset(ops_field, ops);
+    op[0] = put_u32(0);
+    op[1] = put_u32(0);
+    op[2] = put_u32(0);
+
+    /* Opcode index 0 is the default and left out */
+    set_offset(op[0], put_table(put_vtable(op_fields, 0u)));
+    vtable = put_vtable(op_fields, 1u);
+    set_offset(op[1], put_table(vtable));
+    (void)put_u32(1u);
+    set_offset(op[2], put_table(vtable));
+    test_opcode_index = put_u32(2u);
+}
+
+/* Parses every truncation from a buffer of exactly that size. Truncating
+ * only the tensor data of a model goes unnoticed, so only the test model,
+ * which ends with a field of its last operator, must reject all. */
+static void check_truncations(const char* name, const uint8_t* model, uint32_t size, uint32_t step, bool reject_all)
+{
+    uint32_t accepted = 0;
+
+    for (uint32_t length = 0; length < size; length += step)
+    {
+        uint8_t* copy = malloc((length > 0u) ? length : 1u);
+
+        memcpy(copy, model, length);
+        if (MODEL_PROFILE_RET_SUCCESS == model_profile_init(&profile, copy, length, 0u))
+        {
+            accepted++;
+        }
+        free(copy);
+    }
+    CHECK(!reject_all || (0u == accepted), "%s: %lu truncations accepted", name, (unsigned long)accepted);
+}
+
+static void test_linked_model(void)
+{
+    CHECK(MODEL_PROFILE_RET_SUCCESS == model_profile_init(&profile, baby_cry_model.weights,
+                                                          baby_cry_model.weights_size,
+                                                          baby_cry_model.arena_size), "linked model");
+    model_profile_print(&profile.report, printf);
+    CHECK(1u == profile.report.op_count, "linked model: %lu operators", (unsigned long)profile.report.op_count);
+    CHECK(1u == profile.report.npu_ops, "linked model: %lu on the npu", (unsigned long)profile.report.npu_ops);
+    CHECK(0 == strcmp(profile.report.ops[0].name, MODEL_PROFILE_NPU_OP), "linked model: %s",
+          profile.report.ops[0].name);
+    CHECK(baby_cry_model.arena_size == profile.report.arena_size, "linked model: arena size");
+
+    check_truncations("linked model", baby_cry_model.weights, baby_cry_model.weights_size, 97u, false);
+}
+
+static void test_built_model(void)
+{
+    build_test_model();
+    CHECK(MODEL_PROFILE_RET_SUCCESS == model_profile_init(&profile, test_model, test_model_size, 0u),
+          "test model");
+    model_profile_print(&profile.report, printf);
+    CHECK(3u == profile.report.op_count, "test model: %lu operators", (unsigned long)profile.report.op_count);
+    CHECK(1u == profile.report.npu_ops, "test model: %lu on the npu", (unsigned long)profile.report.npu_ops);
+    CHECK((0 == strcmp(profile.report.ops[0].name, "CONV_2D")) && !profile.report.ops[0].npu,
+          "test model: op 0 %s", profile.report.ops[0].name);
+    CHECK((0 == strcmp(profile.report.ops[1].name, "ethos-u")) && profile.report.ops[1].npu,
+          "test model: op 1 %s", profile.report.ops[1].name);
+    CHECK((0 == strcmp(profile.report.ops[2].name, "BUILTIN_150")) && !profile.report.ops[2].npu,
+          "test model: op 2 %s", profile.report.ops[2].name);
+
+    check_truncations("test model", test_model, test_model_size, 1u, true);
+
+    /* Opcode index past the codes */
+    set_u32(test_opcode_index, 3u);
+    CHECK(MODEL_PROFILE_RET_ERROR == model_profile_init(&profile, test_model, test_model_size, 0u),
+          "opcode index past the codes accepted");
+    set_u32(test_opcode_index, 2u);
+
+    /* Root offset past the end */
+    set_u32(0u, test_model_size);
+    CHECK(MODEL_PROFILE_RET_ERROR == model_profile_init(&profile, test_model, test_model_size, 0u),
+          "root past the end accepted");
+
+    /* Not a TFLite file */
+    build_test_model();
+    memcpy(&test_model[4], "XXXX", 4u);
+    CHECK(MODEL_PROFILE_RET_ERROR == model_profile_init(&profile, test_model, test_model_size, 0u),
+          "wrong identifier accepted");
+    CHECK(MODEL_PROFILE_RET_ERROR == model_profile_init(&profile, NULL, 0u, 0u), "no model accepted");
+}
+
+static void test_statistics(void)
+{
+    build_test_model();
+    CHECK(MODEL_PROFILE_RET_SUCCESS == model_profile_init(&profile, test_model, test_model_size, 4096u),
+          "statistics model");
+    for (uint32_t run = 0; run < 4u; run++)
+    {
+        model_profile_op(&profile, 0u, 100u + run);
+        model_profile_op(&profile, 1u, 1000u - run);
+        model_profile_op(&profile, 2u, 10u);
+        model_profile_op(&profile, 3u, 1u);    /* Not an operator, ignored */
+        model_profile_inference(&profile, 1200u + 10u * run);
+    }
+    profile.report.arena_used = 2048u;
+    profile.report.core_clock_hz = 400000000u;
+    model_profile_summarize(&profile);
+    model_profile_print(&profile.report, printf);
+
+    CHECK(4u == profile.report.runs, "runs %lu", (unsigned long)profile.report.runs);
+    CHECK((1200u == profile.report.inference_min) && (1215u == profile.report.inference_mean) &&
+          (1230u == profile.report.inference_max), "inference %lu %lu %lu",
+          (unsigned long)profile.report.inference_min, (unsigned long)profile.report.inference_mean,
+          (unsigned long)profile.report.inference_max);
+    CHECK((4u == profile.report.ops[0].count) && (100u == profile.report.ops[0].min) &&
+          (101u == profile.report.ops[0].mean) && (103u == profile.report.ops[0].max), "op 0 statistics");
+    CHECK((997u == profile.report.ops[1].min) && (998u == profile.report.ops[1].mean) &&
+          (1000u == profile.report.ops[1].max), "op 1 statistics");
+    CHECK((4u == profile.report.ops[2].count) && (0u == profile.report.ops[3].count), "op counts");
+}
+
+int main(void)
+{
+    test_linked_model();
+    test_built_model();
+    test_statistics();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
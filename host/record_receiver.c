@@ -0,0 +1,433 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Receiver of the raw audio stream of the recording mode.
+ *
+ * Reads the frames of proj_cm33_ns/record_frame.h from a TCP connection
+ * (RECORD=TCP), a serial port (RECORD=UART) or a file, checks the CRC and
+ * writes the samples into WAV files. A new file is started at every gap in
+ * the sequence numbers, so that each file is contiguous audio. Bytes that
+ * are not part of a valid frame, such as console output on the UART, are
+ * skipped. Reports the received, lost and corrupted frames and the
+ * overruns of the device; Ctrl-C ends the recording.
+ *
+ *   record_receiver -p 5005 -o session            TCP on port 5005
+ *   record_receiver -u /dev/ttyACM0 -b 921600     debug UART
+ *   record_receiver -f capture.bin                stream saved to a file
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+#include "record_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RECEIVER_FRAME_MAX_SIZE     (RECORD_FRAME_HEADER_SIZE + RECORD_FRAME_MAX_SAMPLES * 2u + \
+                                     RECORD_FRAME_CRC_SIZE)
+#define RECEIVER_BUFFER_SIZE        (4u * RECEIVER_FRAME_MAX_SIZE)
+#define RECEIVER_WAV_HEADER_SIZE    (44u)
+
+/* Seconds of audio between the progress reports */
+#define RECEIVER_REPORT_S           (10u)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    FILE*       wav;
+    uint32_t    files;
+    uint32_t    data_bytes;         /* Samples in the current file */
+    bool        synced;             /* A frame was received */
+    record_frame_info_t last;       /* Last valid frame */
+
+    /* Statistics */
+    uint64_t    frames;
+    uint64_t    samples;            /* Per channel */
+    uint64_t    lost;               /* Frames missing between two received */
+    uint64_t    corrupted;          /* Frames with a bad CRC */
+    uint64_t    skipped;            /* Bytes outside of valid frames */
+    uint64_t    next_report;
+} receiver_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile sig_atomic_t stop;
+static const char* prefix = "record";
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void on_signal(int signal)
+{
+    (void)signal;
+    stop = 1;
+}
+
+static void put_u16(uint8_t* out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* out, uint32_t value)
+{
+    put_u16(out, (uint16_t)value);
+    put_u16(&out[2], (uint16_t)(value >> 16));
+}
+
+/* Writes the WAV header for the samples so far, the file stays valid if the
+ * receiver is killed */
+static void wav_header(receiver_t* rx)
+{
+    uint8_t header[RECEIVER_WAV_HEADER_SIZE];
+    const record_frame_info_t* info = &rx->last;
+
+    memcpy(&header[0], "RIFF", 4);
+    put_u32(&header[4], 36u + rx->data_bytes);
+    memcpy(&header[8], "WAVEfmt ", 8);
+    put_u32(&header[16], 16u);
+    put_u16(&header[20], 1u);
+    put_u16(&header[22], info->channels);
+    put_u32(&header[24], info->sample_rate);
+    put_u32(&header[28], info->sample_rate * info->channels * 2u);
+    put_u16(&header[32], (uint16_t)(info->channels * 2u));
+    put_u16(&header[34], 16u);
+    memcpy(&header[36], "data", 4);
+    put_u32(&header[40], rx->data_bytes);
+
+    fseek(rx->wav, 0, SEEK_SET);
+    fwrite(header, 1, sizeof(header), rx->wav);
+    fseek(rx->wav, 0, SEEK_END);
+    fflush(rx->wav);
+}
+
+static void wav_close(receiver_t* rx)
+{
+    if (NULL != rx->wav)
+    {
+        wav_header(rx);
+        fclose(rx->wav);
+        rx->wav = NULL;
+    }
+}
+
+static int wav_open(receiver_t* rx)
+{
+    char name[512];
+
+    wav_close(rx);
+    snprintf(name, sizeof(name), "%s_%03u.wav", prefix, (unsigned)rx->files);
+    if (NULL == (rx->wav = fopen(name, "w+b")))
+    {
+        fprintf(stderr, "cannot write %s\n", name);
+        return -1;
+    }
+    rx->files++;
+    rx->data_bytes = 0u;
+    wav_header(rx);
+    printf("writing %s: %u Hz, %u channel(s)\n", name, (unsigned)rx->last.sample_rate,
+           (unsigned)rx->last.channels);
+    return 0;
+}
+
+static void report(const receiver_t* rx)
+{
+    printf("%llu frames, %.1f s, %llu lost, %llu corrupted, %llu bytes skipped, %u device overruns, "
+           "%u files\n",
+           (unsigned long long)rx->frames,
+           rx->synced ? (double)rx->samples / rx->last.sample_rate : 0.0,
+           (unsigned long long)rx->lost, (unsigned long long)rx->corrupted,
+           (unsigned long long)rx->skipped, (unsigned)rx->last.overruns, (unsigned)rx->files);
+}
+
+/*******************************************************************************
+* Function Name: receive_frame
+********************************************************************************
+* Summary:
+*  Appends a valid frame to the current file. A gap in the sequence, a new
+*  format or a restart of the device starts a new file.
+*
+*******************************************************************************/
+static int receive_frame(receiver_t* rx, const record_frame_info_t* info, const uint8_t* pcm)
+{
+    bool contiguous = rx->synced && (info->sequence == rx->last.sequence + 1u) &&
+                      (info->sample_rate == rx->last.sample_rate) && (info->channels == rx->last.channels);
+
+    if (rx->synced && (info->sequence > rx->last.sequence))
+    {
+        rx->lost += info->sequence - rx->last.sequence - 1u;
+    }
+    rx->last = *info;
+    rx->synced = true;
+    if (!contiguous && (0 != wav_open(rx)))
+    {
+        return -1;
+    }
+
+    fwrite(pcm, 1, record_frame_payload_size(info), rx->wav);
+    rx->data_bytes += record_frame_payload_size(info);
+    rx->frames++;
+    rx->samples += info->samples;
+    if (0u == rx->next_report)
+    {
+        rx->next_report = (uint64_t)RECEIVER_REPORT_S * info->sample_rate;
+    }
+    else if (rx->samples >= rx->next_report)
+    {
+        rx->next_report = rx->samples + (uint64_t)RECEIVER_REPORT_S * info->sample_rate;
+        wav_header(rx);
+        report(rx);
+    }
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: receive
+********************************************************************************
+* Summary:
+*  Finds the frames in the byte stream of a descriptor until it ends or the
+*  receiver is stopped. After a bad CRC the search resumes one byte after the
+*  false start, so a corrupted frame costs only itself.
+*
+*******************************************************************************/
+static int receive(receiver_t* rx, int fd)
+{
+    static uint8_t buffer[RECEIVER_BUFFER_SIZE];
+    size_t fill = 0;
+    size_t pos = 0;
+
+    while (!stop)
+    {
+        ssize_t got = read(fd, &buffer[fill], sizeof(buffer) - fill);
+        if (got < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            perror("read");
+            return -1;
+        }
+        if (0 == got)
+        {
+            break;
+        }
+        fill += (size_t)got;
+
+        while (fill - pos >= RECORD_FRAME_HEADER_SIZE)
+        {
+            record_frame_info_t info;
+            size_t size;
+
+            if (RECORD_FRAME_RET_SUCCESS != record_frame_parse_header(&buffer[pos], &info))
+            {
+                pos++;
+                rx->skipped++;
+                continue;
+            }
+            size = RECORD_FRAME_HEADER_SIZE + record_frame_payload_size(&info) + RECORD_FRAME_CRC_SIZE;
+            if (fill - pos < size)
+            {
+                break;
+            }
+
+            const uint8_t* crc = &buffer[pos + size - RECORD_FRAME_CRC_SIZE];
+            uint32_t expected = (uint32_t)crc[0] | ((uint32_t)crc[1] << 8) |
+                                ((uint32_t)crc[2] << 16) | ((uint32_t)crc[3] << 24);
+            if (expected != record_frame_crc32(0u, &buffer[pos], (uint32_t)(size - RECORD_FRAME_CRC_SIZE)))
+            {
+                rx->corrupted++;
+                pos++;
+                rx->skipped++;
+                continue;
+            }
+            if (0 != receive_frame(rx, &info, &buffer[pos + RECORD_FRAME_HEADER_SIZE]))
+            {
+                return -1;
+            }
+            pos += size;
+        }
+
+        memmove(buffer, &buffer[pos], fill - pos);
+        fill -= pos;
+        pos = 0;
+    }
+    rx->skipped += fill;
+    return 0;
+}
+
+static speed_t serial_speed(long baud)
+{
+    switch (baud)
+    {
+        case 115200: return B115200;
+        case 230400: return B230400;
+#ifdef B460800
+        case 460800: return B460800;
+#endif
+#ifdef B921600
+        case 921600: return B921600;
+#endif
+#ifdef B1000000
+        case 1000000: return B1000000;
+#endif
+        default: return B0;
+    }
+}
+
+static int open_serial(const char* device, long baud)
+{
+    struct termios tty;
+    int fd = open(device, O_RDONLY | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        perror(device);
+        return -1;
+    }
+    if ((0 != tcgetattr(fd, &tty)) || (B0 == serial_speed(baud)))
+    {
+        fprintf(stderr, "%s: cannot set %ld baud\n", device, baud);
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, serial_speed(baud));
+    cfsetospeed(&tty, serial_speed(baud));
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+    if (0 != tcsetattr(fd, TCSANOW, &tty))
+    {
+        perror(device);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Serves one device connection after the other */
+static int listen_tcp(receiver_t* rx, int port)
+{
+    struct sockaddr_in address;
+    int one = 1;
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if ((server < 0) || (0 != bind(server, (struct sockaddr*)&address, sizeof(address))) ||
+        (0 != listen(server, 1)))
+    {
+        perror("listen");
+        return -1;
+    }
+    printf("waiting for the device on port %d\n", port);
+
+    while (!stop)
+    {
+        int connection = accept(server, NULL, NULL);
+        if (connection < 0)
+        {
+            continue;
+        }
+        printf("device connected\n");
+        if (0 != receive(rx, connection))
+        {
+            close(connection);
+            break;
+        }
+        close(connection);
+        printf("device disconnected\n");
+    }
+    close(server);
+    return 0;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s (-p port | -u device [-b baud] | -f file) [-o prefix]\n"
+            "  -p  listen for RECORD=TCP on this port\n"
+            "  -u  read RECORD=UART from a serial port, -b baud (default 921600)\n"
+            "  -f  read a saved stream\n"
+            "  -o  WAV files <prefix>_000.wav, ... (default record)\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    struct sigaction action;
+    receiver_t rx;
+    const char* device = NULL;
+    const char* file = NULL;
+    long baud = 921600;
+    int port = 0;
+    int opt;
+    int ret = 0;
+
+    while (-1 != (opt = getopt(argc, argv, "p:u:b:f:o:h")))
+    {
+        switch (opt)
+        {
+            case 'p': port = atoi(optarg); break;
+            case 'u': device = optarg; break;
+            case 'b': baud = strtol(optarg, NULL, 10); break;
+            case 'f': file = optarg; break;
+            case 'o': prefix = optarg; break;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if ((0 == port) && (NULL == device) && (NULL == file))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* No SA_RESTART, so that Ctrl-C interrupts a blocking read */
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    memset(&rx, 0, sizeof(rx));
+    if (0 != port)
+    {
+        ret = listen_tcp(&rx, port);
+    }
+    else
+    {
+        int fd = (NULL != device) ? open_serial(device, baud) : open(file, O_RDONLY);
+        if (fd < 0)
+        {
+            if (NULL != file)
+            {
+                perror(file);
+            }
+            return 1;
+        }
+        ret = receive(&rx, fd);
+        close(fd);
+    }
+
+    wav_close(&rx);
+    report(&rx);
+    return (0 == ret) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,199 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the quantized decision of score_q.h against the float decision it
+ * replaces in audio_pipeline_collect(): dequantize every score, take the
+ * first largest one and compare it with the threshold.
+ *
+ * For random output quantizations, thresholds and int8 outputs of 1 to
+ * IMAI_MODEL_MAX_OUTPUTS scores the argmax, the detection, the top k and the
+ * confidence must match the float path exactly. Thresholds right at the
+ * scores of the int8 grid and outside of it are tested as well. Exits with 1
+ * on failure.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "imai_model.h"
+#include "score_q.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_QUANTIZATIONS          (2000)
+#define TEST_VECTORS                (200)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static float uniform(uint32_t* state, float low, float high)
+{
+    return low + (high - low) * (float)next_random(state) / (float)(1u << 24);
+}
+
+/* The dequantization of the generated mtb_model_run_int8() */
+static float reference_score(int8_t q, float scale, int zero_point)
+{
+    return (q - zero_point) * scale;
+}
+
+/* Decision of the float path, returns the label or -1 below the threshold */
+static int reference_decision(const float* scores, int count, float threshold, int* best)
+{
+    float max_score = -1000.0f;
+
+    *best = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (scores[i] > max_score)
+        {
+            max_score = scores[i];
+            *best = i;
+        }
+    }
+    return (max_score >= threshold) ? *best : -1;
+}
+
+static void test_vectors(const score_q_t* sq, float threshold, int count, uint32_t* state)
+{
+    int8_t q[IMAI_MODEL_MAX_OUTPUTS];
+    float scores[IMAI_MODEL_MAX_OUTPUTS];
+    int top[IMAI_MODEL_MAX_OUTPUTS];
+
+    for (int v = 0; v < TEST_VECTORS; v++)
+    {
+        /* Few distinct values on every other vector, for ties */
+        int spread = (0 != (v & 1)) ? 256 : 4;
+        int best;
+        int label;
+        int argmax;
+        bool above;
+
+        for (int i = 0; i < count; i++)
+        {
+            q[i] = (int8_t)((int)(next_random(state) % (uint32_t)spread) + ((spread == 256) ? INT8_MIN : 120));
+            scores[i] = reference_score(q[i], sq->scale, (int)sq->zero_point);
+        }
+        label = reference_decision(scores, count, threshold, &best);
+        argmax = score_q_argmax(q, count);
+        above = score_q_above(sq, q[argmax]);
+
+        CHECK(argmax == best, "argmax %d, float %d", argmax, best);
+        CHECK(above == (label >= 0), "detection %d at q %d, threshold %d (%f), scale %g zero point %ld", above,
+              q[argmax], sq->threshold, (double)threshold, (double)sq->scale, (long)sq->zero_point);
+        CHECK(score_q_value(sq, q[argmax]) == scores[best], "confidence differs");
+
+        for (int k = 1; k <= count + 1; k++)
+        {
+            int n = score_q_top_k(q, count, top, k);
+
+            CHECK(n == ((k < count) ? k : count), "top %d of %d: %d", k, count, n);
+            CHECK(top[0] == best, "top %d starts with %d, float %d", k, top[0], best);
+            for (int i = 1; i < n; i++)
+            {
+                bool ordered = (scores[top[i - 1]] > scores[top[i]]) ||
+                               ((scores[top[i - 1]] == scores[top[i]]) && (top[i - 1] < top[i]));
+
+                CHECK(ordered, "top %d of %d out of order at %d", k, count, i);
+            }
+            /* Nothing left out scores above the last one taken */
+            for (int i = 0; (i < count) && (n > 0); i++)
+            {
+                bool taken = false;
+
+                for (int j = 0; j < n; j++)
+                {
+                    taken = taken || (top[j] == i);
+                }
+                CHECK(taken || (scores[i] <= scores[top[n - 1]]), "top %d of %d misses %d", k, count, i);
+            }
+        }
+    }
+}
+
+static void test_quantizations(void)
+{
+    uint32_t state = 7u;
+    int never = 0;
+    int always = 0;
+
+    for (int t = 0; t < TEST_QUANTIZATIONS; t++)
+    {
+        score_q_t sq;
+        float scale = expf(uniform(&state, -9.0f, 0.0f));
+        int32_t zero_point = (int32_t)(next_random(&state) % 256u) - 128;
+        int count = 1 + (int)(next_random(&state) % IMAI_MODEL_MAX_OUTPUTS);
+        float threshold;
+
+        switch (t % 4)
+        {
+            case 0:
+                /* Right on the score of a grid point, and just off it */
+                threshold = reference_score((int8_t)((int)(next_random(&state) % 256u) - 128), scale, (int)zero_point);
+                threshold = (t % 8 == 0) ? threshold : nextafterf(threshold, (t % 16 < 8) ? INFINITY : -INFINITY);
+                break;
+            case 1:
+                /* Out of reach or always reached */
+                threshold = (t % 8 == 1) ? INFINITY : -INFINITY;
+                break;
+            default:
+                threshold = uniform(&state, -300.0f, 300.0f) * scale;
+                break;
+        }
+
+        CHECK(SCORE_Q_RET_SUCCESS == score_q_init(&sq, scale, zero_point, threshold), "init");
+        never += (SCORE_Q_NEVER == sq.threshold);
+        always += (INT8_MIN == sq.threshold);
+        for (int q = INT8_MIN; q <= INT8_MAX; q++)
+        {
+            bool reached = (reference_score((int8_t)q, scale, (int)zero_point) >= threshold);
+
+            CHECK(reached == score_q_above(&sq, (int8_t)q), "q %d: threshold %d of %f", q, sq.threshold,
+                  (double)threshold);
+        }
+        test_vectors(&sq, threshold, count, &state);
+    }
+    printf("quantizations: %d, threshold out of reach %d, always reached %d\n", TEST_QUANTIZATIONS, never, always);
+    CHECK((never > 0) && (always > 0), "thresholds at the ends not covered");
+}
+
+static void test_quantize(void)
+{
+    score_q_t sq;
+
+    CHECK(SCORE_Q_RET_ERROR == score_q_init(&sq, 0.0f, 0, 0.5f), "zero scale accepted");
+    CHECK(SCORE_Q_RET_ERROR == score_q_init(&sq, -1.0f, 0, 0.5f), "negative scale accepted");
+    CHECK(SCORE_Q_RET_ERROR == score_q_init(&sq, NAN, 0, 0.5f), "NaN scale accepted");
+
+    /* The softmax output of the model: 0 .. 1 in 1/256 */
+    CHECK(SCORE_Q_RET_SUCCESS == score_q_init(&sq, 1.0f / 256.0f, -128, 0.6f), "init");
+    CHECK(26 == sq.threshold, "threshold %d of 0.6, expected 26", sq.threshold);
+    CHECK(INT8_MIN == score_q_quantize(&sq, 0.0f), "0 quantized to %d", score_q_quantize(&sq, 0.0f));
+    CHECK(INT8_MAX == score_q_quantize(&sq, 1.0f), "1 quantized to %d", score_q_quantize(&sq, 1.0f));
+    CHECK(0 == score_q_quantize(&sq, 0.5f), "0.5 quantized to %d", score_q_quantize(&sq, 0.5f));
+    for (int q = INT8_MIN; q <= INT8_MAX; q++)
+    {
+        CHECK(q == score_q_quantize(&sq, score_q_value(&sq, (int8_t)q)), "%d does not quantize back", q);
+    }
+}
+
+int main(void)
+{
+    test_quantize();
+    test_quantizations();
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Test of the streaming input of the generated model code,
+ * BABY_CRY_STREAMING in baby_cry.h.
+ *
+ * Feeds random frames, with values past both ends of the int8 range and on
+ * the quantization steps, to a model instance at several window strides.
+ * Every window the instance classifies is checked against the windowed path
+ * as exported: the float window of the same frames quantized in one go. The
+ * mock NPU is a linear probe of the window, so the model input and the
+ * outputs must agree bit for bit. Holds in either mode, exits with 1 on
+ * failure.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "baby_cry.h"
+#include "host_platform.h"
+#include "mtb_ml.h"
+#include "test_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_FRAME_SIZE             (20)
+#define TEST_WINDOW_FRAMES          (BABY_CRY_WINDOW_FRAMES)
+#define TEST_WINDOW_SIZE            (TEST_FRAME_SIZE * TEST_WINDOW_FRAMES)
+#define TEST_FRAMES                 (600)
+
+/* Input quantization of the test, unlike the default of the mock */
+#define TEST_INPUT_SCALE            (0.37f)
+#define TEST_INPUT_ZERO_POINT       (-7)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int failures;
+static float frames[TEST_FRAMES][TEST_FRAME_SIZE];
+
+static IMAI_ALIGNED(16) int8_t buffer[BABY_CRY_BUFFER_SIZE];
+static IMAI_ALIGNED(16) int8_t state[BABY_CRY_STATE_SIZE];
+static IMAI_ALIGNED(16) int8_t arena[BABY_CRY_ARENA_SIZE];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void render_frames(void)
+{
+    uint32_t seed = 11u;
+
+    for (int i = 0; i < TEST_FRAMES; i++)
+    {
+        for (int j = 0; j < TEST_FRAME_SIZE; j++)
+        {
+            if (0u == (next_random(&seed) % 5u))
+            {
+                /* On a quantization step, up to past the int8 range */
+                int step = (int)((seed >> 12) % 300u) - 150;
+                frames[i][j] = (float)(step - TEST_INPUT_ZERO_POINT) * TEST_INPUT_SCALE;
+            }
+            else
+            {
+                frames[i][j] = ((float)(seed >> 8) / (float)(1u << 24) - 0.5f) * 120.0f;
+            }
+        }
+    }
+}
+
+/* mtb_model_int8_f32() of the windowed path */
+static void quantize_window(const mtb_ml_model_t* model, int first, int8_t* window)
+{
+    const float* src = &frames[first][0];
+    int in_offset = model->input_zero_point;
+    float in_scale = model->input_scale;
+
+    for (int i = 0; i < TEST_WINDOW_SIZE; i++)
+    {
+        float value = (src[i] / in_scale) + in_offset;
+        if (value > 127)
+            window[i] = 127;
+        else if (value < -128)
+            window[i] = -128;
+        else
+            window[i] = (int8_t)value;
+    }
+}
+
+static void test_stride(int stride)
+{
+    imai_ctx_t ctx;
+    int8_t window[TEST_WINDOW_SIZE];
+    float outputs[IMAI_DATA_OUT_COUNT];
+    int first = 0;
+    int windows = 0;
+    int mismatches = 0;
+
+    if (IMAI_MODEL_RET_SUCCESS != imai_model_init(&ctx, &baby_cry_model, NULL, buffer, state, arena))
+    {
+        CHECK(false, "stride %d: init", stride);
+        return;
+    }
+    ctx.window_stride = stride;
+    ctx.model->input_scale = TEST_INPUT_SCALE;
+    ctx.model->input_zero_point = TEST_INPUT_ZERO_POINT;
+
+    for (int i = 0; i < TEST_FRAMES; i++)
+    {
+        CHECK(IMAI_MODEL_RET_SUCCESS == imai_model_enqueue(&ctx, frames[i]), "stride %d: enqueue %d", stride, i);
+        while (IMAI_MODEL_RET_SUCCESS == imai_model_dequeue(&ctx, outputs))
+        {
+            float reference[IMAI_DATA_OUT_COUNT];
+
+            quantize_window(ctx.model, first, window);
+            if (0 != memcmp(window, host_ml_last_input(), sizeof(window)))
+            {
+                mismatches++;
+            }
+
+            mtb_ml_model_run(ctx.model, window);
+            for (int k = 0; k < IMAI_DATA_OUT_COUNT; k++)
+            {
+                reference[k] = (((int8_t*)ctx.model->output)[k] - ctx.model->output_zero_point) *
+                               ctx.model->output_scale;
+            }
+            if (0 != memcmp(reference, outputs, sizeof(outputs)))
+            {
+                mismatches++;
+            }
+            first += stride;
+            windows++;
+        }
+    }
+    imai_model_finalize(&ctx);
+
+    printf("stride %2d: %d windows, %d mismatches\n", stride, windows, mismatches);
+    CHECK(0 == mismatches, "stride %d: %d mismatches", stride, mismatches);
+    CHECK(windows == (TEST_FRAMES - TEST_WINDOW_FRAMES) / stride + 1, "stride %d: %d windows", stride, windows);
+}
+
+int main(void)
+{
+    static const int strides[] = { BABY_CRY_WINDOW_STRIDE, 1, 7, TEST_WINDOW_FRAMES };
+
+    render_frames();
+    host_ml_set_probe(TEST_WINDOW_SIZE);
+    printf("streaming input: %d\n", BABY_CRY_STREAMING);
+    for (size_t i = 0; i < sizeof(strides) / sizeof(strides[0]); i++)
+    {
+        test_stride(strides[i]);
+    }
+
+    printf("%s\n", (0 == failures) ? "PASS" : "FAIL");
+    return (0 == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
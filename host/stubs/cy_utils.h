@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host replacement of the parts of the PDL cy_utils.h the audio code uses */
+
+#ifndef HOST_CY_UTILS_H_
+#define HOST_CY_UTILS_H_
+
+#include <stdint.h>
+#include <assert.h>
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS             ((cy_rslt_t)0x00000000U)
+
+#define CY_ASSERT(x)                assert(x)
+#define CY_UNUSED_PARAMETER(x)      ((void)(x))
+#define CY_ARRAY_SIZE(x)            (sizeof(x) / sizeof((x)[0]))
+
+/* Linker sections of the target have no meaning on the host */
+#define CY_SECTION(name)
+
+#define STRINGIFY(x)                #x
+#define EXPAND_AND_STRINGIFY(x)     STRINGIFY(x)
+
+#endif /* HOST_CY_UTILS_H_ */
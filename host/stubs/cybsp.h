@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host replacement of the BSP header for the portable audio code */
+
+#ifndef HOST_CYBSP_H_
+#define HOST_CYBSP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "cy_utils.h"
+
+/* Ticks per second of cycle_counter_get(), nanoseconds on the host */
+extern uint32_t SystemCoreClock;
+
+#endif /* HOST_CYBSP_H_ */
@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host replacement of the ML middleware, implemented in host/host_platform.c */
+
+#ifndef HOST_MTB_ML_H_
+#define HOST_MTB_ML_H_
+
+#include "cy_utils.h"
+#include "mtb_ml_model.h"
+
+cy_rslt_t mtb_ml_init(int npu_priority);
+cy_rslt_t mtb_ml_deinit(void);
+
+#endif /* HOST_MTB_ML_H_ */
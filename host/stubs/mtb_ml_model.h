@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Host replacement of the ML middleware model API. Only the fields the
+ * generated model code reads are present. */
+
+#ifndef HOST_MTB_ML_MODEL_H_
+#define HOST_MTB_ML_MODEL_H_
+
+#include <stdint.h>
+#include "cy_utils.h"
+
+#define MTB_ML_DATA_T               int8_t
+#define MTB_ML_MODEL_OUTPUT_MAX     (16)
+
+typedef struct
+{
+    const char*     name;
+    uint8_t*        model_bin;
+    int             model_size;
+    int             arena_size;
+} mtb_ml_model_bin_t;
+
+typedef struct
+{
+    uint8_t*        tensor_arena;
+    int             tensor_arena_size;
+} mtb_ml_model_buffer_t;
+
+typedef struct
+{
+    int             input_zero_point;
+    float           input_scale;
+    int             output_zero_point;
+    float           output_scale;
+    MTB_ML_DATA_T*  output;
+    int             output_size;
+    uint32_t        runs;
+    MTB_ML_DATA_T   output_data[MTB_ML_MODEL_OUTPUT_MAX];
+} mtb_ml_model_t;
+
+cy_rslt_t mtb_ml_model_init(const mtb_ml_model_bin_t* bin, const mtb_ml_model_buffer_t* buffer,
+                            mtb_ml_model_t** object);
+cy_rslt_t mtb_ml_model_deinit(mtb_ml_model_t* object);
+cy_rslt_t mtb_ml_model_run(mtb_ml_model_t* object, MTB_ML_DATA_T* input);
+
+#endif /* HOST_MTB_ML_MODEL_H_ */
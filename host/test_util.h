@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Helpers shared by the host tests and evaluation tools: the check of the
+ * tests and the pseudo random numbers of the synthetic signals.
+ *
+ * CHECK() counts into a static int failures that the test defines.
+ */
+
+#ifndef TEST_UTIL_H_
+#define TEST_UTIL_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CHECK(condition, ...)       do { if (!(condition)) { printf("FAIL: " __VA_ARGS__); printf("\n"); failures++; } } while (0)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Linear congruential generator of Numerical Recipes, returns the upper 24
+ * bits of the state */
+static inline uint32_t next_random(uint32_t* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+/* Uniform in [0, 1) */
+static inline double next_uniform(uint32_t* state)
+{
+    return (double)next_random(state) / (double)(1u << 24);
+}
+
+#endif /* TEST_UTIL_H_ */
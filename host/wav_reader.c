@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "wav_reader.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define WAV_FORMAT_PCM              (1u)
+#define WAV_FORMAT_EXTENSIBLE       (0xFFFEu)
+
+/* Upper bound of the channels of one sample frame */
+#define WAV_MAX_CHANNELS            (8u)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static uint32_t wav_le32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t wav_le16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/*******************************************************************************
+* Function Name: wav_reader_open
+********************************************************************************
+* Summary:
+*  Opens a file and positions it at the first sample. WAVE files must hold 16
+*  bit PCM; raw files are taken as mono samples at raw_rate.
+*
+* Parameters:
+*  reader:   reader to initialize
+*  path:     file to open
+*  raw:      file has no header
+*  raw_rate: sample rate of a raw file
+*
+* Return:
+*  WAV_READER_RET_SUCCESS or WAV_READER_RET_ERROR
+*
+*******************************************************************************/
+int wav_reader_open(wav_reader_t* reader, const char* path, bool raw, uint32_t raw_rate)
+{
+    uint8_t header[12];
+    uint8_t chunk[8];
+    bool have_format = false;
+
+    memset(reader, 0, sizeof(*reader));
+    reader->file = fopen(path, "rb");
+    if (NULL == reader->file)
+    {
+        return WAV_READER_RET_ERROR;
+    }
+
+    if (raw)
+    {
+        reader->sample_rate = raw_rate;
+        reader->channels = 1;
+        reader->remaining = UINT32_MAX;
+        return WAV_READER_RET_SUCCESS;
+    }
+
+    if ((1 != fread(header, sizeof(header), 1, reader->file)) ||
+        (0 != memcmp(header, "RIFF", 4)) || (0 != memcmp(&header[8], "WAVE", 4)))
+    {
+        wav_reader_close(reader);
+        return WAV_READER_RET_ERROR;
+    }
+
+    /* Walk the chunks up to the data chunk */
+    while (1 == fread(chunk, sizeof(chunk), 1, reader->file))
+    {
+        uint32_t size = wav_le32(&chunk[4]);
+
+        if (0 == memcmp(chunk, "fmt ", 4))
+        {
+            uint8_t fmt[16];
+            if ((size < sizeof(fmt)) || (1 != fread(fmt, sizeof(fmt), 1, reader->file)))
+            {
+                break;
+            }
+            uint16_t format = wav_le16(&fmt[0]);
+            reader->channels = wav_le16(&fmt[2]);
+            reader->sample_rate = wav_le32(&fmt[4]);
+            if (((WAV_FORMAT_PCM != format) && (WAV_FORMAT_EXTENSIBLE != format)) ||
+                (16 != wav_le16(&fmt[14])) ||
+                (0 == reader->channels) || (reader->channels > WAV_MAX_CHANNELS))
+            {
+                break;
+            }
+            have_format = true;
+            size -= sizeof(fmt);
+        }
+        else if (0 == memcmp(chunk, "data", 4))
+        {
+            if (!have_format)
+            {
+                break;
+            }
+            reader->remaining = size / (2u * reader->channels);
+            return WAV_READER_RET_SUCCESS;
+        }
+
+        /* Chunks are padded to an even size */
+        if (0 != fseek(reader->file, (long)(size + (size & 1u)), SEEK_CUR))
+        {
+            break;
+        }
+    }
+
+    wav_reader_close(reader);
+    return WAV_READER_RET_ERROR;
+}
+
+/*******************************************************************************
+* Function Name: wav_reader_read
+********************************************************************************
+* Summary:
+*  Reads up to count samples of the first channel.
+*
+* Parameters:
+*  reader:  open reader
+*  samples: receives the samples
+*  count:   number of samples wanted
+*
+* Return:
+*  Number of samples read, 0 at the end of the data
+*
+*******************************************************************************/
+uint32_t wav_reader_read(wav_reader_t* reader, int16_t* samples, uint32_t count)
+{
+    uint8_t frame[2u * WAV_MAX_CHANNELS];
+    uint32_t read = 0;
+
+    while ((read < count) && (0 != reader->remaining))
+    {
+        if (1 != fread(frame, 2u * reader->channels, 1, reader->file))
+        {
+            reader->remaining = 0;
+            break;
+        }
+        samples[read++] = (int16_t)wav_le16(frame);
+        reader->remaining--;
+    }
+
+    return read;
+}
+
+/*******************************************************************************
+* Function Name: wav_reader_close
+********************************************************************************
+* Summary:
+*  Closes the file of a reader.
+*
+*******************************************************************************/
+void wav_reader_close(wav_reader_t* reader)
+{
+    if (NULL != reader->file)
+    {
+        fclose(reader->file);
+        reader->file = NULL;
+    }
+}
+
+/* [] END OF FILE */
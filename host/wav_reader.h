@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Streaming reader of 16 bit PCM audio: RIFF/WAVE files or headerless raw
+ * little endian samples. Multi channel files are reduced to their first
+ * channel, which is what the PDM right channel delivers on the target. */
+
+#ifndef WAV_READER_H_
+#define WAV_READER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WAV_READER_RET_SUCCESS      (0)
+#define WAV_READER_RET_ERROR        (-2)
+
+typedef struct
+{
+    FILE*       file;
+    uint32_t    sample_rate;
+    uint16_t    channels;
+    uint32_t    remaining;          /* Sample frames left in the data chunk */
+} wav_reader_t;
+
+int      wav_reader_open(wav_reader_t* reader, const char* path, bool raw, uint32_t raw_rate);
+uint32_t wav_reader_read(wav_reader_t* reader, int16_t* samples, uint32_t count);
+void     wav_reader_close(wav_reader_t* reader);
+
+#endif /* WAV_READER_H_ */
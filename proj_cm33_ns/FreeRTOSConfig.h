@@ -110,7 +110,17 @@ when application makefile has VFP_SELECT configured as softfloat */
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
+#ifdef APP_RUNTIME_STATS
+/* Counted with the LPTimer of the core, see shared/log/rt_stats.h */
+#define configGENERATE_RUN_TIME_STATS           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        rt_stats_counter()
+#if defined (__ICCARM__) || (__GNUC__)
+extern uint32_t rt_stats_counter(void);
+#endif
+#else
 #define configGENERATE_RUN_TIME_STATS           0
+#endif /* APP_RUNTIME_STATS */
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -155,7 +165,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 #define INCLUDE_xTaskGetIdleTaskHandle          0
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
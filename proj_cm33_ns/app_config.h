@@ -38,6 +38,18 @@ In that case, you would need to delete and re-create your device in IoTConnect.
 #define IOTCONNECT_DEVICE_CERT ""
 #define IOTCONNECT_DEVICE_KEY ""
 
+// HTTP server that receives the audio clips around detections when built with CLIP_UPLOAD=1.
+// Every chunk of a clip is POSTed to the path, see clip_codec.h for the format.
+// Plain HTTP on the local network; leave the host empty to discard the clips.
+#define CLIP_UPLOAD_HOST ""
+#define CLIP_UPLOAD_PORT 8080
+#define CLIP_UPLOAD_PATH "/clips"
+
+// Host running host/record_receiver when built with RECORD=TCP.
+// The raw audio is streamed unencrypted, use it on a trusted network only.
+#define RECORD_HOST ""
+#define RECORD_PORT 5005
+
 // you can choose to use your own NTP server to obtain network time, or simply time.google.com for better stability
 #define IOTCONNECT_SNTP_SERVER "pool.ntp.org"
 
@@ -5,13 +5,18 @@
 
 #include "cybsp.h"
 #include <string.h>
+#include <ctype.h>
 
 #include "cy_syslib.h" // for Cy_SysLib_GetUniqueId
 
 #include "FreeRTOS.h"
+#include "task.h"
 
 #include "retarget_io_init.h"
+#include "app_log.h"
 #include "ipc_communication.h"
+#include "rt_stats.h"
+#include "latency_trace.h"
 
 #include "wifi_config.h"
 #include "wifi_app.h"
@@ -20,14 +25,20 @@
 #include "iotc_mtb_time.h"
 
 #include "app_config.h"
+#include "clip_task.h"
 
 
 /////////////////////////////////////////////////////////////////////////////
 
 #define APP_VERSION		"1.1.1"
 
+// Period of the latency histograms
+#define LATENCY_REPORT_PERIOD_MS    (60000u)
+
 static bool is_demo_mode = false;
 static int reporting_interval = 2000;
+static latency_stats_t latency_stats; // of the published decisions, reset every LATENCY_REPORT_PERIOD_MS
+static uint32_t latency_last_sample; // the same decision is published again when the CM55 sends none
 
 /////////////////////////////////////////////////////////////////////////////
 
@@ -35,13 +46,13 @@ static void on_connection_status(IotConnectConnectionStatus status) {
     // Add your own status handling
     switch (status) {
         case IOTC_CS_MQTT_CONNECTED:
-            printf("IoTConnect Client Connected notification.\n");
+            APP_LOG_INFO("IoTConnect Client Connected notification.\n");
             break;
         case IOTC_CS_MQTT_DISCONNECTED:
-            printf("IoTConnect Client Disconnected notification.\n");
+            APP_LOG_INFO("IoTConnect Client Disconnected notification.\n");
             break;
         default:
-            printf("IoTConnect Client ERROR notification\n");
+            APP_LOG_ERROR("IoTConnect Client ERROR notification\n");
             break;
     }
 }
@@ -49,15 +60,15 @@ static void on_connection_status(IotConnectConnectionStatus status) {
 static void on_ota(IotclC2dEventData data) {
     const char *ota_host = iotcl_c2d_get_ota_url_hostname(data, 0);
     if (ota_host == NULL) {
-        printf("OTA host is invalid.\n");
+        APP_LOG_WARN("OTA host is invalid.\n");
         return;
     }
     const char *ota_path = iotcl_c2d_get_ota_url_resource(data, 0);
     if (ota_path == NULL) {
-        printf("OTA resource is invalid.\n");
+        APP_LOG_WARN("OTA resource is invalid.\n");
         return;
     }
-    printf("OTA download request received for https://%s%s, but it is not implemented.\n", ota_host, ota_path);
+    APP_LOG_INFO("OTA download request received for https://%s%s, but it is not implemented.\n", ota_host, ota_path);
 }
 
 // returns success on matching the expected format. Returns is_on, assuming "on" for true, "off" for false
@@ -67,7 +78,7 @@ static bool parse_on_off_command(const char* command, const char* name, bool *ar
     size_t name_len = strlen(name);
     if (0 == strncmp(command, name, name_len)) {
         if (strlen(command) < name_len + 2) { // one for space and at least one character for the argument
-            printf("ERROR: Expected command \"%s\" to have an argument\n", command);
+            APP_LOG_ERROR("Expected command \"%s\" to have an argument\n", command);
             *message = "Command requires an argument";
             *arg_parsing_success = false;
         } else if (0 == strcmp(&command[name_len + 1], "on")) {
@@ -103,7 +114,7 @@ static void on_command(IotclC2dEventData data) {
 
     if (command) {
         bool arg_parsing_success;
-        printf("Command %s received with %s ACK ID\n", command, ack_id ? ack_id : "no");
+        APP_LOG_INFO("Command %s received with %s ACK ID\n", command, ack_id ? ack_id : "no");
         // could be a command without acknowledgment, so ackID can be null
         bool led_on;
         if (parse_on_off_command(command, BOARD_STATUS_LED, &arg_parsing_success, &led_on, &message)) {
@@ -123,16 +134,16 @@ static void on_command(IotclC2dEventData data) {
                 message = "Argument parsing error";
         	} else {
         		reporting_interval = value;
-        		printf("Reporting interval set to %d\n", value);
+        		APP_LOG_INFO("Reporting interval set to %d\n", value);
         		message = "Reporting interval set";
         		command_success =  true;
         	}
         } else {
-            printf("Unknown command \"%s\"\n", command);
+            APP_LOG_WARN("Unknown command \"%s\"\n", command);
             message = "Unknown command";
         }
     } else {
-        printf("Failed to parse command. Command or argument missing?\n");
+        APP_LOG_ERROR("Failed to parse command. Command or argument missing?\n");
         message = "Parsing error";
     }
 
@@ -146,8 +157,32 @@ static void on_command(IotclC2dEventData data) {
         );
     } else {
         // if we send an ack
-        printf("Message status is %s. Message: %s\n", command_success ? "SUCCESS" : "FAILED", message ? message : "<none>");
+        APP_LOG_INFO("Message status is %s. Message: %s\n", command_success ? "SUCCESS" : "FAILED", message ? message : "<none>");
+    }
+}
+
+static uint32_t now_ms(void) {
+    return (uint32_t) (xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+// Adds the model inferences per minute of audio since the previous message and the share of the
+// windows the early exit stage of the CM55 decided without the model.
+static void set_model_rate(IotclMessageHandle msg) {
+    static uint32_t last_windows, last_runs, last_audio_ms;
+    ipc_payload_t payload;
+
+    cm33_ipc_safe_copy_last_payload(&payload);
+    uint32_t windows = payload.windows - last_windows;
+    uint32_t runs = payload.model_runs - last_runs;
+    uint32_t audio_ms = payload.audio_ms - last_audio_ms;
+    // skipped when no window was decided since, or the CM55 started over
+    if ((payload.audio_ms > last_audio_ms) && (payload.windows >= last_windows) && (payload.model_runs >= last_runs)) {
+        iotcl_telemetry_set_number(msg, "npu_runs_per_min", runs * 60000.0 / audio_ms);
+        iotcl_telemetry_set_number(msg, "early_exit_pct", (windows > 0) ? 100.0 * (windows - runs) / windows : 0.0);
     }
+    last_windows = payload.windows;
+    last_runs = payload.model_runs;
+    last_audio_ms = payload.audio_ms;
 }
 
 static cy_rslt_t publish_telemetry(void) {
@@ -155,6 +190,7 @@ static cy_rslt_t publish_telemetry(void) {
     // useful fro debugging - making sure we have te latest data:
     // printf("Has IPC Data: %s\n", cm33_ipc_has_received_message() ? "true" : "false");
     cm33_ipc_safe_get_and_clear_cached_detection(&payload);
+    payload.trace.stamps[LATENCY_STAMP_REPORT] = now_ms();
     IotclMessageHandle msg = iotcl_telemetry_create();
     iotcl_telemetry_set_string(msg, "version", APP_VERSION);
     iotcl_telemetry_set_number(msg, "random", rand() % 100); // test some random numbers
@@ -162,12 +198,265 @@ static cy_rslt_t publish_telemetry(void) {
     iotcl_telemetry_set_number(msg, "class_id", payload.label_id);
     iotcl_telemetry_set_string(msg, "class", payload.label);
 	iotcl_telemetry_set_bool(msg, "event_detected", payload.label_id > 0);
+    iotcl_telemetry_set_number(msg, "agc_gain_db", payload.agc_gain_db);
+    set_model_rate(msg);
+    if (payload.trace.synced) {
+        // from the capture of the newest sample the decision is based on
+        iotcl_telemetry_set_number(msg, "latency_ms",
+            payload.trace.stamps[LATENCY_STAMP_REPORT] - payload.trace.stamps[LATENCY_STAMP_CAPTURE]);
+    }
+#ifdef APP_CLIP_UPLOAD
+    clip_task_stats_t clips;
+    clip_task_get_stats(&clips);
+    iotcl_telemetry_set_number(msg, "clip_id", clips.last_clip);
+    iotcl_telemetry_set_number(msg, "clip_uploaded", clips.uploaded);
+    iotcl_telemetry_set_number(msg, "clip_failed", clips.failed);
+    iotcl_telemetry_set_number(msg, "clip_dropped", clips.dropped);
+    iotcl_telemetry_set_number(msg, "clip_bytes_per_s", clips.bytes_per_s);
+    iotcl_telemetry_set_number(msg, "clip_memory_bytes", clips.memory_bytes);
+#endif
 
     iotcl_mqtt_send_telemetry(msg, false);
     iotcl_telemetry_destroy(msg);
+
+    payload.trace.stamps[LATENCY_STAMP_PUBLISHED] = now_ms();
+    if (payload.trace.sample != latency_last_sample) {
+        latency_stats_record(&latency_stats, &payload.trace);
+        latency_last_sample = payload.trace.sample;
+    }
     return CY_RSLT_SUCCESS;
 }
 
+// Publishes the latency histograms of the decisions as a separate telemetry message every
+// LATENCY_REPORT_PERIOD_MS. Values are in ms, the total histogram as counts per bucket.
+static void publish_latency(void) {
+    static const char* const hop_names[LATENCY_HOP_COUNT] = LATENCY_HOP_NAMES;
+    static const uint32_t bounds[LATENCY_BUCKETS - 1] = LATENCY_BUCKET_BOUNDS_MS;
+    static uint32_t last_report_ms = 0;
+    latency_summary_t summary[LATENCY_HOP_COUNT];
+    char key[32];
+
+    if ((now_ms() - last_report_ms) < LATENCY_REPORT_PERIOD_MS) {
+        return;
+    }
+    last_report_ms = now_ms();
+    if (0 == latency_stats.hops[LATENCY_HOP_TOTAL].count) {
+        return;
+    }
+    latency_stats_summarize(&latency_stats, summary);
+    IotclMessageHandle msg = iotcl_telemetry_create();
+    for (int i = 0; i < LATENCY_HOP_COUNT; i++) {
+        const latency_summary_t* s = &summary[i];
+        snprintf(key, sizeof(key), "lat_%s_count", hop_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->count);
+        snprintf(key, sizeof(key), "lat_%s_mean", hop_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->mean);
+        snprintf(key, sizeof(key), "lat_%s_p50", hop_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->p50);
+        snprintf(key, sizeof(key), "lat_%s_p99", hop_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->p99);
+        snprintf(key, sizeof(key), "lat_%s_max", hop_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->max);
+    }
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+        if (i < LATENCY_BUCKETS - 1u) {
+            snprintf(key, sizeof(key), "lat_total_le_%lu", (unsigned long) bounds[i]);
+        } else {
+            snprintf(key, sizeof(key), "lat_total_gt_%lu", (unsigned long) bounds[i - 1]);
+        }
+        iotcl_telemetry_set_number(msg, key, latency_stats.hops[LATENCY_HOP_TOTAL].hist[i]);
+    }
+
+    iotcl_mqtt_send_telemetry(msg, false);
+    iotcl_telemetry_destroy(msg);
+    APP_LOG_INFO("Latency of the last %lu decisions:\n", (unsigned long) summary[LATENCY_HOP_TOTAL].count);
+    latency_stats_print(&latency_stats, app_log_printf);
+    latency_stats_reset(&latency_stats);
+}
+
+// Publishes the CM55 stage profile as a separate telemetry message, if a new one arrived.
+// Values are in cycles of the CM55 core clock.
+static void publish_diagnostics(void) {
+    static const char* const stage_names[PROF_STAGE_COUNT] = PROF_STAGE_NAMES;
+    ipc_diag_payload_t diag;
+    char key[32];
+
+    if (!cm33_ipc_safe_get_and_clear_diagnostics(&diag)) {
+        return;
+    }
+    IotclMessageHandle msg = iotcl_telemetry_create();
+    iotcl_telemetry_set_number(msg, "prof_core_clock_hz", diag.core_clock_hz);
+    iotcl_telemetry_set_number(msg, "prof_period_ms", diag.period_ms);
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        const prof_summary_t* s = &diag.stages[i];
+        snprintf(key, sizeof(key), "prof_%s_count", stage_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->count);
+        snprintf(key, sizeof(key), "prof_%s_min", stage_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->min);
+        snprintf(key, sizeof(key), "prof_%s_mean", stage_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->mean);
+        snprintf(key, sizeof(key), "prof_%s_max", stage_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->max);
+        snprintf(key, sizeof(key), "prof_%s_p99", stage_names[i]);
+        iotcl_telemetry_set_number(msg, key, s->p99);
+    }
+
+    iotcl_mqtt_send_telemetry(msg, false);
+    iotcl_telemetry_destroy(msg);
+}
+
+#ifdef APP_AUDIO_HEALTH
+// Publishes the CM55 audio input health as a separate telemetry message, if a new report arrived.
+// Levels are in dBFS; clipping and FIFO errors are also logged, as they call for a look at the device.
+static void publish_audio_health(void) {
+    static const char* const fifo_names[AUDIO_HEALTH_FIFO_COUNT] = AUDIO_HEALTH_FIFO_NAMES;
+    audio_health_report_t report;
+    uint32_t fifo_errors = 0;
+    char key[40];
+
+    if (!cm33_ipc_safe_get_and_clear_audio_health(&report)) {
+        return;
+    }
+    IotclMessageHandle msg = iotcl_telemetry_create();
+    iotcl_telemetry_set_number(msg, "audio_period_ms", report.period_ms);
+    iotcl_telemetry_set_number(msg, "audio_agc_limited", report.agc_limited);
+    for (int i = 0; i < AUDIO_HEALTH_FIFO_COUNT; i++) {
+        snprintf(key, sizeof(key), "audio_pdm_%s", fifo_names[i]);
+        iotcl_telemetry_set_number(msg, key, report.fifo[i]);
+        fifo_errors += report.fifo[i];
+    }
+    for (uint32_t c = 0; c < report.channels && c < AUDIO_HEALTH_MAX_CHANNELS; c++) {
+        const audio_health_channel_report_t* ch = &report.ch[c];
+        snprintf(key, sizeof(key), "audio_mic%lu_rms_dbfs", (unsigned long) c);
+        iotcl_telemetry_set_number(msg, key, ch->rms_dbfs);
+        snprintf(key, sizeof(key), "audio_mic%lu_floor_dbfs", (unsigned long) c);
+        iotcl_telemetry_set_number(msg, key, ch->floor_dbfs);
+        snprintf(key, sizeof(key), "audio_mic%lu_peak_dbfs", (unsigned long) c);
+        iotcl_telemetry_set_number(msg, key, ch->peak_dbfs);
+        snprintf(key, sizeof(key), "audio_mic%lu_dc_offset", (unsigned long) c);
+        iotcl_telemetry_set_number(msg, key, ch->dc_offset);
+        snprintf(key, sizeof(key), "audio_mic%lu_clipped", (unsigned long) c);
+        iotcl_telemetry_set_number(msg, key, ch->clipped);
+        if (ch->clipped > 0) {
+            APP_LOG_WARN("Audio: mic %lu clipped %lu of %lu samples\n", (unsigned long) c,
+                         (unsigned long) ch->clipped, (unsigned long) report.samples);
+        }
+    }
+    if (fifo_errors > 0) {
+        APP_LOG_WARN("Audio: %lu PDM FIFO errors in %lu ms\n", (unsigned long) fifo_errors, (unsigned long) report.period_ms);
+    }
+
+    iotcl_mqtt_send_telemetry(msg, false);
+    iotcl_telemetry_destroy(msg);
+}
+#endif /* APP_AUDIO_HEALTH */
+
+#if defined(APP_MODEL_PROFILE) || defined(APP_RUNTIME_STATS)
+// Turns a name sent by the CM55 into part of a telemetry key: lower case, anything but letters and digits
+// becomes '_'. The source is in shared memory, so the copy stops at the size of the destination.
+static void telemetry_key_name(char* name, size_t size, const char* source) {
+    size_t j;
+    for (j = 0; (j < size - 1) && (source[j] != '\0'); j++) {
+        name[j] = isalnum((unsigned char) source[j]) ? (char) tolower((unsigned char) source[j]) : '_';
+    }
+    name[j] = '\0';
+}
+#endif
+
+#ifdef APP_MODEL_PROFILE
+// Publishes the operator profile of the CM55 model once it arrived, taken at boot of the CM55.
+// Operator names and placement become part of the keys: CONV_2D on the CPU as operator 3 is model_op3_cpu_conv_2d_us.
+static void publish_model_profile(void) {
+    static model_profile_report_t report; // too large for a stack frame
+    char key[48];
+    char name[MODEL_PROFILE_NAME_SIZE];
+
+    if (!cm33_ipc_safe_get_and_clear_model_profile(&report)) {
+        return;
+    }
+    uint32_t cycles_per_us = (report.core_clock_hz >= 1000000u) ? (report.core_clock_hz / 1000000u) : 1u;
+    uint32_t listed = (report.op_count < MODEL_PROFILE_MAX_OPS) ? report.op_count : MODEL_PROFILE_MAX_OPS;
+
+    IotclMessageHandle msg = iotcl_telemetry_create();
+    iotcl_telemetry_set_number(msg, "model_ops", report.op_count);
+    iotcl_telemetry_set_number(msg, "model_npu_ops", report.npu_ops);
+    iotcl_telemetry_set_number(msg, "model_weights_size", report.weights_size);
+    iotcl_telemetry_set_number(msg, "model_arena_size", report.arena_size);
+    iotcl_telemetry_set_number(msg, "model_arena_used", report.arena_used);
+    iotcl_telemetry_set_number(msg, "model_inference_mean_us", (double) report.inference_mean / cycles_per_us);
+    iotcl_telemetry_set_number(msg, "model_inference_max_us", (double) report.inference_max / cycles_per_us);
+    APP_LOG_INFO("Model profile: %lu operators, %lu on the NPU, arena %lu of %lu bytes, inference mean %lu us, max %lu us\n",
+                 (unsigned long) report.op_count, (unsigned long) report.npu_ops,
+                 (unsigned long) report.arena_used, (unsigned long) report.arena_size,
+                 (unsigned long) (report.inference_mean / cycles_per_us), (unsigned long) (report.inference_max / cycles_per_us));
+    for (uint32_t i = 0; i < listed; i++) {
+        const model_profile_op_t* op = &report.ops[i];
+        telemetry_key_name(name, sizeof(name), op->name);
+        snprintf(key, sizeof(key), "model_op%lu_%s_%s_us", (unsigned long) i, op->npu ? "npu" : "cpu", name);
+        iotcl_telemetry_set_number(msg, key, (double) op->mean / cycles_per_us);
+        APP_LOG_INFO("  op %-2lu %-20s %s mean %lu us, max %lu us\n", (unsigned long) i, op->name,
+                     op->npu ? "npu" : "cpu", (unsigned long) (op->mean / cycles_per_us), (unsigned long) (op->max / cycles_per_us));
+    }
+    if (report.npu_ops < report.op_count) {
+        APP_LOG_WARN("Model profile: %lu operators fall back to the CPU\n",
+                     (unsigned long) (report.op_count - report.npu_ops));
+    }
+
+    iotcl_mqtt_send_telemetry(msg, false);
+    iotcl_telemetry_destroy(msg);
+}
+#endif /* APP_MODEL_PROFILE */
+
+#ifdef APP_RUNTIME_STATS
+// Publishes a task statistics snapshot of one core as a separate telemetry message.
+// Task names become part of the keys: "IOTC APP task" is rt_cm33_iotc_app_task_cpu_pct.
+static void publish_rt_stats_snapshot(const char* core, const rt_stats_t* stats) {
+    char key[48];
+    char name[RT_STATS_NAME_SIZE];
+
+    IotclMessageHandle msg = iotcl_telemetry_create();
+    snprintf(key, sizeof(key), "rt_%s_period_ms", core);
+    iotcl_telemetry_set_number(msg, key, stats->period_ms);
+    snprintf(key, sizeof(key), "rt_%s_idle_pct", core);
+    iotcl_telemetry_set_number(msg, key, stats->idle_permille / 10.0);
+    snprintf(key, sizeof(key), "rt_%s_heap_free", core);
+    iotcl_telemetry_set_number(msg, key, stats->heap_free);
+    snprintf(key, sizeof(key), "rt_%s_heap_min_free", core);
+    iotcl_telemetry_set_number(msg, key, stats->heap_min_free);
+    for (int i = 0; i < stats->task_count; i++) {
+        const rt_stats_task_t* task = &stats->tasks[i];
+        telemetry_key_name(name, sizeof(name), task->name);
+        snprintf(key, sizeof(key), "rt_%s_%s_cpu_pct", core, name);
+        iotcl_telemetry_set_number(msg, key, task->cpu_permille / 10.0);
+        snprintf(key, sizeof(key), "rt_%s_%s_stack_free", core, name);
+        iotcl_telemetry_set_number(msg, key, task->stack_free);
+    }
+
+    iotcl_mqtt_send_telemetry(msg, false);
+    iotcl_telemetry_destroy(msg);
+    rt_stats_log(core, stats);
+}
+
+// Publishes the task statistics of the CM33 every RT_STATS_PERIOD_MS and those of the CM55 when they arrive.
+static void publish_rt_stats(void) {
+    static rt_stats_t stats; // too large for a stack frame
+    static TickType_t last_tick = 0;
+
+    if (cm33_ipc_safe_get_and_clear_rt_stats(&stats)) {
+        publish_rt_stats_snapshot("cm55", &stats);
+    }
+    if ((xTaskGetTickCount() - last_tick) < pdMS_TO_TICKS(RT_STATS_PERIOD_MS)) {
+        return;
+    }
+    last_tick = xTaskGetTickCount();
+    if (rt_stats_collect(&stats)) {
+        publish_rt_stats_snapshot("cm33", &stats);
+    } else {
+        APP_LOG_WARN("Task statistics: more than %u tasks, raise RT_STATS_MAX_TASKS\n", (unsigned int) RT_STATS_MAX_TASKS);
+    }
+}
+#endif /* APP_RUNTIME_STATS */
+
 void app_task(void *pvParameters) {
     (void) pvParameters;
     
@@ -177,7 +466,7 @@ void app_task(void *pvParameters) {
     while (!cm33_ipc_has_received_message()) {
         taskYIELD(); // wait for CM55
     }
-    printf("App Task: CM55 IPC is ready. Resuming the application...\n");
+    APP_LOG_INFO("App Task: CM55 IPC is ready. Resuming the application...\n");
 
     char iotc_duid[IOTCL_CONFIG_DUID_MAX_LEN] = IOTCONNECT_DUID;
     if (0 == strlen(iotc_duid)) {
@@ -187,11 +476,11 @@ void app_task(void *pvParameters) {
         // feel free to modify the application to use these bytes
         // uint32_t hwuidlo = (uint32_t)(hwuid & 0xFFFFFFFF);
         sprintf(iotc_duid, IOTCONNECT_DUID_PREFIX"%08lx", (unsigned long) hwuidhi);
-        printf("Generated device unique ID (DUID) is: %s\n", iotc_duid);
+        APP_LOG_INFO("Generated device unique ID (DUID) is: %s\n", iotc_duid);
     }
 
     if (strlen(IOTCONNECT_DEVICE_CERT) == 0) {
-		printf("ERROR: Device certificate is missing. Please configure the /IOTCONNECT credentials in app_config.h\n");
+		APP_LOG_ERROR("Device certificate is missing. Please configure the /IOTCONNECT credentials in app_config.h\n");
         goto exit_cleanup;
 	}
 
@@ -216,11 +505,11 @@ void app_task(void *pvParameters) {
         conn_type_str = "Azure";
     }
 
-    printf("Current Settings:\n");
-    printf("Platform: %s\n", conn_type_str);
-    printf("DUID: %s\n", config.duid);
-    printf("CPID: %s\n", config.cpid);
-    printf("ENV: %s\n", config.env);
+    APP_LOG_INFO("Current Settings:\n");
+    APP_LOG_INFO("Platform: %s\n", conn_type_str);
+    APP_LOG_INFO("DUID: %s\n", config.duid);
+    APP_LOG_INFO("CPID: %s\n", config.cpid);
+    APP_LOG_INFO("ENV: %s\n", config.env);
 
     // This will not return if it fails
     wifi_app_connect();
@@ -229,14 +518,14 @@ void app_task(void *pvParameters) {
 
     cy_rslt_t ret = iotconnect_sdk_init(&config);
     if (CY_RSLT_SUCCESS != ret) {
-        printf("Failed to initialize the IoTConnect SDK. Error code: %u\n", (unsigned int) ret);
+        APP_LOG_ERROR("Failed to initialize the IoTConnect SDK. Error code: %u\n", (unsigned int) ret);
         goto exit_cleanup;
     }
 
     for (int i = 0; i < 10; i++) {
         ret = iotconnect_sdk_connect();
         if (CY_RSLT_SUCCESS != ret) {
-            printf("Failed to initialize the IoTConnect SDK. Error code: %u\n", (unsigned int) ret);
+            APP_LOG_ERROR("Failed to initialize the IoTConnect SDK. Error code: %u\n", (unsigned int) ret);
             goto exit_cleanup;
         }
         
@@ -246,20 +535,31 @@ void app_task(void *pvParameters) {
             if (result != CY_RSLT_SUCCESS) {
                 break;
                 }
+            publish_diagnostics();
+            publish_latency();
+#ifdef APP_AUDIO_HEALTH
+            publish_audio_health();
+#endif
+#ifdef APP_RUNTIME_STATS
+            publish_rt_stats();
+#endif
+#ifdef APP_MODEL_PROFILE
+            publish_model_profile();
+#endif
             iotconnect_sdk_poll_inbound_mq(reporting_interval);
         }
         iotconnect_sdk_disconnect();
     }
     iotconnect_sdk_deinit();
 
-    printf("\nAppTask Done.\n");
+    APP_LOG_INFO("AppTask Done.\n");
     while (1) {
         taskYIELD();
     }
     return;
 
     exit_cleanup:
-    printf("\nError encountered. AppTask Done.\n");
+    APP_LOG_ERROR("Error encountered. AppTask Done.\n");
     while (1) {
         taskYIELD();
     }
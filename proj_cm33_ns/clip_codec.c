@@ -0,0 +1,230 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "clip_codec.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* IMA ADPCM quantizer steps and step index adaptation */
+static const int16_t adpcm_steps[89] =
+{
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t adpcm_index_adjust[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Reconstructs a sample from a code and adapts the state, shared by the
+ * encoder and the decoder so that both track the same predictor */
+static inline void adpcm_update(adpcm_state_t* state, uint8_t code)
+{
+    int32_t step = adpcm_steps[state->step_index];
+    int32_t delta = step >> 3;
+    int32_t predictor = state->predictor;
+    int32_t index = (int32_t)state->step_index + adpcm_index_adjust[code & 7u];
+
+    if (code & 4u)
+    {
+        delta += step;
+    }
+    if (code & 2u)
+    {
+        delta += step >> 1;
+    }
+    if (code & 1u)
+    {
+        delta += step >> 2;
+    }
+    predictor += (code & 8u) ? -delta : delta;
+
+    state->predictor = (int16_t)((predictor > 32767) ? 32767 : (predictor < -32768) ? -32768 : predictor);
+    state->step_index = (uint8_t)((index < 0) ? 0 : (index > 88) ? 88 : index);
+}
+
+static inline uint8_t adpcm_encode_sample(adpcm_state_t* state, int16_t sample)
+{
+    int32_t step = adpcm_steps[state->step_index];
+    int32_t diff = (int32_t)sample - state->predictor;
+    uint8_t code = 0u;
+
+    if (diff < 0)
+    {
+        code = 8u;
+        diff = -diff;
+    }
+    if (diff >= step)
+    {
+        code |= 4u;
+        diff -= step;
+    }
+    if (diff >= (step >> 1))
+    {
+        code |= 2u;
+        diff -= step >> 1;
+    }
+    if (diff >= (step >> 2))
+    {
+        code |= 1u;
+    }
+    adpcm_update(state, code);
+    return code;
+}
+
+static void put_u16(uint8_t* out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* out, uint32_t value)
+{
+    put_u16(out, (uint16_t)value);
+    put_u16(&out[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t* in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* in)
+{
+    return get_u16(in) | ((uint32_t)get_u16(&in[2]) << 16);
+}
+
+/*******************************************************************************
+* Function Name: clip_chunk_count
+********************************************************************************
+* Summary:
+*  Number of chunks of a clip.
+*
+*******************************************************************************/
+uint16_t clip_chunk_count(uint32_t clip_samples)
+{
+    return (uint16_t)((clip_samples + CLIP_CHUNK_SAMPLES - 1u) / CLIP_CHUNK_SAMPLES);
+}
+
+/*******************************************************************************
+* Function Name: clip_chunk_encode
+********************************************************************************
+* Summary:
+*  Codes info->samples samples of a ring, starting at index first and
+*  wrapping at capacity, into one chunk. The coder state continues from the
+*  previous chunk of the clip and is stored in the header.
+*
+* Parameters:
+*  info:     header fields, info->state is filled in
+*  state:    coder state, zeroed for the first chunk of a clip
+*  ring:     PCM samples
+*  capacity: ring size
+*  first:    ring index of the first sample of the chunk
+*  out:      CLIP_CHUNK_MAX_SIZE bytes
+*
+* Return:
+*  Size of the chunk in bytes
+*
+*******************************************************************************/
+uint32_t clip_chunk_encode(clip_chunk_info_t* info, adpcm_state_t* state, const int16_t* ring,
+                           uint32_t capacity, uint32_t first, uint8_t* out)
+{
+    uint8_t* coded = &out[CLIP_CHUNK_HEADER_SIZE];
+    uint32_t index = first;
+
+    info->state = *state;
+    put_u32(&out[0], CLIP_CHUNK_MAGIC);
+    put_u32(&out[4], info->sequence);
+    put_u16(&out[8], info->index);
+    put_u16(&out[10], info->count);
+    put_u32(&out[12], info->sample_rate);
+    put_u32(&out[16], info->clip_samples);
+    put_u32(&out[20], info->trigger);
+    put_u32(&out[24], info->label_id);
+    put_u16(&out[28], info->samples);
+    put_u16(&out[30], (uint16_t)state->predictor);
+    out[32] = state->step_index;
+    out[33] = CLIP_CODEC_IMA_ADPCM;
+    put_u16(&out[34], 0u);
+
+    for (uint32_t i = 0; i < info->samples; i++)
+    {
+        uint8_t code = adpcm_encode_sample(state, ring[index]);
+        index = (index + 1u < capacity) ? index + 1u : 0u;
+        if (0u == (i & 1u))
+        {
+            coded[i / 2u] = code;
+        }
+        else
+        {
+            coded[i / 2u] |= (uint8_t)(code << 4);
+        }
+    }
+    return CLIP_CHUNK_HEADER_SIZE + (info->samples + 1u) / 2u;
+}
+
+/*******************************************************************************
+* Function Name: clip_chunk_decode
+********************************************************************************
+* Summary:
+*  Parses a chunk and decodes its samples. Used by receivers and tests.
+*
+* Parameters:
+*  chunk: chunk as produced by clip_chunk_encode()
+*  size:  chunk size in bytes
+*  info:  receives the header fields
+*  pcm:   receives info->samples samples, at most CLIP_CHUNK_SAMPLES
+*
+* Return:
+*  CLIP_CODEC_RET_SUCCESS or CLIP_CODEC_RET_ERROR for a malformed chunk
+*
+*******************************************************************************/
+int clip_chunk_decode(const uint8_t* chunk, uint32_t size, clip_chunk_info_t* info, int16_t* pcm)
+{
+    adpcm_state_t state;
+
+    if ((size < CLIP_CHUNK_HEADER_SIZE) || (CLIP_CHUNK_MAGIC != get_u32(chunk)) ||
+        (CLIP_CODEC_IMA_ADPCM != chunk[33]))
+    {
+        return CLIP_CODEC_RET_ERROR;
+    }
+    info->sequence = get_u32(&chunk[4]);
+    info->index = get_u16(&chunk[8]);
+    info->count = get_u16(&chunk[10]);
+    info->sample_rate = get_u32(&chunk[12]);
+    info->clip_samples = get_u32(&chunk[16]);
+    info->trigger = get_u32(&chunk[20]);
+    info->label_id = get_u32(&chunk[24]);
+    info->samples = get_u16(&chunk[28]);
+    info->state.predictor = (int16_t)get_u16(&chunk[30]);
+    info->state.step_index = chunk[32];
+    if ((info->samples > CLIP_CHUNK_SAMPLES) || (info->state.step_index > 88u) ||
+        (size < CLIP_CHUNK_HEADER_SIZE + (info->samples + 1u) / 2u) || (info->index >= info->count))
+    {
+        return CLIP_CODEC_RET_ERROR;
+    }
+
+    state = info->state;
+    for (uint32_t i = 0; i < info->samples; i++)
+    {
+        uint8_t byte = chunk[CLIP_CHUNK_HEADER_SIZE + i / 2u];
+        adpcm_update(&state, (0u == (i & 1u)) ? (byte & 0x0Fu) : (byte >> 4));
+        pcm[i] = state.predictor;
+    }
+    return CLIP_CODEC_RET_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Compressed chunks of the audio clips uploaded by clip_task.c.
+ *
+ * A clip is split into chunks of CLIP_CHUNK_SAMPLES 16 bit PCM samples,
+ * each coded with IMA ADPCM at 4 bits per sample. Every chunk starts with
+ * a little endian header that carries the coder state, so chunks decode
+ * independently and a receiver can reassemble a clip from any order:
+ *
+ *   offset  size  field
+ *        0     4  magic "CLP1"
+ *        4     4  clip sequence number
+ *        8     2  chunk index
+ *       10     2  chunk count
+ *       12     4  sample rate in Hz
+ *       16     4  samples of the whole clip
+ *       20     4  samples from the clip start to the detection
+ *       24     4  label id of the detection
+ *       28     2  samples in this chunk
+ *       30     2  ADPCM predictor at the chunk start
+ *       32     1  ADPCM step index at the chunk start
+ *       33     1  codec, CLIP_CODEC_IMA_ADPCM
+ *       34     2  reserved
+ *       36        coded samples, two per byte, first sample in the low nibble
+ */
+
+#ifndef CLIP_CODEC_H_
+#define CLIP_CODEC_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef CLIP_CHUNK_SAMPLES
+#define CLIP_CHUNK_SAMPLES          (4096u)
+#endif
+
+#define CLIP_CHUNK_MAGIC            (0x31504C43u)   /* "CLP1" */
+#define CLIP_CHUNK_HEADER_SIZE      (36u)
+#define CLIP_CHUNK_MAX_SIZE         (CLIP_CHUNK_HEADER_SIZE + (CLIP_CHUNK_SAMPLES + 1u) / 2u)
+
+#define CLIP_CODEC_IMA_ADPCM        (1u)
+
+#define CLIP_CODEC_RET_SUCCESS      (0)
+#define CLIP_CODEC_RET_ERROR        (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    int16_t     predictor;
+    uint8_t     step_index;
+} adpcm_state_t;
+
+/* Header fields of a chunk */
+typedef struct
+{
+    uint32_t    sequence;
+    uint16_t    index;
+    uint16_t    count;
+    uint32_t    sample_rate;
+    uint32_t    clip_samples;
+    uint32_t    trigger;
+    uint32_t    label_id;
+    uint16_t    samples;
+    adpcm_state_t state;
+} clip_chunk_info_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint16_t clip_chunk_count(uint32_t clip_samples);
+uint32_t clip_chunk_encode(clip_chunk_info_t* info, adpcm_state_t* state, const int16_t* ring,
+                           uint32_t capacity, uint32_t first, uint8_t* out);
+int      clip_chunk_decode(const uint8_t* chunk, uint32_t size, clip_chunk_info_t* info,
+                           int16_t* pcm);
+
+#endif /* CLIP_CODEC_H_ */
@@ -0,0 +1,193 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include "cybsp.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cy_wcm.h"
+#include "cy_http_client_api.h"
+
+#include "retarget_io_init.h"
+#include "app_log.h"
+#include "ipc_communication.h"
+
+#include "app_config.h"
+#include "clip_upload.h"
+#include "clip_task.h"
+
+#ifdef APP_CLIP_UPLOAD
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Period at which the task looks for a new clip from the CM55 */
+#define CLIP_TASK_POLL_MS           (100u)
+
+#define CLIP_HTTP_TIMEOUT_MS        (5000u)
+#define CLIP_HTTP_BUFFER_SIZE       (1024u)     /* Request and response headers */
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static clip_uploader_t uploader;
+static uint8_t http_buffer[CLIP_HTTP_BUFFER_SIZE];
+static clip_task_stats_t task_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void clip_sleep_ms(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+static uint32_t clip_now_ms(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: clip_http_send
+********************************************************************************
+* Summary:
+*  Transport of clip_upload(): one HTTP POST of a chunk to CLIP_UPLOAD_PATH
+*  on the connection the task opened for the clip.
+*
+* Return:
+*  0 if the server answered with a 2xx status
+*
+*******************************************************************************/
+static int clip_http_send(void* arg, const uint8_t* chunk, uint32_t size)
+{
+    cy_http_client_t handle = (cy_http_client_t)arg;
+    cy_http_client_request_header_t request;
+    cy_http_client_header_t header;
+    cy_http_client_response_t response;
+
+    memset(&request, 0, sizeof(request));
+    request.buffer = http_buffer;
+    request.buffer_len = sizeof(http_buffer);
+    request.method = CY_HTTP_CLIENT_METHOD_POST;
+    request.range_start = -1;
+    request.range_end = -1;
+    request.resource_path = CLIP_UPLOAD_PATH;
+
+    header.field = "Content-Type";
+    header.field_len = strlen(header.field);
+    header.value = "application/octet-stream";
+    header.value_len = strlen(header.value);
+
+    if (CY_RSLT_SUCCESS != cy_http_client_write_header(handle, &request, &header, 1)) {
+        return -1;
+    }
+    if (CY_RSLT_SUCCESS != cy_http_client_send(handle, &request, (uint8_t *) chunk, size, &response)) {
+        return -1;
+    }
+    return ((response.status_code >= 200) && (response.status_code < 300)) ? 0 : -1;
+}
+
+/*******************************************************************************
+* Function Name: clip_upload_one
+********************************************************************************
+* Summary:
+*  Opens a connection to the clip server, uploads the clip and closes the
+*  connection.
+*
+*******************************************************************************/
+static int clip_upload_one(const ipc_clip_payload_t* payload)
+{
+    cy_awsport_server_info_t server_info;
+    cy_http_client_t handle;
+    clip_source_t clip;
+    int ret = CLIP_UPLOAD_RET_ERROR;
+
+    if (!cy_wcm_is_connected_to_ap()) {
+        return CLIP_UPLOAD_RET_ERROR;
+    }
+
+    memset(&server_info, 0, sizeof(server_info));
+    server_info.host_name = CLIP_UPLOAD_HOST;
+    server_info.port = CLIP_UPLOAD_PORT;
+    if (CY_RSLT_SUCCESS != cy_http_client_create(NULL, &server_info, NULL, NULL, &handle)) {
+        return CLIP_UPLOAD_RET_ERROR;
+    }
+    if (CY_RSLT_SUCCESS == cy_http_client_connect(handle, CLIP_HTTP_TIMEOUT_MS, CLIP_HTTP_TIMEOUT_MS)) {
+        clip.ring = payload->samples;
+        clip.capacity = payload->capacity;
+        clip.start = payload->start;
+        clip.length = payload->length;
+        clip.sample_rate = payload->sample_rate;
+        clip.trigger = payload->trigger;
+        clip.sequence = payload->sequence;
+        clip.label_id = payload->label_id;
+
+        uploader.port.arg = (void *) handle;
+        ret = clip_upload(&uploader, &clip);
+        cy_http_client_disconnect(handle);
+    }
+    cy_http_client_delete(handle);
+    return ret;
+}
+
+/*******************************************************************************
+* Function Name: clip_task
+********************************************************************************
+* Summary:
+*  Uploads every clip the CM55 freezes to the HTTP server of app_config.h and
+*  releases the CM55 ring afterwards. Runs below the telemetry task, clips
+*  are only sent while the telemetry task waits.
+*
+*******************************************************************************/
+void clip_task(void *pvParameters) {
+    static const clip_upload_port_t port = { clip_http_send, clip_sleep_ms, clip_now_ms, NULL };
+    ipc_clip_payload_t payload;
+    uint32_t received = 0;
+
+    (void) pvParameters;
+
+    clip_upload_init(&uploader, &port, CLIP_UPLOAD_MAX_BYTES_PER_S);
+    bool configured = (0 != strlen(CLIP_UPLOAD_HOST)) && (CY_RSLT_SUCCESS == cy_http_client_init());
+    if (!configured) {
+        APP_LOG_INFO("Clip Task: no clip server configured, clips are discarded.\n");
+    }
+
+    while (1) {
+        if (!cm33_ipc_safe_get_and_clear_clip(&payload)) {
+            vTaskDelay(pdMS_TO_TICKS(CLIP_TASK_POLL_MS));
+            continue;
+        }
+        received++;
+
+        if (configured && (CLIP_UPLOAD_RET_SUCCESS != clip_upload_one(&payload))) {
+            APP_LOG_ERROR("Clip Task: upload of clip %lu failed.\n", (unsigned long) payload.sequence);
+        }
+        // the samples are not touched after this, the CM55 resumes recording into the ring
+        cm33_ipc_release_clip();
+        clip_upload_print_stats(&uploader, app_log_printf);
+
+        taskENTER_CRITICAL();
+        task_stats.uploaded = uploader.clips;
+        task_stats.failed = received - uploader.clips;
+        task_stats.dropped = payload.dropped;
+        task_stats.last_clip = payload.sequence;
+        task_stats.bytes_per_s = clip_upload_bytes_per_s(&uploader);
+        task_stats.memory_bytes = sizeof(uploader) + sizeof(http_buffer);
+        taskEXIT_CRITICAL();
+    }
+}
+
+void clip_task_get_stats(clip_task_stats_t* stats) {
+    taskENTER_CRITICAL();
+    memcpy(stats, &task_stats, sizeof(clip_task_stats_t));
+    taskEXIT_CRITICAL();
+}
+
+#endif /* APP_CLIP_UPLOAD */
+
+/* [] END OF FILE */
@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#ifndef CLIP_TASK_H_
+#define CLIP_TASK_H_
+
+#include <stdint.h>
+
+/* Below the telemetry of app_task, so that uploads never delay it */
+#define CLIP_TASK_PRIORITY      (1)
+#define CLIP_TASK_STACK_SIZE    (1024 * 4)
+
+typedef struct {
+    uint32_t uploaded;          // clips uploaded
+    uint32_t failed;            // clips given up
+    uint32_t dropped;           // detections the CM55 had no free ring for
+    uint32_t last_clip;         // sequence number of the last clip handled
+    uint32_t bytes_per_s;       // mean upload throughput
+    uint32_t memory_bytes;      // buffers of the upload on the CM33
+} clip_task_stats_t;
+
+void clip_task(void *pvParameters);
+void clip_task_get_stats(clip_task_stats_t* stats);
+
+#endif /* CLIP_TASK_H_ */
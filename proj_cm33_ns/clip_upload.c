@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "clip_upload.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: clip_upload_init
+********************************************************************************
+* Summary:
+*  Binds the platform functions and clears the statistics.
+*
+* Parameters:
+*  up:              uploader instance
+*  port:            transport, clock and sleep of the platform
+*  max_bytes_per_s: cap of the upload rate, 0 for none
+*
+*******************************************************************************/
+void clip_upload_init(clip_uploader_t* up, const clip_upload_port_t* port, uint32_t max_bytes_per_s)
+{
+    memset(up, 0, sizeof(*up));
+    up->port = *port;
+    up->max_bytes_per_s = max_bytes_per_s;
+}
+
+/* Sleeps until sent bytes fit the rate cap since start */
+static void clip_upload_pace(clip_uploader_t* up, uint32_t start, uint32_t sent)
+{
+    if (0u != up->max_bytes_per_s)
+    {
+        uint32_t due = (uint32_t)(((uint64_t)sent * 1000u + up->max_bytes_per_s - 1u) / up->max_bytes_per_s);
+        uint32_t elapsed = up->port.now_ms() - start;
+        if (due > elapsed)
+        {
+            up->port.sleep_ms(due - elapsed);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: clip_upload
+********************************************************************************
+* Summary:
+*  Codes and sends all chunks of a clip, in order, at most at the capped
+*  rate. A chunk that fails is retried CLIP_UPLOAD_RETRIES times before the
+*  clip is given up. The ring is only read, the caller releases it after the
+*  call.
+*
+* Parameters:
+*  up:   uploader instance
+*  clip: frozen clip
+*
+* Return:
+*  CLIP_UPLOAD_RET_SUCCESS or CLIP_UPLOAD_RET_ERROR if a chunk could not be
+*  sent
+*
+*******************************************************************************/
+int clip_upload(clip_uploader_t* up, const clip_source_t* clip)
+{
+    const uint32_t start = up->port.now_ms();
+    clip_chunk_info_t info;
+    adpcm_state_t state = { 0, 0 };
+    uint32_t first = clip->start;
+    uint32_t sent = 0u;
+    int ret = CLIP_UPLOAD_RET_SUCCESS;
+
+    info.sequence = clip->sequence;
+    info.count = clip_chunk_count(clip->length);
+    info.sample_rate = clip->sample_rate;
+    info.clip_samples = clip->length;
+    info.trigger = clip->trigger;
+    info.label_id = clip->label_id;
+
+    for (uint16_t index = 0; (index < info.count) && (CLIP_UPLOAD_RET_SUCCESS == ret); index++)
+    {
+        uint32_t offset = (uint32_t)index * CLIP_CHUNK_SAMPLES;
+        uint32_t size;
+        uint32_t attempt = 0u;
+
+        info.index = index;
+        info.samples = (uint16_t)(((clip->length - offset) < CLIP_CHUNK_SAMPLES) ?
+                                  (clip->length - offset) : CLIP_CHUNK_SAMPLES);
+        size = clip_chunk_encode(&info, &state, clip->ring, clip->capacity, first, up->chunk);
+        first = (first + info.samples) % clip->capacity;
+
+        while (0 != up->port.send(up->port.arg, up->chunk, size))
+        {
+            if (attempt++ >= CLIP_UPLOAD_RETRIES)
+            {
+                ret = CLIP_UPLOAD_RET_ERROR;
+                break;
+            }
+            up->retries++;
+        }
+        if (CLIP_UPLOAD_RET_SUCCESS == ret)
+        {
+            sent += size;
+            up->chunks++;
+            clip_upload_pace(up, start, sent);
+        }
+    }
+
+    up->sent_bytes += sent;
+    up->last_ms = up->port.now_ms() - start;
+    up->busy_ms += up->last_ms;
+    up->last_sequence = clip->sequence;
+    if (CLIP_UPLOAD_RET_SUCCESS == ret)
+    {
+        up->pcm_bytes += (uint64_t)clip->length * sizeof(int16_t);
+        up->clips++;
+    }
+    else
+    {
+        up->failed++;
+    }
+    return ret;
+}
+
+/*******************************************************************************
+* Function Name: clip_upload_bytes_per_s
+********************************************************************************
+* Summary:
+*  Mean upload throughput while uploading.
+*
+*******************************************************************************/
+uint32_t clip_upload_bytes_per_s(const clip_uploader_t* up)
+{
+    return (0u != up->busy_ms) ? (uint32_t)((up->sent_bytes * 1000u) / up->busy_ms) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: clip_upload_print_stats
+********************************************************************************
+* Summary:
+*  Prints the clip counts, the compression and the throughput.
+*
+* Parameters:
+*  up:    uploader instance
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void clip_upload_print_stats(const clip_uploader_t* up, clip_upload_print_fn print)
+{
+    print("clip upload: clips %lu, failed %lu, chunks %lu, retries %lu, %lu of %lu bytes, "
+          "%lu bytes/s, buffer %lu bytes\r\n",
+          (unsigned long)up->clips, (unsigned long)up->failed, (unsigned long)up->chunks,
+          (unsigned long)up->retries, (unsigned long)up->sent_bytes, (unsigned long)up->pcm_bytes,
+          (unsigned long)clip_upload_bytes_per_s(up), (unsigned long)sizeof(up->chunk));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Chunked upload of one audio clip.
+ *
+ * Codes the clip chunk by chunk with clip_codec.h straight from the frozen
+ * ring and hands every chunk to a transport. The only buffer is one coded
+ * chunk. The upload rate is capped, so the uploader never takes more than
+ * its share of the network from the telemetry. The transport, the clock and
+ * the sleep are supplied by the platform: clip_task.c on the CM33, the host
+ * test in host/clip_upload_test.c.
+ */
+
+#ifndef CLIP_UPLOAD_H_
+#define CLIP_UPLOAD_H_
+
+#include <stdint.h>
+#include "clip_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef CLIP_UPLOAD_MAX_BYTES_PER_S
+#define CLIP_UPLOAD_MAX_BYTES_PER_S (16384u)
+#endif
+#ifndef CLIP_UPLOAD_RETRIES
+#define CLIP_UPLOAD_RETRIES         (2u)        /* Further attempts per chunk */
+#endif
+
+#define CLIP_UPLOAD_RET_SUCCESS     (0)
+#define CLIP_UPLOAD_RET_ERROR       (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Sends one chunk, returns 0 on success */
+typedef int (*clip_send_fn)(void* arg, const uint8_t* chunk, uint32_t size);
+
+typedef struct
+{
+    clip_send_fn    send;
+    void            (*sleep_ms)(uint32_t ms);
+    uint32_t        (*now_ms)(void);
+    void*           arg;
+} clip_upload_port_t;
+
+/* A frozen clip: length samples from index start of the ring, wrapping */
+typedef struct
+{
+    const int16_t*  ring;
+    uint32_t        capacity;
+    uint32_t        start;
+    uint32_t        length;
+    uint32_t        sample_rate;
+    uint32_t        trigger;
+    uint32_t        sequence;
+    uint32_t        label_id;
+} clip_source_t;
+
+typedef struct
+{
+    clip_upload_port_t port;
+    uint32_t        max_bytes_per_s;    /* 0 = unlimited */
+    uint8_t         chunk[CLIP_CHUNK_MAX_SIZE];
+
+    /* Statistics */
+    uint32_t        clips;
+    uint32_t        failed;             /* Clips given up */
+    uint32_t        chunks;
+    uint32_t        retries;
+    uint64_t        pcm_bytes;
+    uint64_t        sent_bytes;
+    uint32_t        busy_ms;            /* Time spent uploading */
+    uint32_t        last_ms;            /* Duration of the last clip */
+    uint32_t        last_sequence;
+} clip_uploader_t;
+
+/* printf compatible sink for clip_upload_print_stats() */
+typedef int (*clip_upload_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void     clip_upload_init(clip_uploader_t* up, const clip_upload_port_t* port, uint32_t max_bytes_per_s);
+int      clip_upload(clip_uploader_t* up, const clip_source_t* clip);
+uint32_t clip_upload_bytes_per_s(const clip_uploader_t* up);
+void     clip_upload_print_stats(const clip_uploader_t* up, clip_upload_print_fn print);
+
+#endif /* CLIP_UPLOAD_H_ */
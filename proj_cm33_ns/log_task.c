@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ipc_communication.h"
+#include "app_log.h"
+#include "log_task.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records formatted per pass, then the other tasks of the same priority get a turn */
+#define LOG_TASK_BATCH              (8u)
+
+#define LOG_TASK_IDLE_MS            (20u)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static uint32_t log_now_ms(void)
+{
+    TickType_t ticks = xPortIsInsideInterrupt() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+    return (uint32_t)(ticks * portTICK_PERIOD_MS);
+}
+
+static void log_write(const char* text, uint32_t size)
+{
+    fwrite(text, 1, size, stdout);
+    fflush(stdout);
+}
+
+/*******************************************************************************
+* Function Name: log_task_init
+********************************************************************************
+* Summary:
+*  Sets up the log before the scheduler starts, so that the tasks can log
+*  from their first line. Needs retarget-io.
+*
+*******************************************************************************/
+void log_task_init(void)
+{
+    static const app_log_port_t port = { log_now_ms, log_write, APP_LOG_CORE_CM33 };
+
+    app_log_init(&port, APP_LOG_LEVEL_INFO);
+}
+
+/*******************************************************************************
+* Function Name: log_task
+********************************************************************************
+* Summary:
+*  Formats the records of the log and the ones forwarded by the CM55 and
+*  writes them to the debug UART through retarget-io. Only this task waits
+*  for the UART, the tasks that log do not.
+*
+*******************************************************************************/
+void log_task(void *pvParameters) {
+    (void) pvParameters;
+
+    while (1) {
+        log_stream_t* cm55 = cm33_ipc_get_log_stream();
+        uint32_t written = app_log_drain(LOG_TASK_BATCH);
+
+        if (NULL != cm55) {
+            written += log_stream_drain(cm55, log_write, LOG_TASK_BATCH);
+        }
+        if (0u != written) {
+            taskYIELD();
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(LOG_TASK_IDLE_MS));
+        }
+    }
+}
+
+/* [] END OF FILE */
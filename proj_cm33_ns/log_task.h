@@ -0,0 +1,16 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#ifndef LOG_TASK_H_
+#define LOG_TASK_H_
+
+/* Lowest application priority: the UART is written only when nothing else runs */
+#define LOG_TASK_PRIORITY       (1)
+#define LOG_TASK_STACK_SIZE     (1024 * 2)
+
+void log_task_init(void);
+void log_task(void *pvParameters);
+
+#endif /* LOG_TASK_H_ */
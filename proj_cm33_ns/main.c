@@ -42,6 +42,9 @@
 #include "cybsp.h"
 #include "retarget_io_init.h"
 #include "app_task.h"
+#include "clip_task.h"
+#include "record_task.h"
+#include "log_task.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "cyabs_rtos.h"
@@ -49,6 +52,7 @@
 #include "cy_time.h"
 #include "cycfg_peripherals.h"
 #include "ipc_communication.h"
+#include "rt_stats.h"
 
 /******************************************************************************
  * Macros
@@ -200,9 +204,17 @@ int main(void)
     /* Setup the LPTimer instance for CM33 CPU. */
     setup_tickless_idle_timer();
 
+#ifdef APP_RUNTIME_STATS
+    /* The run time of the tasks is counted with the same LPTimer */
+    rt_stats_init(&lptimer_obj);
+#endif
+
     /* Initialize retarget-io middleware */
     init_retarget_io();
 
+    /* The tasks log through log_task */
+    log_task_init();
+
     /* Initialize rtc */
     Cy_RTC_Init(&CYBSP_RTC_config);
     Cy_RTC_SetDateAndTime(&CYBSP_RTC_config);
@@ -225,11 +237,33 @@ int main(void)
     /* Enable CM55. CY_CORTEX_M55_APPL_ADDR must be updated if CM55 memory layout is changed. */
     Cy_SysEnableCM55(MXCM55, CY_CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_US);
 
+    result = xTaskCreate(log_task, "Log task", LOG_TASK_STACK_SIZE,
+                NULL, LOG_TASK_PRIORITY, NULL);
+    if( pdPASS != result ) {
+		handle_app_error();
+	}
+
     result = xTaskCreate(app_task, "IOTC APP task", APP_TASK_STACK_SIZE,
                 NULL, APP_TASK_PRIORITY, NULL);
     if( pdPASS != result ) {
 		handle_app_error();
 	}
+
+#ifdef APP_CLIP_UPLOAD
+    result = xTaskCreate(clip_task, "Clip upload task", CLIP_TASK_STACK_SIZE,
+                NULL, CLIP_TASK_PRIORITY, NULL);
+    if( pdPASS != result ) {
+		handle_app_error();
+	}
+#endif
+
+#ifdef APP_RECORD
+    result = xTaskCreate(record_task, "Record task", RECORD_TASK_STACK_SIZE,
+                NULL, RECORD_TASK_PRIORITY, NULL);
+    if( pdPASS != result ) {
+		handle_app_error();
+	}
+#endif
              
             
     if( pdPASS == result )
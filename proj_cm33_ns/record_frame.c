@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include "record_frame.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* CRC-32 of a nibble, polynomial 0xEDB88320. Two lookups per byte keep the
+ * table at 64 bytes; a 1024 sample frame costs about 20k cycles. */
+static const uint32_t crc32_nibble[16] =
+{
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void put_u16(uint8_t* out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* out, uint32_t value)
+{
+    put_u16(out, (uint16_t)value);
+    put_u16(&out[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t* in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* in)
+{
+    return get_u16(in) | ((uint32_t)get_u16(&in[2]) << 16);
+}
+
+/*******************************************************************************
+* Function Name: record_frame_header
+********************************************************************************
+* Summary:
+*  Writes the RECORD_FRAME_HEADER_SIZE bytes of a frame header.
+*
+*******************************************************************************/
+void record_frame_header(const record_frame_info_t* info, uint8_t* header)
+{
+    put_u32(&header[0], RECORD_FRAME_MAGIC);
+    put_u32(&header[4], info->sequence);
+    put_u32(&header[8], info->sample_rate);
+    put_u16(&header[12], info->channels);
+    put_u16(&header[14], info->samples);
+    put_u32(&header[16], info->overruns);
+}
+
+/*******************************************************************************
+* Function Name: record_frame_parse_header
+********************************************************************************
+* Summary:
+*  Reads a frame header. Only the magic and the bounds are checked, the CRC
+*  at the end of the frame confirms the header.
+*
+* Return:
+*  RECORD_FRAME_RET_SUCCESS or RECORD_FRAME_RET_ERROR if this is no header
+*
+*******************************************************************************/
+int record_frame_parse_header(const uint8_t* header, record_frame_info_t* info)
+{
+    if (RECORD_FRAME_MAGIC != get_u32(&header[0]))
+    {
+        return RECORD_FRAME_RET_ERROR;
+    }
+    info->sequence = get_u32(&header[4]);
+    info->sample_rate = get_u32(&header[8]);
+    info->channels = get_u16(&header[12]);
+    info->samples = get_u16(&header[14]);
+    info->overruns = get_u32(&header[16]);
+
+    if ((0u == info->channels) || (0u == info->samples) ||
+        ((uint32_t)info->channels * info->samples > RECORD_FRAME_MAX_SAMPLES))
+    {
+        return RECORD_FRAME_RET_ERROR;
+    }
+    return RECORD_FRAME_RET_SUCCESS;
+}
+
+/* Bytes of the samples of a frame */
+uint32_t record_frame_payload_size(const record_frame_info_t* info)
+{
+    return (uint32_t)info->channels * info->samples * sizeof(int16_t);
+}
+
+/*******************************************************************************
+* Function Name: record_frame_crc32
+********************************************************************************
+* Summary:
+*  CRC-32 as in zlib and Ethernet. Start with 0 and pass the result of a
+*  block as crc of the next one.
+*
+*******************************************************************************/
+uint32_t record_frame_crc32(uint32_t crc, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0Fu];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Frames of the raw audio stream of the recording mode (record_task.c).
+ *
+ * Every PDM frame is sent as a little endian header, the interleaved 16 bit
+ * PCM samples and a CRC-32 (as zlib) of header and samples. A receiver
+ * finds the frames in a byte stream by the magic and the CRC, so the stream
+ * survives lost bytes and console output on the same UART:
+ *
+ *   offset  size  field
+ *        0     4  magic "REC1"
+ *        4     4  frame sequence number, from 0, a gap means lost frames
+ *        8     4  sample rate in Hz
+ *       12     2  channels
+ *       14     2  samples per channel
+ *       16     4  frames the device dropped so far
+ *       20        samples x channels PCM samples, interleaved
+ *          +   4  CRC-32 of all bytes before it
+ */
+
+#ifndef RECORD_FRAME_H_
+#define RECORD_FRAME_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RECORD_FRAME_MAGIC          (0x31434552u)   /* "REC1" */
+#define RECORD_FRAME_HEADER_SIZE    (20u)
+#define RECORD_FRAME_CRC_SIZE       (4u)
+
+/* Bound of samples x channels a receiver accepts */
+#define RECORD_FRAME_MAX_SAMPLES    (8192u)
+
+#define RECORD_FRAME_RET_SUCCESS    (0)
+#define RECORD_FRAME_RET_ERROR      (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    sequence;
+    uint32_t    sample_rate;
+    uint16_t    channels;
+    uint16_t    samples;
+    uint32_t    overruns;
+} record_frame_info_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void     record_frame_header(const record_frame_info_t* info, uint8_t* header);
+int      record_frame_parse_header(const uint8_t* header, record_frame_info_t* info);
+uint32_t record_frame_payload_size(const record_frame_info_t* info);
+uint32_t record_frame_crc32(uint32_t crc, const void* data, uint32_t size);
+
+#endif /* RECORD_FRAME_H_ */
@@ -0,0 +1,249 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include "cybsp.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef APP_RECORD_TCP
+#include "cy_wcm.h"
+#include "cy_secure_sockets.h"
+#endif
+
+#include "retarget_io_init.h"
+#include "app_log.h"
+#include "ipc_communication.h"
+
+#include "app_config.h"
+#include "record_frame.h"
+#include "record_task.h"
+
+#ifdef APP_RECORD
+
+#if !defined(APP_RECORD_TCP) && !defined(APP_RECORD_UART)
+#error "RECORD must be TCP or UART"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Well below the 64 ms of a PDM frame */
+#define RECORD_POLL_MS              (10u)
+
+/* Wait before connecting again to the receiver */
+#define RECORD_RETRY_MS             (2000u)
+
+#define RECORD_REPORT_PERIOD_MS     (10000u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#ifdef APP_RECORD_TCP
+static cy_socket_t record_socket;
+#endif
+static bool record_connected;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+#ifdef APP_RECORD_TCP
+/*******************************************************************************
+* Function Name: record_open
+********************************************************************************
+* Summary:
+*  Connects to the receiver at RECORD_HOST:RECORD_PORT once Wi-Fi is up.
+*
+*******************************************************************************/
+static bool record_open(void)
+{
+    cy_socket_sockaddr_t address;
+
+    if (record_connected) {
+        return true;
+    }
+    if (!cy_wcm_is_connected_to_ap()) {
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    if (CY_RSLT_SUCCESS != cy_socket_gethostbyname(RECORD_HOST, CY_SOCKET_IP_VER_V4, &address.ip_address)) {
+        return false;
+    }
+    address.port = RECORD_PORT;
+    if (CY_RSLT_SUCCESS != cy_socket_create(CY_SOCKET_DOMAIN_AF_INET, CY_SOCKET_TYPE_STREAM,
+                                            CY_SOCKET_IPPROTO_TCP, &record_socket)) {
+        return false;
+    }
+    if (CY_RSLT_SUCCESS != cy_socket_connect(record_socket, &address, sizeof(address))) {
+        cy_socket_delete(record_socket);
+        return false;
+    }
+    APP_LOG_INFO("Record Task: streaming to %s:%u\n", RECORD_HOST, (unsigned) RECORD_PORT);
+    record_connected = true;
+    return true;
+}
+
+static void record_close(void)
+{
+    cy_socket_disconnect(record_socket, 0);
+    cy_socket_delete(record_socket);
+    record_connected = false;
+}
+
+static bool record_send(const void* data, uint32_t size)
+{
+    const uint8_t* bytes = (const uint8_t*) data;
+    uint32_t sent;
+
+    while (size > 0u) {
+        if (CY_RSLT_SUCCESS != cy_socket_send(record_socket, bytes, size, CY_SOCKET_FLAGS_NONE, &sent)) {
+            return false;
+        }
+        bytes += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+#else /* APP_RECORD_UART */
+
+static bool record_open(void)
+{
+    record_connected = true;
+    return true;
+}
+
+static void record_close(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: record_send
+********************************************************************************
+* Summary:
+*  Writes to the TX FIFO of the debug UART and gives up the CPU while the FIFO
+*  is full, instead of the busy wait of Cy_SCB_UART_PutArrayBlocking().
+*
+*******************************************************************************/
+static bool record_send(const void* data, uint32_t size)
+{
+    uint8_t* bytes = (uint8_t*) data;
+
+    while (size > 0u) {
+        uint32_t put = Cy_SCB_UART_PutArray(CYBSP_DEBUG_UART_HW, bytes, size);
+        if (0u == put) {
+            vTaskDelay(1);
+        }
+        bytes += put;
+        size -= put;
+    }
+    return true;
+}
+
+#endif /* APP_RECORD_TCP */
+
+/*******************************************************************************
+* Function Name: record_send_frame
+********************************************************************************
+* Summary:
+*  Sends one frame of the ring with its header and CRC, see record_frame.h.
+*  The samples are sent from the shared memory of the CM55 without a copy.
+*
+*******************************************************************************/
+static bool record_send_frame(const record_ring_t* ring, const int16_t* pcm, uint32_t sequence)
+{
+    uint8_t header[RECORD_FRAME_HEADER_SIZE];
+    uint8_t trailer[RECORD_FRAME_CRC_SIZE];
+    record_frame_info_t info;
+    uint32_t crc;
+
+    info.sequence = sequence;
+    info.sample_rate = ring->sample_rate;
+    info.channels = (uint16_t) ring->channels;
+    info.samples = (uint16_t) ring->frame_samples;
+    info.overruns = ring->overruns;
+    record_frame_header(&info, header);
+
+    crc = record_frame_crc32(0u, header, sizeof(header));
+    crc = record_frame_crc32(crc, pcm, record_frame_payload_size(&info));
+    for (uint32_t i = 0; i < sizeof(trailer); i++) {
+        trailer[i] = (uint8_t) (crc >> (8u * i));
+    }
+
+    return record_send(header, sizeof(header))
+        && record_send(pcm, record_frame_payload_size(&info))
+        && record_send(trailer, sizeof(trailer));
+}
+
+/*******************************************************************************
+* Function Name: record_task
+********************************************************************************
+* Summary:
+*  Recording mode: sends every raw PDM frame the CM55 puts into the ring to
+*  the receiver, host/record_receiver. Frames captured while there is no
+*  receiver are discarded.
+*
+*******************************************************************************/
+void record_task(void *pvParameters) {
+    record_ring_t* ring;
+    uint32_t sent = 0;
+    uint32_t failed = 0;
+    TickType_t report = xTaskGetTickCount();
+
+    (void) pvParameters;
+
+    while (NULL == (ring = cm33_ipc_get_record_ring())) {
+        vTaskDelay(pdMS_TO_TICKS(RECORD_RETRY_MS));
+    }
+    APP_LOG_INFO("Record Task: %lu Hz, %lu channel(s), ring of %lu frames of %lu samples\n",
+           (unsigned long) ring->sample_rate, (unsigned long) ring->channels,
+           (unsigned long) ring->frames, (unsigned long) ring->frame_samples);
+
+#ifdef APP_RECORD_TCP
+    if ((0 == strlen(RECORD_HOST)) || (CY_RSLT_SUCCESS != cy_socket_init())) {
+        APP_LOG_INFO("Record Task: no receiver configured, recording is off.\n");
+        vTaskSuspend(NULL);
+    }
+#endif
+
+    while (1) {
+        const int16_t* pcm;
+        uint32_t sequence;
+
+        if (!record_open()) {
+            record_stream_skip(ring);
+            vTaskDelay(pdMS_TO_TICKS(RECORD_RETRY_MS));
+            continue;
+        }
+
+        pcm = record_stream_peek(ring, &sequence);
+        if (NULL == pcm) {
+            vTaskDelay(pdMS_TO_TICKS(RECORD_POLL_MS));
+            continue;
+        }
+
+        if (record_send_frame(ring, pcm, sequence)) {
+            sent++;
+        } else {
+            // the receiver sees the lost frame as a gap
+            failed++;
+            record_close();
+        }
+        record_stream_consume(ring);
+
+        if ((xTaskGetTickCount() - report) >= pdMS_TO_TICKS(RECORD_REPORT_PERIOD_MS)) {
+            report = xTaskGetTickCount();
+            APP_LOG_INFO("Record Task: %lu frames sent, %lu failed, %lu overruns\n",
+                   (unsigned long) sent, (unsigned long) failed, (unsigned long) ring->overruns);
+        }
+    }
+}
+
+#endif /* APP_RECORD */
+
+/* [] END OF FILE */
@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#ifndef RECORD_TASK_H_
+#define RECORD_TASK_H_
+
+/* Above the telemetry of app_task: in the recording mode the stream comes first */
+#define RECORD_TASK_PRIORITY    (3)
+#define RECORD_TASK_STACK_SIZE  (1024 * 4)
+
+void record_task(void *pvParameters);
+
+#endif /* RECORD_TASK_H_ */
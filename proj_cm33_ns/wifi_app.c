@@ -60,6 +60,7 @@
 /* Middleware libraries */
 #include "cy_wcm.h"
 #include "retarget_io_init.h"
+#include "app_log.h"
 
 #include "wifi_config.h"
 
@@ -91,7 +92,7 @@
                          }                                     \
                          else                                  \
                          {                                     \
-                             printf(error_message);            \
+                             APP_LOG_ERROR(error_message);     \
                              return result;                    \
                          }                                     \
                      } while(0)
@@ -141,7 +142,7 @@ static cy_rslt_t wifi_connect(void)
         memcpy(connect_param.ap_credentials.password, WIFI_PASSWORD, sizeof(WIFI_PASSWORD));
         connect_param.ap_credentials.security = WIFI_SECURITY;
 
-        printf("\nWi-Fi Connecting to '%s'\n", connect_param.ap_credentials.SSID);
+        APP_LOG_INFO("Wi-Fi Connecting to '%s'\n", connect_param.ap_credentials.SSID);
 
         /* Connect to the Wi-Fi AP. */
         for (uint32_t retry_count = 0; retry_count < MAX_WIFI_CONN_RETRIES; retry_count++)
@@ -150,7 +151,7 @@ static cy_rslt_t wifi_connect(void)
 
             if (CY_RSLT_SUCCESS == result)
             {
-                printf("Successfully connected to Wi-Fi network '%s'.\n", connect_param.ap_credentials.SSID);
+                APP_LOG_INFO("Successfully connected to Wi-Fi network '%s'.\n", connect_param.ap_credentials.SSID);
 
                 /* Set the appropriate bit in the status_flag to denote
                  * successful Wi-Fi connection, print the assigned IP address.
@@ -158,22 +159,22 @@ static cy_rslt_t wifi_connect(void)
                 status_flag |= WIFI_CONNECTED;
                 if (ip_address.version == CY_WCM_IP_VER_V4)
                 {
-                    printf("IPv4 Address Assigned: %s\n\n", ip4addr_ntoa((const ip4_addr_t *) &ip_address.ip.v4));
+                    APP_LOG_INFO("IPv4 Address Assigned: %s\n", ip4addr_ntoa((const ip4_addr_t *) &ip_address.ip.v4));
                 }
                 else if (ip_address.version == CY_WCM_IP_VER_V6)
                 {
-                    printf("IPv6 Address Assigned: %s\n\n", ip6addr_ntoa((const ip6_addr_t *) &ip_address.ip.v6));
+                    APP_LOG_INFO("IPv6 Address Assigned: %s\n", ip6addr_ntoa((const ip6_addr_t *) &ip_address.ip.v6));
                 }
                 return result;
             }
 
-            printf("Wi-Fi Connection failed. Error code:0x%0X. Retrying in %d ms. Retries left: %d\n",
+            APP_LOG_ERROR("Wi-Fi Connection failed. Error code:0x%0X. Retrying in %d ms. Retries left: %d\n",
                 (int)result, WIFI_CONN_RETRY_INTERVAL_MS, (int)(MAX_WIFI_CONN_RETRIES - retry_count - 1));
             vTaskDelay(pdMS_TO_TICKS(WIFI_CONN_RETRY_INTERVAL_MS));
         }
 
-        printf("\nExceeded maximum Wi-Fi connection attempts!\n");
-        printf("Wi-Fi connection failed after retrying for %d mins\n\n",
+        APP_LOG_ERROR("Exceeded maximum Wi-Fi connection attempts!\n");
+        APP_LOG_ERROR("Wi-Fi connection failed after retrying for %d mins\n",
             (int)(WIFI_CONN_RETRY_INTERVAL_MS * MAX_WIFI_CONN_RETRIES) / TIME_DIV_MS);
     }
     return result;
@@ -290,7 +291,7 @@ void wifi_app_connect(void) {
      * upon failure.
      */
     if (CY_RSLT_SUCCESS != cy_wcm_init(&wcm_config)) {
-        printf("Failed to intialize the WiFi interface.\n");
+        APP_LOG_ERROR("Failed to intialize the WiFi interface.\n");
         while (1) { taskYIELD(); }
     }
     status_flag |= WCM_INITIALIZED;
@@ -298,14 +299,14 @@ void wifi_app_connect(void) {
     /* Set the appropriate bit in the status_flag to denote successful
      * WCM initialization.
      */
-    printf("Wi-Fi Connection Manager initialized.\n");
+    APP_LOG_INFO("Wi-Fi Connection Manager initialized.\n");
 
     /* Initiate connection to the Wi-Fi AP and cleanup if the operation fails. */
     if (CY_RSLT_SUCCESS == wifi_connect()) {
-		printf("wifi is connected.\n");
+		APP_LOG_INFO("wifi is connected.\n");
 	} else {
 		if (CY_RSLT_SUCCESS != wifi_connect()) {
-			printf("wifi failed to connect.\n");
+			APP_LOG_ERROR("wifi failed to connect.\n");
 			while (1) { taskYIELD(); }
 		}
 	}
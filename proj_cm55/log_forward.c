@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ipc_communication.h"
+#include "app_log.h"
+#include "log_stream.h"
+#include "log_forward.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records moved to the CM33 per pass of cm55_task */
+#define LOG_FORWARD_BATCH           (16u)
+
+/* Clock synchronization with the CM33: period, retry until the first one
+ * succeeds and how long an answer is waited for */
+#define LOG_FORWARD_SYNC_MS         (10000u)
+#define LOG_FORWARD_RETRY_MS        (500u)
+#define LOG_FORWARD_SYNC_WAIT_MS    (100u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+CY_SECTION_SHAREDMEM static log_stream_t log_stream;
+static uint32_t log_sync_ms;
+static uint32_t log_sync_request;
+static uint32_t log_sync_sent_ms;
+static bool log_sync_pending;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static uint32_t log_now_ms(void)
+{
+    TickType_t ticks = xPortIsInsideInterrupt() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+    return (uint32_t)(ticks * portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: log_forward_init
+********************************************************************************
+* Summary:
+*  Sets up the log of the CM55. The CM55 has no console of its own: its
+*  records go to the CM33, which writes them with its own.
+*
+*******************************************************************************/
+void log_forward_init(void)
+{
+    static const app_log_port_t port = { log_now_ms, NULL, APP_LOG_CORE_CM55 };
+
+    log_stream_init(&log_stream);
+    app_log_init(&port, APP_LOG_LEVEL_INFO);
+}
+
+/*******************************************************************************
+* Function Name: log_forward_sync
+********************************************************************************
+* Summary:
+*  Measures the offset to the clock of the CM33 without waiting: one call
+*  sends the request, the following ones look for the answer. A request that is not answered within
+*  LOG_FORWARD_SYNC_WAIT_MS is given up and the next period tries again, a
+*  busy pipe is tried again on the next call.
+*
+*******************************************************************************/
+static void log_forward_sync(uint32_t now)
+{
+    if (log_sync_pending)
+    {
+        if (log_stream_sync_end(&log_stream, log_sync_request, log_sync_sent_ms) ||
+            ((now - log_sync_sent_ms) >= LOG_FORWARD_SYNC_WAIT_MS))
+        {
+            log_sync_pending = false;
+        }
+        return;
+    }
+
+    if ((now - log_sync_ms) < (log_stream.synced ? LOG_FORWARD_SYNC_MS : LOG_FORWARD_RETRY_MS))
+    {
+        return;
+    }
+    log_sync_request = log_stream_sync_begin(&log_stream);
+    log_sync_sent_ms = log_now_ms();
+    if (cm55_ipc_send_log_to_cm33(&log_stream))
+    {
+        log_sync_ms = now;
+        log_sync_pending = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: log_forward_service
+********************************************************************************
+* Summary:
+*  Moves the records logged since the last call to the CM33, without
+*  formatting them. Called once per pass of cm55_task, after the audio.
+*
+*******************************************************************************/
+void log_forward_service(void)
+{
+    uint32_t now = log_now_ms();
+    app_log_stats_t stats;
+
+    log_forward_sync(now);
+
+    app_log_get_stats(&stats);
+    log_stream_report_drops(&log_stream, stats.dropped, now);
+    (void)app_log_forward(log_stream_write, &log_stream, LOG_FORWARD_BATCH);
+}
+
+/*******************************************************************************
+* Function Name: log_forward_flush
+********************************************************************************
+* Summary:
+*  Forwards the queued records, a tick at a time while the stream to the CM33
+*  is full or not synchronized yet. For code that holds cm55_task longer than
+*  the log ring lasts, like the benchmark.
+*
+* Parameters:
+*  timeout_ms: longest wait
+*
+* Return:
+*  false if records are still queued after timeout_ms
+*
+*******************************************************************************/
+bool log_forward_flush(uint32_t timeout_ms)
+{
+    const uint32_t start = log_now_ms();
+
+    for (;;)
+    {
+        log_forward_service();
+        (void)app_log_forward(log_stream_write, &log_stream, 0u);
+
+        /* app_log_forward() only stops early when the stream refuses a record */
+        if (log_stream.synced && ((log_stream.written - log_stream.consumed) < LOG_STREAM_RECORDS))
+        {
+            return true;
+        }
+        if ((log_now_ms() - start) >= timeout_ms)
+        {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+}
+
+bool log_forward_cm33_ms(uint32_t cm55_ms, uint32_t* cm33_ms)
+{
+    *cm33_ms = cm55_ms + (uint32_t)log_stream.offset_ms;
+    return log_stream.synced;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#ifndef LOG_FORWARD_H_
+#define LOG_FORWARD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void log_forward_init(void);
+void log_forward_service(void);
+
+/* Forwards until the records logged so far are in the stream, false if
+ * some are still queued after timeout_ms */
+bool log_forward_flush(uint32_t timeout_ms);
+
+/* A time of the CM55 tick count in ms of the CM33, false until the clocks
+ * are synchronized */
+bool log_forward_cm33_ms(uint32_t cm55_ms, uint32_t* cm33_ms);
+
+#endif /* LOG_FORWARD_H_ */
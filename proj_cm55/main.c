@@ -44,11 +44,18 @@
 #include "cyabs_rtos_impl.h"
 
 #include "ipc_communication.h"
+#include "app_log.h"
+#include "log_forward.h"
+#include "rt_stats.h"
 //#include "retarget_io_init.h"
 #ifdef ML_DEEPCRAFT_CM55
 #include "stdlib.h"
 #include "audio.h"
 #include "baby_cry.h"
+#ifdef AUDIO_BENCHMARK
+#include <stdarg.h>
+#include "audio_bench.h"
+#endif
 #endif /* ML_DEEPCRAFT_CM55 */
 
 /*****************************************************************************
@@ -58,6 +65,10 @@
 #define TASK_STACK_SIZE          (configMINIMAL_STACK_SIZE * 4)
 #define TASK_PRIORITY            (configMAX_PRIORITIES - 1)
 #define TASK_DELAY_MSEC          (500U)
+/* Longest wait of a pass, the log forwarding runs at least this often */
+#define TASK_WAIT_MSEC           (50U)
+/* Longest wait of the benchmark for room in the log forwarded to the CM33 */
+#define BENCH_LOG_FLUSH_MSEC     (2000U)
 
 /* Enabling or disabling a MCWDT requires a wait time of upto 2 CLK_LF cycles  
  * to come into effect. This wait time value will depend on the actual CLK_LF  
@@ -75,6 +86,12 @@
 
 static mtb_hal_lptimer_t lptimer_obj;
 
+#ifdef ML_DEEPCRAFT_CM55
+/* The task stack is placed in the audio memory region by audio_model_init() */
+static StaticTask_t cm55_task_tcb;
+static StackType_t* cm55_task_stack;
+#endif /* ML_DEEPCRAFT_CM55 */
+
 /*****************************************************************************
  * Function Definitions
  *****************************************************************************/
@@ -84,6 +101,67 @@ static cy_rslt_t system_init(void);
 static void cm55_ml_deepcraft_init(void);
 #endif /* ML_DEEPCRAFT_CM55 */
 
+#ifdef APP_RUNTIME_STATS
+/*******************************************************************************
+ * Function Name: cm55_rt_stats_service
+ *******************************************************************************
+ * Summary:
+ * Takes a snapshot of the tasks every RT_STATS_PERIOD_MS and sends it to the
+ * CM33, again on the next pass while the pipe is busy.
+ *
+ *******************************************************************************/
+static void cm55_rt_stats_service(void)
+{
+    static rt_stats_t stats;
+    static TickType_t last_tick;
+    static bool pending;
+
+    if (!pending && ((xTaskGetTickCount() - last_tick) >= pdMS_TO_TICKS(RT_STATS_PERIOD_MS)))
+    {
+        last_tick = xTaskGetTickCount();
+        pending = rt_stats_collect(&stats);
+    }
+    if (pending)
+    {
+        pending = !cm55_ipc_send_rt_stats_to_cm33(&stats);
+    }
+}
+#endif /* APP_RUNTIME_STATS */
+
+#ifdef AUDIO_BENCHMARK
+/*******************************************************************************
+ * Function Name: cm55_task_stack_used
+ *******************************************************************************
+ * Summary:
+ * Stack high-water mark of the calling task in bytes, for the benchmark.
+ *
+ *******************************************************************************/
+static uint32_t cm55_task_stack_used(void)
+{
+    return (TASK_STACK_SIZE * 4 - uxTaskGetStackHighWaterMark(NULL)) * sizeof(StackType_t);
+}
+
+/*******************************************************************************
+ * Function Name: cm55_bench_print
+ *******************************************************************************
+ * Summary:
+ * Output of the benchmark. The CM55 has no console: every line goes to the
+ * log, which the CM33 prints. The benchmark holds cm55_task, so the line is
+ * forwarded here instead of in the loop of the task.
+ *
+ *******************************************************************************/
+static int cm55_bench_print(const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    (void)app_log_vprintf(format, args);
+    va_end(args);
+    (void)log_forward_flush(BENCH_LOG_FLUSH_MSEC);
+    return 0;
+}
+#endif /* AUDIO_BENCHMARK */
+
 /*******************************************************************************
  * Function Name: cm55_task
  *******************************************************************************
@@ -104,12 +182,33 @@ static void cm55_task(void * arg)
 {
     CY_UNUSED_PARAMETER(arg);
 
+    APP_LOG_INFO("CM55 task started, core clock %lu Hz", (unsigned long)SystemCoreClock);
+
+    #ifdef AUDIO_BENCHMARK
+    /* Stress mode: the PDM is not started and the pipeline runs back to back
+     * on synthetic audio, see shared/audio/audio_bench.h */
+    audio_bench_run("cm55", audio_bench_configs, audio_bench_config_count,
+                    AUDIO_BENCH_SECONDS, cm55_task_stack_used, cm55_bench_print);
+    vTaskSuspend(NULL);
+    #endif /* AUDIO_BENCHMARK */
+
     for (;;)
     {     	
        	#ifdef ML_DEEPCRAFT_CM55
-		pdm_data_process();
+		if (PDM_PCM_DATA_NOT_READY == pdm_data_process())
+		{
+			/* Sleep until the next frame or decision instead of spinning, the
+			 * inference task and the idle task get the CPU meanwhile */
+			audio_wait(TASK_WAIT_MSEC);
+		}
+		#else
+		Cy_SysLib_Delay(TASK_WAIT_MSEC);
+		#endif
+		/* The pipeline only queues its records, the CM33 writes them */
+		log_forward_service();
+		#ifdef APP_RUNTIME_STATS
+		cm55_rt_stats_service();
 		#endif
-       	Cy_SysLib_Delay(50);
     	
         //vTaskSuspend(NULL);
     }
@@ -242,12 +341,19 @@ int main(void)
     
     /* Setup the LPTimer instance for CM55*/
     setup_tickless_idle_timer();
+
+    #ifdef APP_RUNTIME_STATS
+    /* The run time of the tasks is counted with the same LPTimer */
+    rt_stats_init(&lptimer_obj);
+    #endif
     
     
     /* Initialize retarget-io middleware */ 
     // init_retarget_io(); //for printf
     
     
+    log_forward_init();
+
     /* Setup IPC communication for CM55*/
     cm55_ipc_communication_setup();
 
@@ -259,9 +365,15 @@ int main(void)
 	#endif /* ML_DEEPCRAFT_CM55 */
 
     /* Create the FreeRTOS Task */
+    #ifdef ML_DEEPCRAFT_CM55
+    result = (NULL != xTaskCreateStatic(cm55_task, TASK_NAME,
+                        TASK_STACK_SIZE * 4, NULL,
+                        TASK_PRIORITY, cm55_task_stack, &cm55_task_tcb)) ? pdPASS : pdFAIL;
+    #else
     result = xTaskCreate(cm55_task, TASK_NAME,
                         TASK_STACK_SIZE * 4, NULL,
                         TASK_PRIORITY, NULL);
+    #endif /* ML_DEEPCRAFT_CM55 */
 
     if( pdPASS == result )
     {
@@ -291,11 +403,19 @@ static cy_rslt_t system_init(void)
 {
     cy_rslt_t result;
 
-    /* Initialize DEEPCRAFT pre-processing library */
-    IMAI_init();
+    /* Plan the audio memory, initialize the DEEPCRAFT pre-processing and the
+     * model instance */
+    result = audio_model_init(TASK_STACK_SIZE * 4 * sizeof(StackType_t),
+                              (void**)&cm55_task_stack);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
 
+    #ifndef AUDIO_BENCHMARK
     /* Configure PDM, PDM clocks, and PDM event */
     result = pdm_init();
+    #endif /* AUDIO_BENCHMARK */
 
     return result;
 }
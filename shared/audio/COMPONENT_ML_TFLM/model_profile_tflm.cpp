@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Boot time operator profile of model_profile.h, TFLM builds of the CM55
+ * with APP_MODEL_PROFILE only. */
+
+#ifdef APP_MODEL_PROFILE
+
+#include <string.h>
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "cycle_counter.h"
+#include "model_profile.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Operators the profiling interpreter can run. Models exported for the NPU
+ * have the ethos-u operator plus the few Vela left on the CPU; a model with
+ * another operator fails in AllocateTensors(). */
+#define MODEL_PROFILE_RESOLVER_OPS      (16u)
+
+/* Handle of events that are not operators of the graph */
+#define MODEL_PROFILE_NO_OP             (0xFFFFFFFFu)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+namespace {
+
+/* Micro profiler of the interpreter. TFLM opens one event per operator,
+ * tagged with the name of model_profile_init(), in execution order. */
+class OpProfiler : public tflite::MicroProfilerInterface
+{
+public:
+    explicit OpProfiler(model_profile_t* prof) : prof_(prof), next_(0u) {}
+
+    /* Operators are counted from 0 for every Invoke() */
+    void StartInference() { next_ = 0u; }
+
+    uint32_t BeginEvent(const char* tag) override
+    {
+        uint32_t index = next_;
+
+        if ((index >= prof_->report.op_count) || (index >= MODEL_PROFILE_MAX_OPS) ||
+            (0 != strncmp(tag, prof_->report.ops[index].name, MODEL_PROFILE_NAME_SIZE - 1u)))
+        {
+            return MODEL_PROFILE_NO_OP;
+        }
+        next_++;
+        start_[index] = cycle_counter_get();
+        return index;
+    }
+
+    void EndEvent(uint32_t event_handle) override
+    {
+        if (MODEL_PROFILE_NO_OP != event_handle)
+        {
+            model_profile_op(prof_, event_handle, cycle_counter_get() - start_[event_handle]);
+        }
+    }
+
+private:
+    model_profile_t*    prof_;
+    uint32_t            next_;
+    uint32_t            start_[MODEL_PROFILE_MAX_OPS];
+};
+
+} /* namespace */
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: model_profile_run
+********************************************************************************
+* Summary:
+*  Runs the model on a zero input in a TFLM interpreter with the micro
+*  profiler attached and records every operator and every inference. The
+*  ML runtime and the NPU must be initialized. prof must have been set up by
+*  model_profile_init() with the same model and the size of the arena.
+*
+* Parameters:
+*  prof:  profile
+*  model: TFLite flatbuffer, where the application executes it from
+*  arena: tensor arena of prof->report.arena_size bytes, 16-byte aligned
+*  runs:  inferences
+*
+* Return:
+*  MODEL_PROFILE_RET_SUCCESS or MODEL_PROFILE_RET_ERROR
+*
+*******************************************************************************/
+extern "C" int model_profile_run(model_profile_t* prof, const uint8_t* model, uint8_t* arena, uint32_t runs)
+{
+    const tflite::Model* graph = tflite::GetModel(model);
+    tflite::MicroMutableOpResolver<MODEL_PROFILE_RESOLVER_OPS> resolver;
+    OpProfiler profiler(prof);
+
+    if (graph->version() != TFLITE_SCHEMA_VERSION)
+    {
+        return MODEL_PROFILE_RET_ERROR;
+    }
+
+    resolver.AddEthosU();
+    resolver.AddAdd();
+    resolver.AddAveragePool2D();
+    resolver.AddConcatenation();
+    resolver.AddConv2D();
+    resolver.AddDepthwiseConv2D();
+    resolver.AddDequantize();
+    resolver.AddFullyConnected();
+    resolver.AddLogistic();
+    resolver.AddMaxPool2D();
+    resolver.AddMean();
+    resolver.AddMul();
+    resolver.AddPad();
+    resolver.AddQuantize();
+    resolver.AddReshape();
+    resolver.AddSoftmax();
+
+    tflite::MicroInterpreter interpreter(graph, resolver, arena, prof->report.arena_size, nullptr, &profiler);
+    if (kTfLiteOk != interpreter.AllocateTensors())
+    {
+        return MODEL_PROFILE_RET_ERROR;
+    }
+
+    TfLiteTensor* input = interpreter.input(0);
+    memset(input->data.raw, 0, input->bytes);
+
+    for (uint32_t i = 0; i < runs; i++)
+    {
+        uint32_t start;
+
+        profiler.StartInference();
+        start = cycle_counter_get();
+        if (kTfLiteOk != interpreter.Invoke())
+        {
+            return MODEL_PROFILE_RET_ERROR;
+        }
+        model_profile_inference(prof, cycle_counter_get() - start);
+    }
+    prof->report.arena_used = (uint32_t)interpreter.arena_used_bytes();
+
+    return MODEL_PROFILE_RET_SUCCESS;
+}
+
+#endif /* APP_MODEL_PROFILE */
+
+/* [] END OF FILE */
@@ -0,0 +1,417 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "agc.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AGC_DB_TO_LINEAR(db)        (powf(10.0f, (db) / 20.0f))
+
+/* Width of the portable loops. Fixed inner loops of this many samples are
+ * vectorized by the compiler at -O2. */
+#define AGC_LANES                   (8)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Sum of squares and largest magnitude of a block */
+static void agc_block_stats(const float* samples, int count, float* power, float* peak)
+{
+    #if defined(COMPONENT_CM55)
+    uint32_t index;
+    arm_power_f32(samples, (uint32_t)count, power);
+    arm_absmax_f32(samples, (uint32_t)count, peak, &index);
+    #else
+    /* Independent lanes, so that the reductions vectorize too */
+    float sum[AGC_LANES] = { 0.0f };
+    float max[AGC_LANES] = { 0.0f };
+    int i = 0;
+
+    for (; i + AGC_LANES <= count; i += AGC_LANES)
+    {
+        for (int lane = 0; lane < AGC_LANES; lane++)
+        {
+            float magnitude = fabsf(samples[i + lane]);
+            sum[lane] += samples[i + lane] * samples[i + lane];
+            max[lane] = (magnitude > max[lane]) ? magnitude : max[lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        float magnitude = fabsf(samples[i]);
+        sum[0] += samples[i] * samples[i];
+        max[0] = (magnitude > max[0]) ? magnitude : max[0];
+    }
+    *power = 0.0f;
+    *peak = 0.0f;
+    for (int lane = 0; lane < AGC_LANES; lane++)
+    {
+        *power += sum[lane];
+        *peak = (max[lane] > *peak) ? max[lane] : *peak;
+    }
+    #endif
+}
+
+/* Same for 16 bit PCM, normalized to [-1, 1] */
+static void agc_block_stats_q15(const int16_t* pcm, int count, float* power, float* peak)
+{
+    #if defined(COMPONENT_CM55)
+    q63_t sum;
+    q15_t max;
+    uint32_t index;
+    arm_power_q15(pcm, (uint32_t)count, &sum);
+    arm_absmax_q15(pcm, (uint32_t)count, &max, &index);
+    *power = (float)sum / (float)(1u << 30);
+    *peak = (float)max / 32768.0f;
+    #else
+    float sum[AGC_LANES] = { 0.0f };
+    float max[AGC_LANES] = { 0.0f };
+    int i = 0;
+
+    for (; i + AGC_LANES <= count; i += AGC_LANES)
+    {
+        for (int lane = 0; lane < AGC_LANES; lane++)
+        {
+            float value = (float)pcm[i + lane];
+            float magnitude = fabsf(value);
+            sum[lane] += value * value;
+            max[lane] = (magnitude > max[lane]) ? magnitude : max[lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        float value = (float)pcm[i];
+        sum[0] += value * value;
+        max[0] = (fabsf(value) > max[0]) ? fabsf(value) : max[0];
+    }
+    *power = 0.0f;
+    *peak = 0.0f;
+    for (int lane = 0; lane < AGC_LANES; lane++)
+    {
+        *power += sum[lane];
+        *peak = (max[lane] > *peak) ? max[lane] : *peak;
+    }
+    *power /= 32768.0f * 32768.0f;
+    *peak /= 32768.0f;
+    #endif
+}
+
+static void agc_scale(float* samples, int count, float gain)
+{
+    #if defined(COMPONENT_CM55)
+    arm_scale_f32(samples, gain, samples, (uint32_t)count);
+    #else
+    int i = 0;
+    for (; i + AGC_LANES <= count; i += AGC_LANES)
+    {
+        for (int lane = 0; lane < AGC_LANES; lane++)
+        {
+            samples[i + lane] *= gain;
+        }
+    }
+    for (; i < count; i++)
+    {
+        samples[i] *= gain;
+    }
+    #endif
+}
+
+/* Normalization and gain, in one multiply on the host */
+static void agc_scale_q15(const int16_t* pcm, int count, float gain, float* out)
+{
+    #if defined(COMPONENT_CM55)
+    arm_q15_to_float(pcm, out, (uint32_t)count);
+    arm_scale_f32(out, gain, out, (uint32_t)count);
+    #else
+    const float scale = gain / 32768.0f;
+    int i = 0;
+    for (; i + AGC_LANES <= count; i += AGC_LANES)
+    {
+        for (int lane = 0; lane < AGC_LANES; lane++)
+        {
+            out[i + lane] = (float)pcm[i + lane] * scale;
+        }
+    }
+    for (; i < count; i++)
+    {
+        out[i] = (float)pcm[i] * scale;
+    }
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: agc_soft_limit
+********************************************************************************
+* Summary:
+*  Compresses the magnitudes above the knee towards 1 with
+*  knee + (1 - knee) * t / (1 + t), t = (|x| - knee) / (1 - knee), which
+*  continues the identity with slope 1 at the knee and never reaches 1.
+*
+* Return:
+*  Number of samples above the knee
+*
+*******************************************************************************/
+static uint32_t agc_soft_limit(float* samples, int count, float knee)
+{
+    const float range = 1.0f - knee;
+    uint32_t limited = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        float magnitude = fabsf(samples[i]);
+        if (magnitude > knee)
+        {
+            float t = (magnitude - knee) / range;
+            float limit = knee + range * t / (1.0f + t);
+            samples[i] = (samples[i] < 0.0f) ? -limit : limit;
+            limited++;
+        }
+    }
+    return limited;
+}
+
+/*******************************************************************************
+* Function Name: agc_default_config
+********************************************************************************
+* Summary:
+*  Fills in the AGC_* defaults of agc.h.
+*
+*******************************************************************************/
+void agc_default_config(agc_config_t* config)
+{
+    config->target_dbfs = AGC_TARGET_DBFS;
+    config->gate_dbfs = AGC_GATE_DBFS;
+    config->initial_gain_db = AGC_INITIAL_GAIN_DB;
+    config->min_gain_db = AGC_MIN_GAIN_DB;
+    config->max_gain_db = AGC_MAX_GAIN_DB;
+    config->attack_ms = AGC_ATTACK_MS;
+    config->release_ms = AGC_RELEASE_MS;
+    config->knee = AGC_KNEE;
+}
+
+/*******************************************************************************
+* Function Name: agc_init
+********************************************************************************
+* Summary:
+*  Converts the configuration to per block coefficients and resets the
+*  envelope to the level the initial gain maps to the target.
+*
+* Parameters:
+*  agc:         AGC instance
+*  config:      levels and time constants, see agc_default_config()
+*  sample_rate: of the samples passed to agc_process()
+*  block_size:  samples per agc_process() call, normally one hop
+*
+* Return:
+*  AGC_RET_SUCCESS or AGC_RET_ERROR for an inconsistent configuration
+*
+*******************************************************************************/
+int agc_init(agc_t* agc, const agc_config_t* config, int sample_rate, int block_size)
+{
+    const float block_ms = 1000.0f * (float)block_size / (float)sample_rate;
+
+    memset(agc, 0, sizeof(*agc));
+    if ((block_size <= 0) || (config->attack_ms <= 0.0f) || (config->release_ms <= 0.0f) ||
+        (config->min_gain_db > config->max_gain_db) ||
+        (config->initial_gain_db < config->min_gain_db) ||
+        (config->initial_gain_db > config->max_gain_db) ||
+        (config->knee <= 0.0f) || (config->knee >= 1.0f))
+    {
+        return AGC_RET_ERROR;
+    }
+
+    agc->target = AGC_DB_TO_LINEAR(config->target_dbfs);
+    agc->gate = AGC_DB_TO_LINEAR(config->gate_dbfs);
+    agc->min_gain = AGC_DB_TO_LINEAR(config->min_gain_db);
+    agc->max_gain = AGC_DB_TO_LINEAR(config->max_gain_db);
+    agc->attack = 1.0f - expf(-block_ms / config->attack_ms);
+    agc->release = 1.0f - expf(-block_ms / config->release_ms);
+    agc->knee = config->knee;
+    agc->block_size = block_size;
+
+    agc->gain = AGC_DB_TO_LINEAR(config->initial_gain_db);
+    agc->envelope = agc->target / agc->gain;
+    agc->gain_min = agc->gain;
+    agc->gain_max = agc->gain;
+
+    return AGC_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: agc_update
+********************************************************************************
+* Summary:
+*  Updates the envelope with the power of a block and selects the gain of the
+*  block. The coefficients of agc_init() are scaled to the length of the
+*  block, so the time constants hold for any block size.
+*
+*******************************************************************************/
+static void agc_update(agc_t* agc, float power, int count)
+{
+    float level = sqrtf(power / (float)count);
+    float rate = (level > agc->envelope) ? agc->attack : agc->release;
+
+    /* A shorter block, such as the tail of a capture frame, moves the
+     * envelope by its share of the time constant */
+    if (count != agc->block_size)
+    {
+        rate = 1.0f - powf(1.0f - rate, (float)count / (float)agc->block_size);
+    }
+    agc->envelope += rate * (level - agc->envelope);
+
+    /* Below the gate the last gain is held */
+    if (agc->envelope >= agc->gate)
+    {
+        float gain = agc->target / agc->envelope;
+        agc->gain = (gain < agc->min_gain) ? agc->min_gain :
+                    (gain > agc->max_gain) ? agc->max_gain : gain;
+    }
+    else
+    {
+        agc->gated_blocks++;
+    }
+
+    if (agc->gain < agc->gain_min)
+    {
+        agc->gain_min = agc->gain;
+    }
+    if (agc->gain > agc->gain_max)
+    {
+        agc->gain_max = agc->gain;
+    }
+    agc->blocks++;
+}
+
+/* Soft limits the block if its peak requires it */
+static void agc_limit(agc_t* agc, float* samples, int count, float peak)
+{
+    if (peak * agc->gain > agc->knee)
+    {
+        agc->limited_samples += agc_soft_limit(samples, count, agc->knee);
+        agc->limited_blocks++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: agc_process
+********************************************************************************
+* Summary:
+*  Updates the envelope with the block, applies the resulting gain to the
+*  block in place and soft limits the samples above the knee. The limiter
+*  only runs when the peak of the block requires it.
+*
+* Parameters:
+*  agc:     AGC instance
+*  samples: normalized samples, modified in place
+*  count:   number of samples, any size
+*
+*******************************************************************************/
+void agc_process(agc_t* agc, float* samples, int count)
+{
+    float power;
+    float peak;
+
+    if (count <= 0)
+    {
+        return;
+    }
+    agc_block_stats(samples, count, &power, &peak);
+    agc_update(agc, power, count);
+    agc_scale(samples, count, agc->gain);
+    agc_limit(agc, samples, count, peak);
+}
+
+/*******************************************************************************
+* Function Name: agc_process_q15
+********************************************************************************
+* Summary:
+*  Like agc_process() for 16 bit PCM. The statistics are taken from the PCM
+*  and the normalization is applied with the gain.
+*
+* Parameters:
+*  agc:   AGC instance
+*  pcm:   16 bit PCM samples
+*  count: number of samples, any size
+*  out:   count normalized samples with the gain applied
+*
+*******************************************************************************/
+void agc_process_q15(agc_t* agc, const int16_t* pcm, int count, float* out)
+{
+    float power;
+    float peak;
+
+    if (count <= 0)
+    {
+        return;
+    }
+    agc_block_stats_q15(pcm, count, &power, &peak);
+    agc_update(agc, power, count);
+    agc_scale_q15(pcm, count, agc->gain, out);
+    agc_limit(agc, out, count, peak);
+}
+
+/*******************************************************************************
+* Function Name: agc_process_stats
+********************************************************************************
+* Summary:
+*  Like agc_process() for a block whose statistics an earlier pass computed,
+*  e.g. dc_block_q15() of dc_block.h.
+*
+* Parameters:
+*  agc:     AGC instance
+*  samples: normalized samples, modified in place
+*  count:   number of samples, any size
+*  power:   sum of squares of the samples
+*  peak:    largest magnitude of the samples
+*
+*******************************************************************************/
+void agc_process_stats(agc_t* agc, float* samples, int count, float power, float peak)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    agc_update(agc, power, count);
+    agc_scale(samples, count, agc->gain);
+    agc_limit(agc, samples, count, peak);
+}
+
+/*******************************************************************************
+* Function Name: agc_gain_db
+********************************************************************************
+* Summary:
+*  Gain applied to the last block.
+*
+*******************************************************************************/
+float agc_gain_db(const agc_t* agc)
+{
+    return 20.0f * log10f(agc->gain);
+}
+
+/*******************************************************************************
+* Function Name: agc_print_stats
+********************************************************************************
+* Summary:
+*  Prints the gain range and how often the gate and the limiter acted.
+*
+* Parameters:
+*  agc:   AGC instance
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void agc_print_stats(const agc_t* agc, agc_print_fn print)
+{
+    print("agc: gain %.1f dB (min %.1f max %.1f), blocks %lu, gated %lu, limited %lu (%lu samples)\r\n",
+          (double)agc_gain_db(agc), (double)(20.0f * log10f(agc->gain_min)),
+          (double)(20.0f * log10f(agc->gain_max)), (unsigned long)agc->blocks,
+          (unsigned long)agc->gated_blocks, (unsigned long)agc->limited_blocks,
+          (unsigned long)agc->limited_samples);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Streaming automatic gain control of the normalized input.
+ *
+ * Tracks the RMS envelope of every block with separate attack and release
+ * time constants and applies one gain per block that moves the envelope to
+ * the target level. The gain is held while the input is below the gate, so
+ * the noise floor between events is not pulled up. Samples the gain pushes
+ * above the knee are soft limited instead of hard clipped. On the CM55 the
+ * block statistics and the gain run on the Helium kernels of CMSIS-DSP.
+ */
+
+#ifndef AGC_H_
+#define AGC_H_
+
+#include <stdint.h>
+
+#if defined(COMPONENT_CM55)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Defaults of agc_config_t. The initial gain is the former fixed digital
+ * boost of 10, so the first blocks look like the training data. */
+#ifndef AGC_TARGET_DBFS
+#define AGC_TARGET_DBFS             (-20.0f)    /* RMS after the gain */
+#endif
+#ifndef AGC_GATE_DBFS
+#define AGC_GATE_DBFS               (-55.0f)    /* RMS before the gain */
+#endif
+#ifndef AGC_INITIAL_GAIN_DB
+#define AGC_INITIAL_GAIN_DB         (20.0f)
+#endif
+#ifndef AGC_MIN_GAIN_DB
+#define AGC_MIN_GAIN_DB             (-10.0f)
+#endif
+#ifndef AGC_MAX_GAIN_DB
+#define AGC_MAX_GAIN_DB             (30.0f)
+#endif
+#ifndef AGC_ATTACK_MS
+#define AGC_ATTACK_MS               (10.0f)
+#endif
+#ifndef AGC_RELEASE_MS
+#define AGC_RELEASE_MS              (1500.0f)
+#endif
+#ifndef AGC_KNEE
+#define AGC_KNEE                    (0.5f)      /* Start of the soft limiter */
+#endif
+
+#define AGC_RET_SUCCESS             (0)
+#define AGC_RET_ERROR               (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       target_dbfs;
+    float       gate_dbfs;
+    float       initial_gain_db;
+    float       min_gain_db;
+    float       max_gain_db;
+    float       attack_ms;
+    float       release_ms;
+    float       knee;
+} agc_config_t;
+
+typedef struct
+{
+    /* Derived from agc_config_t and the block size */
+    float       target;             /* Linear RMS */
+    float       gate;
+    float       min_gain;
+    float       max_gain;
+    float       attack;             /* Envelope coefficient per block */
+    float       release;
+    float       knee;
+    int         block_size;
+
+    float       envelope;           /* RMS before the gain */
+    float       gain;               /* Applied to the last block */
+
+    /* Statistics */
+    uint32_t    blocks;
+    uint32_t    gated_blocks;
+    uint32_t    limited_blocks;     /* Blocks that reached the soft limiter */
+    uint32_t    limited_samples;
+    float       gain_min;
+    float       gain_max;
+} agc_t;
+
+/* printf compatible sink for agc_print_stats() */
+typedef int (*agc_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void  agc_default_config(agc_config_t* config);
+int   agc_init(agc_t* agc, const agc_config_t* config, int sample_rate, int block_size);
+void  agc_process(agc_t* agc, float* samples, int count);
+void  agc_process_q15(agc_t* agc, const int16_t* pcm, int count, float* out);
+void  agc_process_stats(agc_t* agc, float* samples, int count, float power, float peak);
+float agc_gain_db(const agc_t* agc);
+void  agc_print_stats(const agc_t* agc, agc_print_fn print);
+
+#endif /* AGC_H_ */
@@ -2,7 +2,8 @@
 * File Name:   audio.c
 *
 * Description: This file implements the interface with the PDM, as
-*              well as the PDM ISR to feed the audio processing block.
+*              well as the PDM ISR to feed the audio pipeline and the
+*              IPC link that reports its decisions to the CM33.
 *
 * Related Document: See README.md
 *
@@ -40,12 +41,26 @@
 * so agrees to indemnify Cypress against all liability.
 *******************************************************************************/
 #include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 #include "audio.h"
-#include "baby_cry.h"
-#include <math.h>
+#include "audio_health.h"
+#include "audio_pipeline.h"
+#include "clip_capture.h"
+#include "prof.h"
+#include "record_stream.h"
+#include <string.h>
+#ifdef PRINT_CM55
+#include "app_log.h"
+#endif
 
 #include "ipc_communication.h"
+#include "latency_trace.h"
+#include "log_forward.h"
+#if AUDIO_EARLY_EXIT
+#include "baby_cry_exit.h"
+#endif
 
 /******************************************************************************
  * Macros
@@ -56,6 +71,8 @@
 /* Channel Index */
 #define RIGHT_CH_INDEX                          (3u)
 #define RIGHT_CH_CONFIG                         channel_3_config
+#define LEFT_CH_INDEX                           (2u)
+#define LEFT_CH_CONFIG                          channel_2_config
 
 /* PDM PCM hardware FIFO size */
 #define HW_FIFO_SIZE                            (64u)
@@ -66,34 +83,32 @@
 /* Total number of interrupts to get the FRAME_SIZE number of samples*/
 #define NUMBER_INTERRUPTS_FOR_FRAME             (FRAME_SIZE/RX_FIFO_TRIG_LEVEL)
 
-/* Multiplication factor of the input signal.
- * This should ideally be 1. Higher values will have a negative impact on
- * the sampling dynamic range. However, it can be used as a last resort 
- * when MICROPHONE_GAIN is already at maximum and the ML model was trained
- * with data at a higher amplitude than the microphone captures.
- * Note: If you use the same board for recording training data and 
- * deployment of your own ML model set this to 1.0. */
-#define DIGITAL_BOOST_FACTOR                    10.0f
+/* Period of the profiling statistics sent to the CM33 */
+#define PROF_REPORT_PERIOD_MS                   (10000u)
+#define PROF_REPORT_PERIOD_SAMPLES              ((LOGMEL_SAMPLE_RATE / 1000u) * PROF_REPORT_PERIOD_MS)
+
+/* Period of the audio health reports sent to the CM33 */
+#define AUDIO_HEALTH_PERIOD_SAMPLES             ((LOGMEL_SAMPLE_RATE / 1000u) * AUDIO_HEALTH_PERIOD_MS)
 
-/* Specifies the dynamic range in bits.
- * PCM word length, see the A/D specific documentation for valid ranges. */
-#define AUIDO_BITS_PER_SAMPLE                  16
+/* Channel of the capture buffer recorded into the clips */
+#define CLIP_CHANNEL                            (AUDIO_CAPTURE_CHANNELS - 1u)
 
-/* Converts given audio sample into range [-1,1] */
-#define SAMPLE_NORMALIZE(sample)                (((float) (sample)) / (float) (1 << (AUIDO_BITS_PER_SAMPLE - 1)))
+/* Task that classifies the model windows with AUDIO_ASYNC_INFERENCE. Below
+ * the audio task, so it runs while that one waits for the next frame. */
+#define INFERENCE_TASK_NAME                     ("inference")
+#define INFERENCE_TASK_STACK_SIZE               (configMINIMAL_STACK_SIZE * 8)
+#define INFERENCE_TASK_PRIORITY                 (configMAX_PRIORITIES - 2)
 
-/* Threshold for the output score to be considered a valid detection.
-*  The threshold can be adjusted to increase or decrease the sensitivity of the
- * detection. A lower value will result in more false positives, while a higher
- * value will result in more false negatives. */
-#define OUTPUT_THRESHOLD_SCORE                  (0.6f)
+/* Decisions waiting for the IPC pipe, which the other CM33 clients may hold */
+#define RESULT_QUEUE_SIZE                       (4u)
 
 /******************************************************************************
  * Global Variables
  *****************************************************************************/
-/* Set up one buffer for data collection and one for processing */
-static int16_t audio_buffer0[FRAME_SIZE] = {0};
-static int16_t audio_buffer1[FRAME_SIZE] = {0};
+/* Set up one buffer for data collection and one for processing. Both halves
+ * of the capture buffer placed by the audio pipeline. With two microphones
+ * each buffer holds FRAME_SIZE interleaved left/right sample pairs. */
+static int16_t* audio_capture;
 static int16_t* active_rx_buffer;
 static int16_t* full_rx_buffer;
 
@@ -107,15 +122,239 @@ static const cy_stc_sysint_t PDM_IRQ_cfg =
 /* Flag to check if the data from PDM/PCM block is ready for processing. */
 static volatile bool pdm_pcm_flag;
 
+/* Tick count in ms when the last sample of the full buffer was captured */
+static volatile uint32_t full_rx_end_ms;
+
+/* Decisions not sent yet because the pipe was busy, oldest at result_head.
+ * When the queue is full the oldest decision is dropped. */
+static ipc_payload_t result_queue[RESULT_QUEUE_SIZE];
+static uint32_t result_head;
+static uint32_t result_count;
+static uint32_t results_dropped;
+
+/* Task waiting in audio_wait(), woken by the PDM and the inference task */
+static TaskHandle_t audio_task;
+
+/* Latency trace of the last frame taken up: samples up to its end, the
+ * capture time of its end and when cm55_task took it up, in ms of the CM55 */
+static uint32_t frame_end_sample;
+static uint32_t frame_end_ms;
+static uint32_t frame_pickup_ms;
+
+#if AUDIO_ASYNC_INFERENCE
+static StaticTask_t inference_task_tcb;
+static StackType_t inference_task_stack[INFERENCE_TASK_STACK_SIZE];
+static TaskHandle_t inference_task;
+#endif
+
+#ifdef APP_PROFILING
+/* Samples processed since the last profiling report */
+static uint32_t prof_report_samples;
+#endif
+
+#ifdef APP_AUDIO_HEALTH
+/* Statistics of the raw frames of the period */
+static audio_health_t audio_health;
+
+/* Error interrupts of the PDM since the start, counted by the ISR, and the
+ * counts of the previous report */
+static volatile uint32_t pdm_fifo_errors[AUDIO_HEALTH_FIFO_COUNT];
+static uint32_t health_fifo_reported[AUDIO_HEALTH_FIFO_COUNT];
+static uint32_t health_limited_reported;
+#endif
+
+#ifdef APP_CLIP_UPLOAD
+/* Pre-roll ring of the clips around detections. It is in shared memory, the
+ * CM33 reads a frozen clip in place. */
+CY_SECTION_SHAREDMEM static int16_t clip_ring[CLIP_RING_SAMPLES(LOGMEL_SAMPLE_RATE)];
+static clip_capture_t clip_capture;
+
+/* Clip taken from the ring but not sent yet, because the pipe was busy */
+static ipc_clip_payload_t clip_payload;
+static bool clip_pending;
+#endif
+
+#ifdef APP_RECORD
+/* Raw PDM frames of the recording mode, sent on by the CM33 from this ring */
+CY_SECTION_SHAREDMEM static int16_t record_samples[RECORD_RING_FRAMES * FRAME_SIZE * AUDIO_CAPTURE_CHANNELS];
+CY_SECTION_SHAREDMEM static record_ring_t record_ring;
+
+/* Set once the CM33 knows the ring */
+static bool record_announced;
+#endif
+
+#ifdef APP_MODEL_PROFILE
+/* Set once the operator profile of the model reached the CM33 */
+static bool model_profile_sent;
+#endif
+
 /*******************************************************************************
 * Local Function Prototypes
 *******************************************************************************/
 static void pdm_pcm_event_handler(void);
+static void audio_send_result(const audio_result_t* result, void* arg);
+static void audio_result_service(void);
+#if AUDIO_ASYNC_INFERENCE
+static void inference_task_main(void* arg);
+static void inference_start(void* arg);
+static void inference_wait(void* arg);
+#endif
+#ifdef APP_PROFILING
+static void audio_prof_report(void);
+#endif
+#ifdef APP_AUDIO_HEALTH
+static void audio_health_report(void);
+#endif
+#ifdef APP_CLIP_UPLOAD
+static void audio_clip_service(void);
+#endif
 
 /*******************************************************************************
 * Function Definitions
 *******************************************************************************/
 
+/*******************************************************************************
+* Function Name: audio_model_init
+********************************************************************************
+* Summary:
+*  Initializes the audio pipeline with the PDM capture buffers and the task
+*  stack placed in its memory region. Decisions are sent to the CM33. With
+*  AUDIO_ASYNC_INFERENCE the model windows are handed to the inference task.
+*
+* Parameters:
+*  task_stack_size: bytes of task stack to place with the windows, 0 for none
+*  task_stack:      receives the task stack address
+*
+* Return:
+*  The status of the initialization.
+*
+*******************************************************************************/
+cy_rslt_t audio_model_init(uint32_t task_stack_size, void** task_stack)
+{
+    #ifdef APP_AUDIO_HEALTH
+    if (AUDIO_HEALTH_RET_SUCCESS != audio_health_init(&audio_health, AUDIO_CAPTURE_CHANNELS))
+    {
+        return AUDIO_PIPELINE_MEM_ERROR;
+    }
+    #endif
+
+    #ifdef APP_CLIP_UPLOAD
+    if (CLIP_CAPTURE_RET_SUCCESS != clip_capture_init(&clip_capture, clip_ring,
+                                                      CLIP_RING_SAMPLES(LOGMEL_SAMPLE_RATE),
+                                                      (LOGMEL_SAMPLE_RATE / 1000u) * CLIP_POSTROLL_MS))
+    {
+        return AUDIO_PIPELINE_MEM_ERROR;
+    }
+    #endif
+
+    #ifdef APP_RECORD
+    if (RECORD_STREAM_RET_SUCCESS != record_stream_init(&record_ring, record_samples, RECORD_RING_FRAMES,
+                                                        FRAME_SIZE, AUDIO_CAPTURE_CHANNELS,
+                                                        LOGMEL_SAMPLE_RATE))
+    {
+        return AUDIO_PIPELINE_MEM_ERROR;
+    }
+    #endif
+
+    cy_rslt_t result = audio_pipeline_init(2u * FRAME_SIZE * AUDIO_CAPTURE_CHANNELS * sizeof(int16_t),
+                                           (void**)&audio_capture,
+                                           task_stack_size, task_stack, audio_send_result, NULL);
+
+    #if AUDIO_EARLY_EXIT
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = audio_pipeline_set_early_exit(&baby_cry_exit);
+    }
+    #endif
+
+    #if AUDIO_ASYNC_INFERENCE
+    if (CY_RSLT_SUCCESS == result)
+    {
+        static const audio_executor_t inference_executor = { inference_start, inference_wait, NULL };
+
+        inference_task = xTaskCreateStatic(inference_task_main, INFERENCE_TASK_NAME,
+                                           INFERENCE_TASK_STACK_SIZE, NULL, INFERENCE_TASK_PRIORITY,
+                                           inference_task_stack, &inference_task_tcb);
+        result = (NULL != inference_task) ? audio_pipeline_set_executor(&inference_executor)
+                                          : AUDIO_PIPELINE_MODEL_ERROR;
+    }
+    #endif
+
+    return result;
+}
+
+#if AUDIO_ASYNC_INFERENCE
+/*******************************************************************************
+* Function Name: inference_task_main
+********************************************************************************
+* Summary:
+*  Classifies a model window per notification and wakes the audio task to
+*  collect the decision. While the NPU runs the CPU is free for the audio
+*  task, which keeps taking up PDM frames.
+*
+* Parameters:
+*  arg: unused
+*
+*******************************************************************************/
+static void inference_task_main(void* arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        audio_pipeline_infer();
+        xTaskNotifyGive(audio_task);
+    }
+}
+
+/*******************************************************************************
+* Function Name: inference_start
+********************************************************************************
+* Summary:
+*  Executor start, hands the window to the inference task. The decision goes
+*  back to the task that started it.
+*
+*******************************************************************************/
+static void inference_start(void* arg)
+{
+    (void)arg;
+    audio_task = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(inference_task);
+}
+
+/*******************************************************************************
+* Function Name: inference_wait
+********************************************************************************
+* Summary:
+*  Executor wait, blocks until the inference task or the PDM wakes the audio
+*  task. The pipeline waits again until the window is classified.
+*
+*******************************************************************************/
+static void inference_wait(void* arg)
+{
+    (void)arg;
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+#endif /* AUDIO_ASYNC_INFERENCE */
+
+/*******************************************************************************
+* Function Name: audio_wait
+********************************************************************************
+* Summary:
+*  Blocks the calling task until a PDM frame is full, a model window is
+*  classified by the inference task or the timeout passed. The CPU is idle
+*  meanwhile.
+*
+* Parameters:
+*  timeout_ms: longest wait
+*
+*******************************************************************************/
+void audio_wait(uint32_t timeout_ms)
+{
+    audio_task = xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+}
+
 /*******************************************************************************
 * Function Name: pdm_init
 ********************************************************************************
@@ -145,6 +384,13 @@ cy_rslt_t pdm_init(void)
     Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &RIGHT_CH_CONFIG, (uint8_t)RIGHT_CH_INDEX);
     Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, RIGHT_CH_INDEX);
 
+    #if (AUDIO_CAPTURE_CHANNELS > 1)
+    /* Initialize and enable PDM PCM channel 2 -Left. It runs off the same
+     * clock as the right channel and is read in the same interrupt. */
+    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &LEFT_CH_CONFIG, (uint8_t)LEFT_CH_INDEX);
+    Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    #endif
+
     /* An interrupt is registered for right channel, clear and set masks for it. */
     Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, RIGHT_CH_INDEX, CY_PDM_PCM_INTR_MASK);
     Cy_PDM_PCM_Channel_SetInterruptMask(CYBSP_PDM_HW, RIGHT_CH_INDEX, CY_PDM_PCM_INTR_MASK);
@@ -163,9 +409,12 @@ cy_rslt_t pdm_init(void)
 
     /* Set up pointers to two buffers to implement a ping-pong buffer system.
      * One gets filled by the PDM while the other can be processed. */
-    active_rx_buffer = audio_buffer0;
-    full_rx_buffer = audio_buffer1;
+    active_rx_buffer = &audio_capture[0];
+    full_rx_buffer = &audio_capture[FRAME_SIZE * AUDIO_CAPTURE_CHANNELS];
 
+    #if (AUDIO_CAPTURE_CHANNELS > 1)
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    #endif
     Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
 
     return CY_RSLT_SUCCESS;
@@ -190,17 +439,28 @@ static void pdm_pcm_event_handler(void)
 {
     /* Used to track how full the buffer is */
     static uint16_t frame_counter = 0;
+    BaseType_t woken = pdFALSE;
+    PROF_BEGIN(prof_start);
 
     /* Check the interrupt status */
     uint32_t intr_status = Cy_PDM_PCM_Channel_GetInterruptStatusMasked(CYBSP_PDM_HW, RIGHT_CH_INDEX);
     if(CY_PDM_PCM_INTR_RX_TRIGGER & intr_status)
     {
         /* Move data from the PDM fifo and place it in a buffer */
+        #if (AUDIO_CAPTURE_CHANNELS > 1)
+        int16_t* pair = &active_rx_buffer[frame_counter * RX_FIFO_TRIG_LEVEL * 2u];
+        for(uint32_t index=0; index < RX_FIFO_TRIG_LEVEL; index++)
+        {
+            pair[2u * index] = (int16_t)Cy_PDM_PCM_Channel_ReadFifo(CYBSP_PDM_HW, LEFT_CH_INDEX);
+            pair[2u * index + 1u] = (int16_t)Cy_PDM_PCM_Channel_ReadFifo(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+        }
+        #else
         for(uint32_t index=0; index < RX_FIFO_TRIG_LEVEL; index++)
         {
             int32_t data = (int32_t)Cy_PDM_PCM_Channel_ReadFifo(CYBSP_PDM_HW, RIGHT_CH_INDEX);
             active_rx_buffer[frame_counter * RX_FIFO_TRIG_LEVEL + index] = (int16_t)(data);
         }
+        #endif
         Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, RIGHT_CH_INDEX, CY_PDM_PCM_INTR_RX_TRIGGER);
         frame_counter++;
     }
@@ -213,23 +473,146 @@ static void pdm_pcm_event_handler(void)
         full_rx_buffer = temp;
 
         /* Set the PDM_PCM flag as true, signaling there is data ready for use */
+        full_rx_end_ms = (uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS);
         pdm_pcm_flag = true;
         frame_counter = 0;
+        if (NULL != audio_task)
+        {
+            vTaskNotifyGiveFromISR(audio_task, &woken);
+        }
     }
 
+    #if (AUDIO_CAPTURE_CHANNELS > 1)
+    /* The left channel has no interrupt of its own, its errors are taken
+     * from its raw status here */
+    intr_status |= Cy_PDM_PCM_Channel_GetInterruptStatus(CYBSP_PDM_HW, LEFT_CH_INDEX) &
+                   (CY_PDM_PCM_INTR_RX_FIR_OVERFLOW | CY_PDM_PCM_INTR_RX_OVERFLOW |
+                    CY_PDM_PCM_INTR_RX_IF_OVERFLOW | CY_PDM_PCM_INTR_RX_UNDERFLOW);
+    #endif
+
     if((CY_PDM_PCM_INTR_RX_FIR_OVERFLOW | CY_PDM_PCM_INTR_RX_OVERFLOW|
             CY_PDM_PCM_INTR_RX_IF_OVERFLOW | CY_PDM_PCM_INTR_RX_UNDERFLOW) & intr_status)
     {
+        #ifdef APP_AUDIO_HEALTH
+        /* An error of either channel counts once per interrupt */
+        pdm_fifo_errors[AUDIO_HEALTH_FIFO_RX_OVERFLOW] += (0u != (CY_PDM_PCM_INTR_RX_OVERFLOW & intr_status)) ? 1u : 0u;
+        pdm_fifo_errors[AUDIO_HEALTH_FIFO_FIR_OVERFLOW] += (0u != (CY_PDM_PCM_INTR_RX_FIR_OVERFLOW & intr_status)) ? 1u : 0u;
+        pdm_fifo_errors[AUDIO_HEALTH_FIFO_IF_OVERFLOW] += (0u != (CY_PDM_PCM_INTR_RX_IF_OVERFLOW & intr_status)) ? 1u : 0u;
+        pdm_fifo_errors[AUDIO_HEALTH_FIFO_UNDERFLOW] += (0u != (CY_PDM_PCM_INTR_RX_UNDERFLOW & intr_status)) ? 1u : 0u;
+        #endif
         Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, RIGHT_CH_INDEX, CY_PDM_PCM_INTR_MASK);
+        #if (AUDIO_CAPTURE_CHANNELS > 1)
+        Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, LEFT_CH_INDEX, CY_PDM_PCM_INTR_MASK);
+        #endif
+    }
+
+    PROF_END(prof_start, PROF_STAGE_PDM_ISR);
+    portYIELD_FROM_ISR(woken);
+}
+
+/*******************************************************************************
+* Function Name: audio_send_result
+********************************************************************************
+* Summary:
+*  Audio pipeline callback, queues the decision of a model window for the
+*  CM33 and sends it unless the pipe is busy. A detection also arms the clip
+*  capture.
+*
+* Parameters:
+*  result: decision of the window
+*  arg:    unused
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_send_result(const audio_result_t* result, void* arg)
+{
+    ipc_payload_t* payload;
+    latency_trace_t* trace;
+    uint32_t result_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    uint32_t window_ms = result_ms - result->elapsed_cycles / (SystemCoreClock / 1000u);
+    uint32_t capture_ms = latency_capture_ms(frame_end_ms, frame_end_sample,
+                                             result->sample, LOGMEL_SAMPLE_RATE);
+
+    (void)arg;
+    if (RESULT_QUEUE_SIZE == result_count)
+    {
+        result_head = (result_head + 1u) % RESULT_QUEUE_SIZE;
+        result_count--;
+        results_dropped++;
+    }
+    payload = &result_queue[(result_head + result_count) % RESULT_QUEUE_SIZE];
+    trace = &payload->trace;
+    result_count++;
+
+    payload->label_id = result->label_id;
+    strcpy(payload->label, result->label);
+    payload->confidence = result->confidence;
+    payload->agc_gain_db = result->gain_db;
+    payload->windows = result->window + 1u;
+    payload->model_runs = result->model_runs;
+    payload->audio_ms = result->sample / (LOGMEL_SAMPLE_RATE / 1000u);
+
+    /* The newest sample of the window is in the last frame taken up */
+    memset(trace, 0, sizeof(*trace));
+    trace->sample = result->sample;
+    trace->synced = log_forward_cm33_ms(capture_ms, &trace->stamps[LATENCY_STAMP_CAPTURE]);
+    (void)log_forward_cm33_ms(frame_pickup_ms, &trace->stamps[LATENCY_STAMP_PICKUP]);
+    (void)log_forward_cm33_ms(window_ms, &trace->stamps[LATENCY_STAMP_WINDOW]);
+    (void)log_forward_cm33_ms(result_ms, &trace->stamps[LATENCY_STAMP_RESULT]);
+    audio_result_service();
+
+    #ifdef APP_CLIP_UPLOAD
+    if (0u != result->label_id)
+    {
+        if (CLIP_STATE_RECORDING == clip_capture.state)
+        {
+            clip_payload.label_id = result->label_id;
+            clip_payload.confidence = result->confidence;
+        }
+        clip_capture_trigger(&clip_capture);
+    }
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: audio_result_service
+********************************************************************************
+* Summary:
+*  Sends the queued decisions in order until the pipe is busy; the rest is
+*  retried from pdm_data_process().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_result_service(void)
+{
+    while ((0u != result_count) && cm55_ipc_send_to_cm33(&result_queue[result_head]))
+    {
+        result_head = (result_head + 1u) % RESULT_QUEUE_SIZE;
+        result_count--;
+    }
+    #ifdef PRINT_CM55
+    if (0u != results_dropped)
+    {
+        APP_LOG_WARN("%lu decisions dropped, IPC pipe busy", (unsigned long)results_dropped);
+        results_dropped = 0;
     }
+    #endif
 }
 
 /*******************************************************************************
 * Function Name: pdm_data_process
 ********************************************************************************
 * Summary:
-*  This function feeds the data to the DEEPCRAFT pre-processor and returns the
-*  processed results.
+*  This function feeds the data to the audio pipeline, which runs the
+*  registered models when their feature windows are complete. A decision of
+*  the inference task is sent on first, also when no frame is ready.
 *
 * Parameters:
 *  None
@@ -241,11 +624,9 @@ static void pdm_pcm_event_handler(void)
 cy_rslt_t pdm_data_process(void)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
-    int16_t best_label = 0;
-    float sample = 0.0f;
-    float max_score = 0.0f;
-    float label_scores[IMAI_DATA_OUT_COUNT];
-    char *label_text[] = IMAI_DATA_OUT_SYMBOLS;
+
+    (void)audio_pipeline_collect(false);
+    audio_result_service();
 
     /* Check if PDM PCM Data is ready to be processed */
     if (!pdm_pcm_flag)
@@ -254,95 +635,195 @@ cy_rslt_t pdm_data_process(void)
         return result;
     }
 
+    PROF_BEGIN(prof_start);
+
     /* Reset the flag to false, indicating that the data is being processed */
     pdm_pcm_flag = false;
+    frame_end_ms = full_rx_end_ms;
+    frame_end_sample += FRAME_SIZE;
+    frame_pickup_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    #ifdef APP_RECORD
+    /* The raw frame as captured, before any processing */
+    record_stream_write(&record_ring, full_rx_buffer);
+    if (!record_announced)
+    {
+        record_announced = cm55_ipc_send_record_to_cm33(&record_ring);
+    }
+    #endif
 
-#ifdef PRINT_CM55
-    printf("\033[H\n");
+    #ifdef APP_AUDIO_HEALTH
+    audio_health_frame(&audio_health, full_rx_buffer, FRAME_SIZE);
+    #endif
 
-#ifdef COMPONENT_CM33
-    printf("DEEPCRAFT Studio Deploy Audio Example - CM33\r\n\n");
-#else
-    printf("DEEPCRAFT Studio Deploy Audio Example - CM55\r\n\n");
-#endif /* COMPONENT_CM33 */
-#endif
+    #ifdef APP_CLIP_UPLOAD
+    clip_capture_write(&clip_capture, &full_rx_buffer[CLIP_CHANNEL], FRAME_SIZE, AUDIO_CAPTURE_CHANNELS);
+    #endif
 
-    for (uint32_t index = 0; index < FRAME_SIZE ; index++)
-    {
-        int16_t val_temp = full_rx_buffer[index];
-        sample = SAMPLE_NORMALIZE(val_temp) * DIGITAL_BOOST_FACTOR;
-        if (sample > 1.0)
-        {
-            sample = 1.0;
-        }
-        else if (sample < -1.0)
-        {
-            sample = -1.0;
-        }
+    #if (AUDIO_CAPTURE_CHANNELS > 1)
+    audio_pipeline_process_stereo(full_rx_buffer, FRAME_SIZE);
+    #else
+    audio_pipeline_process(full_rx_buffer, FRAME_SIZE);
+    #endif
+    PROF_END(prof_start, PROF_STAGE_FRAME);
 
-        /* Pass the audio sample for enqueue */
-        result = IMAI_enqueue(&sample);
-        CY_ASSERT(IMAI_RET_SUCCESS == result);
+    #ifdef APP_CLIP_UPLOAD
+    audio_clip_service();
+    #endif
 
-        best_label = 0;
-        max_score = -1000.0f;
+    #ifdef APP_AUDIO_HEALTH
+    if (audio_health.samples >= AUDIO_HEALTH_PERIOD_SAMPLES)
+    {
+        audio_health_report();
+    }
+    #endif
 
-        /* Check if there is any model output to process */
-        switch(IMAI_dequeue(label_scores))
-        {
-            case IMAI_RET_SUCCESS:      /* We have data, display it */
-            {
-                for(int i = 0; i < IMAI_DATA_OUT_COUNT; i++)
-                {
-                    #ifdef PRINT_CM55
-                    printf("label: %-11s: score: %.4f\r\n", label_text[i], label_scores[i]);
-                    #endif
-                    if (label_scores[i] > max_score)
-                    {
-                        max_score = label_scores[i];
-                        best_label = i;
-                    }
-                }
-
-                ipc_payload_t* payload = cm55_ipc_get_payload_ptr();
-
-                if(max_score >= OUTPUT_THRESHOLD_SCORE)
-                {
-                    payload->label_id = best_label;
-                    strcpy(payload->label, label_text[best_label]);
-                    payload->confidence = label_scores[best_label];
-                    #ifdef PRINT_CM55
-                    printf("\n\nOutput: %-10s\r\n", label_text[best_label]);
-                    #endif
-                }
-                else
-                {
-                    payload->label_id = 0;
-                    strcpy(payload->label, label_text[0]);
-                    payload->confidence = label_scores[0];
-
-                    #ifdef PRINT_CM55
-                    printf("\n\nOutput: %-10s\r\n", "");
-                    #endif
-                }
-                cm55_ipc_send_to_cm33();
-
-                break;
-            }
-
-            case IMAI_RET_NODATA:   /* No new output, continue with sampling */
-            {
-                break;
-            }
-            case IMAI_RET_ERROR:    /* Abort on error */
-            {
-                CY_ASSERT(0);
-                break;
-            }
-        }
+    #ifdef APP_MODEL_PROFILE
+    /* Taken at boot, retried with the next frame while the pipe is busy */
+    if (!model_profile_sent && (NULL != audio_pipeline_model_profile()))
+    {
+        model_profile_sent = cm55_ipc_send_model_profile_to_cm33(audio_pipeline_model_profile());
     }
+    #endif
+
+    #ifdef APP_PROFILING
+    prof_report_samples += FRAME_SIZE;
+    if (prof_report_samples >= PROF_REPORT_PERIOD_SAMPLES)
+    {
+        audio_prof_report();
+    }
+    #endif
 
     return result;
 }
 
+#ifdef APP_PROFILING
+/*******************************************************************************
+* Function Name: audio_prof_report
+********************************************************************************
+* Summary:
+*  Sends the stage statistics of the elapsed period to the CM33 and starts a
+*  new period. If the IPC pipe is busy the statistics keep accumulating and
+*  the report is retried with the next frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_prof_report(void)
+{
+    static ipc_diag_payload_t diag;
+
+    diag.core_clock_hz = SystemCoreClock;
+    diag.period_ms = prof_report_samples / (LOGMEL_SAMPLE_RATE / 1000u);
+    prof_summarize(diag.stages);
+
+    if (cm55_ipc_send_diag_to_cm33(&diag))
+    {
+        prof_reset();
+        prof_report_samples = 0;
+
+        #ifdef PRINT_CM55
+        APP_LOG_INFO("profile of %lu ms at %lu Hz:", (unsigned long)diag.period_ms,
+                     (unsigned long)diag.core_clock_hz);
+        prof_print(diag.stages, app_log_printf);
+        #endif
+    }
+}
+#endif /* APP_PROFILING */
+
+#ifdef APP_AUDIO_HEALTH
+/*******************************************************************************
+* Function Name: audio_health_report
+********************************************************************************
+* Summary:
+*  Sends the audio health of the elapsed period to the CM33 and starts a new
+*  period. If the IPC pipe is busy the statistics keep accumulating and the
+*  report is retried with the next frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_health_report(void)
+{
+    static audio_health_report_t report;
+    uint32_t fifo[AUDIO_HEALTH_FIFO_COUNT];
+    uint32_t limited = audio_pipeline_limited_samples();
+
+    audio_health_summarize(&audio_health, LOGMEL_SAMPLE_RATE, &report);
+    for (uint32_t i = 0; i < AUDIO_HEALTH_FIFO_COUNT; i++)
+    {
+        fifo[i] = pdm_fifo_errors[i];
+        report.fifo[i] = fifo[i] - health_fifo_reported[i];
+    }
+    report.agc_limited = limited - health_limited_reported;
+
+    if (cm55_ipc_send_audio_health_to_cm33(&report))
+    {
+        audio_health_reset(&audio_health);
+        memcpy(health_fifo_reported, fifo, sizeof(fifo));
+        health_limited_reported = limited;
+
+        #ifdef PRINT_CM55
+        audio_health_print(&report, app_log_printf);
+        #endif
+    }
+}
+#endif /* APP_AUDIO_HEALTH */
+
+#ifdef APP_CLIP_UPLOAD
+/*******************************************************************************
+* Function Name: audio_clip_service
+********************************************************************************
+* Summary:
+*  Resumes recording once the CM33 released the last clip and hands a newly
+*  frozen clip to the CM33. If the IPC pipe is busy the clip is sent with the
+*  next frame. PRINT_CM55 prints the clip statistics with every new clip.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_clip_service(void)
+{
+    clip_t clip;
+
+    if ((CLIP_STATE_HANDED == clip_capture.state) && !clip_pending && cm55_ipc_clip_released())
+    {
+        clip_capture_release(&clip_capture);
+    }
+
+    if (clip_capture_take(&clip_capture, &clip))
+    {
+        clip_payload.samples = clip.ring;
+        clip_payload.capacity = clip.capacity;
+        clip_payload.start = clip.start;
+        clip_payload.length = clip.length;
+        clip_payload.sample_rate = LOGMEL_SAMPLE_RATE;
+        clip_payload.trigger = clip.trigger;
+        clip_payload.sequence = clip.sequence;
+        clip_pending = true;
+        #ifdef PRINT_CM55
+        clip_capture_print_stats(&clip_capture, app_log_printf);
+        #endif
+    }
+
+    if (clip_pending)
+    {
+        clip_payload.dropped = clip_capture.dropped;
+        clip_pending = !cm55_ipc_send_clip_to_cm33(&clip_payload);
+    }
+}
+#endif /* APP_CLIP_UPLOAD */
+
 /* [] END OF FILE */
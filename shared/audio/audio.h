@@ -44,6 +44,8 @@
 #define AUDIO_H_
 
 #include "stdbool.h"
+#include "stdint.h"
+#include "audio_pipeline.h"
 
 /******************************************************************************
  * Constants
@@ -54,11 +56,19 @@
 /* Error type for data processing code when PDM PCM data is not available. */
 #define PDM_PCM_DATA_NOT_READY      (-1L)
 
+/* Error type when the model instance fails to initialize. */
+#define AUDIO_MODEL_INIT_ERROR      AUDIO_PIPELINE_MODEL_ERROR
+
+/* Error type when the audio memory region cannot hold the memory plan. */
+#define AUDIO_MEM_PLAN_ERROR        AUDIO_PIPELINE_MEM_ERROR
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
+cy_rslt_t audio_model_init(uint32_t task_stack_size, void** task_stack);
 cy_rslt_t pdm_init(void);
 cy_rslt_t pdm_data_process(void);
+void audio_wait(uint32_t timeout_ms);
 
 
 #endif /* AUDIO_H_ */
@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include "audio_bench.h"
+#include "audio_pipeline.h"
+#include "baby_cry.h"
+#include "cycle_counter.h"
+#include "ml_placement.h"
+#include "prof.h"
+#include "rdft.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Synthetic input: a slow sweep over noise, about -20 dBFS after the boost */
+#define AUDIO_BENCH_TONE_AMPLITUDE  (200.0f)
+#define AUDIO_BENCH_NOISE_AMPLITUDE (64)
+#define AUDIO_BENCH_SWEEP_MIN_HZ    (200.0f)
+#define AUDIO_BENCH_SWEEP_MAX_HZ    (4000.0f)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t     noise;              /* LCG state */
+    float        phase;
+    float        freq;
+    float        sweep;              /* Hz per sample */
+} audio_bench_synth_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+const audio_bench_config_t audio_bench_configs[] =
+{
+    { 160,  0 },
+    { 1024, 0 },
+    { 4096, 0 },
+    { 1024, 1 },
+    { 1024, 8 },
+    { 1024, 16 },
+    { 1024, BABY_CRY_WINDOW_FRAMES },
+};
+const int audio_bench_config_count = (int)CY_ARRAY_SIZE(audio_bench_configs);
+
+static int16_t bench_block[AUDIO_BENCH_MAX_BLOCK];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static void audio_bench_synth(audio_bench_synth_t* synth, int16_t* pcm, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        synth->noise = synth->noise * 1664525u + 1013904223u;
+        synth->phase += 2.0f * (float)M_PI * synth->freq / LOGMEL_SAMPLE_RATE;
+        if (synth->phase > (float)M_PI)
+        {
+            synth->phase -= 2.0f * (float)M_PI;
+        }
+        synth->freq += synth->sweep;
+        if ((synth->freq > AUDIO_BENCH_SWEEP_MAX_HZ) || (synth->freq < AUDIO_BENCH_SWEEP_MIN_HZ))
+        {
+            synth->sweep = -synth->sweep;
+        }
+        pcm[i] = (int16_t)(AUDIO_BENCH_TONE_AMPLITUDE * sinf(synth->phase)) +
+                 (int16_t)((int32_t)(synth->noise >> 24) % AUDIO_BENCH_NOISE_AMPLITUDE);
+    }
+}
+
+static void audio_bench_count_result(const audio_result_t* result, void* arg)
+{
+    (void)result;
+    (*(uint32_t*)arg)++;
+}
+
+/*******************************************************************************
+* Function Name: audio_bench_print_run
+********************************************************************************
+* Summary:
+*  Prints the JSON object of one configuration.
+*
+*******************************************************************************/
+static void audio_bench_print_run(const audio_bench_config_t* config, uint16_t stride,
+                                  uint32_t samples, uint64_t busy, uint32_t block_max,
+                                  uint32_t windows, uint32_t stack, const char* separator,
+                                  audio_bench_print_fn print)
+{
+    const double clock = (double)SystemCoreClock;
+    const double audio_s = (double)samples / LOGMEL_SAMPLE_RATE;
+    const double block_period = (double)config->block_samples * clock / LOGMEL_SAMPLE_RATE;
+    const logmel_t* frontend = audio_pipeline_frontend();
+
+    print("    {\"block_samples\": %lu, \"window_stride\": %u, \"audio_s\": %.3f,\r\n",
+          (unsigned long)config->block_samples, (unsigned)stride, audio_s);
+    print("     \"frames\": %lu, \"windows\": %lu,\r\n",
+          (unsigned long)(samples - LOGMEL_FFT_SIZE) / LOGMEL_HOP_SIZE + 1u, (unsigned long)windows);
+    print("     \"busy_cycles\": %llu, \"rtf\": %.2f, \"block_cycles_max\": %lu,\r\n",
+          (unsigned long long)busy, (0u != busy) ? audio_s * clock / (double)busy : 0.0,
+          (unsigned long)block_max);
+    print("     \"block_period_cycles\": %.0f, \"peak_load\": %.4f,\r\n",
+          block_period, (double)block_max / block_period);
+    print("     \"frame_cycles\": %lu, \"frame_cycles_max\": %lu,\r\n",
+          (unsigned long)((0u != frontend->frames) ? frontend->cycles_total / frontend->frames : 0u),
+          (unsigned long)frontend->cycles_max);
+
+    #ifdef APP_PROFILING
+    static const char* const names[PROF_STAGE_COUNT] = PROF_STAGE_NAMES;
+    prof_summary_t summary[PROF_STAGE_COUNT];
+    int last = -1;
+
+    prof_summarize(summary);
+    for (int stage = 0; stage < PROF_STAGE_COUNT; stage++)
+    {
+        if (0u != summary[stage].count)
+        {
+            last = stage;
+        }
+    }
+    print("     \"stages\": {\r\n");
+    for (int stage = 0; stage <= last; stage++)
+    {
+        const prof_summary_t* s = &summary[stage];
+        if (0u == s->count)
+        {
+            continue;
+        }
+        print("      \"%s\": {\"count\": %lu, \"min\": %lu, \"mean\": %lu, \"max\": %lu,\r\n",
+              names[stage], (unsigned long)s->count, (unsigned long)s->min, (unsigned long)s->mean,
+              (unsigned long)s->max);
+        print("       \"p99\": %lu, \"total\": %llu}%s\r\n", (unsigned long)s->p99,
+              (unsigned long long)s->count * s->mean, (stage < last) ? "," : "");
+    }
+    print("     },\r\n");
+    #endif /* APP_PROFILING */
+
+    print("     \"memory\": {\r\n");
+    for (int i = 0; NULL != audio_pipeline_mem_plan(i); i++)
+    {
+        const mem_plan_t* plan = audio_pipeline_mem_plan(i);
+        print("      \"%s\": {\"size\": %lu, \"used\": %lu, \"unaliased\": %lu},\r\n", plan->name,
+              (unsigned long)plan->region_size, (unsigned long)plan->used,
+              (unsigned long)plan->unaliased);
+    }
+    if (0u != stack)
+    {
+        print("      \"stack_used\": %lu}}%s\r\n", (unsigned long)stack, separator);
+    }
+    else
+    {
+        print("      \"stack_used\": null}}%s\r\n", separator);
+    }
+}
+
+/*******************************************************************************
+* Function Name: audio_bench_run
+********************************************************************************
+* Summary:
+*  Runs every configuration for the given seconds of synthetic audio without
+*  pacing and prints the results as one JSON document. Cycles are core clock
+*  cycles on the target and nanoseconds on a host, see cycle_counter.h.
+*
+* Parameters:
+*  platform:   name reported in the document, e.g. "cm55"
+*  configs:    configurations, e.g. audio_bench_configs
+*  count:      number of configurations
+*  seconds:    seconds of audio per configuration
+*  stack_used: reports the stack high-water mark of the task, may be NULL
+*  print:      printf compatible output function
+*
+* Return:
+*  AUDIO_BENCH_RET_SUCCESS or AUDIO_BENCH_RET_ERROR for an invalid
+*  configuration or a failed pipeline restart
+*
+*******************************************************************************/
+int audio_bench_run(const char* platform, const audio_bench_config_t* configs, int count,
+                    uint32_t seconds, audio_bench_stack_fn stack_used,
+                    audio_bench_print_fn print)
+{
+    #ifdef APP_PROFILING
+    const char* profiling = "true";
+    #else
+    const char* profiling = "false";
+    #endif
+    #if defined(COMPONENT_CM55) && (AUDIO_FRONTEND_TCM == 1)
+    const char* frontend_tcm = "true";
+    #else
+    const char* frontend_tcm = "false";
+    #endif
+    int ret = AUDIO_BENCH_RET_SUCCESS;
+
+    /* Every print() is one complete line with a short format, so that the
+     * document survives app_log_printf() and the log forwarding of the CM55 */
+    print("{\"benchmark\": \"audio_pipeline\", \"platform\": \"%s\", \"core_clock_hz\": %lu,\r\n",
+          platform, (unsigned long)SystemCoreClock);
+    print(" \"profiling\": %s, \"placement\": \"%s\", \"frontend_tcm\": %s, \"frontend_code\": \"%p\",\r\n",
+          profiling, ML_PLACEMENT_NAME, frontend_tcm, (void*)(uintptr_t)rdft_f32);
+    print(" \"sample_rate\": %d, \"fft_size\": %d, \"hop_size\": %d, \"bands\": %d,\r\n",
+          LOGMEL_SAMPLE_RATE, LOGMEL_FFT_SIZE, LOGMEL_HOP_SIZE, LOGMEL_BANDS);
+    print(" \"model\": \"%s\", \"window_frames\": %d, \"model_stride\": %d,\r\n",
+          baby_cry_model.name, baby_cry_model.window_frames, baby_cry_model.window_stride);
+    print(" \"runs\": [\r\n");
+
+    for (int i = 0; i < count; i++)
+    {
+        const audio_bench_config_t* config = &configs[i];
+        const uint32_t total = seconds * LOGMEL_SAMPLE_RATE;
+        audio_bench_synth_t synth = { 1u, 0.0f, AUDIO_BENCH_SWEEP_MIN_HZ, 0.01f };
+        uint32_t windows = 0;
+        uint16_t stride = (0u != config->window_stride) ? config->window_stride
+                                                        : (uint16_t)baby_cry_model.window_stride;
+        uint32_t samples = 0;
+        uint32_t block_max = 0;
+        uint64_t busy = 0;
+
+        if ((0u == config->block_samples) || (config->block_samples > AUDIO_BENCH_MAX_BLOCK) ||
+            (CY_RSLT_SUCCESS != audio_pipeline_restart(stride, audio_bench_count_result, &windows)))
+        {
+            ret = AUDIO_BENCH_RET_ERROR;
+            break;
+        }
+        #ifdef APP_PROFILING
+        prof_reset();
+        #endif
+
+        while (samples < total)
+        {
+            uint32_t block = total - samples;
+            if (block > config->block_samples)
+            {
+                block = config->block_samples;
+            }
+            audio_bench_synth(&synth, bench_block, block);
+
+            uint32_t start = cycle_counter_get();
+            audio_pipeline_process(bench_block, block);
+            uint32_t cycles = cycle_counter_get() - start;
+
+            busy += cycles;
+            if (cycles > block_max)
+            {
+                block_max = cycles;
+            }
+            samples += block;
+        }
+
+        audio_bench_print_run(config, stride, samples, busy, block_max, windows,
+                              (NULL != stack_used) ? stack_used() : 0u, (i + 1 < count) ? "," : "", print);
+    }
+
+    print(" ],\r\n");
+    print(" \"status\": \"%s\"}\r\n", (AUDIO_BENCH_RET_SUCCESS == ret) ? "ok" : "error");
+    return ret;
+}
+
+/* [] END OF FILE */
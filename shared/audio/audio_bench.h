@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Throughput benchmark of the audio pipeline.
+ *
+ * Feeds synthetic PCM blocks to audio_pipeline_process() back to back, as
+ * pdm_data_process() would without the pacing of the PDM, and prints one JSON
+ * document with the sustained real-time factor, the worst block load, the
+ * per-stage cycles (APP_PROFILING builds) and the memory usage of every
+ * configuration. Block size and model stride are varied at run time, FFT size
+ * and hop are compile-time settings of logmel.h and only reported.
+ */
+
+#ifndef AUDIO_BENCH_H_
+#define AUDIO_BENCH_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest block handed to audio_pipeline_process() */
+#define AUDIO_BENCH_MAX_BLOCK       (4096)
+
+/* Seconds of synthetic audio per configuration */
+#ifndef AUDIO_BENCH_SECONDS
+#define AUDIO_BENCH_SECONDS         (10)
+#endif
+
+#define AUDIO_BENCH_RET_SUCCESS     (0)
+#define AUDIO_BENCH_RET_ERROR       (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t     block_samples;      /* Samples per call, FRAME_SIZE on the target */
+    uint16_t     window_stride;      /* Model stride in frames, 0 = model default */
+} audio_bench_config_t;
+
+/* Bytes of stack the calling task used so far, 0 if unknown */
+typedef uint32_t (*audio_bench_stack_fn)(void);
+
+/* printf compatible sink of the JSON document */
+typedef int (*audio_bench_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Block sizes around FRAME_SIZE and strides from every frame to no overlap */
+extern const audio_bench_config_t audio_bench_configs[];
+extern const int audio_bench_config_count;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* The pipeline must be initialized. It is restarted for every configuration
+ * and left running with the last one. */
+int audio_bench_run(const char* platform, const audio_bench_config_t* configs, int count,
+                    uint32_t seconds, audio_bench_stack_fn stack_used,
+                    audio_bench_print_fn print);
+
+#endif /* AUDIO_BENCH_H_ */
@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "audio_health.h"
+
+#if defined(COMPONENT_CM55)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Width of the portable loops, see agc.c */
+#define AUDIO_HEALTH_LANES          (8)
+
+#define AUDIO_HEALTH_FULL_SCALE     (32768.0f)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Sum, sum of squares and largest magnitude of one channel of a frame */
+static void audio_health_block(const int16_t* pcm, uint32_t count, uint32_t stride,
+                               int32_t* sum, uint64_t* power, uint32_t* peak)
+{
+    #if defined(COMPONENT_CM55)
+    if (1u == stride)
+    {
+        q63_t squares;
+        q15_t max;
+        q15_t mean;
+        uint32_t index;
+
+        /* The products of arm_power_q15() are not shifted, the sum is the
+         * integer sum of squares. The mean drops the fraction, a DC offset
+         * of at most one LSB. */
+        arm_power_q15(pcm, count, &squares);
+        arm_absmax_q15(pcm, count, &max, &index);
+        arm_mean_q15(pcm, count, &mean);
+        *power = (uint64_t)squares;
+        *peak = (uint32_t)max;
+        *sum = (int32_t)mean * (int32_t)count;
+        return;
+    }
+    #endif
+
+    /* Independent lanes, so that the reductions vectorize too */
+    int32_t sums[AUDIO_HEALTH_LANES] = { 0 };
+    uint64_t squares[AUDIO_HEALTH_LANES] = { 0 };
+    uint32_t max[AUDIO_HEALTH_LANES] = { 0 };
+    uint32_t i = 0;
+
+    for (; i + AUDIO_HEALTH_LANES <= count; i += AUDIO_HEALTH_LANES)
+    {
+        for (uint32_t lane = 0; lane < AUDIO_HEALTH_LANES; lane++)
+        {
+            int32_t value = pcm[(i + lane) * stride];
+            uint32_t magnitude = (uint32_t)((value < 0) ? -value : value);
+            sums[lane] += value;
+            squares[lane] += (uint64_t)(value * value);
+            max[lane] = (magnitude > max[lane]) ? magnitude : max[lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        int32_t value = pcm[i * stride];
+        uint32_t magnitude = (uint32_t)((value < 0) ? -value : value);
+        sums[0] += value;
+        squares[0] += (uint64_t)(value * value);
+        max[0] = (magnitude > max[0]) ? magnitude : max[0];
+    }
+    *sum = 0;
+    *power = 0u;
+    *peak = 0u;
+    for (uint32_t lane = 0; lane < AUDIO_HEALTH_LANES; lane++)
+    {
+        *sum += sums[lane];
+        *power += squares[lane];
+        *peak = (max[lane] > *peak) ? max[lane] : *peak;
+    }
+}
+
+/* Samples at full scale, only called when the peak reached it */
+static uint32_t audio_health_count_clipped(const int16_t* pcm, uint32_t count, uint32_t stride)
+{
+    uint32_t clipped = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int32_t value = pcm[i * stride];
+        if ((value >= AUDIO_HEALTH_CLIP_LEVEL) || (value <= -AUDIO_HEALTH_CLIP_LEVEL))
+        {
+            clipped++;
+        }
+    }
+    return clipped;
+}
+
+static float audio_health_dbfs(float rms)
+{
+    float dbfs = (rms > 0.0f) ? 20.0f * log10f(rms / AUDIO_HEALTH_FULL_SCALE) : AUDIO_HEALTH_MIN_DBFS;
+    return (dbfs > AUDIO_HEALTH_MIN_DBFS) ? dbfs : AUDIO_HEALTH_MIN_DBFS;
+}
+
+/*******************************************************************************
+* Function Name: audio_health_init
+********************************************************************************
+* Summary:
+*  Initializes the statistics of a capture with one or more microphones.
+*
+* Parameters:
+*  health:   statistics
+*  channels: microphones, interleaved in the frames
+*
+* Return:
+*  AUDIO_HEALTH_RET_SUCCESS or AUDIO_HEALTH_RET_ERROR
+*
+*******************************************************************************/
+int audio_health_init(audio_health_t* health, uint32_t channels)
+{
+    if ((0u == channels) || (channels > AUDIO_HEALTH_MAX_CHANNELS))
+    {
+        return AUDIO_HEALTH_RET_ERROR;
+    }
+    health->channels = channels;
+    audio_health_reset(health);
+    return AUDIO_HEALTH_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: audio_health_frame
+********************************************************************************
+* Summary:
+*  Adds a raw frame to the statistics.
+*
+* Parameters:
+*  health: statistics
+*  pcm:    16 bit PCM, the channels interleaved
+*  count:  samples per channel
+*
+*******************************************************************************/
+void audio_health_frame(audio_health_t* health, const int16_t* pcm, uint32_t count)
+{
+    for (uint32_t c = 0; c < health->channels; c++)
+    {
+        audio_health_channel_t* ch = &health->ch[c];
+        int32_t sum;
+        uint64_t power;
+        uint32_t peak;
+
+        audio_health_block(&pcm[c], count, health->channels, &sum, &power, &peak);
+        ch->sum += sum;
+        ch->power += power;
+        if (peak >= AUDIO_HEALTH_CLIP_LEVEL)
+        {
+            ch->clipped += audio_health_count_clipped(&pcm[c], count, health->channels);
+        }
+        ch->peak = (peak > ch->peak) ? peak : ch->peak;
+
+        /* Frames of other sizes compare by their mean square */
+        if ((0u == health->frames) ||
+            (power * ch->min_frame_samples < ch->min_frame_power * count))
+        {
+            ch->min_frame_power = power;
+            ch->min_frame_samples = count;
+        }
+    }
+    health->frames++;
+    health->samples += count;
+}
+
+/*******************************************************************************
+* Function Name: audio_health_summarize
+********************************************************************************
+* Summary:
+*  Computes the levels of every channel since the last reset. The FIFO errors
+*  and the AGC figures are left to the caller.
+*
+* Parameters:
+*  health:      statistics
+*  sample_rate: samples per second, for the period
+*  report:      filled in
+*
+*******************************************************************************/
+void audio_health_summarize(const audio_health_t* health, uint32_t sample_rate, audio_health_report_t* report)
+{
+    memset(report, 0, sizeof(*report));
+    report->samples = health->samples;
+    report->channels = health->channels;
+    report->period_ms = (uint32_t)(((uint64_t)health->samples * 1000u) / sample_rate);
+
+    for (uint32_t c = 0; c < health->channels; c++)
+    {
+        const audio_health_channel_t* ch = &health->ch[c];
+        audio_health_channel_report_t* out = &report->ch[c];
+
+        if (0u == health->samples)
+        {
+            out->rms_dbfs = AUDIO_HEALTH_MIN_DBFS;
+            out->floor_dbfs = AUDIO_HEALTH_MIN_DBFS;
+            out->peak_dbfs = AUDIO_HEALTH_MIN_DBFS;
+            continue;
+        }
+        out->rms_dbfs = audio_health_dbfs(sqrtf((float)ch->power / (float)health->samples));
+        out->floor_dbfs = audio_health_dbfs(sqrtf((float)ch->min_frame_power / (float)ch->min_frame_samples));
+        out->peak_dbfs = audio_health_dbfs((float)ch->peak);
+        out->dc_offset = ((float)ch->sum / (float)health->samples) / AUDIO_HEALTH_FULL_SCALE;
+        out->clipped = ch->clipped;
+    }
+}
+
+void audio_health_reset(audio_health_t* health)
+{
+    uint32_t channels = health->channels;
+
+    memset(health, 0, sizeof(*health));
+    health->channels = channels;
+}
+
+/*******************************************************************************
+* Function Name: audio_health_print
+********************************************************************************
+* Summary:
+*  Prints a report, one line per channel.
+*
+* Parameters:
+*  report: report
+*  print:  printf compatible output function
+*
+*******************************************************************************/
+void audio_health_print(const audio_health_report_t* report, audio_health_print_fn print)
+{
+    static const char* const fifo_names[AUDIO_HEALTH_FIFO_COUNT] = AUDIO_HEALTH_FIFO_NAMES;
+
+    print("audio health: %lu ms, agc limited %lu samples, pdm %s %lu, %s %lu, %s %lu, %s %lu\r\n",
+          (unsigned long)report->period_ms, (unsigned long)report->agc_limited,
+          fifo_names[0], (unsigned long)report->fifo[0], fifo_names[1], (unsigned long)report->fifo[1],
+          fifo_names[2], (unsigned long)report->fifo[2], fifo_names[3], (unsigned long)report->fifo[3]);
+    for (uint32_t c = 0; c < report->channels; c++)
+    {
+        const audio_health_channel_report_t* ch = &report->ch[c];
+        print("  mic %lu: rms %.1f dBFS, floor %.1f dBFS, peak %.1f dBFS, dc %+.5f, clipped %lu of %lu\r\n",
+              (unsigned long)c, ch->rms_dbfs, ch->floor_dbfs, ch->peak_dbfs, ch->dc_offset,
+              (unsigned long)ch->clipped, (unsigned long)report->samples);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,975 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "audio_pipeline.h"
+#include "agc.h"
+#include "baby_cry.h"
+#include "beamform.h"
+#include "dc_block.h"
+#include "denoise.h"
+#include "mem_plan.h"
+#include "ml_placement.h"
+#include "cycle_counter.h"
+#include "model_profile.h"
+#include "prof.h"
+#ifdef PRINT_CM55
+#include "app_log.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The input level is set by the AGC of agc.h, which replaces the former
+ * fixed DIGITAL_BOOST_FACTOR of 10. Its AGC_* defaults can be overridden
+ * with DEFINES, e.g. AGC_MAX_GAIN_DB=0 AGC_MIN_GAIN_DB=0 AGC_INITIAL_GAIN_DB=0
+ * if the same board recorded the training data of your own model. */
+
+/* Specifies the dynamic range in bits.
+ * PCM word length, see the A/D specific documentation for valid ranges. */
+#define AUIDO_BITS_PER_SAMPLE                   16
+
+/* Converts given audio sample into range [-1,1] */
+#define SAMPLE_NORMALIZE(sample)                (((float) (sample)) / (float) (1 << (AUIDO_BITS_PER_SAMPLE - 1)))
+
+/* Threshold for the output score to be considered a valid detection.
+ * The threshold can be adjusted to increase or decrease the sensitivity of the
+ * detection. A lower value will result in more false positives, while a higher
+ * value will result in more false negatives. */
+#define OUTPUT_THRESHOLD_SCORE                  (0.6f)
+
+/* Best scores of every window logged with PRINT_CM55 */
+#define PRINT_TOP_SCORES                        (3)
+
+/* Cycle budget of one model window (enqueue of the frames and inference).
+ * One hop of the front end; the ping-pong buffers give FRAME_SIZE samples of
+ * slack before PDM data is lost. */
+#define MODEL_CYCLE_BUDGET_MS                   (10u)
+
+/* Geometry of the two microphones and the look direction of the beamformer,
+ * in degrees from broadside, positive towards the channel 0 microphone */
+#ifndef BEAMFORM_MIC_SPACING_MM
+#define BEAMFORM_MIC_SPACING_MM                 (20)
+#endif
+#ifndef BEAMFORM_ANGLE_DEG
+#define BEAMFORM_ANGLE_DEG                      (0)
+#endif
+
+/* Cycle budget of the beamformer per hop, a tenth of the hop */
+#define BEAMFORM_CYCLE_BUDGET_US                ((1000000u / LOGMEL_SAMPLE_RATE) * LOGMEL_HOP_SIZE / 10u)
+
+/* Beamformer state, only planned when two microphones are captured */
+#define AUDIO_MEM_BEAMFORM_SIZE                 ((AUDIO_CAPTURE_CHANNELS > 1) ? sizeof(beamform_t) : 0u)
+
+/* Noise suppression state, only planned with AUDIO_DENOISE */
+#define AUDIO_MEM_DENOISE_SIZE                  (AUDIO_DENOISE ? sizeof(denoise_t) : 0u)
+
+/* Phases of the processing loop, used to alias buffers in the memory plan */
+#define MEM_LIVE_FRONTEND                       (1u << 0)   /* Log-mel frame */
+#define MEM_LIVE_INFERENCE                      (1u << 1)   /* Model window */
+
+#define MEM_MAX(a, b)                           (((a) > (b)) ? (a) : (b))
+
+/* The model scratch is only live while a window is classified, unless that
+ * happens in another task while the front end goes on */
+#define MEM_LIVE_MODEL                          (AUDIO_ASYNC_INFERENCE ? MEM_PLAN_LIVE_ALWAYS : MEM_LIVE_INFERENCE)
+
+/* Sizes of the buffer classes of ml_placement.h. The scratch buffers alias
+ * unless the inference is asynchronous. */
+#define AUDIO_MEM_WINDOWS_SIZE                  (AUDIO_MEM_CAPTURE_RESERVE + \
+                                                 sizeof(logmel_t) + BABY_CRY_STATE_SIZE + \
+                                                 AUDIO_MEM_BEAMFORM_SIZE + AUDIO_MEM_DENOISE_SIZE + \
+                                                 AUDIO_MEM_STACK_RESERVE)
+#define AUDIO_MEM_SCRATCH_SIZE                  (AUDIO_ASYNC_INFERENCE ? \
+                                                 (sizeof(logmel_scratch_t) + BABY_CRY_BUFFER_SIZE) : \
+                                                 MEM_MAX(sizeof(logmel_scratch_t), BABY_CRY_BUFFER_SIZE))
+
+/* Size of the region of one memory: the classes placed there plus alignment
+ * slack */
+#define AUDIO_MEM_POOL_SIZE(mem)                ((((mem) == ML_PLACE_WEIGHTS) ? BABY_CRY_WEIGHTS_SIZE : 0u) + \
+                                                 (((mem) == ML_PLACE_ARENA) ? BABY_CRY_ARENA_SIZE : 0u) + \
+                                                 (((mem) == ML_PLACE_WINDOWS) ? AUDIO_MEM_WINDOWS_SIZE : 0u) + \
+                                                 (((mem) == ML_PLACE_SCRATCH) ? AUDIO_MEM_SCRATCH_SIZE : 0u) + \
+                                                 16u * 10u)
+
+/* NPU interrupt priority the generated model code initializes the runtime with */
+#define MODEL_PROFILE_NPU_PRIORITY              (3)
+
+/* Runtime sized entries of audio_mem_bufs */
+#define AUDIO_MEM_BUF_CAPTURE                   (0)
+#define AUDIO_MEM_BUF_TASK_STACK                (1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Shared log-mel front end. Every model is registered as a frame consumer. */
+static logmel_t* frontend;
+static logmel_scratch_t* frontend_scratch;
+
+/* Beamformer of the two microphone capture, NULL with one microphone */
+static beamform_t* beamformer;
+
+/* Noise suppression of the front end, NULL without AUDIO_DENOISE */
+static denoise_t* frontend_denoise;
+
+/* Gain control of the normalized input, one block per hop */
+static agc_t input_agc;
+
+/* DC blocker ahead of the AGC, only used with AUDIO_DC_BLOCK */
+static dc_block_t input_dc_block;
+
+/* Baby cry model instance and its memory. The scratch buffer is only used
+ * from imai_model_prepare() to the end of imai_model_run() and can be shared
+ * by further model instances. */
+static imai_ctx_t cry_model;
+static logmel_consumer_t cry_consumer;
+static int8_t* model_scratch;
+static int8_t* cry_model_state;
+static int8_t* cry_model_arena;
+static uint8_t* cry_model_weights;         /* NULL when executed in place */
+static uint32_t weights_copy_cycles;
+static uint32_t cry_model_runs;
+
+/* Output quantization of the model and OUTPUT_THRESHOLD_SCORE in it */
+static score_q_t cry_score_q;
+
+/* Early exit stage ahead of the baby cry model, off while params is NULL */
+static const early_exit_params_t* cry_exit_params;
+static early_exit_t cry_exit;
+
+#ifdef APP_MODEL_PROFILE
+/* Operator profile of the model, taken once at boot */
+static model_profile_t cry_model_profile;
+static bool cry_model_profiled;
+#endif
+
+/* Receiver of the model decisions */
+static audio_result_fn result_callback;
+static void* result_arg;
+
+/* Classifies the windows in another task, NULL to do it in place */
+static const audio_executor_t* executor;
+
+/* Window of the model: copied and described by cry_model_window(),
+ * classified by audio_pipeline_infer() and decided on by
+ * audio_pipeline_collect(). Only one window is in flight at a time. */
+static audio_result_t job_result;
+static uint32_t job_start;                 /* When the window was complete */
+static int job_status;
+static bool job_started;                   /* Not collected yet */
+static bool job_done;                      /* Classified, set by the executor task */
+
+/* Every buffer is placed in the memory its class selects in ml_placement.h.
+ * Each memory has one region planned by mem_plan. The front end scratch is
+ * only live while a frame is computed and the model scratch only while a
+ * window is classified, so the two share their address, unless the windows
+ * are classified in another task (AUDIO_ASYNC_INFERENCE). */
+static IMAI_ARENA_MEM IMAI_ALIGNED(16) uint8_t audio_mem_socmem[AUDIO_MEM_POOL_SIZE(ML_MEM_SOCMEM)];
+static IMAI_ALIGNED(16) uint8_t audio_mem_local[AUDIO_MEM_POOL_SIZE(ML_MEM_LOCAL)];
+static mem_plan_t audio_mem[2];
+static mem_plan_buf_t audio_mem_bufs[] =
+{
+    { "capture",          0,                             4, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, NULL, 0 },
+    { "task_stack",       0,                             8, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, NULL, 0 },
+    { "logmel",           sizeof(logmel_t),              8, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, (void**)&frontend, 0 },
+    { "beamform",         AUDIO_MEM_BEAMFORM_SIZE,       8, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, (void**)&beamformer, 0 },
+    { "denoise",          AUDIO_MEM_DENOISE_SIZE,        8, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, (void**)&frontend_denoise, 0 },
+    { "baby_cry_state",   BABY_CRY_STATE_SIZE,          16, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WINDOWS, (void**)&cry_model_state, 0 },
+    { "logmel_scratch",   sizeof(logmel_scratch_t),      8, MEM_LIVE_FRONTEND,    ML_PLACE_SCRATCH, (void**)&frontend_scratch, 0 },
+    { "model_scratch",    BABY_CRY_BUFFER_SIZE,         16, MEM_LIVE_MODEL,       ML_PLACE_SCRATCH, (void**)&model_scratch, 0 },
+    { "baby_cry_arena",   BABY_CRY_ARENA_SIZE,          16, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_ARENA,   (void**)&cry_model_arena, 0 },
+    { "baby_cry_weights", BABY_CRY_WEIGHTS_SIZE,        16, MEM_PLAN_LIVE_ALWAYS, ML_PLACE_WEIGHTS, (void**)&cry_model_weights, 0 },
+};
+
+/*******************************************************************************
+* Local Function Prototypes
+*******************************************************************************/
+static cy_rslt_t audio_pipeline_start(uint16_t window_stride);
+static int model_consumer_push(void* arg, const float* frame);
+static void cry_model_window(void* arg);
+#ifdef APP_MODEL_PROFILE
+static void audio_model_profile(void);
+#endif
+#ifdef PRINT_CM55
+static void audio_mem_report(void);
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: audio_pipeline_init
+********************************************************************************
+* Summary:
+*  Lays out the audio memory regions, copies the weights if they are not
+*  executed in place, initializes the log-mel front end, binds memory to the
+*  model instance, initializes the inference engine and registers the model as
+*  a consumer of the front end.
+*
+* Parameters:
+*  capture_size:    bytes of capture buffer to place with the windows, 0 for none
+*  capture:         receives the capture buffer address
+*  task_stack_size: bytes of task stack to place with the windows, 0 for none
+*  task_stack:      receives the task stack address
+*  on_result:       called with the decision of every model window
+*  arg:             passed to on_result
+*
+* Return:
+*  The status of the initialization.
+*
+*******************************************************************************/
+cy_rslt_t audio_pipeline_init(uint32_t capture_size, void** capture,
+                              uint32_t task_stack_size, void** task_stack,
+                              audio_result_fn on_result, void* arg)
+{
+    if ((capture_size > AUDIO_MEM_CAPTURE_RESERVE) ||
+        (task_stack_size > AUDIO_MEM_STACK_RESERVE))
+    {
+        return AUDIO_PIPELINE_MEM_ERROR;
+    }
+    audio_mem_bufs[AUDIO_MEM_BUF_CAPTURE].size = capture_size;
+    audio_mem_bufs[AUDIO_MEM_BUF_CAPTURE].ptr = capture;
+    audio_mem_bufs[AUDIO_MEM_BUF_TASK_STACK].size = task_stack_size;
+    audio_mem_bufs[AUDIO_MEM_BUF_TASK_STACK].ptr = task_stack;
+
+    memset(audio_mem_socmem, 0, sizeof(audio_mem_socmem));
+    memset(audio_mem_local, 0, sizeof(audio_mem_local));
+    if ((MEM_PLAN_RET_SUCCESS != mem_plan_layout(&audio_mem[0], "socmem", ML_MEM_SOCMEM,
+                                                 audio_mem_socmem, sizeof(audio_mem_socmem),
+                                                 audio_mem_bufs, (int)CY_ARRAY_SIZE(audio_mem_bufs))) ||
+        (MEM_PLAN_RET_SUCCESS != mem_plan_verify(&audio_mem[0])) ||
+        (MEM_PLAN_RET_SUCCESS != mem_plan_layout(&audio_mem[1], "local", ML_MEM_LOCAL,
+                                                 audio_mem_local, sizeof(audio_mem_local),
+                                                 audio_mem_bufs, (int)CY_ARRAY_SIZE(audio_mem_bufs))) ||
+        (MEM_PLAN_RET_SUCCESS != mem_plan_verify(&audio_mem[1])))
+    {
+        return AUDIO_PIPELINE_MEM_ERROR;
+    }
+
+    cycle_counter_init();
+
+    /* Copy the weights out of flash unless they are executed in place */
+    if (NULL != cry_model_weights)
+    {
+        uint32_t start = cycle_counter_get();
+        memcpy(cry_model_weights, baby_cry_model.weights, baby_cry_model.weights_size);
+        weights_copy_cycles = cycle_counter_get() - start;
+    }
+
+    #ifdef PRINT_CM55
+    audio_mem_report();
+    #endif
+
+    #ifdef APP_MODEL_PROFILE
+    audio_model_profile();
+    #endif
+
+    result_callback = on_result;
+    result_arg = arg;
+
+    return audio_pipeline_start(0);
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_start
+********************************************************************************
+* Summary:
+*  Resets the DC blocker, the AGC, the beamformer, the noise suppression and
+*  the log-mel front end, initializes the model instance in its planned memory and registers it
+*  as a consumer of the front end.
+*
+* Parameters:
+*  window_stride: model stride in frames, 0 for the stride of the model
+*
+* Return:
+*  The status of the initialization.
+*
+*******************************************************************************/
+static cy_rslt_t audio_pipeline_start(uint16_t window_stride)
+{
+    agc_config_t agc_config;
+    denoise_config_t denoise_config;
+
+    logmel_init(frontend, frontend_scratch);
+
+    if (NULL != frontend_denoise)
+    {
+        denoise_default_config(&denoise_config);
+        if (DENOISE_RET_SUCCESS != denoise_init(frontend_denoise, &denoise_config))
+        {
+            return AUDIO_PIPELINE_MODEL_ERROR;
+        }
+        logmel_set_denoise(frontend, frontend_denoise);
+    }
+
+    agc_default_config(&agc_config);
+    if (AGC_RET_SUCCESS != agc_init(&input_agc, &agc_config, LOGMEL_SAMPLE_RATE, LOGMEL_HOP_SIZE))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+    if (DC_BLOCK_RET_SUCCESS != dc_block_init(&input_dc_block, DC_BLOCK_CUTOFF_HZ, LOGMEL_SAMPLE_RATE))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+
+    if ((NULL != beamformer) &&
+        (BEAMFORM_RET_SUCCESS != beamform_init(beamformer, BEAMFORM_MIC_SPACING_MM / 1000.0f,
+                                               (float)BEAMFORM_ANGLE_DEG,
+                                               (SystemCoreClock / 1000000u) * BEAMFORM_CYCLE_BUDGET_US)))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+
+    if ((baby_cry_model.out_count > AUDIO_PIPELINE_MAX_SCORES) ||
+        (window_stride > baby_cry_model.window_frames) ||
+        (IMAI_MODEL_RET_SUCCESS != imai_model_init(&cry_model, &baby_cry_model,
+                                                   cry_model_weights, model_scratch,
+                                                   cry_model_state, cry_model_arena)))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+    if (0 != window_stride)
+    {
+        cry_model.window_stride = window_stride;
+    }
+    if ((NULL == cry_model.def->run_q) ||
+        (SCORE_Q_RET_SUCCESS != score_q_init(&cry_score_q, cry_model.model->output_scale,
+                                             cry_model.model->output_zero_point, OUTPUT_THRESHOLD_SCORE)))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+    cry_model_runs = 0;
+    memset(&cry_exit, 0, sizeof(cry_exit));
+    if ((NULL != cry_exit_params) &&
+        (EARLY_EXIT_RET_SUCCESS != early_exit_init(&cry_exit, cry_exit_params, cry_model.def->window_frames)))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+
+    cry_consumer.name = cry_model.def->name;
+    cry_consumer.window_frames = cry_model.def->window_frames;
+    cry_consumer.window_stride = cry_model.window_stride;
+    cry_consumer.budget_cycles = (SystemCoreClock / 1000u) * MODEL_CYCLE_BUDGET_MS;
+    cry_consumer.push = model_consumer_push;
+    cry_consumer.window = cry_model_window;
+    cry_consumer.arg = &cry_model;
+
+    if (LOGMEL_RET_SUCCESS != logmel_add_consumer(frontend, &cry_consumer))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_restart
+********************************************************************************
+* Summary:
+*  Starts the front end and the model instance over in the memory planned by
+*  audio_pipeline_init(). Further consumers have to be added again. Used by
+*  the throughput benchmark to compare model strides.
+*
+* Parameters:
+*  window_stride: model stride in frames, 0 for the stride of the model
+*  on_result:     called with the decision of every model window
+*  arg:           passed to on_result
+*
+* Return:
+*  The status of the initialization.
+*
+*******************************************************************************/
+cy_rslt_t audio_pipeline_restart(uint16_t window_stride, audio_result_fn on_result, void* arg)
+{
+    (void)audio_pipeline_collect(true);
+    imai_model_finalize(&cry_model);
+    result_callback = on_result;
+    result_arg = arg;
+    return audio_pipeline_start(window_stride);
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_deinit
+********************************************************************************
+* Summary:
+*  Releases the model instance so that audio_pipeline_init() can start over,
+*  e.g. between two recordings replayed on a host.
+*
+*******************************************************************************/
+void audio_pipeline_deinit(void)
+{
+    (void)audio_pipeline_collect(true);
+    imai_model_finalize(&cry_model);
+    result_callback = NULL;
+    result_arg = NULL;
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_add_consumer
+********************************************************************************
+* Summary:
+*  Registers a further consumer of the log-mel frames, e.g. a feature logger.
+*  Must be called after audio_pipeline_init().
+*
+* Parameters:
+*  consumer: consumer with its configuration fields filled in
+*
+* Return:
+*  LOGMEL_RET_SUCCESS or LOGMEL_RET_ERROR
+*
+*******************************************************************************/
+int audio_pipeline_add_consumer(logmel_consumer_t* consumer)
+{
+    return logmel_add_consumer(frontend, consumer);
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_mem_plan
+********************************************************************************
+* Summary:
+*  Gives access to the memory plans, one per memory, e.g. for usage reports.
+*
+* Parameters:
+*  index: plan index, from 0
+*
+* Return:
+*  The plan or NULL past the last one
+*
+*******************************************************************************/
+const mem_plan_t* audio_pipeline_mem_plan(int index)
+{
+    return ((index >= 0) && (index < (int)CY_ARRAY_SIZE(audio_mem))) ? &audio_mem[index] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_frontend
+********************************************************************************
+* Summary:
+*  Gives access to the log-mel front end, e.g. for its frame statistics.
+*
+*******************************************************************************/
+const logmel_t* audio_pipeline_frontend(void)
+{
+    return frontend;
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_model_profile
+********************************************************************************
+* Summary:
+*  Operator profile of the model, taken by audio_pipeline_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  The report or NULL if built without APP_MODEL_PROFILE or the profile failed
+*
+*******************************************************************************/
+const model_profile_report_t* audio_pipeline_model_profile(void)
+{
+    #ifdef APP_MODEL_PROFILE
+    return cry_model_profiled ? &cry_model_profile.report : NULL;
+    #else
+    return NULL;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_set_early_exit
+********************************************************************************
+* Summary:
+*  Puts an early exit stage of early_exit.h ahead of the model: windows it
+*  rejects as background are decided without running the model. The stage
+*  starts with an empty window. A window in flight is collected first.
+*  Must be called after audio_pipeline_init().
+*
+* Parameters:
+*  params: weights and threshold, must stay valid; NULL to run the model on
+*          every window again
+*
+* Return:
+*  CY_RSLT_SUCCESS or AUDIO_PIPELINE_MODEL_ERROR
+*
+*******************************************************************************/
+cy_rslt_t audio_pipeline_set_early_exit(const early_exit_params_t* params)
+{
+    (void)audio_pipeline_collect(true);
+    cry_exit_params = NULL;
+    memset(&cry_exit, 0, sizeof(cry_exit));
+    if ((NULL != params) &&
+        (EARLY_EXIT_RET_SUCCESS != early_exit_init(&cry_exit, params, cry_model.def->window_frames)))
+    {
+        return AUDIO_PIPELINE_MODEL_ERROR;
+    }
+    cry_exit_params = params;
+    return CY_RSLT_SUCCESS;
+}
+
+#ifdef APP_MODEL_PROFILE
+/*******************************************************************************
+* Function Name: audio_model_profile
+********************************************************************************
+* Summary:
+*  Profiles the operators of the model at boot. The interpreter of the
+*  profile runs the weights from where the instance will execute them and
+*  borrows the arena of the instance, which is not initialized yet, so the
+*  latencies and the arena use are those of the application.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_model_profile(void)
+{
+    const uint8_t* weights = (NULL != cry_model_weights) ? cry_model_weights : baby_cry_model.weights;
+
+    if ((MODEL_PROFILE_RET_SUCCESS != model_profile_init(&cry_model_profile, weights,
+                                                         baby_cry_model.weights_size,
+                                                         baby_cry_model.arena_size)) ||
+        (IMAI_MODEL_RET_SUCCESS != imai_runtime_acquire(MODEL_PROFILE_NPU_PRIORITY)))
+    {
+        return;
+    }
+    cry_model_profiled = (MODEL_PROFILE_RET_SUCCESS == model_profile_run(&cry_model_profile, weights,
+                                                                          (uint8_t*)cry_model_arena,
+                                                                          MODEL_PROFILE_RUNS));
+    imai_runtime_release();
+
+    cry_model_profile.report.core_clock_hz = SystemCoreClock;
+    model_profile_summarize(&cry_model_profile);
+    #ifdef PRINT_CM55
+    if (!cry_model_profiled)
+    {
+        APP_LOG_WARN("model profile: the profiling interpreter failed, only the placement is known");
+    }
+    model_profile_print(&cry_model_profile.report, app_log_printf);
+    #endif
+}
+#endif /* APP_MODEL_PROFILE */
+
+#ifdef PRINT_CM55
+/*******************************************************************************
+* Function Name: audio_mem_report
+********************************************************************************
+* Summary:
+*  Boot report of the placement preset, the memory every buffer landed in and
+*  the time the weight copy took.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_mem_report(void)
+{
+    APP_LOG_INFO("ML placement %s: weights %s, arena %s, windows %s, scratch %s",
+           ML_PLACEMENT_NAME, ML_MEM_NAME(ML_PLACE_WEIGHTS), ML_MEM_NAME(ML_PLACE_ARENA),
+           ML_MEM_NAME(ML_PLACE_WINDOWS), ML_MEM_NAME(ML_PLACE_SCRATCH));
+    mem_plan_report(&audio_mem[0], app_log_printf);
+    mem_plan_report(&audio_mem[1], app_log_printf);
+    if (NULL != cry_model_weights)
+    {
+        APP_LOG_INFO("weights: %lu bytes copied to %p in %lu cycles (%lu us)",
+               (unsigned long)baby_cry_model.weights_size, (void*)cry_model_weights,
+               (unsigned long)weights_copy_cycles,
+               (unsigned long)(weights_copy_cycles / (SystemCoreClock / 1000000u)));
+    }
+    else
+    {
+        APP_LOG_INFO("weights: %lu bytes in place at %p",
+               (unsigned long)baby_cry_model.weights_size, (void*)baby_cry_model.weights);
+    }
+}
+#endif /* PRINT_CM55 */
+
+/*******************************************************************************
+* Function Name: model_consumer_push
+********************************************************************************
+* Summary:
+*  Front end callback, hands one log-mel frame to a model instance and to its
+*  early exit stage.
+*
+* Parameters:
+*  arg:   the model instance (imai_ctx_t)
+*  frame: log-mel frame
+*
+* Return:
+*  IMAI_MODEL_RET_SUCCESS or IMAI_MODEL_RET_ERROR
+*
+*******************************************************************************/
+static int model_consumer_push(void* arg, const float* frame)
+{
+    if (NULL != cry_exit.params)
+    {
+        early_exit_push(&cry_exit, frame);
+    }
+    return imai_model_enqueue((imai_ctx_t*)arg, frame);
+}
+
+/*******************************************************************************
+* Function Name: cry_model_window
+********************************************************************************
+* Summary:
+*  Front end callback, copies a complete feature window of the baby cry model
+*  and classifies it. With an executor the classification runs in its task
+*  and the decision follows with audio_pipeline_collect(), otherwise it is
+*  handed to the result callback right away. A window the early exit stage
+*  rejects is decided at once without the model. A window still in flight is
+*  collected first, it owns the model scratch.
+*
+* Parameters:
+*  arg: the model instance (imai_ctx_t)
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void cry_model_window(void* arg)
+{
+    imai_ctx_t* ctx = (imai_ctx_t*)arg;
+    uint32_t start = cycle_counter_get();
+    int status;
+
+    (void)audio_pipeline_collect(true);
+
+    status = imai_model_prepare(ctx);
+    if (IMAI_MODEL_RET_NODATA == status)
+    {
+        /* No new output, continue with sampling */
+        return;
+    }
+    if (IMAI_MODEL_RET_SUCCESS != status)
+    {
+        /* Abort on error */
+        CY_ASSERT(0);
+        return;
+    }
+
+    /* The state of the front end when the window was complete */
+    job_result.model = ctx->def->name;
+    job_result.window = cry_consumer.windows;
+    job_result.frame = frontend->frames;
+    job_result.sample = LOGMEL_FFT_SIZE + (frontend->frames - 1u) * LOGMEL_HOP_SIZE;
+    job_result.gain_db = agc_gain_db(&input_agc);
+    job_start = start;
+    job_started = true;
+
+    job_result.early_exit = (NULL != cry_exit.params) && early_exit_window(&cry_exit);
+    if (job_result.early_exit)
+    {
+        float scores[AUDIO_PIPELINE_MAX_SCORES];
+
+        early_exit_scores(&cry_exit, scores, ctx->def->out_count);
+        for (int i = 0; i < ctx->def->out_count; i++)
+        {
+            job_result.scores_q[i] = score_q_quantize(&cry_score_q, scores[i]);
+        }
+        job_result.inference_cycles = 0;
+        job_result.model_runs = cry_model_runs;
+        job_status = IMAI_MODEL_RET_SUCCESS;
+        __atomic_store_n(&job_done, true, __ATOMIC_RELEASE);
+        (void)audio_pipeline_collect(false);
+        return;
+    }
+    __atomic_store_n(&job_done, false, __ATOMIC_RELAXED);
+
+    if (NULL != executor)
+    {
+        executor->start(executor->arg);
+    }
+    else
+    {
+        audio_pipeline_infer();
+        (void)audio_pipeline_collect(false);
+    }
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_infer
+********************************************************************************
+* Summary:
+*  Classifies the window copied by cry_model_window(). Called by the task of
+*  the executor; only touches the model scratch, the arena and the scores, so
+*  the front end may go on meanwhile. The scores stay quantized.
+*
+*******************************************************************************/
+void audio_pipeline_infer(void)
+{
+    uint32_t start = cycle_counter_get();
+    const int8_t* scores_q;
+
+    job_status = imai_model_run_q(&cry_model, &scores_q);
+    if (IMAI_MODEL_RET_SUCCESS == job_status)
+    {
+        memcpy(job_result.scores_q, scores_q, (size_t)cry_model.def->out_count);
+    }
+    job_result.inference_cycles = cycle_counter_get() - start;
+    job_result.model_runs = ++cry_model_runs;
+    __atomic_store_n(&job_done, true, __ATOMIC_RELEASE);
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_collect
+********************************************************************************
+* Summary:
+*  Decides on the scores of a classified window and hands the decision to the
+*  result callback. Called from the task that feeds the pipeline, e.g. when
+*  the executor signals the end of audio_pipeline_infer(). The argmax and the
+*  threshold work on the int8 scores, only the confidence is dequantized.
+*
+* Parameters:
+*  wait: block in the executor until a window in flight is classified
+*
+* Return:
+*  true if a decision was handed on
+*
+*******************************************************************************/
+bool audio_pipeline_collect(bool wait)
+{
+    const char* const* label_text = cry_model.def->labels;
+    int count = cry_model.def->out_count;
+    int16_t best_label;
+    bool detected;
+
+    if (!job_started)
+    {
+        return false;
+    }
+    while (!__atomic_load_n(&job_done, __ATOMIC_ACQUIRE))
+    {
+        if (!wait)
+        {
+            return false;
+        }
+        executor->wait(executor->arg);
+    }
+    job_started = false;
+
+    if (IMAI_MODEL_RET_SUCCESS != job_status)
+    {
+        /* Abort on error */
+        CY_ASSERT(0);
+        return false;
+    }
+
+    #ifdef PRINT_CM55
+    int top[PRINT_TOP_SCORES];
+    int top_count = score_q_top_k(job_result.scores_q, count, top, PRINT_TOP_SCORES);
+
+    for (int i = 0; i < top_count; i++)
+    {
+        APP_LOG_INFO("label: %-11s: score: %.4f", label_text[top[i]],
+                     score_q_value(&cry_score_q, job_result.scores_q[top[i]]));
+    }
+    #endif
+
+    best_label = (int16_t)score_q_argmax(job_result.scores_q, count);
+    detected = !job_result.early_exit && score_q_above(&cry_score_q, job_result.scores_q[best_label]);
+    if (!detected)
+    {
+        best_label = 0;
+    }
+    job_result.elapsed_cycles = cycle_counter_get() - job_start;
+    job_result.score_count = count;
+    job_result.score_q = cry_score_q;
+    job_result.label_id = best_label;
+    job_result.label = label_text[best_label];
+    job_result.confidence = score_q_value(&cry_score_q, job_result.scores_q[best_label]);
+
+    #ifdef PRINT_CM55
+    APP_LOG_INFO("Output: %-10s", detected ? label_text[best_label] : "");
+    #endif
+
+    if (NULL != result_callback)
+    {
+        result_callback(&job_result, result_arg);
+    }
+
+    #ifdef PRINT_CM55
+    logmel_print_stats(frontend, app_log_printf);
+    #endif
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_set_executor
+********************************************************************************
+* Summary:
+*  Has the model windows classified by an executor instead of inside
+*  audio_pipeline_process(). Only possible when built with
+*  AUDIO_ASYNC_INFERENCE, which keeps the model scratch apart from the front
+*  end scratch. A window in flight is collected first.
+*
+* Parameters:
+*  exec: the executor, must stay valid; NULL to classify in place again
+*
+* Return:
+*  CY_RSLT_SUCCESS or AUDIO_PIPELINE_MEM_ERROR
+*
+*******************************************************************************/
+cy_rslt_t audio_pipeline_set_executor(const audio_executor_t* exec)
+{
+    #if AUDIO_ASYNC_INFERENCE
+    (void)audio_pipeline_collect(true);
+    executor = exec;
+    return CY_RSLT_SUCCESS;
+    #else
+    return (NULL == exec) ? CY_RSLT_SUCCESS : AUDIO_PIPELINE_MEM_ERROR;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_process
+********************************************************************************
+* Summary:
+*  Normalizes a block of PCM samples, removes its DC offset, applies the AGC
+*  and feeds it to the log-mel front end, which runs the registered models when their feature
+*  windows are complete.
+*
+* Parameters:
+*  pcm:   16 bit PCM samples at LOGMEL_SAMPLE_RATE
+*  count: number of samples, any size
+*
+*******************************************************************************/
+void audio_pipeline_process(const int16_t* pcm, uint32_t count)
+{
+    float samples[LOGMEL_HOP_SIZE];
+    #if (AUDIO_DC_BLOCK != 0)
+    float power;
+    float peak;
+    #endif
+
+    /* Convert the block in chunks of one hop to keep the stack small */
+    for (uint32_t offset = 0; offset < count; offset += LOGMEL_HOP_SIZE)
+    {
+        uint32_t chunk = count - offset;
+        if (chunk > LOGMEL_HOP_SIZE)
+        {
+            chunk = LOGMEL_HOP_SIZE;
+        }
+        PROF_BEGIN(prof_start);
+        #if (AUDIO_DC_BLOCK == 2)
+        /* The filter pass also takes the statistics of the AGC */
+        dc_block_q15(&input_dc_block, &pcm[offset], (int)chunk, samples, &power, &peak);
+        agc_process_stats(&input_agc, samples, (int)chunk, power, peak);
+        #elif (AUDIO_DC_BLOCK == 1)
+        #if defined(COMPONENT_CM55)
+        arm_q15_to_float(&pcm[offset], samples, chunk);
+        #else
+        for (uint32_t index = 0; index < chunk; index++)
+        {
+            samples[index] = SAMPLE_NORMALIZE(pcm[offset + index]);
+        }
+        #endif
+        /* The statistics of the AGC in the order of dc_block_q15() */
+        dc_block_process_stats(&input_dc_block, samples, (int)chunk, &power, &peak);
+        agc_process_stats(&input_agc, samples, (int)chunk, power, peak);
+        #else
+        agc_process_q15(&input_agc, &pcm[offset], (int)chunk, samples);
+        #endif
+        PROF_END(prof_start, PROF_STAGE_PCM_CONVERT);
+
+        /* Pass the audio samples to the front end and the models */
+        logmel_process(frontend, samples, (int)chunk);
+    }
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_process_stereo
+********************************************************************************
+* Summary:
+*  Beamforms a block of interleaved two microphone PCM and processes the
+*  result like audio_pipeline_process(). Only available when the pipeline is
+*  built with AUDIO_CAPTURE_CHANNELS 2.
+*
+* Parameters:
+*  pcm:   interleaved 16 bit PCM at LOGMEL_SAMPLE_RATE, channel 0 first
+*  count: number of samples per channel, any size
+*
+*******************************************************************************/
+void audio_pipeline_process_stereo(const int16_t* pcm, uint32_t count)
+{
+    float samples[LOGMEL_HOP_SIZE];
+
+    CY_ASSERT(NULL != beamformer);
+
+    for (uint32_t offset = 0; offset < count; offset += LOGMEL_HOP_SIZE)
+    {
+        uint32_t chunk = count - offset;
+        if (chunk > LOGMEL_HOP_SIZE)
+        {
+            chunk = LOGMEL_HOP_SIZE;
+        }
+        beamform_process(beamformer, &pcm[BEAMFORM_CHANNELS * offset], (int)chunk, samples);
+
+        /* The beamformer keeps the PCM scale */
+        PROF_BEGIN(prof_start);
+        #if defined(COMPONENT_CM55)
+        arm_scale_f32(samples, SAMPLE_NORMALIZE(1), samples, chunk);
+        #else
+        for (uint32_t index = 0; index < chunk; index++)
+        {
+            samples[index] = SAMPLE_NORMALIZE(samples[index]);
+        }
+        #endif
+        #if (AUDIO_DC_BLOCK != 0)
+        dc_block_process(&input_dc_block, samples, (int)chunk);
+        #endif
+        agc_process(&input_agc, samples, (int)chunk);
+        PROF_END(prof_start, PROF_STAGE_PCM_CONVERT);
+
+        logmel_process(frontend, samples, (int)chunk);
+    }
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_print_stats
+********************************************************************************
+* Summary:
+*  Prints the AGC, the beamformer, front end and per model cost, and the
+*  windows that exited early.
+*
+* Parameters:
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void audio_pipeline_print_stats(logmel_print_fn print)
+{
+    agc_print_stats(&input_agc, print);
+    if (NULL != beamformer)
+    {
+        beamform_print_stats(beamformer, print);
+    }
+    logmel_print_stats(frontend, print);
+    if (NULL != cry_exit.params)
+    {
+        early_exit_print_stats(&cry_exit, print);
+    }
+}
+
+/*******************************************************************************
+* Function Name: audio_pipeline_limited_samples
+********************************************************************************
+* Summary:
+*  Samples the AGC soft limited since the start, for the audio health report.
+*
+* Return:
+*  Sample count
+*
+*******************************************************************************/
+uint32_t audio_pipeline_limited_samples(void)
+{
+    return input_agc.limited_samples;
+}
+
+/* [] END OF FILE */
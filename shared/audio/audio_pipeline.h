@@ -0,0 +1,143 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Portable part of the audio processing: PCM normalization, gain control, the
+ * log-mel front end, the model instances and the decision on their scores.
+ *
+ * Nothing in here touches the PDM, the IPC or the RTOS, so the same code runs
+ * on the CM55 (fed by audio.c) and on a host (fed by the tools in host/).
+ */
+
+#ifndef AUDIO_PIPELINE_H_
+#define AUDIO_PIPELINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "early_exit.h"
+#include "logmel.h"
+#include "mem_plan.h"
+#include "model_profile.h"
+#include "score_q.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Microphones captured: 1, or 2 for the beamformer of beamform.h */
+#ifndef AUDIO_CAPTURE_CHANNELS
+#define AUDIO_CAPTURE_CHANNELS                  (1)
+#endif
+
+/* Stationary noise suppression of denoise.h in the front end: 0 or 1 */
+#ifndef AUDIO_DENOISE
+#define AUDIO_DENOISE                           (0)
+#endif
+
+/* DC blocking high-pass of dc_block.h ahead of the AGC: 0 off, 1 as a pass
+ * of its own, 2 fused into the normalization of the PCM. With two
+ * microphones it always runs as a pass of its own after the beamformer. */
+#ifndef AUDIO_DC_BLOCK
+#define AUDIO_DC_BLOCK                          (2)
+#endif
+
+/* Inference of the model windows by an executor of another task, see
+ * audio_pipeline_set_executor(): 0 or 1. With 1 the model scratch gets its
+ * own memory instead of sharing it with the front end scratch. */
+#ifndef AUDIO_ASYNC_INFERENCE
+#define AUDIO_ASYNC_INFERENCE                   (0)
+#endif
+
+/* Early exit stage of early_exit.h ahead of the model with the parameters
+ * of Models/baby_cry_exit.h, set by audio.c: 0 or 1 */
+#ifndef AUDIO_EARLY_EXIT
+#define AUDIO_EARLY_EXIT                        (0)
+#endif
+
+/* Upper bound of the capture buffers placed in the audio memory region */
+#ifndef AUDIO_MEM_CAPTURE_RESERVE
+#define AUDIO_MEM_CAPTURE_RESERVE               (4096u * AUDIO_CAPTURE_CHANNELS)
+#endif
+
+/* Upper bound of the task stack placed in the audio memory region */
+#ifndef AUDIO_MEM_STACK_RESERVE
+#define AUDIO_MEM_STACK_RESERVE                 (8192u)
+#endif
+
+#define AUDIO_PIPELINE_MAX_SCORES               (8)
+
+/* Error type when the model instance fails to initialize. */
+#define AUDIO_PIPELINE_MODEL_ERROR              (-2L)
+
+/* Error type when the audio memory region cannot hold the memory plan. */
+#define AUDIO_PIPELINE_MEM_ERROR                (-3L)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Outcome of one model window */
+typedef struct
+{
+    const char*  model;
+    uint32_t     window;             /* Window index, from 0 */
+    uint32_t     frame;              /* Front end frames processed so far */
+    uint32_t     sample;             /* Samples processed up to the newest of the window */
+    uint32_t     inference_cycles;   /* Of the window, see cycle_counter.h for the unit */
+    uint32_t     elapsed_cycles;     /* From the complete window to the decision */
+    uint32_t     model_runs;         /* Windows the model classified so far */
+    bool         early_exit;         /* Rejected by the early exit stage, the model did not run */
+    int          score_count;
+    int8_t       scores_q[AUDIO_PIPELINE_MAX_SCORES];    /* Quantized, see audio_result_score() */
+    score_q_t    score_q;            /* Quantization of the scores */
+    int16_t      label_id;           /* Best label above the threshold, else 0 */
+    const char*  label;
+    float        confidence;         /* Score of label_id */
+    float        gain_db;            /* Input gain of the AGC */
+} audio_result_t;
+
+typedef void (*audio_result_fn)(const audio_result_t* result, void* arg);
+
+/* Runs the model windows outside of audio_pipeline_process(). start() has
+ * audio_pipeline_infer() called in another task and returns at once, wait()
+ * blocks until that call returned. Both are called from the task that feeds
+ * the pipeline, which then picks up the decision with
+ * audio_pipeline_collect(). */
+typedef struct
+{
+    void    (*start)(void* arg);
+    void    (*wait)(void* arg);
+    void*   arg;
+} audio_executor_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t audio_pipeline_init(uint32_t capture_size, void** capture,
+                              uint32_t task_stack_size, void** task_stack,
+                              audio_result_fn on_result, void* arg);
+void audio_pipeline_deinit(void);
+cy_rslt_t audio_pipeline_restart(uint16_t window_stride, audio_result_fn on_result, void* arg);
+int  audio_pipeline_add_consumer(logmel_consumer_t* consumer);
+void audio_pipeline_process(const int16_t* pcm, uint32_t count);
+void audio_pipeline_process_stereo(const int16_t* pcm, uint32_t count);
+void audio_pipeline_print_stats(logmel_print_fn print);
+uint32_t audio_pipeline_limited_samples(void);
+cy_rslt_t audio_pipeline_set_executor(const audio_executor_t* executor);
+void audio_pipeline_infer(void);
+bool audio_pipeline_collect(bool wait);
+const mem_plan_t* audio_pipeline_mem_plan(int index);
+const logmel_t* audio_pipeline_frontend(void);
+const model_profile_report_t* audio_pipeline_model_profile(void);
+cy_rslt_t audio_pipeline_set_early_exit(const early_exit_params_t* params);
+
+/*******************************************************************************
+* Inline Functions
+*******************************************************************************/
+/* Dequantized score of label i */
+static inline float audio_result_score(const audio_result_t* result, int i)
+{
+    return score_q_value(&result->score_q, result->scores_q[i]);
+}
+
+#endif /* AUDIO_PIPELINE_H_ */
@@ -0,0 +1,198 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "beamform.h"
+#include "cycle_counter.h"
+#include "prof.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Group delay of the FIR, the steering delays are applied around it */
+#define BEAMFORM_CENTER             ((BEAMFORM_TAPS - 1) / 2.0f)
+
+/* Largest delay per channel that keeps the sinc peak inside the FIR */
+#define BEAMFORM_MAX_DELAY          (BEAMFORM_CENTER - 1.0f)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: beamform_design
+********************************************************************************
+* Summary:
+*  Hamming windowed sinc delaying by BEAMFORM_CENTER + delay samples, unity
+*  gain at DC. The coefficients are stored time reversed as arm_fir_f32()
+*  expects them.
+*
+*******************************************************************************/
+static void beamform_design(float* coeffs, float delay)
+{
+    float sum = 0.0f;
+
+    for (int n = 0; n < BEAMFORM_TAPS; n++)
+    {
+        float x = (float)n - BEAMFORM_CENTER - delay;
+        float sinc = (fabsf(x) < 1e-6f) ? 1.0f : sinf((float)M_PI * x) / ((float)M_PI * x);
+        float window = 0.54f - 0.46f * cosf(2.0f * (float)M_PI * n / (BEAMFORM_TAPS - 1));
+
+        coeffs[BEAMFORM_TAPS - 1 - n] = sinc * window;
+        sum += sinc * window;
+    }
+    for (int n = 0; n < BEAMFORM_TAPS; n++)
+    {
+        coeffs[n] /= sum;
+    }
+}
+
+/* One channel FIR over a block, state holds BEAMFORM_TAPS - 1 past inputs */
+static void beamform_fir(beamform_t* bf, int channel, int count)
+{
+    #if defined(COMPONENT_CM55)
+    arm_fir_f32(&bf->fir[channel], bf->input[channel], bf->output[channel], (uint32_t)count);
+    #else
+    float* state = bf->state[channel];
+    const float* coeffs = bf->coeffs[channel];
+
+    memcpy(&state[BEAMFORM_TAPS - 1], bf->input[channel], (size_t)count * sizeof(float));
+    for (int n = 0; n < count; n++)
+    {
+        float acc = 0.0f;
+        for (int k = 0; k < BEAMFORM_TAPS; k++)
+        {
+            acc += coeffs[k] * state[n + k];
+        }
+        bf->output[channel][n] = acc;
+    }
+    memmove(state, &state[count], (BEAMFORM_TAPS - 1) * sizeof(float));
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: beamform_init
+********************************************************************************
+* Summary:
+*  Steers the beamformer. A source at angle_deg from broadside, positive
+*  towards the microphone of channel 0, reaches channel 1 later by
+*  spacing_m * sin(angle) / c; channel 0 is delayed by half of that and
+*  channel 1 advanced by the other half.
+*
+* Parameters:
+*  bf:            beamformer instance
+*  spacing_m:     distance of the two microphones in meters
+*  angle_deg:     look direction in degrees from broadside
+*  budget_cycles: allowed cycles per beamform_process() call, 0 for none
+*
+* Return:
+*  BEAMFORM_RET_SUCCESS or BEAMFORM_RET_ERROR if the steering delay does not
+*  fit the filters
+*
+*******************************************************************************/
+int beamform_init(beamform_t* bf, float spacing_m, float angle_deg, uint32_t budget_cycles)
+{
+    float delay = spacing_m * sinf(angle_deg * (float)M_PI / 180.0f) /
+                  BEAMFORM_SPEED_OF_SOUND * LOGMEL_SAMPLE_RATE;
+
+    memset(bf, 0, sizeof(*bf));
+    if (fabsf(delay) / 2.0f > BEAMFORM_MAX_DELAY)
+    {
+        return BEAMFORM_RET_ERROR;
+    }
+
+    bf->steer_delay = delay;
+    bf->budget_cycles = budget_cycles;
+    beamform_design(bf->coeffs[0], delay / 2.0f);
+    beamform_design(bf->coeffs[1], -delay / 2.0f);
+
+    #if defined(COMPONENT_CM55)
+    for (int channel = 0; channel < BEAMFORM_CHANNELS; channel++)
+    {
+        arm_fir_init_f32(&bf->fir[channel], BEAMFORM_TAPS, bf->coeffs[channel],
+                         bf->state[channel], BEAMFORM_BLOCK_MAX);
+    }
+    #endif
+
+    return BEAMFORM_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: beamform_process
+********************************************************************************
+* Summary:
+*  Beamforms one block of interleaved stereo PCM into mono samples of the same
+*  scale.
+*
+* Parameters:
+*  bf:    beamformer instance
+*  pcm:   interleaved 16 bit PCM, channel 0 first
+*  count: samples per channel, at most BEAMFORM_BLOCK_MAX
+*  out:   count mono samples
+*
+*******************************************************************************/
+void beamform_process(beamform_t* bf, const int16_t* pcm, int count, float* out)
+{
+    uint32_t start = cycle_counter_get();
+    PROF_BEGIN(prof_start);
+
+    for (int i = 0; i < count; i++)
+    {
+        bf->input[0][i] = (float)pcm[2 * i];
+        bf->input[1][i] = (float)pcm[2 * i + 1];
+    }
+    beamform_fir(bf, 0, count);
+    beamform_fir(bf, 1, count);
+
+    #if defined(COMPONENT_CM55)
+    arm_add_f32(bf->output[0], bf->output[1], out, (uint32_t)count);
+    arm_scale_f32(out, 0.5f, out, (uint32_t)count);
+    #else
+    for (int i = 0; i < count; i++)
+    {
+        out[i] = 0.5f * (bf->output[0][i] + bf->output[1][i]);
+    }
+    #endif
+
+    PROF_END(prof_start, PROF_STAGE_BEAMFORM);
+    bf->cycles_last = cycle_counter_get() - start;
+    bf->cycles_total += bf->cycles_last;
+    if (bf->cycles_last > bf->cycles_max)
+    {
+        bf->cycles_max = bf->cycles_last;
+    }
+    if ((0u != bf->budget_cycles) && (bf->cycles_last > bf->budget_cycles))
+    {
+        bf->overruns++;
+    }
+    bf->blocks++;
+}
+
+/*******************************************************************************
+* Function Name: beamform_print_stats
+********************************************************************************
+* Summary:
+*  Prints the steering and the cost of the beamformer.
+*
+* Parameters:
+*  bf:    beamformer instance
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void beamform_print_stats(const beamform_t* bf, beamform_print_fn print)
+{
+    print("beamform: delay %.2f samples, blocks %lu, cycles last %lu max %lu avg %lu, budget %lu, overruns %lu\r\n",
+          (double)bf->steer_delay, (unsigned long)bf->blocks, (unsigned long)bf->cycles_last,
+          (unsigned long)bf->cycles_max,
+          (unsigned long)(bf->blocks ? bf->cycles_total / bf->blocks : 0),
+          (unsigned long)bf->budget_cycles, (unsigned long)bf->overruns);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Two microphone delay-and-sum beamformer.
+ *
+ * Takes interleaved stereo PCM, delays each channel by half the steering
+ * delay with a windowed-sinc fractional delay FIR and averages the two, which
+ * adds the look direction coherently and uncorrelated noise incoherently.
+ * On the CM55 the filters run on the Helium kernels of CMSIS-DSP; host
+ * builds use plain C with the same arithmetic.
+ */
+
+#ifndef BEAMFORM_H_
+#define BEAMFORM_H_
+
+#include <stdint.h>
+#include "logmel.h"
+
+#if defined(COMPONENT_CM55)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BEAMFORM_CHANNELS           (2)
+
+/* Fractional delay FIR length, a multiple of 4 for the Helium kernels */
+#define BEAMFORM_TAPS               (16)
+
+/* Largest block of beamform_process(), in samples per channel */
+#define BEAMFORM_BLOCK_MAX          (LOGMEL_HOP_SIZE)
+
+/* Filter state, with the slack the Helium kernels read past the end */
+#define BEAMFORM_STATE_SIZE         (BEAMFORM_TAPS + BEAMFORM_BLOCK_MAX + 3)
+
+#define BEAMFORM_SPEED_OF_SOUND     (343.0f)
+
+#define BEAMFORM_RET_SUCCESS        (0)
+#define BEAMFORM_RET_ERROR          (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       coeffs[BEAMFORM_CHANNELS][BEAMFORM_TAPS];
+    float       state[BEAMFORM_CHANNELS][BEAMFORM_STATE_SIZE];
+    float       input[BEAMFORM_CHANNELS][BEAMFORM_BLOCK_MAX];
+    float       output[BEAMFORM_CHANNELS][BEAMFORM_BLOCK_MAX];
+    #if defined(COMPONENT_CM55)
+    arm_fir_instance_f32 fir[BEAMFORM_CHANNELS];
+    #endif
+    float       steer_delay;        /* Samples channel 1 lags channel 0 */
+    uint32_t    budget_cycles;      /* Allowed cycles per block, 0 = none */
+
+    /* Statistics, see cycle_counter.h for the unit */
+    uint32_t    blocks;
+    uint32_t    overruns;           /* Blocks above budget_cycles */
+    uint32_t    cycles_last;
+    uint32_t    cycles_max;
+    uint64_t    cycles_total;
+} beamform_t;
+
+/* printf compatible sink for beamform_print_stats() */
+typedef int (*beamform_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  beamform_init(beamform_t* bf, float spacing_m, float angle_deg, uint32_t budget_cycles);
+void beamform_process(beamform_t* bf, const int16_t* pcm, int count, float* out);
+void beamform_print_stats(const beamform_t* bf, beamform_print_fn print);
+
+#endif /* BEAMFORM_H_ */
@@ -0,0 +1,193 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "clip_capture.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: clip_capture_init
+********************************************************************************
+* Summary:
+*  Binds the ring and starts recording. The pre-roll is the part of the ring
+*  not needed for the post-roll.
+*
+* Parameters:
+*  cc:       clip capture instance
+*  ring:     capacity samples, in memory the reader of the clips can access
+*  capacity: ring size, see CLIP_RING_SAMPLES()
+*  postroll: samples recorded after a detection
+*
+* Return:
+*  CLIP_CAPTURE_RET_SUCCESS or CLIP_CAPTURE_RET_ERROR if the post-roll does
+*  not fit the ring
+*
+*******************************************************************************/
+int clip_capture_init(clip_capture_t* cc, int16_t* ring, uint32_t capacity, uint32_t postroll)
+{
+    memset(cc, 0, sizeof(*cc));
+    if ((NULL == ring) || (0u == capacity) || (postroll > capacity))
+    {
+        return CLIP_CAPTURE_RET_ERROR;
+    }
+    cc->ring = ring;
+    cc->capacity = capacity;
+    cc->postroll = postroll;
+    cc->state = CLIP_STATE_RECORDING;
+
+    return CLIP_CAPTURE_RET_SUCCESS;
+}
+
+/* Completes the clip that ends at the write index */
+static void clip_capture_freeze(clip_capture_t* cc)
+{
+    uint32_t length = (cc->valid < cc->capacity) ? cc->valid : cc->capacity;
+
+    cc->clip.ring = cc->ring;
+    cc->clip.capacity = cc->capacity;
+    cc->clip.start = (cc->write + cc->capacity - length) % cc->capacity;
+    cc->clip.length = length;
+    cc->clip.trigger = length - cc->postroll;
+    cc->clip.sequence = ++cc->clips;
+    cc->state = CLIP_STATE_FROZEN;
+}
+
+/*******************************************************************************
+* Function Name: clip_capture_write
+********************************************************************************
+* Summary:
+*  Records PCM while the ring is not frozen. Once the post-roll of an armed
+*  ring is complete the rest of the block is discarded and the clip frozen.
+*
+* Parameters:
+*  cc:     clip capture instance
+*  pcm:    first sample of the recorded channel
+*  count:  samples of the channel
+*  stride: distance of two samples of the channel, 2 for interleaved stereo
+*
+*******************************************************************************/
+void clip_capture_write(clip_capture_t* cc, const int16_t* pcm, uint32_t count, uint32_t stride)
+{
+    if ((CLIP_STATE_RECORDING != cc->state) && (CLIP_STATE_ARMED != cc->state))
+    {
+        return;
+    }
+    if ((CLIP_STATE_ARMED == cc->state) && (count > cc->remaining))
+    {
+        count = cc->remaining;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        cc->ring[cc->write] = pcm[i * stride];
+        cc->write = (cc->write + 1u < cc->capacity) ? cc->write + 1u : 0u;
+    }
+    cc->valid += count;
+
+    if (CLIP_STATE_ARMED == cc->state)
+    {
+        cc->remaining -= count;
+        if (0u == cc->remaining)
+        {
+            clip_capture_freeze(cc);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: clip_capture_trigger
+********************************************************************************
+* Summary:
+*  Marks a detection at the current write position. Detections during the
+*  post-roll belong to the armed clip, detections while a clip is frozen are
+*  dropped.
+*
+*******************************************************************************/
+void clip_capture_trigger(clip_capture_t* cc)
+{
+    switch (cc->state)
+    {
+        case CLIP_STATE_RECORDING:
+            cc->remaining = cc->postroll;
+            cc->state = CLIP_STATE_ARMED;
+            if (0u == cc->remaining)
+            {
+                clip_capture_freeze(cc);
+            }
+            break;
+        case CLIP_STATE_ARMED:
+            cc->merged++;
+            break;
+        default:
+            cc->dropped++;
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: clip_capture_take
+********************************************************************************
+* Summary:
+*  Hands out a frozen clip once. The ring stays frozen until
+*  clip_capture_release().
+*
+* Parameters:
+*  cc:   clip capture instance
+*  clip: receives the clip
+*
+* Return:
+*  true if a new clip was handed out
+*
+*******************************************************************************/
+bool clip_capture_take(clip_capture_t* cc, clip_t* clip)
+{
+    if (CLIP_STATE_FROZEN != cc->state)
+    {
+        return false;
+    }
+    *clip = cc->clip;
+    cc->state = CLIP_STATE_HANDED;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: clip_capture_release
+********************************************************************************
+* Summary:
+*  Resumes recording after the reader is done with the clip. The pre-roll of
+*  the next clip starts at the release.
+*
+*******************************************************************************/
+void clip_capture_release(clip_capture_t* cc)
+{
+    if (CLIP_STATE_HANDED == cc->state)
+    {
+        cc->valid = 0u;
+        cc->state = CLIP_STATE_RECORDING;
+    }
+}
+
+/*******************************************************************************
+* Function Name: clip_capture_print_stats
+********************************************************************************
+* Summary:
+*  Prints the ring size and how many detections got a clip.
+*
+* Parameters:
+*  cc:    clip capture instance
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void clip_capture_print_stats(const clip_capture_t* cc, clip_print_fn print)
+{
+    print("clips: ring %lu bytes, clips %lu, merged %lu, dropped %lu\r\n",
+          (unsigned long)(cc->capacity * sizeof(int16_t)), (unsigned long)cc->clips,
+          (unsigned long)cc->merged, (unsigned long)cc->dropped);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Audio clips around detections.
+ *
+ * Keeps the last pre-roll of 16 bit PCM in a ring. A detection arms the ring,
+ * which keeps recording for the post-roll and then freezes, so that the ring
+ * holds the clip from the pre-roll before to the post-roll after the
+ * detection. The frozen clip is read in place, from the other core through
+ * shared memory, and recording resumes once the reader releases it.
+ * Detections while a clip is frozen are counted and dropped.
+ */
+
+#ifndef CLIP_CAPTURE_H_
+#define CLIP_CAPTURE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef CLIP_PREROLL_MS
+#define CLIP_PREROLL_MS             (2000u)
+#endif
+#ifndef CLIP_POSTROLL_MS
+#define CLIP_POSTROLL_MS            (1000u)
+#endif
+
+/* Ring size of clip_capture_init() for a sample rate */
+#define CLIP_RING_SAMPLES(rate)     (((rate) / 1000u) * (CLIP_PREROLL_MS + CLIP_POSTROLL_MS))
+
+#define CLIP_CAPTURE_RET_SUCCESS    (0)
+#define CLIP_CAPTURE_RET_ERROR      (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    CLIP_STATE_RECORDING = 0,
+    CLIP_STATE_ARMED,               /* Recording the post-roll */
+    CLIP_STATE_FROZEN,              /* Complete, not handed out yet */
+    CLIP_STATE_HANDED               /* Read by clip_capture_take() until released */
+} clip_state_t;
+
+/* A frozen clip: length samples from index start of the ring, wrapping */
+typedef struct
+{
+    const int16_t*  ring;
+    uint32_t        capacity;
+    uint32_t        start;
+    uint32_t        length;
+    uint32_t        trigger;        /* Samples from the clip start to the detection */
+    uint32_t        sequence;       /* Clip number, from 1 */
+} clip_t;
+
+typedef struct
+{
+    int16_t*        ring;
+    uint32_t        capacity;
+    uint32_t        postroll;
+    uint32_t        write;          /* Next ring index */
+    uint32_t        valid;          /* Contiguous samples in the ring */
+    uint32_t        remaining;      /* Post-roll samples still to record */
+    clip_state_t    state;
+    clip_t          clip;
+
+    /* Statistics */
+    uint32_t        clips;
+    uint32_t        merged;         /* Detections during the post-roll */
+    uint32_t        dropped;        /* Detections while frozen */
+} clip_capture_t;
+
+/* printf compatible sink for clip_capture_print_stats() */
+typedef int (*clip_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  clip_capture_init(clip_capture_t* cc, int16_t* ring, uint32_t capacity, uint32_t postroll);
+void clip_capture_write(clip_capture_t* cc, const int16_t* pcm, uint32_t count, uint32_t stride);
+void clip_capture_trigger(clip_capture_t* cc);
+bool clip_capture_take(clip_capture_t* cc, clip_t* clip);
+void clip_capture_release(clip_capture_t* cc);
+void clip_capture_print_stats(const clip_capture_t* cc, clip_print_fn print);
+
+#endif /* CLIP_CAPTURE_H_ */
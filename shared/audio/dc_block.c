@@ -0,0 +1,208 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "dc_block.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: dc_block_init
+********************************************************************************
+* Summary:
+*  Sets the pole for the cutoff and clears the state. An instance is used
+*  either with dc_block_process() or with dc_block_q15(), the two keep their
+*  state apart on the CM55.
+*
+* Parameters:
+*  dc:          filter instance
+*  cutoff_hz:   -3 dB corner, above 0 and well below the Nyquist frequency
+*  sample_rate: samples per second
+*
+* Return:
+*  DC_BLOCK_RET_SUCCESS or DC_BLOCK_RET_ERROR
+*
+*******************************************************************************/
+int dc_block_init(dc_block_t* dc, float cutoff_hz, int sample_rate)
+{
+    memset(dc, 0, sizeof(*dc));
+    if ((sample_rate <= 0) || (cutoff_hz <= 0.0f) || (cutoff_hz >= (float)sample_rate / 8.0f))
+    {
+        return DC_BLOCK_RET_ERROR;
+    }
+    dc->r = expf(-2.0f * (float)M_PI * cutoff_hz / (float)sample_rate);
+    dc->g = 0.5f * (1.0f + dc->r);
+
+    #if defined(COMPONENT_CM55)
+    /* b0, b1, b2, a1, a2; CMSIS adds the feedback terms */
+    dc->coeffs[0] = dc->g;
+    dc->coeffs[1] = -dc->g;
+    dc->coeffs[2] = 0.0f;
+    dc->coeffs[3] = dc->r;
+    dc->coeffs[4] = 0.0f;
+    #if defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE)
+    arm_biquad_cascade_df1_mve_init_f32(&dc->biquad, 1u, dc->coeffs, &dc->coeffs_mod, dc->biquad_state);
+    #else
+    arm_biquad_cascade_df1_init_f32(&dc->biquad, 1u, dc->coeffs, dc->biquad_state);
+    #endif
+    #endif
+
+    return DC_BLOCK_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: dc_block_process
+********************************************************************************
+* Summary:
+*  Filters a block in place.
+*
+* Parameters:
+*  dc:      filter instance
+*  samples: samples, any scale
+*  count:   number of samples, any size
+*
+*******************************************************************************/
+void dc_block_process(dc_block_t* dc, float* samples, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    #if defined(COMPONENT_CM55)
+    arm_biquad_cascade_df1_f32(&dc->biquad, samples, samples, (uint32_t)count);
+    #else
+    const float r = dc->r;
+    const float g = dc->g;
+    float x1 = dc->x1;
+    float y1 = dc->y1;
+
+    for (int i = 0; i < count; i++)
+    {
+        float x = samples[i];
+        y1 = g * (x - x1) + r * y1;
+        x1 = x;
+        samples[i] = y1;
+    }
+    dc->x1 = x1;
+    dc->y1 = y1;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: dc_block_process_stats
+********************************************************************************
+* Summary:
+*  Filters a block in place like dc_block_process() and returns the
+*  statistics of the output the AGC needs. They are added up serially in
+*  sample order, as dc_block_q15() does, so both give the AGC the same power
+*  for the same samples.
+*
+* Parameters:
+*  dc:      filter instance
+*  samples: samples, any scale
+*  count:   number of samples, any size
+*  power:   receives the sum of squares of the output
+*  peak:    receives the largest magnitude of the output
+*
+*******************************************************************************/
+void dc_block_process_stats(dc_block_t* dc, float* samples, int count, float* power, float* peak)
+{
+    float sum = 0.0f;
+    float max = 0.0f;
+
+    #if defined(COMPONENT_CM55)
+    if (count > 0)
+    {
+        arm_biquad_cascade_df1_f32(&dc->biquad, samples, samples, (uint32_t)count);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        float magnitude = fabsf(samples[i]);
+        sum += samples[i] * samples[i];
+        max = (magnitude > max) ? magnitude : max;
+    }
+    #else
+    const float r = dc->r;
+    const float g = dc->g;
+    float x1 = dc->x1;
+    float y1 = dc->y1;
+
+    for (int i = 0; i < count; i++)
+    {
+        float x = samples[i];
+        float magnitude;
+
+        y1 = g * (x - x1) + r * y1;
+        x1 = x;
+        samples[i] = y1;
+        magnitude = fabsf(y1);
+        sum += y1 * y1;
+        max = (magnitude > max) ? magnitude : max;
+    }
+    dc->x1 = x1;
+    dc->y1 = y1;
+    #endif
+    *power = sum;
+    *peak = max;
+}
+
+/*******************************************************************************
+* Function Name: dc_block_q15
+********************************************************************************
+* Summary:
+*  Normalizes 16 bit PCM to [-1, 1] and filters it in the same pass, which
+*  also adds up the statistics of the output the AGC needs. The recursion is
+*  serial, but the loop takes the place of the statistics pass of the AGC, so
+*  the input stage keeps its two passes over the block.
+*
+* Parameters:
+*  dc:    filter instance
+*  pcm:   16 bit PCM samples
+*  count: number of samples, any size
+*  out:   count filtered, normalized samples
+*  power: receives the sum of squares of out
+*  peak:  receives the largest magnitude of out
+*
+*******************************************************************************/
+void dc_block_q15(dc_block_t* dc, const int16_t* pcm, int count, float* out, float* power, float* peak)
+{
+    const float r = dc->r;
+    const float g = dc->g / 32768.0f;
+    float x1 = dc->x1;
+    float y1 = dc->y1;
+    float sum = 0.0f;
+    float max = 0.0f;
+
+    /* The previous input is kept at PCM scale, g normalizes */
+    for (int i = 0; i < count; i++)
+    {
+        float x = (float)pcm[i];
+        float magnitude;
+
+        y1 = g * (x - x1) + r * y1;
+        x1 = x;
+        out[i] = y1;
+        magnitude = fabsf(y1);
+        sum += y1 * y1;
+        max = (magnitude > max) ? magnitude : max;
+    }
+    dc->x1 = x1;
+    dc->y1 = y1;
+    *power = sum;
+    *peak = max;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* DC blocking high-pass filter of the capture path.
+ *
+ * First order, y[n] = g * (x[n] - x[n-1]) + r * y[n-1] with the pole r set
+ * by the cutoff and g = (1 + r) / 2 for unity gain at Nyquist. The state is
+ * carried from block to block.
+ *
+ * dc_block_process() filters normalized samples in place; on the CM55 it
+ * runs the Helium biquad kernel of CMSIS-DSP, which computes several outputs
+ * of the recursion per vector. dc_block_q15() fuses the filter into the
+ * normalization of the PCM and returns the sum of squares and the peak of
+ * the output, so that the AGC needs no pass of its own over the block.
+ * dc_block_process_stats() returns the same statistics, added up in the
+ * same order, after the filter pass.
+ */
+
+#ifndef DC_BLOCK_H_
+#define DC_BLOCK_H_
+
+#include <stdint.h>
+
+#if defined(COMPONENT_CM55)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* -3 dB corner. The lowest mel band of the front end starts near 280 Hz. */
+#ifndef DC_BLOCK_CUTOFF_HZ
+#define DC_BLOCK_CUTOFF_HZ          (20.0f)
+#endif
+
+#define DC_BLOCK_RET_SUCCESS        (0)
+#define DC_BLOCK_RET_ERROR          (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       r;                  /* Pole */
+    float       g;                  /* Gain of the difference */
+    float       x1;                 /* Previous input */
+    float       y1;                 /* Previous output */
+
+    #if defined(COMPONENT_CM55)
+    arm_biquad_casd_df1_inst_f32 biquad;
+    float32_t   coeffs[5];
+    float32_t   biquad_state[4];
+    #if defined(ARM_MATH_MVEF) && !defined(ARM_MATH_AUTOVECTORIZE)
+    arm_biquad_mod_coef_f32 coeffs_mod;
+    #endif
+    #endif
+} dc_block_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  dc_block_init(dc_block_t* dc, float cutoff_hz, int sample_rate);
+void dc_block_process(dc_block_t* dc, float* samples, int count);
+void dc_block_process_stats(dc_block_t* dc, float* samples, int count, float* power, float* peak);
+void dc_block_q15(dc_block_t* dc, const int16_t* pcm, int count, float* out, float* power, float* peak);
+
+#endif /* DC_BLOCK_H_ */
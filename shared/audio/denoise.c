@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "denoise.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: denoise_default_config
+********************************************************************************
+* Summary:
+*  Fills in the DENOISE_* defaults of denoise.h.
+*
+*******************************************************************************/
+void denoise_default_config(denoise_config_t* config)
+{
+    config->rise_db_per_s = DENOISE_RISE_DB_PER_S;
+    config->fall = DENOISE_FALL;
+    config->oversubtract = DENOISE_OVERSUBTRACT;
+    config->floor = DENOISE_FLOOR;
+}
+
+/*******************************************************************************
+* Function Name: denoise_init
+********************************************************************************
+* Summary:
+*  Converts the configuration to per frame factors and clears the estimate,
+*  which is seeded by the first frame.
+*
+* Parameters:
+*  dn:     noise suppression instance
+*  config: see denoise_default_config()
+*
+* Return:
+*  DENOISE_RET_SUCCESS or DENOISE_RET_ERROR for an invalid configuration
+*
+*******************************************************************************/
+int denoise_init(denoise_t* dn, const denoise_config_t* config)
+{
+    const float hop_s = (float)LOGMEL_HOP_SIZE / (float)LOGMEL_SAMPLE_RATE;
+
+    memset(dn, 0, sizeof(*dn));
+    if ((config->rise_db_per_s <= 0.0f) || (config->fall <= 0.0f) || (config->fall > 1.0f) ||
+        (config->oversubtract < 0.0f) || (config->floor < 0.0f) || (config->floor > 1.0f))
+    {
+        return DENOISE_RET_ERROR;
+    }
+
+    dn->rise = powf(10.0f, config->rise_db_per_s * hop_s / 20.0f);
+    dn->fall = config->fall;
+    dn->oversubtract = config->oversubtract;
+    dn->floor = config->floor;
+
+    return DENOISE_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: denoise_process
+********************************************************************************
+* Summary:
+*  Updates the noise floor with one magnitude spectrum and subtracts it in
+*  place: max(|X| - oversubtract * N, floor * |X|). The estimate is kept
+*  at DENOISE_ESTIMATE_MIN or above.
+*
+* Parameters:
+*  dn:        noise suppression instance
+*  magnitude: LOGMEL_BINS magnitudes of one frame, modified in place
+*
+*******************************************************************************/
+void denoise_process(denoise_t* dn, float* restrict magnitude)
+{
+    float* restrict estimate = dn->estimate;
+    const float rise = dn->rise;
+    const float fall = dn->fall;
+    const float oversubtract = dn->oversubtract;
+    const float spectral_floor = dn->floor;
+
+    if (0u == dn->frames)
+    {
+        memcpy(estimate, magnitude, sizeof(dn->estimate));
+    }
+
+    for (int i = 0; i < LOGMEL_BINS; i++)
+    {
+        float value = magnitude[i];
+        float noise = estimate[i];
+        float down = noise + fall * (value - noise);
+        float up = noise * rise;
+        noise = (value < noise) ? down : up;
+        noise = (noise > DENOISE_ESTIMATE_MIN) ? noise : DENOISE_ESTIMATE_MIN;
+        estimate[i] = noise;
+
+        float clean = value - oversubtract * noise;
+        float least = spectral_floor * value;
+        magnitude[i] = (clean > least) ? clean : least;
+    }
+    dn->frames++;
+}
+
+/* [] END OF FILE */
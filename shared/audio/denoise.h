@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Stationary noise suppression of the log-mel front end.
+ *
+ * Tracks the noise floor of every FFT bin by minimum statistics: the estimate
+ * follows the magnitude down quickly and rises slowly while the magnitude is
+ * above it, so it settles near the minima of the spectrum, which steady
+ * noise (HVAC, fans, white noise machines) sets and short events do not.
+ * The scaled estimate is subtracted from the magnitude spectrum between
+ * norm_f32() and mel_f32(), down to a spectral floor. The only state is the
+ * LOGMEL_BINS estimate; the kernel is branch free so it vectorizes.
+ */
+
+#ifndef DENOISE_H_
+#define DENOISE_H_
+
+#include <stdint.h>
+#include "logmel.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Defaults of denoise_config_t */
+#ifndef DENOISE_RISE_DB_PER_S
+#define DENOISE_RISE_DB_PER_S       (3.0f)      /* Rise of the estimate */
+#endif
+#ifndef DENOISE_FALL
+#define DENOISE_FALL                (0.03f)     /* Fraction of a drop followed per frame */
+#endif
+#ifndef DENOISE_OVERSUBTRACT
+#define DENOISE_OVERSUBTRACT        (3.0f)      /* Estimate to noise magnitude, see DEVELOPER_GUIDE.md */
+#endif
+#ifndef DENOISE_FLOOR
+#define DENOISE_FLOOR               (0.1f)      /* Least fraction of the magnitude kept */
+#endif
+
+/* Least noise estimate, 40 dB below the lower clip of the mel energies. The
+ * estimate only rises by a factor, so it would stay at 0 after silence. */
+#define DENOISE_ESTIMATE_MIN        (1e-5f)
+
+#define DENOISE_RET_SUCCESS         (0)
+#define DENOISE_RET_ERROR           (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       rise_db_per_s;
+    float       fall;
+    float       oversubtract;
+    float       floor;
+} denoise_config_t;
+
+typedef struct denoise
+{
+    float       estimate[LOGMEL_BINS];  /* Noise floor magnitude per bin */
+    float       rise;                   /* Factor per frame */
+    float       fall;
+    float       oversubtract;
+    float       floor;
+    uint32_t    frames;
+} denoise_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void denoise_default_config(denoise_config_t* config);
+int  denoise_init(denoise_t* dn, const denoise_config_t* config);
+void denoise_process(denoise_t* dn, float* magnitude);
+
+#endif /* DENOISE_H_ */
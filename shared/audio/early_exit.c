@@ -0,0 +1,230 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "early_exit.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/* Spread and peak of count energies */
+static void energy_stats(const float* energy, uint32_t count, float* std, float* max)
+{
+    float mean = 0.0f;
+    float var = 0.0f;
+
+    *max = energy[0];
+    for (uint32_t i = 0; i < count; i++)
+    {
+        mean += energy[i];
+        *max = (energy[i] > *max) ? energy[i] : *max;
+    }
+    mean /= (float)count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        var += (energy[i] - mean) * (energy[i] - mean);
+    }
+    *std = sqrtf(var / (float)count);
+}
+
+/*******************************************************************************
+* Function Name: early_exit_init
+********************************************************************************
+* Summary:
+*  Binds the parameters and empties the frame rings.
+*
+* Parameters:
+*  ee:            stage
+*  params:        weights and threshold, must stay valid
+*  window_frames: frames of the model window, 1 .. EARLY_EXIT_MAX_FRAMES
+*
+* Return:
+*  EARLY_EXIT_RET_SUCCESS or EARLY_EXIT_RET_ERROR
+*
+*******************************************************************************/
+int early_exit_init(early_exit_t* ee, const early_exit_params_t* params, uint32_t window_frames)
+{
+    memset(ee, 0, sizeof(*ee));
+    if ((NULL == params) || (0u == window_frames) || (window_frames > EARLY_EXIT_MAX_FRAMES))
+    {
+        return EARLY_EXIT_RET_ERROR;
+    }
+    ee->params = params;
+    ee->window_frames = window_frames;
+    return EARLY_EXIT_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: early_exit_push
+********************************************************************************
+* Summary:
+*  Takes up one log-mel frame, the same frames as the model in the same order.
+*
+* Parameters:
+*  ee:    stage
+*  frame: LOGMEL_BANDS values
+*
+*******************************************************************************/
+void early_exit_push(early_exit_t* ee, const float* frame)
+{
+    const float* weights = ee->params->weights;
+    float score = 0.0f;
+    float energy = 0.0f;
+
+    for (int i = 0; i < LOGMEL_BANDS; i++)
+    {
+        score += weights[i] * frame[i];
+        energy += frame[i];
+    }
+    ee->score[ee->head] = score;
+    ee->energy[ee->head] = energy / (float)LOGMEL_BANDS;
+    ee->head = (ee->head + 1u < ee->window_frames) ? (ee->head + 1u) : 0u;
+    if (ee->count < ee->window_frames)
+    {
+        ee->count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: early_exit_window
+********************************************************************************
+* Summary:
+*  Decides on the window of the last window_frames frames. Until the window
+*  is full nothing exits.
+*
+* Parameters:
+*  ee: stage
+*
+* Return:
+*  true if the window is background and the model need not run
+*
+*******************************************************************************/
+bool early_exit_window(early_exit_t* ee)
+{
+    const early_exit_params_t* params = ee->params;
+    float score = 0.0f;
+    float std, max;
+    bool exit;
+
+    ee->windows++;
+    if (ee->count < ee->window_frames)
+    {
+        ee->logit = INFINITY;
+        return false;
+    }
+    for (uint32_t i = 0; i < ee->count; i++)
+    {
+        score += ee->score[i];
+    }
+    energy_stats(ee->energy, ee->count, &std, &max);
+    ee->logit = params->bias + score / (float)ee->count +
+                params->weights[EARLY_EXIT_FEATURE_STD] * std + params->weights[EARLY_EXIT_FEATURE_MAX] * max;
+
+    exit = (ee->logit < params->threshold);
+    if (exit)
+    {
+        ee->exits++;
+    }
+    return exit;
+}
+
+/*******************************************************************************
+* Function Name: early_exit_scores
+********************************************************************************
+* Summary:
+*  Scores of a window that exited in place of those of the model: the
+*  probability of the logistic model that the window is not background,
+*  shared by the labels after the first.
+*
+* Parameters:
+*  ee:     stage
+*  scores: count scores, the first one of the background label
+*  count:  labels of the model
+*
+*******************************************************************************/
+void early_exit_scores(const early_exit_t* ee, float* scores, int count)
+{
+    float p = 1.0f / (1.0f + expf(-ee->logit));
+
+    scores[0] = 1.0f - p;
+    for (int i = 1; i < count; i++)
+    {
+        scores[i] = p / (float)(count - 1);
+    }
+}
+
+/*******************************************************************************
+* Function Name: early_exit_print_stats
+********************************************************************************
+* Summary:
+*  Prints the windows that exited.
+*
+*******************************************************************************/
+void early_exit_print_stats(const early_exit_t* ee, early_exit_print_fn print)
+{
+    print("early exit: %lu of %lu windows (%lu%%), target recall %.3f\n", (unsigned long)ee->exits,
+          (unsigned long)ee->windows,
+          (unsigned long)((0u != ee->windows) ? (100u * ee->exits + ee->windows / 2u) / ee->windows : 0u),
+          (double)ee->params->recall);
+}
+
+/*******************************************************************************
+* Function Name: early_exit_features
+********************************************************************************
+* Summary:
+*  Features of a whole window, the reference of early_exit_window() for the
+*  calibration.
+*
+* Parameters:
+*  window:   frames * LOGMEL_BANDS values, oldest frame first
+*  frames:   1 .. EARLY_EXIT_MAX_FRAMES
+*  features: EARLY_EXIT_FEATURES values
+*
+*******************************************************************************/
+void early_exit_features(const float* window, uint32_t frames, float* features)
+{
+    float energy[EARLY_EXIT_MAX_FRAMES];
+
+    memset(features, 0, EARLY_EXIT_FEATURES * sizeof(float));
+    for (uint32_t t = 0; t < frames; t++)
+    {
+        const float* frame = &window[t * LOGMEL_BANDS];
+
+        energy[t] = 0.0f;
+        for (int i = 0; i < LOGMEL_BANDS; i++)
+        {
+            features[i] += frame[i];
+            energy[t] += frame[i];
+        }
+        energy[t] /= (float)LOGMEL_BANDS;
+    }
+    for (int i = 0; i < LOGMEL_BANDS; i++)
+    {
+        features[i] /= (float)frames;
+    }
+    energy_stats(energy, frames, &features[EARLY_EXIT_FEATURE_STD], &features[EARLY_EXIT_FEATURE_MAX]);
+}
+
+/*******************************************************************************
+* Function Name: early_exit_logit
+********************************************************************************
+* Summary:
+*  Logit of the logistic model for the features of a window.
+*
+*******************************************************************************/
+float early_exit_logit(const early_exit_params_t* params, const float* features)
+{
+    float logit = params->bias;
+
+    for (int i = 0; i < EARLY_EXIT_FEATURES; i++)
+    {
+        logit += params->weights[i] * features[i];
+    }
+    return logit;
+}
+
+/* [] END OF FILE */
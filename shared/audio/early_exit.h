@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Early exit stage ahead of the model: a logistic model on the log-mel window
+ * that rejects background windows before they reach the NPU.
+ *
+ * The features of a window are the mean of every mel band over the window,
+ * and the standard deviation and the maximum of the frame energy, the mean
+ * of the bands of a frame. The band weights are the same for every frame, so
+ * early_exit_push() reduces each frame to its weighted sum and its energy
+ * and the stage only keeps two floats per frame of the window. A window with
+ * a logit below the threshold exits: it is background and the model is not
+ * run. Ambiguous windows go on to the model.
+ *
+ * The weights and the threshold come from host/early_exit_calib, which fits
+ * the model on a labeled corpus and sets the threshold for a target recall
+ * of the positive windows. It writes Models/baby_cry_exit.h.
+ */
+
+#ifndef EARLY_EXIT_H_
+#define EARLY_EXIT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "logmel.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest window in frames */
+#define EARLY_EXIT_MAX_FRAMES       (64u)
+
+/* Features: the band means, then the spread and the peak of the energy */
+#define EARLY_EXIT_FEATURE_STD      (LOGMEL_BANDS)
+#define EARLY_EXIT_FEATURE_MAX      (LOGMEL_BANDS + 1)
+#define EARLY_EXIT_FEATURES         (LOGMEL_BANDS + 2)
+
+#define EARLY_EXIT_RET_SUCCESS      (0)
+#define EARLY_EXIT_RET_ERROR        (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       weights[EARLY_EXIT_FEATURES];
+    float       bias;
+    float       threshold;          /* Logit below which a window exits */
+    float       recall;             /* Target of the calibration, 0 if none */
+} early_exit_params_t;
+
+typedef struct
+{
+    const early_exit_params_t* params;
+    uint32_t    window_frames;
+    uint32_t    head;               /* Next slot of the frame rings */
+    uint32_t    count;              /* Frames in the rings */
+    float       score[EARLY_EXIT_MAX_FRAMES];   /* Band weights times the frame */
+    float       energy[EARLY_EXIT_MAX_FRAMES];  /* Mean of the bands */
+    float       logit;              /* Of the last window */
+    uint32_t    windows;
+    uint32_t    exits;
+} early_exit_t;
+
+typedef int (*early_exit_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int   early_exit_init(early_exit_t* ee, const early_exit_params_t* params, uint32_t window_frames);
+void  early_exit_push(early_exit_t* ee, const float* frame);
+bool  early_exit_window(early_exit_t* ee);
+void  early_exit_scores(const early_exit_t* ee, float* scores, int count);
+void  early_exit_print_stats(const early_exit_t* ee, early_exit_print_fn print);
+
+/* Reference of the calibration: the features of a window of frames * bands
+ * floats and their logit */
+void  early_exit_features(const float* window, uint32_t frames, float* features);
+float early_exit_logit(const early_exit_params_t* params, const float* features);
+
+#endif /* EARLY_EXIT_H_ */
@@ -0,0 +1,545 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "cycle_counter.h"
+#include "prof.h"
+#include "rdft.h"
+#include "denoise.h"
+#include "logmel.h"
+#include "ml_placement.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifdef LOGMEL_ENABLE_TAP
+#define LOGMEL_TAP(stage, data, count)  logmel_tap((stage), (data), (count))
+#else
+#define LOGMEL_TAP(stage, data, count)
+#endif
+
+/* Lower clip of the mel energies (-70 dB) before the log */
+#define LOGMEL_CLIP_MIN             (0.000316227766016)
+#define LOGMEL_CLIP_MAX             (3.40282347E+38)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if (LOGMEL_FFT_SIZE == 512)
+/* Symmetric Hann window, 0.5 - 0.5 * cos(2 * pi * i / (N - 1)), float bit
+ * patterns as exported by DEEPCRAFT Studio */
+ML_TCM_DATA static const uint32_t hann_window[LOGMEL_FFT_SIZE] = {
+    0x00000000, 0x381e87c4, 0x391e863b, 0x39b25423, 0x3a1e8019, 0x3a77a0f6, 0x3ab2449b, 0x3af29a52, 
+    0x3b1e6790, 0x3b487014, 0x3b776514, 0x3b95a260, 0x3bb2068a, 0x3bd0ddef, 0x3bf2275e, 0x3c0af0c6, 
+    0x3c1e058c, 0x3c325144, 0x3c47d325, 0x3c5e8a59, 0x3c767600, 0x3c87ca96, 0x3c94f373, 0x3ca2b513, 
+    0x3cb10eef, 0x3cc00079, 0x3ccf891c, 0x3cdfa83e, 0x3cf05d41, 0x3d00d3bf, 0x3d09c324, 0x3d12fc79, 
+    0x3d1c7f61, 0x3d264b7e, 0x3d306070, 0x3d3abdd2, 0x3d45633d, 0x3d505049, 0x3d5b8488, 0x3d66ff8d, 
+    0x3d72c0e4, 0x3d7ec81a, 0x3d858a5c, 0x3d8bd322, 0x3d923e20, 0x3d98cb17, 0x3d9f79c6, 0x3da649eb, 
+    0x3dad3b42, 0x3db44d87, 0x3dbb8073, 0x3dc2d3c0, 0x3dca4724, 0x3dd1da56, 0x3dd98d0a, 0x3de15ef5, 
+    0x3de94fc9, 0x3df15f37, 0x3df98cef, 0x3e00ec51, 0x3e0520fd, 0x3e096453, 0x3e0db62a, 0x3e121654, 
+    0x3e1684a9, 0x3e1b00fb, 0x3e1f8b1e, 0x3e2422e6, 0x3e28c824, 0x3e2d7aab, 0x3e323a4b, 0x3e3706d7, 
+    0x3e3be01f, 0x3e40c5f2, 0x3e45b820, 0x3e4ab678, 0x3e4fc0c8, 0x3e54d6df, 0x3e59f88a, 0x3e5f2596, 
+    0x3e645dd0, 0x3e69a105, 0x3e6eeeff, 0x3e74478b, 0x3e79aa74, 0x3e7f1784, 0x3e824743, 0x3e8507a1, 
+    0x3e87ccc2, 0x3e8a968a, 0x3e8d64dd, 0x3e9037a0, 0x3e930eb6, 0x3e95ea04, 0x3e98c96d, 0x3e9bacd4, 
+    0x3e9e941e, 0x3ea17f2c, 0x3ea46de3, 0x3ea76026, 0x3eaa55d6, 0x3ead4ed8, 0x3eb04b0c, 0x3eb34a56, 
+    0x3eb64c99, 0x3eb951b5, 0x3ebc598e, 0x3ebf6406, 0x3ec270fd, 0x3ec58056, 0x3ec891f3, 0x3ecba5b5, 
+    0x3ecebb7e, 0x3ed1d32f, 0x3ed4ecaa, 0x3ed807cf, 0x3edb2480, 0x3ede429f, 0x3ee1620c, 0x3ee482a8, 
+    0x3ee7a455, 0x3eeac6f2, 0x3eedea63, 0x3ef10e86, 0x3ef4333d, 0x3ef7586a, 0x3efa7dec, 0x3efda3a4, 
+    0x3f0064ba, 0x3f01f79e, 0x3f038a6f, 0x3f051d1d, 0x3f06af97, 0x3f0841d0, 0x3f09d3b7, 0x3f0b653c, 
+    0x3f0cf651, 0x3f0e86e5, 0x3f1016e9, 0x3f11a64e, 0x3f133504, 0x3f14c2fc, 0x3f165025, 0x3f17dc72, 
+    0x3f1967d3, 0x3f1af237, 0x3f1c7b91, 0x3f1e03d0, 0x3f1f8ae6, 0x3f2110c4, 0x3f22955a, 0x3f241899, 
+    0x3f259a73, 0x3f271ad8, 0x3f2899b9, 0x3f2a1709, 0x3f2b92b7, 0x3f2d0cb6, 0x3f2e84f6, 0x3f2ffb69, 
+    0x3f317001, 0x3f32e2af, 0x3f345365, 0x3f35c214, 0x3f372eaf, 0x3f389927, 0x3f3a016e, 0x3f3b6776, 
+    0x3f3ccb32, 0x3f3e2c94, 0x3f3f8b8d, 0x3f40e811, 0x3f424212, 0x3f439982, 0x3f44ee55, 0x3f46407c, 
+    0x3f478fec, 0x3f48dc96, 0x3f4a266f, 0x3f4b6d69, 0x3f4cb177, 0x3f4df28e, 0x3f4f30a0, 0x3f506ba2, 
+    0x3f51a386, 0x3f52d842, 0x3f5409c9, 0x3f553810, 0x3f56630a, 0x3f578aac, 0x3f58aeeb, 0x3f59cfbb, 
+    0x3f5aed11, 0x3f5c06e2, 0x3f5d1d24, 0x3f5e2fcb, 0x3f5f3ecc, 0x3f604a1e, 0x3f6151b6, 0x3f62558a, 
+    0x3f63558f, 0x3f6451bc, 0x3f654a07, 0x3f663e67, 0x3f672ed2, 0x3f681b3e, 0x3f6903a2, 0x3f69e7f7, 
+    0x3f6ac831, 0x3f6ba44a, 0x3f6c7c39, 0x3f6d4ff4, 0x3f6e1f74, 0x3f6eeab2, 0x3f6fb1a4, 0x3f707443, 
+    0x3f713289, 0x3f71ec6c, 0x3f72a1e7, 0x3f7352f3, 0x3f73ff87, 0x3f74a79e, 0x3f754b32, 0x3f75ea3b, 
+    0x3f7684b4, 0x3f771a97, 0x3f77abdd, 0x3f783882, 0x3f78c080, 0x3f7943d1, 0x3f79c270, 0x3f7a3c5a, 
+    0x3f7ab188, 0x3f7b21f6, 0x3f7b8da1, 0x3f7bf483, 0x3f7c5699, 0x3f7cb3df, 0x3f7d0c52, 0x3f7d5fee, 
+    0x3f7daeaf, 0x3f7df893, 0x3f7e3d97, 0x3f7e7db8, 0x3f7eb8f4, 0x3f7eef48, 0x3f7f20b3, 0x3f7f4d32, 
+    0x3f7f74c3, 0x3f7f9766, 0x3f7fb519, 0x3f7fcdda, 0x3f7fe1a9, 0x3f7ff085, 0x3f7ffa6d, 0x3f7fff61, 
+    0x3f7fff61, 0x3f7ffa6d, 0x3f7ff085, 0x3f7fe1a9, 0x3f7fcdda, 0x3f7fb519, 0x3f7f9766, 0x3f7f74c3, 
+    0x3f7f4d32, 0x3f7f20b3, 0x3f7eef48, 0x3f7eb8f4, 0x3f7e7db8, 0x3f7e3d97, 0x3f7df893, 0x3f7daeaf, 
+    0x3f7d5fee, 0x3f7d0c52, 0x3f7cb3df, 0x3f7c5699, 0x3f7bf483, 0x3f7b8da1, 0x3f7b21f6, 0x3f7ab188, 
+    0x3f7a3c5a, 0x3f79c270, 0x3f7943d1, 0x3f78c080, 0x3f783882, 0x3f77abdd, 0x3f771a97, 0x3f7684b4, 
+    0x3f75ea3b, 0x3f754b32, 0x3f74a79e, 0x3f73ff87, 0x3f7352f3, 0x3f72a1e7, 0x3f71ec6c, 0x3f713289, 
+    0x3f707443, 0x3f6fb1a4, 0x3f6eeab2, 0x3f6e1f74, 0x3f6d4ff4, 0x3f6c7c39, 0x3f6ba44a, 0x3f6ac831, 
+    0x3f69e7f7, 0x3f6903a2, 0x3f681b3e, 0x3f672ed2, 0x3f663e67, 0x3f654a07, 0x3f6451bc, 0x3f63558f, 
+    0x3f62558a, 0x3f6151b6, 0x3f604a1e, 0x3f5f3ecc, 0x3f5e2fcb, 0x3f5d1d24, 0x3f5c06e2, 0x3f5aed11, 
+    0x3f59cfbb, 0x3f58aeeb, 0x3f578aac, 0x3f56630a, 0x3f553810, 0x3f5409c9, 0x3f52d842, 0x3f51a386, 
+    0x3f506ba2, 0x3f4f30a0, 0x3f4df28e, 0x3f4cb177, 0x3f4b6d69, 0x3f4a266f, 0x3f48dc96, 0x3f478fec, 
+    0x3f46407c, 0x3f44ee55, 0x3f439982, 0x3f424212, 0x3f40e811, 0x3f3f8b8d, 0x3f3e2c94, 0x3f3ccb32, 
+    0x3f3b6776, 0x3f3a016e, 0x3f389927, 0x3f372eaf, 0x3f35c214, 0x3f345365, 0x3f32e2af, 0x3f317001, 
+    0x3f2ffb69, 0x3f2e84f6, 0x3f2d0cb6, 0x3f2b92b7, 0x3f2a1709, 0x3f2899b9, 0x3f271ad8, 0x3f259a73, 
+    0x3f241899, 0x3f22955a, 0x3f2110c4, 0x3f1f8ae6, 0x3f1e03d0, 0x3f1c7b91, 0x3f1af237, 0x3f1967d3, 
+    0x3f17dc72, 0x3f165025, 0x3f14c2fc, 0x3f133504, 0x3f11a64e, 0x3f1016e9, 0x3f0e86e5, 0x3f0cf651, 
+    0x3f0b653c, 0x3f09d3b7, 0x3f0841d0, 0x3f06af97, 0x3f051d1d, 0x3f038a6f, 0x3f01f79e, 0x3f0064ba, 
+    0x3efda3a4, 0x3efa7dec, 0x3ef7586a, 0x3ef4333d, 0x3ef10e86, 0x3eedea63, 0x3eeac6f2, 0x3ee7a455, 
+    0x3ee482a8, 0x3ee1620c, 0x3ede429f, 0x3edb2480, 0x3ed807cf, 0x3ed4ecaa, 0x3ed1d32f, 0x3ecebb7e, 
+    0x3ecba5b5, 0x3ec891f3, 0x3ec58056, 0x3ec270fd, 0x3ebf6406, 0x3ebc598e, 0x3eb951b5, 0x3eb64c99, 
+    0x3eb34a56, 0x3eb04b0c, 0x3ead4ed8, 0x3eaa55d6, 0x3ea76026, 0x3ea46de3, 0x3ea17f2c, 0x3e9e941e, 
+    0x3e9bacd4, 0x3e98c96d, 0x3e95ea04, 0x3e930eb6, 0x3e9037a0, 0x3e8d64dd, 0x3e8a968a, 0x3e87ccc2, 
+    0x3e8507a1, 0x3e824743, 0x3e7f1784, 0x3e79aa74, 0x3e74478b, 0x3e6eeeff, 0x3e69a105, 0x3e645dd0, 
+    0x3e5f2596, 0x3e59f88a, 0x3e54d6df, 0x3e4fc0c8, 0x3e4ab678, 0x3e45b820, 0x3e40c5f2, 0x3e3be01f, 
+    0x3e3706d7, 0x3e323a4b, 0x3e2d7aab, 0x3e28c824, 0x3e2422e6, 0x3e1f8b1e, 0x3e1b00fb, 0x3e1684a9, 
+    0x3e121654, 0x3e0db62a, 0x3e096453, 0x3e0520fd, 0x3e00ec51, 0x3df98cef, 0x3df15f37, 0x3de94fc9, 
+    0x3de15ef5, 0x3dd98d0a, 0x3dd1da56, 0x3dca4724, 0x3dc2d3c0, 0x3dbb8073, 0x3db44d87, 0x3dad3b42, 
+    0x3da649eb, 0x3d9f79c6, 0x3d98cb17, 0x3d923e20, 0x3d8bd322, 0x3d858a5c, 0x3d7ec81a, 0x3d72c0e4, 
+    0x3d66ff8d, 0x3d5b8488, 0x3d505049, 0x3d45633d, 0x3d3abdd2, 0x3d306070, 0x3d264b7e, 0x3d1c7f61, 
+    0x3d12fc79, 0x3d09c324, 0x3d00d3bf, 0x3cf05d41, 0x3cdfa83e, 0x3ccf891c, 0x3cc00079, 0x3cb10eef, 
+    0x3ca2b513, 0x3c94f373, 0x3c87ca96, 0x3c767600, 0x3c5e8a59, 0x3c47d325, 0x3c325144, 0x3c1e058c, 
+    0x3c0af0c6, 0x3bf2275e, 0x3bd0ddef, 0x3bb2068a, 0x3b95a260, 0x3b776514, 0x3b487014, 0x3b1e6790, 
+    0x3af29a52, 0x3ab2449b, 0x3a77a0f6, 0x3a1e8019, 0x39b25423, 0x391e863b, 0x381e87c4, 0x00000000
+};
+
+/* Triangular mel filter edges in FFT bins, 20 bands between 0 and 8 kHz */
+ML_TCM_DATA static const short mel_filter_points[LOGMEL_BANDS + 2] = {
+    9, 13, 16, 21, 25, 31, 37, 43, 50, 58, 67, 77, 87, 99, 113, 127, 144, 162,
+    182, 204, 229, 256
+};
+#else
+/* Benchmark FFT sizes: same window and filter bank, computed by
+ * logmel_init_tables() */
+#define LOGMEL_MEL_FMIN             (300.0)
+
+#ifndef M_PI
+#define M_PI                        (3.14159265358979323846)
+#endif
+
+ML_TCM_DATA static float hann_window[LOGMEL_FFT_SIZE];
+ML_TCM_DATA static short mel_filter_points[LOGMEL_BANDS + 2];
+#endif /* LOGMEL_FFT_SIZE == 512 */
+
+/*******************************************************************************
+* Generated DSP kernels (ImagiNet Compiler), kept bit exact with the models.
+* Inlined into logmel_compute_frame(), which runs from the ITCM with
+* AUDIO_FRONTEND_TCM, see ml_placement.h.
+*******************************************************************************/
+// input array (any shape >= 1D)
+// output array (same shape as input array)
+// d0 = input.shape.step(axis)
+// d1 = input.shape.size(axis)
+// d2 = input.shape.slot(axis)
+static inline void hannmul_f32(const float* restrict input, const float* restrict w, int d0, int d1, int d2, float* restrict output)
+{
+	const int d3 = d0 * d1;
+
+	const float* ip = input;
+	float* op = output;
+
+	for (int j = 0; j < d2; j++) {
+		for (int i = 0; i < d0; i++) {
+			for (int k = 0; k < d1; k++) {
+				op[k * d0 + i] = ip[k * d0 + i] * w[k];
+			}
+		}
+
+		ip += d3;
+		op += d3;
+	}
+}
+
+// input array (any shape >= 1D)
+// output array (shape = input.shape.replace(axis, n).insert(0,2))
+// d0 = input.shape.step(axis)
+// d1 = input.shape.size(axis)
+// d2 = input.shape.slot(axis)
+static inline void rfft_libfft_f32(
+    const float* restrict input, 
+    float* restrict output, 
+    int d0, int d1, int d2,
+    int32_t* restrict temp_ip, float* restrict temp_w, float* restrict temp_a)
+{
+    int d3 = d0 * d1;
+    int d_out = (d1 >> 1) + 1;
+
+    for (int k = 0; k < d2; k++)
+    {
+        int dk = k * d3;
+        int dm = k * 2 * d_out * d0;
+        for (int i = 0; i < d0; i++)
+        {                	           
+            for (int j = 0; j < d1; j++)
+            {
+                temp_a[j] = input[dk + j * d0 + i];
+            }
+            rdft_f32(d1, 1, temp_a, (int *)temp_ip, temp_w);
+
+            for (int m = 2; m < d1; m+=2)
+            {
+                int index = (m * d0) + 2 * i + dm;
+                output[index] = temp_a[m];
+                output[index + 1] = -temp_a[m + 1];
+            }
+            int beta = dm + 2 * i;
+            output[beta] = temp_a[0];
+            output[beta + 1] = 0;
+            output[beta + d3] = temp_a[1];
+            output[beta + d3 + 1] = 0;
+        }
+    }
+}
+
+static inline float __norm_sqrt_sum_f32(const float* restrict input, int count)
+{
+	float sum = 0;
+	for (int j = 0; j < count; j++) {
+		float item = *input++;
+		sum += item * item;
+	}
+	return sqrtf(sum);
+}
+
+static inline void norm_f32(const float* restrict input, int d1, int d2, float* restrict output)
+{
+	for (int k = 0; k < d2; k++) {
+		*output++ = __norm_sqrt_sum_f32(input, d1);
+		input += d1;
+	}
+}
+
+static inline float __mel_f32(const float* restrict input, const short* restrict filter_points, int filter)
+{
+	short n0 = filter_points[filter];
+	short n1 = filter_points[filter+1];
+	short n2 = filter_points[filter+2];
+	short c0 = n1 - n0;
+	short c1 = n2 - n1;
+	float sum = 0;
+	
+	for (int i = 0; i <= c0; i++) {
+		float rate = i / (float)c0;
+		float value = input[i + n0];
+		sum += value * rate;
+	}
+
+	for (int i = 1; i <= c1; i++) {
+		float rate = i / (float)c1;
+		float value = input[i + n1];
+		sum += value * (1.0 - rate);
+	}
+
+	return sum;
+}
+
+// input array (any shape >= 1D)
+// output array (same shape as input array except with 0 replaced with num_filter)
+// size = input.shape.size(0)
+// slot = input.shape.slot(0)
+static inline void mel_f32(const float* restrict input, const short* restrict filter_points, int size, int slot, int num_filter, float* restrict output)
+{	
+	for (int k = 0; k < slot; k++) {
+		const float *ip = input + k * size;
+		for (int i = 0; i < num_filter; i++) {
+			*output++ = __mel_f32(ip, filter_points, i);
+		}
+	}
+}
+
+static inline void clip_f32(const float* restrict input, int count, float min, float max, float* restrict output)
+{	
+	for (int i = 0; i < count; i++) {
+		float value = input[i];
+		if (value > max)
+			value = max;
+		if (value < min)
+			value = min;
+
+		output[i] = value;
+	}
+}
+
+static inline void ln_f32(const float* restrict x, int count, float* restrict result)
+{
+	for (int i = 0; i < count; i++) {
+		*result++ = logf(*x++);
+	}
+}
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+#if (LOGMEL_FFT_SIZE != 512)
+/*******************************************************************************
+* Function Name: logmel_init_tables
+********************************************************************************
+* Summary:
+*  Computes the Hann window and the mel filter edges of the exported tables
+*  for another FFT size: symmetric window, bands evenly spaced on the mel
+*  scale between LOGMEL_MEL_FMIN and the Nyquist frequency. Both reproduce
+*  the 512 point tables.
+*
+*******************************************************************************/
+static void logmel_init_tables(void)
+{
+    const double mel_min = 2595.0 * log10(1.0 + LOGMEL_MEL_FMIN / 700.0);
+    const double mel_max = 2595.0 * log10(1.0 + (LOGMEL_SAMPLE_RATE / 2) / 700.0);
+
+    for (int i = 0; i < LOGMEL_FFT_SIZE; i++)
+    {
+        hann_window[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / (LOGMEL_FFT_SIZE - 1)));
+    }
+    for (int i = 0; i < LOGMEL_BANDS + 2; i++)
+    {
+        double mel = mel_min + (mel_max - mel_min) * i / (LOGMEL_BANDS + 1);
+        double hz = 700.0 * (pow(10.0, mel / 2595.0) - 1.0);
+        mel_filter_points[i] = (short)floor(hz * (LOGMEL_FFT_SIZE + 1) / LOGMEL_SAMPLE_RATE);
+    }
+}
+#endif /* LOGMEL_FFT_SIZE != 512 */
+
+/*******************************************************************************
+* Function Name: logmel_init
+********************************************************************************
+* Summary:
+*  Resets the front end and binds its scratch memory. Consumers have to be
+*  added again after a reset.
+*
+* Parameters:
+*  lm:      front end instance
+*  scratch: scratch memory, only used inside logmel_process()
+*
+*******************************************************************************/
+void logmel_init(logmel_t* lm, logmel_scratch_t* scratch)
+{
+    memset(lm, 0, sizeof(*lm));
+    lm->scratch = scratch;
+    #if (LOGMEL_FFT_SIZE != 512)
+    logmel_init_tables();
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: logmel_set_denoise
+********************************************************************************
+* Summary:
+*  Enables noise suppression of the magnitude spectrum with an initialized
+*  instance, or disables it with NULL. Call it again after logmel_init().
+*
+*******************************************************************************/
+void logmel_set_denoise(logmel_t* lm, struct denoise* dn)
+{
+    lm->denoise = dn;
+}
+
+/*******************************************************************************
+* Function Name: logmel_add_consumer
+********************************************************************************
+* Summary:
+*  Registers a frame consumer. Consumers are served in registration order.
+*
+* Parameters:
+*  lm:       front end instance
+*  consumer: consumer with its configuration fields filled in
+*
+* Return:
+*  LOGMEL_RET_SUCCESS or LOGMEL_RET_ERROR for an invalid configuration
+*
+*******************************************************************************/
+int logmel_add_consumer(logmel_t* lm, logmel_consumer_t* consumer)
+{
+    logmel_consumer_t** tail = &lm->consumers;
+
+    if ((0 == consumer->window_frames) || (0 == consumer->window_stride) ||
+        (NULL == consumer->push))
+    {
+        return LOGMEL_RET_ERROR;
+    }
+
+    consumer->frames = 0;
+    consumer->windows = 0;
+    consumer->errors = 0;
+    consumer->overruns = 0;
+    consumer->cycles_last = 0;
+    consumer->cycles_max = 0;
+    consumer->cycles_total = 0;
+    consumer->next_window = consumer->window_frames;
+    consumer->cycles_acc = 0;
+    consumer->next = NULL;
+
+    while (NULL != *tail)
+    {
+        tail = &(*tail)->next;
+    }
+    *tail = consumer;
+
+    return LOGMEL_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: logmel_compute_frame
+********************************************************************************
+* Summary:
+*  Computes the log-mel frame of the current analysis window into lm->frame.
+*  Same kernel sequence as the generated model code.
+*
+*******************************************************************************/
+ML_TCM_CODE static void logmel_compute_frame(logmel_t* lm)
+{
+    logmel_scratch_t* s = lm->scratch;
+    PROF_BEGIN(prof_start);
+
+    hannmul_f32(lm->samples, (const float*)hann_window, 1, LOGMEL_FFT_SIZE, 1, s->windowed);
+    PROF_LAP(prof_start, PROF_STAGE_HANN);
+    LOGMEL_TAP(LOGMEL_STAGE_WINDOWED, s->windowed, LOGMEL_FFT_SIZE);
+    rfft_libfft_f32(s->windowed, s->spectrum, 1, LOGMEL_FFT_SIZE, 1, lm->fft_ip, lm->fft_w, s->fft_work);
+    PROF_LAP(prof_start, PROF_STAGE_FFT);
+    LOGMEL_TAP(LOGMEL_STAGE_SPECTRUM, s->spectrum, LOGMEL_BINS * 2);
+    norm_f32(s->spectrum, 2, LOGMEL_BINS, s->magnitude);
+    PROF_LAP(prof_start, PROF_STAGE_NORM);
+    LOGMEL_TAP(LOGMEL_STAGE_MAGNITUDE, s->magnitude, LOGMEL_BINS);
+    if (NULL != lm->denoise)
+    {
+        denoise_process(lm->denoise, s->magnitude);
+        PROF_LAP(prof_start, PROF_STAGE_DENOISE);
+    }
+    mel_f32(s->magnitude, mel_filter_points, LOGMEL_BINS, 1, LOGMEL_BANDS, s->mel);
+    PROF_LAP(prof_start, PROF_STAGE_MEL);
+    LOGMEL_TAP(LOGMEL_STAGE_MEL, s->mel, LOGMEL_BANDS);
+    clip_f32(s->mel, LOGMEL_BANDS, LOGMEL_CLIP_MIN, LOGMEL_CLIP_MAX, s->clipped);
+    PROF_LAP(prof_start, PROF_STAGE_CLIP);
+    LOGMEL_TAP(LOGMEL_STAGE_CLIPPED, s->clipped, LOGMEL_BANDS);
+    ln_f32(s->clipped, LOGMEL_BANDS, lm->frame);
+    PROF_END(prof_start, PROF_STAGE_LN);
+    LOGMEL_TAP(LOGMEL_STAGE_LOGMEL, lm->frame, LOGMEL_BANDS);
+}
+
+/*******************************************************************************
+* Function Name: logmel_publish
+********************************************************************************
+* Summary:
+*  Hands the current frame to every consumer and runs the window callback of
+*  the consumers whose window is complete. The cycles of push() and window()
+*  since the previous window are accounted to that window.
+*
+*******************************************************************************/
+static void logmel_publish(logmel_t* lm)
+{
+    for (logmel_consumer_t* c = lm->consumers; NULL != c; c = c->next)
+    {
+        uint32_t start = cycle_counter_get();
+
+        if (c->push(c->arg, lm->frame) < 0)
+        {
+            c->errors++;
+        }
+        c->frames++;
+
+        if (c->frames == c->next_window)
+        {
+            if (NULL != c->window)
+            {
+                c->window(c->arg);
+            }
+            c->next_window += c->window_stride;
+            c->windows++;
+
+            c->cycles_last = c->cycles_acc + (cycle_counter_get() - start);
+            c->cycles_acc = 0;
+            c->cycles_total += c->cycles_last;
+            if (c->cycles_last > c->cycles_max)
+            {
+                c->cycles_max = c->cycles_last;
+            }
+            if ((0 != c->budget_cycles) && (c->cycles_last > c->budget_cycles))
+            {
+                c->overruns++;
+            }
+        }
+        else
+        {
+            c->cycles_acc += cycle_counter_get() - start;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: logmel_process
+********************************************************************************
+* Summary:
+*  Feeds audio samples (normalized to [-1, 1]) into the front end. A frame is
+*  computed and published every LOGMEL_HOP_SIZE samples once the first
+*  LOGMEL_FFT_SIZE samples have been received.
+*
+* Parameters:
+*  lm:      front end instance
+*  samples: audio samples
+*  count:   number of samples
+*
+*******************************************************************************/
+void logmel_process(logmel_t* lm, const float* samples, int count)
+{
+    while (count > 0)
+    {
+        int n = LOGMEL_FFT_SIZE - lm->fill;
+        if (n > count)
+        {
+            n = count;
+        }
+        memcpy(&lm->samples[lm->fill], samples, n * sizeof(float));
+        lm->fill += n;
+        samples += n;
+        count -= n;
+
+        if (LOGMEL_FFT_SIZE == lm->fill)
+        {
+            uint32_t start = cycle_counter_get();
+            logmel_compute_frame(lm);
+
+            /* Slide the analysis window by one hop */
+            memmove(lm->samples, &lm->samples[LOGMEL_HOP_SIZE],
+                    (LOGMEL_FFT_SIZE - LOGMEL_HOP_SIZE) * sizeof(float));
+            lm->fill = LOGMEL_FFT_SIZE - LOGMEL_HOP_SIZE;
+
+            lm->cycles_last = cycle_counter_get() - start;
+            lm->cycles_total += lm->cycles_last;
+            if (lm->cycles_last > lm->cycles_max)
+            {
+                lm->cycles_max = lm->cycles_last;
+            }
+            lm->frames++;
+
+            logmel_publish(lm);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: logmel_print_stats
+********************************************************************************
+* Summary:
+*  Prints the feature extraction cost and, per consumer, the cost of a window
+*  against its budget.
+*
+* Parameters:
+*  lm:    front end instance
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void logmel_print_stats(const logmel_t* lm, logmel_print_fn print)
+{
+    print("logmel: frames %lu, cycles last %lu max %lu avg %lu\r\n",
+          (unsigned long)lm->frames, (unsigned long)lm->cycles_last,
+          (unsigned long)lm->cycles_max,
+          (unsigned long)(lm->frames ? lm->cycles_total / lm->frames : 0));
+
+    for (const logmel_consumer_t* c = lm->consumers; NULL != c; c = c->next)
+    {
+        print("  %-12s windows %lu, cycles last %lu max %lu avg %lu, budget %lu, overruns %lu, errors %lu\r\n",
+              c->name, (unsigned long)c->windows, (unsigned long)c->cycles_last,
+              (unsigned long)c->cycles_max,
+              (unsigned long)(c->windows ? c->cycles_total / c->windows : 0),
+              (unsigned long)c->budget_cycles, (unsigned long)c->overruns,
+              (unsigned long)c->errors);
+    }
+}
+
+/* [] END OF FILE */
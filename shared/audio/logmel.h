@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Streaming log-mel front end shared by all DEEPCRAFT models.
+ *
+ * Computes the same features as the pre-processing the ImagiNet Compiler emits
+ * into every model file (512 point Hann window, 160 sample hop, magnitude
+ * spectrum, 20 mel bands, clip at -70 dB, natural log) once, and publishes each
+ * 20 float frame to the registered consumers. Every consumer has its own window
+ * length and stride in frames: push() is called for every frame and window()
+ * once the consumer's window is complete, exactly when the generated
+ * fixwin_dequeue() of that model would succeed.
+ */
+
+#ifndef LOGMEL_H_
+#define LOGMEL_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LOGMEL_SAMPLE_RATE          (16000)
+#define LOGMEL_BANDS                (20)
+
+/* The models are trained with a 512 point FFT and a 160 sample hop. Other
+ * values (FFT size a power of two, hop not above the FFT size) only exist for
+ * throughput benchmarks and produce features the models do not expect. */
+#ifndef LOGMEL_FFT_SIZE
+#define LOGMEL_FFT_SIZE             (512)
+#endif
+#ifndef LOGMEL_HOP_SIZE
+#define LOGMEL_HOP_SIZE             (160)
+#endif
+#define LOGMEL_BINS                 (LOGMEL_FFT_SIZE / 2 + 1)
+
+/* Work area sizes of rdft_f32() for LOGMEL_FFT_SIZE, ip needs at least
+ * 2 + sqrt(LOGMEL_FFT_SIZE / 2) entries */
+#define LOGMEL_FFT_IP_SIZE          ((LOGMEL_FFT_SIZE <= 512) ? 24 : (2 + LOGMEL_FFT_SIZE / 32))
+#define LOGMEL_FFT_W_SIZE           (LOGMEL_FFT_SIZE / 2 + 2)
+
+#define LOGMEL_RET_SUCCESS          (0)
+#define LOGMEL_RET_ERROR            (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* A frame consumer, normally one model instance. The caller fills in the
+ * configuration fields, the front end owns the rest. */
+typedef struct logmel_consumer
+{
+    /* Configuration */
+    const char*  name;
+    uint16_t     window_frames;      /* Frames per window */
+    uint16_t     window_stride;      /* Frames between two windows */
+    uint32_t     budget_cycles;      /* Allowed cycles per window(), 0 = none */
+    int          (*push)(void* arg, const float* frame);
+    void         (*window)(void* arg);
+    void*        arg;
+
+    /* Statistics, see cycle_counter.h for the unit */
+    uint32_t     frames;
+    uint32_t     windows;
+    uint32_t     errors;             /* push() failures */
+    uint32_t     overruns;           /* window() calls above budget_cycles */
+    uint32_t     cycles_last;        /* push() + window() of the last window */
+    uint32_t     cycles_max;
+    uint64_t     cycles_total;
+
+    /* Internal */
+    uint32_t     next_window;
+    uint32_t     cycles_acc;
+    struct logmel_consumer* next;
+} logmel_consumer_t;
+
+/* Scratch memory of one frame computation. Only live inside logmel_process()
+ * and can be shared with other code running in the same task. */
+typedef struct
+{
+    union
+    {
+        float    windowed[LOGMEL_FFT_SIZE];
+        float    magnitude[LOGMEL_BINS];
+    };
+    float        spectrum[LOGMEL_BINS * 2];
+    float        fft_work[LOGMEL_FFT_SIZE];
+    float        mel[LOGMEL_BANDS];
+    float        clipped[LOGMEL_BANDS];
+} logmel_scratch_t;
+
+struct denoise;
+
+typedef struct
+{
+    float               samples[LOGMEL_FFT_SIZE];   /* Analysis window */
+    int                 fill;
+    int32_t             fft_ip[LOGMEL_FFT_IP_SIZE];
+    float               fft_w[LOGMEL_FFT_W_SIZE];
+    float               frame[LOGMEL_BANDS];        /* Last published frame */
+    logmel_scratch_t*   scratch;
+    logmel_consumer_t*  consumers;
+    struct denoise*     denoise;                    /* Noise suppression, NULL = off */
+
+    /* Feature extraction statistics */
+    uint32_t            frames;
+    uint32_t            cycles_last;
+    uint32_t            cycles_max;
+    uint64_t            cycles_total;
+} logmel_t;
+
+/* Intermediate results of a frame, in computation order */
+typedef enum
+{
+    LOGMEL_STAGE_WINDOWED = 0,      /* LOGMEL_FFT_SIZE Hann windowed samples */
+    LOGMEL_STAGE_SPECTRUM,          /* LOGMEL_BINS complex bins, interleaved */
+    LOGMEL_STAGE_MAGNITUDE,         /* LOGMEL_BINS magnitudes */
+    LOGMEL_STAGE_MEL,               /* LOGMEL_BANDS mel energies */
+    LOGMEL_STAGE_CLIPPED,           /* LOGMEL_BANDS clipped mel energies */
+    LOGMEL_STAGE_LOGMEL,            /* LOGMEL_BANDS published features */
+    LOGMEL_STAGE_COUNT
+} logmel_stage_t;
+
+/* printf compatible sink for logmel_print_stats() */
+typedef int (*logmel_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void logmel_init(logmel_t* lm, logmel_scratch_t* scratch);
+int  logmel_add_consumer(logmel_t* lm, logmel_consumer_t* consumer);
+void logmel_set_denoise(logmel_t* lm, struct denoise* dn);
+void logmel_process(logmel_t* lm, const float* samples, int count);
+void logmel_print_stats(const logmel_t* lm, logmel_print_fn print);
+
+/* Debug tap on every stage of every frame, for regression tests on a host.
+ * Only called when built with LOGMEL_ENABLE_TAP; the application provides
+ * the function. */
+void logmel_tap(logmel_stage_t stage, const float* data, int count);
+
+#endif /* LOGMEL_H_ */
@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "mem_plan.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: mem_plan_conflict
+********************************************************************************
+* Summary:
+*  Checks whether two buffers are live in a common phase and their address
+*  ranges overlap.
+*
+*******************************************************************************/
+static bool mem_plan_conflict(const mem_plan_buf_t* a, uint32_t a_offset,
+                              const mem_plan_buf_t* b)
+{
+    return (a->pool == b->pool) && (0 != (a->live & b->live)) &&
+           (0 != a->size) && (0 != b->size) &&
+           (a_offset < b->offset + b->size) &&
+           (b->offset < a_offset + a->size);
+}
+
+/*******************************************************************************
+* Function Name: mem_plan_layout
+********************************************************************************
+* Summary:
+*  Assigns an offset in the region to every buffer of the pool and writes the
+*  resulting addresses to the buffer's ptr. Buffers of other pools are left
+*  untouched. Buffers are placed largest first at the lowest address that does
+*  not collide with a placed buffer live in a common phase. Zero sized buffers
+*  are skipped and get a NULL address.
+*
+* Parameters:
+*  plan:        plan to fill in
+*  name:        name of the region in the report
+*  pool:        pool laid out by this plan
+*  region:      memory to lay the buffers out in
+*  region_size: size of the region in bytes
+*  bufs:        buffer descriptions, offset is written back
+*  count:       number of buffers, at most MEM_PLAN_MAX_BUFS
+*
+* Return:
+*  MEM_PLAN_RET_SUCCESS, MEM_PLAN_RET_NOMEM if the region is too small or
+*  MEM_PLAN_RET_ERROR for an invalid description. No address is written on
+*  failure; plan->used still reports the size the layout needed.
+*
+*******************************************************************************/
+int mem_plan_layout(mem_plan_t* plan, const char* name, uint32_t pool,
+                    uint8_t* region, uint32_t region_size,
+                    mem_plan_buf_t* bufs, int count)
+{
+    int order[MEM_PLAN_MAX_BUFS];
+    uintptr_t base = (uintptr_t)region;
+
+    plan->name = name;
+    plan->pool = pool;
+    plan->region = region;
+    plan->region_size = region_size;
+    plan->bufs = bufs;
+    plan->count = count;
+    plan->used = 0;
+    plan->unaliased = 0;
+
+    if ((count < 0) || (count > MEM_PLAN_MAX_BUFS))
+    {
+        return MEM_PLAN_RET_ERROR;
+    }
+
+    /* Sort by size, largest first. Insertion sort keeps equal sizes in the
+     * order they were declared. */
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        while ((j > 0) && (bufs[order[j - 1]].size < bufs[i].size))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        mem_plan_buf_t* buf = &bufs[order[i]];
+        uint32_t offset = 0;
+        bool moved;
+
+        if (pool != buf->pool)
+        {
+            continue;
+        }
+        buf->offset = 0;
+        if (0 == buf->size)
+        {
+            continue;
+        }
+        if ((0 == buf->align) || (0 != (buf->align & (buf->align - 1))))
+        {
+            return MEM_PLAN_RET_ERROR;
+        }
+
+        /* Move up past every colliding buffer until the slot is free */
+        do
+        {
+            moved = false;
+            offset = (uint32_t)(((base + offset + buf->align - 1) & ~(uintptr_t)(buf->align - 1)) - base);
+            for (int j = 0; j < i; j++)
+            {
+                const mem_plan_buf_t* placed = &bufs[order[j]];
+                if (mem_plan_conflict(buf, offset, placed))
+                {
+                    offset = placed->offset + placed->size;
+                    moved = true;
+                }
+            }
+        } while (moved);
+
+        buf->offset = offset;
+        plan->unaliased += buf->size;
+        if (offset + buf->size > plan->used)
+        {
+            plan->used = offset + buf->size;
+        }
+    }
+
+    if (plan->used > region_size)
+    {
+        return MEM_PLAN_RET_NOMEM;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if ((pool == bufs[i].pool) && (NULL != bufs[i].ptr))
+        {
+            *bufs[i].ptr = (0 != bufs[i].size) ? (void*)(region + bufs[i].offset) : NULL;
+        }
+    }
+
+    return MEM_PLAN_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mem_plan_verify
+********************************************************************************
+* Summary:
+*  Independent check of a layout: every buffer is aligned and inside the
+*  region, and no two buffers that are live in a common phase overlap.
+*
+* Parameters:
+*  plan: plan filled in by mem_plan_layout()
+*
+* Return:
+*  MEM_PLAN_RET_SUCCESS or MEM_PLAN_RET_ERROR
+*
+*******************************************************************************/
+int mem_plan_verify(const mem_plan_t* plan)
+{
+    for (int i = 0; i < plan->count; i++)
+    {
+        const mem_plan_buf_t* a = &plan->bufs[i];
+
+        if ((plan->pool != a->pool) || (0 == a->size))
+        {
+            continue;
+        }
+        if ((a->offset + a->size > plan->region_size) ||
+            (0 != (((uintptr_t)plan->region + a->offset) & (a->align - 1))))
+        {
+            return MEM_PLAN_RET_ERROR;
+        }
+        for (int j = i + 1; j < plan->count; j++)
+        {
+            if (mem_plan_conflict(a, a->offset, &plan->bufs[j]))
+            {
+                return MEM_PLAN_RET_ERROR;
+            }
+        }
+    }
+
+    return MEM_PLAN_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: mem_plan_report
+********************************************************************************
+* Summary:
+*  Prints the memory map of a plan with the absolute addresses and the bytes
+*  saved by aliasing.
+*
+* Parameters:
+*  plan:  plan filled in by mem_plan_layout()
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void mem_plan_report(const mem_plan_t* plan, mem_plan_print_fn print)
+{
+    print("mem plan %s @ %p: region %lu bytes, used %lu, unaliased %lu, saved %lu\r\n",
+          plan->name, (void*)plan->region,
+          (unsigned long)plan->region_size, (unsigned long)plan->used,
+          (unsigned long)plan->unaliased,
+          (unsigned long)(plan->unaliased - plan->used));
+    print("  address     size      live        name\r\n");
+
+    for (int i = 0; i < plan->count; i++)
+    {
+        const mem_plan_buf_t* buf = &plan->bufs[i];
+        if ((plan->pool != buf->pool) || (0 == buf->size))
+        {
+            continue;
+        }
+        print("  %-10p  %-8lu  0x%08lx  %s\r\n",
+              (void*)(plan->region + buf->offset), (unsigned long)buf->size,
+              (unsigned long)buf->live, buf->name);
+    }
+}
+
+/* [] END OF FILE */
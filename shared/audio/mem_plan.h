@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Startup memory planner.
+ *
+ * Lays out a set of buffers in one region. Every buffer declares the phases of
+ * the processing loop in which it is live as a bit mask; buffers whose masks do
+ * not intersect may share addresses. The layout is a greedy first fit, largest
+ * buffer first, as used by the TFLM greedy memory planner.
+ *
+ * A buffer table may span several memories: each buffer names its pool and
+ * every pool is laid out into its own region by a separate mem_plan_t.
+ */
+
+#ifndef MEM_PLAN_H_
+#define MEM_PLAN_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Live in every phase, never aliased */
+#define MEM_PLAN_LIVE_ALWAYS        (0xFFFFFFFFu)
+
+/* Upper bound of the buffers in one plan */
+#define MEM_PLAN_MAX_BUFS           (16)
+
+#define MEM_PLAN_RET_SUCCESS        (0)
+#define MEM_PLAN_RET_NOMEM          (-1)
+#define MEM_PLAN_RET_ERROR          (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    const char*  name;
+    uint32_t     size;           /* Bytes, 0 = not used in this plan */
+    uint32_t     align;          /* Power of two */
+    uint32_t     live;           /* Bit mask of the phases using the buffer */
+    uint32_t     pool;           /* Region the buffer is placed in */
+    void**       ptr;            /* Receives the address, may be NULL */
+    uint32_t     offset;         /* Set by mem_plan_layout() */
+} mem_plan_buf_t;
+
+typedef struct
+{
+    const char*      name;
+    uint32_t         pool;
+    uint8_t*         region;
+    uint32_t         region_size;
+    mem_plan_buf_t*  bufs;
+    int              count;
+    uint32_t         used;           /* End of the highest placed buffer */
+    uint32_t         unaliased;      /* Sum of all buffer sizes */
+} mem_plan_t;
+
+/* printf compatible sink for mem_plan_report() */
+typedef int (*mem_plan_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  mem_plan_layout(mem_plan_t* plan, const char* name, uint32_t pool,
+                     uint8_t* region, uint32_t region_size,
+                     mem_plan_buf_t* bufs, int count);
+int  mem_plan_verify(const mem_plan_t* plan);
+void mem_plan_report(const mem_plan_t* plan, mem_plan_print_fn print);
+
+#endif /* MEM_PLAN_H_ */
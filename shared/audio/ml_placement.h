@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Memory placement policy of the ML buffers.
+ *
+ * Every buffer class can be placed independently:
+ *   ML_PLACE_WEIGHTS - model weights: ML_MEM_XIP (executed in place from flash)
+ *                      or ML_MEM_SOCMEM (copied at boot)
+ *   ML_PLACE_ARENA   - NPU tensor arena, must be NPU accessible
+ *   ML_PLACE_WINDOWS - PDM ring, front end window, model feature windows and
+ *                      the task stack
+ *   ML_PLACE_SCRATCH - FFT and model scratch
+ * ML_MEM_LOCAL is the default RAM of the core (the CM55 DTCM).
+ *
+ * Presets, selected with ML_PLACEMENT in proj_cm55/Makefile:
+ *   ML_PLACEMENT_LATENCY - weights copied to SOCMEM, CPU buffers in local RAM
+ *   ML_PLACEMENT_RAM     - weights in XIP flash, everything else in SOCMEM
+ * Single classes can be overridden by defining ML_PLACE_xxx.
+ *
+ * The hot code and the constant tables of the log-mel front end are placed
+ * with section attributes, AUDIO_FRONTEND_TCM in proj_cm55/Makefile:
+ *   ML_TCM_CODE - function in the CM55 ITCM (FFT, window, mel filter bank)
+ *   ML_TCM_DATA - table in the CM55 DTCM (Hann window, mel filter edges)
+ * The sections are those the CM55 linker script of the BSP maps to the TCMs
+ * and copies from flash at startup. Both are empty on other cores and on a
+ * host. The buffers of the front end follow ML_PLACE_WINDOWS and
+ * ML_PLACE_SCRATCH, which are local RAM with the LATENCY preset.
+ */
+
+#ifndef ML_PLACEMENT_H_
+#define ML_PLACEMENT_H_
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ML_MEM_XIP                  (0u)
+#define ML_MEM_SOCMEM               (1u)
+#define ML_MEM_LOCAL                (2u)
+
+#if defined(ML_PLACEMENT_RAM)
+ #define ML_PLACEMENT_NAME          "RAM"
+ #ifndef ML_PLACE_WEIGHTS
+  #define ML_PLACE_WEIGHTS          ML_MEM_XIP
+ #endif
+ #ifndef ML_PLACE_ARENA
+  #define ML_PLACE_ARENA            ML_MEM_SOCMEM
+ #endif
+ #ifndef ML_PLACE_WINDOWS
+  #define ML_PLACE_WINDOWS          ML_MEM_SOCMEM
+ #endif
+ #ifndef ML_PLACE_SCRATCH
+  #define ML_PLACE_SCRATCH          ML_MEM_SOCMEM
+ #endif
+#else
+ #define ML_PLACEMENT_NAME          "LATENCY"
+ #ifndef ML_PLACE_WEIGHTS
+  #define ML_PLACE_WEIGHTS          ML_MEM_SOCMEM
+ #endif
+ #ifndef ML_PLACE_ARENA
+  #define ML_PLACE_ARENA            ML_MEM_SOCMEM
+ #endif
+ #ifndef ML_PLACE_WINDOWS
+  #define ML_PLACE_WINDOWS          ML_MEM_LOCAL
+ #endif
+ #ifndef ML_PLACE_SCRATCH
+  #define ML_PLACE_SCRATCH          ML_MEM_LOCAL
+ #endif
+#endif /* ML_PLACEMENT_RAM */
+
+#if (ML_PLACE_WEIGHTS == ML_MEM_LOCAL)
+ #error "Model weights can be placed in ML_MEM_XIP or ML_MEM_SOCMEM only"
+#endif
+#if (ML_PLACE_ARENA == ML_MEM_XIP) || (ML_PLACE_WINDOWS == ML_MEM_XIP) || (ML_PLACE_SCRATCH == ML_MEM_XIP)
+ #error "Only the model weights can be placed in ML_MEM_XIP"
+#endif
+#if (ML_PLACE_ARENA == ML_MEM_LOCAL)
+ #error "The NPU tensor arena must be NPU accessible, place it in ML_MEM_SOCMEM"
+#endif
+
+#ifndef AUDIO_FRONTEND_TCM
+ #define AUDIO_FRONTEND_TCM         (0)
+#endif
+#ifndef ML_TCM_CODE_SECTION
+ #define ML_TCM_CODE_SECTION        ".cy_itcm"
+#endif
+#ifndef ML_TCM_DATA_SECTION
+ #define ML_TCM_DATA_SECTION        ".cy_dtcm"
+#endif
+
+#if defined(COMPONENT_CM55) && (AUDIO_FRONTEND_TCM == 1)
+ #include "cy_utils.h"
+ /* Not inlined, the callers run from flash */
+ #define ML_TCM_CODE                CY_SECTION(ML_TCM_CODE_SECTION) CY_NOINLINE
+ #define ML_TCM_DATA                CY_SECTION(ML_TCM_DATA_SECTION)
+#else
+ #define ML_TCM_CODE
+ #define ML_TCM_DATA
+#endif
+
+/* Name of a placement for the boot report */
+#define ML_MEM_NAME(mem)            (((mem) == ML_MEM_XIP) ? "xip" : \
+                                     ((mem) == ML_MEM_SOCMEM) ? "socmem" : "local")
+
+#endif /* ML_PLACEMENT_H_ */
@@ -0,0 +1,420 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "model_profile.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* File identifier of the TFLite schema */
+#define TFLITE_IDENTIFIER           "TFL3"
+
+/* Fields of the tables of the schema that are read */
+#define TFLITE_MODEL_OPERATOR_CODES (1u)
+#define TFLITE_MODEL_SUBGRAPHS      (2u)
+#define TFLITE_CODE_DEPRECATED      (0u)    /* int8, codes below 127 */
+#define TFLITE_CODE_CUSTOM          (1u)    /* string */
+#define TFLITE_CODE_BUILTIN         (3u)    /* int32 */
+#define TFLITE_SUBGRAPH_OPERATORS   (3u)
+#define TFLITE_OPERATOR_OPCODE      (0u)    /* uint32 index into the operator codes */
+
+#define TFLITE_BUILTIN_CUSTOM       (32)
+
+/* BuiltinOperator of the schema, as EnumNameBuiltinOperator() of TFLM names them */
+#define TFLITE_BUILTIN_NAMES        { \
+    "ADD", "AVERAGE_POOL_2D", "CONCATENATION", "CONV_2D", "DEPTHWISE_CONV_2D", "DEPTH_TO_SPACE", \
+    "DEQUANTIZE", "EMBEDDING_LOOKUP", "FLOOR", "FULLY_CONNECTED", "HASHTABLE_LOOKUP", \
+    "L2_NORMALIZATION", "L2_POOL_2D", "LOCAL_RESPONSE_NORMALIZATION", "LOGISTIC", "LSH_PROJECTION", \
+    "LSTM", "MAX_POOL_2D", "MUL", "RELU", "RELU_N1_TO_1", "RELU6", "RESHAPE", "RESIZE_BILINEAR", \
+    "RNN", "SOFTMAX", "SPACE_TO_DEPTH", "SVDF", "TANH", "CONCAT_EMBEDDINGS", "SKIP_GRAM", "CALL", \
+    "CUSTOM", "EMBEDDING_LOOKUP_SPARSE", "PAD", "UNIDIRECTIONAL_SEQUENCE_RNN", "GATHER", \
+    "BATCH_TO_SPACE_ND", "SPACE_TO_BATCH_ND", "TRANSPOSE", "MEAN", "SUB", "DIV", "SQUEEZE", \
+    "UNIDIRECTIONAL_SEQUENCE_LSTM", "STRIDED_SLICE", "BIDIRECTIONAL_SEQUENCE_RNN", "EXP", "TOPK_V2", \
+    "SPLIT", "LOG_SOFTMAX", "DELEGATE", "BIDIRECTIONAL_SEQUENCE_LSTM", "CAST", "PRELU", "MAXIMUM", \
+    "ARG_MAX", "MINIMUM", "LESS", "NEG", "PADV2", "GREATER", "GREATER_EQUAL", "LESS_EQUAL", "SELECT", \
+    "SLICE", "SIN", "TRANSPOSE_CONV", "SPARSE_TO_DENSE", "TILE", "EXPAND_DIMS", "EQUAL", "NOT_EQUAL", \
+    "LOG", "SUM", "SQRT", "RSQRT", "SHAPE", "POW", "ARG_MIN", "FAKE_QUANT", "REDUCE_PROD", \
+    "REDUCE_MAX", "PACK", "LOGICAL_OR", "ONE_HOT", "LOGICAL_AND", "LOGICAL_NOT", "UNPACK", \
+    "REDUCE_MIN", "FLOOR_DIV", "REDUCE_ANY", "SQUARE", "ZEROS_LIKE", "FILL", "FLOOR_MOD", "RANGE", \
+    "RESIZE_NEAREST_NEIGHBOR", "LEAKY_RELU", "SQUARED_DIFFERENCE", "MIRROR_PAD", "ABS", "SPLIT_V", \
+    "UNIQUE", "CEIL", "REVERSE_V2", "ADD_N", "GATHER_ND", "COS", "WHERE", "RANK", "ELU", \
+    "REVERSE_SEQUENCE", "MATRIX_DIAG", "QUANTIZE", "MATRIX_SET_DIAG", "ROUND", "HARD_SWISH", "IF", \
+    "WHILE", "NON_MAX_SUPPRESSION_V4", "NON_MAX_SUPPRESSION_V5", "SCATTER_ND", "SELECT_V2", \
+    "DENSIFY", "SEGMENT_SUM", "BATCH_MATMUL" }
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Flatbuffer being read; every offset is checked against the size. A read
+ * past the end marks the buffer corrupt, an absent field does not. */
+typedef struct
+{
+    const uint8_t*  data;
+    uint32_t        size;
+    bool            corrupt;
+} flatbuffer_t;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+static bool fb_u32(flatbuffer_t* fb, uint32_t pos, uint32_t* value)
+{
+    if ((pos > fb->size) || ((fb->size - pos) < 4u))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    *value = (uint32_t)fb->data[pos] | ((uint32_t)fb->data[pos + 1u] << 8) |
+             ((uint32_t)fb->data[pos + 2u] << 16) | ((uint32_t)fb->data[pos + 3u] << 24);
+    return true;
+}
+
+static bool fb_u16(flatbuffer_t* fb, uint32_t pos, uint32_t* value)
+{
+    if ((pos > fb->size) || ((fb->size - pos) < 2u))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    *value = (uint32_t)fb->data[pos] | ((uint32_t)fb->data[pos + 1u] << 8);
+    return true;
+}
+
+/* Follows the unsigned offset stored at pos */
+static bool fb_deref(flatbuffer_t* fb, uint32_t pos, uint32_t* target)
+{
+    uint32_t offset;
+
+    if (!fb_u32(fb, pos, &offset))
+    {
+        return false;
+    }
+    if (offset > (fb->size - pos))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    *target = pos + offset;
+    return true;
+}
+
+/* Position of a field of the table, false if the field is absent */
+static bool fb_field(flatbuffer_t* fb, uint32_t table, uint32_t field, uint32_t* pos)
+{
+    uint32_t soffset;
+    uint32_t vtable_size;
+    uint32_t offset;
+    int64_t vtable;
+
+    if (!fb_u32(fb, table, &soffset))
+    {
+        return false;
+    }
+    vtable = (int64_t)table - (int64_t)(int32_t)soffset;
+    if ((vtable < 0) || (vtable > (int64_t)fb->size))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    if (!fb_u16(fb, (uint32_t)vtable, &vtable_size) ||
+        ((4u + 2u * field + 2u) > vtable_size) ||
+        !fb_u16(fb, (uint32_t)vtable + 4u + 2u * field, &offset) ||
+        (0u == offset))
+    {
+        return false;
+    }
+    if (offset >= (fb->size - table))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    *pos = table + offset;
+    return true;
+}
+
+/* Vector of tables or strings: element count and position of the first offset */
+static bool fb_vector(flatbuffer_t* fb, uint32_t table, uint32_t field, uint32_t* count, uint32_t* first)
+{
+    uint32_t pos;
+    uint32_t vector;
+
+    if (!fb_field(fb, table, field, &pos) || !fb_deref(fb, pos, &vector) || !fb_u32(fb, vector, count))
+    {
+        return false;
+    }
+    if (*count > ((fb->size - vector - 4u) / 4u))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    *first = vector + 4u;
+    return true;
+}
+
+/* Copies a string field, truncated to size - 1 characters */
+static bool fb_string(flatbuffer_t* fb, uint32_t table, uint32_t field, char* out, uint32_t size)
+{
+    uint32_t pos;
+    uint32_t string;
+    uint32_t length;
+
+    if (!fb_field(fb, table, field, &pos) || !fb_deref(fb, pos, &string) || !fb_u32(fb, string, &length))
+    {
+        return false;
+    }
+    if (length > (fb->size - string - 4u))
+    {
+        fb->corrupt = true;
+        return false;
+    }
+    length = (length < (size - 1u)) ? length : (size - 1u);
+    memcpy(out, &fb->data[string + 4u], length);
+    out[length] = '\0';
+    return true;
+}
+
+/* Name of an operator code, the custom name for custom operators */
+static bool operator_name(flatbuffer_t* fb, uint32_t code, char* name)
+{
+    static const char* const builtin_names[] = TFLITE_BUILTIN_NAMES;
+    uint32_t pos;
+    uint32_t value;
+    int32_t builtin = 0;
+
+    /* Codes below 127 are also in the deprecated int8 field, older
+     * converters only write that one */
+    if (fb_field(fb, code, TFLITE_CODE_DEPRECATED, &pos))
+    {
+        builtin = (int32_t)(int8_t)fb->data[pos];
+    }
+    if (fb_field(fb, code, TFLITE_CODE_BUILTIN, &pos) && fb_u32(fb, pos, &value) &&
+        ((int32_t)value > builtin))
+    {
+        builtin = (int32_t)value;
+    }
+
+    if (TFLITE_BUILTIN_CUSTOM == builtin)
+    {
+        return fb_string(fb, code, TFLITE_CODE_CUSTOM, name, MODEL_PROFILE_NAME_SIZE);
+    }
+    if ((builtin >= 0) && (builtin < (int32_t)(sizeof(builtin_names) / sizeof(builtin_names[0]))))
+    {
+        (void)snprintf(name, MODEL_PROFILE_NAME_SIZE, "%s", builtin_names[builtin]);
+    }
+    else
+    {
+        (void)snprintf(name, MODEL_PROFILE_NAME_SIZE, "BUILTIN_%ld", (long)builtin);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: model_profile_init
+********************************************************************************
+* Summary:
+*  Clears the profile and lists the operators of the first subgraph of a
+*  TFLite flatbuffer with their placement. The flatbuffer is not trusted,
+*  every offset is checked against its size.
+*
+* Parameters:
+*  prof:       profile
+*  model:      TFLite flatbuffer
+*  model_size: bytes of the flatbuffer
+*  arena_size: bytes of the tensor arena allocated for the model
+*
+* Return:
+*  MODEL_PROFILE_RET_SUCCESS or MODEL_PROFILE_RET_ERROR if the flatbuffer is
+*  not a TFLite model
+*
+*******************************************************************************/
+int model_profile_init(model_profile_t* prof, const uint8_t* model, uint32_t model_size, uint32_t arena_size)
+{
+    flatbuffer_t fb = { model, model_size, false };
+    uint32_t root;
+    uint32_t code_count;
+    uint32_t codes;
+    uint32_t subgraph_count;
+    uint32_t subgraphs;
+    uint32_t subgraph;
+    uint32_t op_count;
+    uint32_t ops;
+
+    memset(prof, 0, sizeof(*prof));
+    prof->report.weights_size = model_size;
+    prof->report.arena_size = arena_size;
+
+    if ((NULL == model) || (model_size < 8u) || (0 != memcmp(&model[4], TFLITE_IDENTIFIER, 4u)) ||
+        !fb_deref(&fb, 0u, &root) ||
+        !fb_vector(&fb, root, TFLITE_MODEL_OPERATOR_CODES, &code_count, &codes) ||
+        !fb_vector(&fb, root, TFLITE_MODEL_SUBGRAPHS, &subgraph_count, &subgraphs) ||
+        (0u == subgraph_count) || !fb_deref(&fb, subgraphs, &subgraph) ||
+        !fb_vector(&fb, subgraph, TFLITE_SUBGRAPH_OPERATORS, &op_count, &ops))
+    {
+        return MODEL_PROFILE_RET_ERROR;
+    }
+
+    for (uint32_t i = 0; i < op_count; i++)
+    {
+        char name[MODEL_PROFILE_NAME_SIZE];
+        uint32_t op;
+        uint32_t pos;
+        uint32_t index = 0;
+        uint32_t code;
+
+        if (!fb_deref(&fb, ops + 4u * i, &op) ||
+            (fb_field(&fb, op, TFLITE_OPERATOR_OPCODE, &pos) && !fb_u32(&fb, pos, &index)) ||
+            (index >= code_count) || !fb_deref(&fb, codes + 4u * index, &code) ||
+            !operator_name(&fb, code, name) || fb.corrupt)
+        {
+            return MODEL_PROFILE_RET_ERROR;
+        }
+
+        if (0 == strcmp(name, MODEL_PROFILE_NPU_OP))
+        {
+            prof->report.npu_ops++;
+        }
+        if (i < MODEL_PROFILE_MAX_OPS)
+        {
+            memcpy(prof->report.ops[i].name, name, sizeof(name));
+            prof->report.ops[i].npu = (0 == strcmp(name, MODEL_PROFILE_NPU_OP)) ? 1u : 0u;
+        }
+    }
+    prof->report.op_count = op_count;
+
+    return MODEL_PROFILE_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: model_profile_op
+********************************************************************************
+* Summary:
+*  Records one invocation of an operator.
+*
+* Parameters:
+*  prof:   profile
+*  index:  operator in execution order
+*  cycles: counter ticks of the invocation
+*
+*******************************************************************************/
+void model_profile_op(model_profile_t* prof, uint32_t index, uint32_t cycles)
+{
+    model_profile_op_t* op;
+
+    if ((index >= prof->report.op_count) || (index >= MODEL_PROFILE_MAX_OPS))
+    {
+        return;
+    }
+    op = &prof->report.ops[index];
+    op->min = ((0u == op->count) || (cycles < op->min)) ? cycles : op->min;
+    op->max = (cycles > op->max) ? cycles : op->max;
+    op->count++;
+    prof->op_total[index] += cycles;
+}
+
+/*******************************************************************************
+* Function Name: model_profile_inference
+********************************************************************************
+* Summary:
+*  Records one inference of the whole graph.
+*
+* Parameters:
+*  prof:   profile
+*  cycles: counter ticks of the inference
+*
+*******************************************************************************/
+void model_profile_inference(model_profile_t* prof, uint32_t cycles)
+{
+    model_profile_report_t* report = &prof->report;
+
+    report->inference_min = ((0u == report->runs) || (cycles < report->inference_min)) ? cycles : report->inference_min;
+    report->inference_max = (cycles > report->inference_max) ? cycles : report->inference_max;
+    report->runs++;
+    prof->inference_total += cycles;
+}
+
+/*******************************************************************************
+* Function Name: model_profile_summarize
+********************************************************************************
+* Summary:
+*  Sets the means of the report from the recorded totals.
+*
+* Parameters:
+*  prof: profile
+*
+*******************************************************************************/
+void model_profile_summarize(model_profile_t* prof)
+{
+    model_profile_report_t* report = &prof->report;
+
+    for (uint32_t i = 0; i < MODEL_PROFILE_MAX_OPS; i++)
+    {
+        model_profile_op_t* op = &report->ops[i];
+        op->mean = (op->count > 0u) ? (uint32_t)(prof->op_total[i] / op->count) : 0u;
+    }
+    report->inference_mean = (report->runs > 0u) ? (uint32_t)(prof->inference_total / report->runs) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: model_profile_print
+********************************************************************************
+* Summary:
+*  Prints a report, one line per operator. Without measurements only the
+*  placement of the operators is printed.
+*
+* Parameters:
+*  report: summarized report
+*  print:  printf compatible output function
+*
+*******************************************************************************/
+void model_profile_print(const model_profile_report_t* report, model_profile_print_fn print)
+{
+    uint32_t listed = (report->op_count < MODEL_PROFILE_MAX_OPS) ? report->op_count : MODEL_PROFILE_MAX_OPS;
+
+    /* One call per line, a line per record with app_log_printf() */
+    print("model profile: %lu operators, %lu on the npu, %lu on the cpu\r\n",
+          (unsigned long)report->op_count, (unsigned long)report->npu_ops,
+          (unsigned long)(report->op_count - report->npu_ops));
+    if (report->arena_used > 0u)
+    {
+        print("  weights %lu bytes, arena %lu of %lu bytes\r\n", (unsigned long)report->weights_size,
+              (unsigned long)report->arena_used, (unsigned long)report->arena_size);
+    }
+    else
+    {
+        print("  weights %lu bytes\r\n", (unsigned long)report->weights_size);
+    }
+
+    if (0u == report->runs)
+    {
+        print("  op  name                  unit\r\n");
+        for (uint32_t i = 0; i < listed; i++)
+        {
+            print("  %-2lu  %-20s  %s\r\n", (unsigned long)i, report->ops[i].name,
+                  report->ops[i].npu ? "npu" : "cpu");
+        }
+        return;
+    }
+
+    print("  inference %lu runs at %lu Hz: min %lu, mean %lu, max %lu\r\n",
+          (unsigned long)report->runs, (unsigned long)report->core_clock_hz,
+          (unsigned long)report->inference_min, (unsigned long)report->inference_mean,
+          (unsigned long)report->inference_max);
+    print("  op  name                  unit  count     min       mean      max       share\r\n");
+    for (uint32_t i = 0; i < listed; i++)
+    {
+        const model_profile_op_t* op = &report->ops[i];
+        float share = (report->inference_mean > 0u) ? (100.0f * (float)op->mean / (float)report->inference_mean) : 0.0f;
+
+        print("  %-2lu  %-20s  %s   %-8lu  %-8lu  %-8lu  %-8lu  %.1f%%\r\n", (unsigned long)i, op->name,
+              op->npu ? "npu" : "cpu", (unsigned long)op->count, (unsigned long)op->min,
+              (unsigned long)op->mean, (unsigned long)op->max, share);
+    }
+}
+
+/* [] END OF FILE */
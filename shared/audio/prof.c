@@ -0,0 +1,218 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "prof.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Histogram buckets per octave, as a power of two */
+#define PROF_HIST_SUB_BITS          (2u)
+#define PROF_HIST_SUB               (1u << PROF_HIST_SUB_BITS)
+
+/* Values below PROF_HIST_SUB get a bucket each, every octave above has
+ * PROF_HIST_SUB buckets */
+#define PROF_HIST_BUCKETS           ((32u - PROF_HIST_SUB_BITS + 1u) * PROF_HIST_SUB)
+
+#if defined(COMPONENT_CM55) || defined(COMPONENT_CM33)
+#define PROF_ENTER_CRITICAL()       uint32_t prof_irq_ = Cy_SysLib_EnterCriticalSection()
+#define PROF_EXIT_CRITICAL()        Cy_SysLib_ExitCriticalSection(prof_irq_)
+#else
+#define PROF_ENTER_CRITICAL()
+#define PROF_EXIT_CRITICAL()
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    total;
+    uint16_t    hist[PROF_HIST_BUCKETS];
+} prof_stage_stats_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static prof_stage_stats_t prof_stats[PROF_STAGE_COUNT];
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: prof_bucket
+********************************************************************************
+* Summary:
+*  Histogram bucket of a value: the octave of its most significant bit and the
+*  PROF_HIST_SUB_BITS bits below it.
+*
+*******************************************************************************/
+static inline uint32_t prof_bucket(uint32_t ticks)
+{
+    uint32_t msb;
+
+    if (ticks < PROF_HIST_SUB)
+    {
+        return ticks;
+    }
+    msb = 31u - (uint32_t)__builtin_clz(ticks);
+    return ((msb - PROF_HIST_SUB_BITS + 1u) << PROF_HIST_SUB_BITS) +
+           ((ticks >> (msb - PROF_HIST_SUB_BITS)) & (PROF_HIST_SUB - 1u));
+}
+
+/*******************************************************************************
+* Function Name: prof_bucket_upper
+********************************************************************************
+* Summary:
+*  Largest value that falls into a histogram bucket.
+*
+*******************************************************************************/
+static uint32_t prof_bucket_upper(uint32_t bucket)
+{
+    uint32_t shift;
+
+    if (bucket < PROF_HIST_SUB)
+    {
+        return bucket;
+    }
+    shift = (bucket >> PROF_HIST_SUB_BITS) - 1u;
+    return (uint32_t)((((uint64_t)(PROF_HIST_SUB + (bucket & (PROF_HIST_SUB - 1u))) + 1u) << shift) - 1u);
+}
+
+/*******************************************************************************
+* Function Name: prof_record
+********************************************************************************
+* Summary:
+*  Adds one measurement to a stage. A histogram bucket about to overflow halves
+*  all buckets of the stage, which keeps the percentiles of long periods.
+*
+* Parameters:
+*  stage: stage the measurement belongs to
+*  ticks: duration in counter ticks
+*
+*******************************************************************************/
+void prof_record(prof_stage_t stage, uint32_t ticks)
+{
+    prof_stage_stats_t* s = &prof_stats[stage];
+    uint32_t bucket = prof_bucket(ticks);
+
+    if ((0 == s->count) || (ticks < s->min))
+    {
+        s->min = ticks;
+    }
+    if (ticks > s->max)
+    {
+        s->max = ticks;
+    }
+    s->count++;
+    s->total += ticks;
+
+    if (UINT16_MAX == s->hist[bucket])
+    {
+        for (uint32_t i = 0; i < PROF_HIST_BUCKETS; i++)
+        {
+            s->hist[i] >>= 1;
+        }
+    }
+    s->hist[bucket]++;
+}
+
+/*******************************************************************************
+* Function Name: prof_summarize
+********************************************************************************
+* Summary:
+*  Computes min, mean, max and 99th percentile of every stage.
+*
+* Parameters:
+*  summary: receives one entry per stage
+*
+*******************************************************************************/
+void prof_summarize(prof_summary_t summary[PROF_STAGE_COUNT])
+{
+    for (uint32_t stage = 0; stage < PROF_STAGE_COUNT; stage++)
+    {
+        prof_stage_stats_t* s = &prof_stats[stage];
+        prof_summary_t* out = &summary[stage];
+        uint32_t hist_total = 0;
+        uint32_t rank;
+        uint32_t seen = 0;
+
+        PROF_ENTER_CRITICAL();
+
+        out->count = s->count;
+        out->min = s->min;
+        out->max = s->max;
+        out->mean = (0 != s->count) ? (uint32_t)(s->total / s->count) : 0u;
+        out->p99 = 0;
+
+        for (uint32_t i = 0; i < PROF_HIST_BUCKETS; i++)
+        {
+            hist_total += s->hist[i];
+        }
+        /* Smallest bucket covering 99% of the samples */
+        rank = hist_total - hist_total / 100u;
+        for (uint32_t i = 0; (i < PROF_HIST_BUCKETS) && (0 != rank); i++)
+        {
+            seen += s->hist[i];
+            if (seen >= rank)
+            {
+                out->p99 = prof_bucket_upper(i);
+                break;
+            }
+        }
+        if (out->p99 > out->max)
+        {
+            out->p99 = out->max;
+        }
+
+        PROF_EXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+* Function Name: prof_reset
+********************************************************************************
+* Summary:
+*  Clears the statistics of all stages to start a new period.
+*
+*******************************************************************************/
+void prof_reset(void)
+{
+    PROF_ENTER_CRITICAL();
+    memset(prof_stats, 0, sizeof(prof_stats));
+    PROF_EXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: prof_print
+********************************************************************************
+* Summary:
+*  Prints a summary as one line per stage.
+*
+* Parameters:
+*  summary: result of prof_summarize()
+*  print:   printf compatible output function
+*
+*******************************************************************************/
+void prof_print(const prof_summary_t summary[PROF_STAGE_COUNT], prof_print_fn print)
+{
+    static const char* const names[PROF_STAGE_COUNT] = PROF_STAGE_NAMES;
+
+    print("  stage        count     min       mean      max       p99\r\n");
+    for (uint32_t stage = 0; stage < PROF_STAGE_COUNT; stage++)
+    {
+        const prof_summary_t* s = &summary[stage];
+        print("  %-11s  %-8lu  %-8lu  %-8lu  %-8lu  %lu\r\n", names[stage],
+              (unsigned long)s->count, (unsigned long)s->min, (unsigned long)s->mean,
+              (unsigned long)s->max, (unsigned long)s->p99);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,22 @@
+/*
+* Real discrete Fourier transform (Takuya Ooura's split-radix fftsg package,
+* single precision) as used by the DEEPCRAFT generated models.
+*
+* Copyright(C) 1996-2001 Takuya OOURA
+* Copyright © 2023- Imagimob AB, All Rights Reserved.
+*/
+
+#ifndef RDFT_H_
+#define RDFT_H_
+
+/* Real DFT / inverse real DFT of a[0...n-1] in place.
+ *  n    : data length, power of 2
+ *  isgn : 1 for the forward transform, -1 for the inverse
+ *  ip   : work area for bit reversal, length >= 2+sqrt(n/2), ip[0] must be 0
+ *         before the first call
+ *  w    : cos/sin table, length n/2, initialized on the first call
+ * The output layout is Ooura's: a[0] = R[0], a[1] = R[n/2],
+ * a[2k] = R[k], a[2k+1] = I[k] with the sign convention of the original. */
+void rdft_f32(int n, int isgn, float *a, int *ip, float *w);
+
+#endif /* RDFT_H_ */
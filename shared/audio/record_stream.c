@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "record_stream.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: record_stream_init
+********************************************************************************
+* Summary:
+*  Sets up an empty ring over the sample buffer.
+*
+* Parameters:
+*  ring:          ring, in memory shared with the reader
+*  samples:       frames x frame_samples x channels samples, shared as well
+*  frames:        slots of the ring, at most RECORD_RING_FRAMES
+*  frame_samples: samples per channel of a frame
+*  channels:      interleaved channels of a frame
+*  sample_rate:   sample rate in Hz
+*
+* Return:
+*  RECORD_STREAM_RET_SUCCESS or RECORD_STREAM_RET_ERROR for a bad geometry
+*
+*******************************************************************************/
+int record_stream_init(record_ring_t* ring, int16_t* samples, uint32_t frames,
+                       uint32_t frame_samples, uint32_t channels, uint32_t sample_rate)
+{
+    if ((NULL == samples) || (0u == frames) || (frames > RECORD_RING_FRAMES) ||
+        (0u == frame_samples) || (0u == channels))
+    {
+        return RECORD_STREAM_RET_ERROR;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->samples = samples;
+    ring->frames = frames;
+    ring->frame_samples = frame_samples;
+    ring->channels = channels;
+    ring->sample_rate = sample_rate;
+
+    return RECORD_STREAM_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: record_stream_write
+********************************************************************************
+* Summary:
+*  Copies a frame into the next free slot. If the reader has not consumed
+*  the oldest frame yet, the new frame is dropped and counted as an overrun;
+*  its sequence number is skipped all the same.
+*
+* Parameters:
+*  ring: ring
+*  pcm:  frame_samples x channels interleaved samples
+*
+* Return:
+*  true if the frame was queued
+*
+*******************************************************************************/
+bool record_stream_write(record_ring_t* ring, const int16_t* pcm)
+{
+    const uint32_t sequence = ring->captured++;
+    const uint32_t written = ring->written;
+    uint32_t slot;
+
+    if ((written - ring->consumed) >= ring->frames)
+    {
+        ring->overruns = ring->overruns + 1u;
+        return false;
+    }
+
+    /* The reader is done with the slot once it has advanced consumed */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    slot = written % ring->frames;
+    memcpy(&ring->samples[(size_t)slot * ring->frame_samples * ring->channels], pcm,
+           (size_t)ring->frame_samples * ring->channels * sizeof(int16_t));
+    ring->sequence[slot] = sequence;
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->written = written + 1u;
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,144 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <math.h>
+#include "score_q.h"
+
+#if defined(COMPONENT_CM55)
+#include "arm_math.h"
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: score_q_init
+********************************************************************************
+* Summary:
+*  Takes the quantization of the model output and finds the int8 threshold:
+*  the smallest q with score_q_value(q) >= threshold.
+*
+* Parameters:
+*  sq:         quantized decision
+*  scale:      output scale of the model, > 0
+*  zero_point: output zero point of the model
+*  threshold:  score threshold
+*
+* Return:
+*  SCORE_Q_RET_SUCCESS or SCORE_Q_RET_ERROR
+*
+*******************************************************************************/
+int score_q_init(score_q_t* sq, float scale, int32_t zero_point, float threshold)
+{
+    sq->scale = scale;
+    sq->zero_point = zero_point;
+    sq->threshold = SCORE_Q_NEVER;
+    if (!(scale > 0.0f) || isinf(scale))
+    {
+        return SCORE_Q_RET_ERROR;
+    }
+
+    /* The scores grow with q, the first one at the threshold wins. A scan
+     * and not a division, so that rounding cannot move the boundary. */
+    for (int32_t q = INT8_MIN; q <= INT8_MAX; q++)
+    {
+        if (score_q_value(sq, (int8_t)q) >= threshold)
+        {
+            sq->threshold = (int16_t)q;
+            break;
+        }
+    }
+    return SCORE_Q_RET_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: score_q_argmax
+********************************************************************************
+* Summary:
+*  Index of the largest of count int8 scores, the first one on a tie.
+*
+*******************************************************************************/
+int score_q_argmax(const int8_t* q, int count)
+{
+    #if defined(COMPONENT_CM55)
+    q7_t max;
+    uint32_t index;
+
+    arm_max_q7((const q7_t*)q, (uint32_t)count, &max, &index);
+    return (int)index;
+    #else
+    int best = 0;
+
+    for (int i = 1; i < count; i++)
+    {
+        if (q[i] > q[best])
+        {
+            best = i;
+        }
+    }
+    return best;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: score_q_top_k
+********************************************************************************
+* Summary:
+*  Indices of the k largest of count int8 scores, best first, the lower
+*  index first on a tie.
+*
+* Parameters:
+*  q:     count scores
+*  count: scores
+*  index: k indices
+*  k:     wanted
+*
+* Return:
+*  indices written, the smaller of k and count
+*
+*******************************************************************************/
+int score_q_top_k(const int8_t* q, int count, int* index, int k)
+{
+    int n = 0;
+
+    k = (k < count) ? k : count;
+    for (int i = 0; i < count; i++)
+    {
+        int j = (n < k) ? n++ : k;
+
+        /* Insert behind every score that is not lower */
+        while ((j > 0) && (q[index[j - 1]] < q[i]))
+        {
+            if (j < k)
+            {
+                index[j] = index[j - 1];
+            }
+            j--;
+        }
+        if (j < k)
+        {
+            index[j] = i;
+        }
+    }
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: score_q_quantize
+********************************************************************************
+* Summary:
+*  Nearest int8 value of a score, for scores that did not come from the
+*  model, e.g. those of the early exit stage.
+*
+*******************************************************************************/
+int8_t score_q_quantize(const score_q_t* sq, float score)
+{
+    float q = roundf(score / sq->scale) + (float)sq->zero_point;
+
+    return (int8_t)((q > (float)INT8_MAX) ? INT8_MAX : (q < (float)INT8_MIN) ? INT8_MIN : q);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Decision on the int8 output of a model without dequantizing it.
+ *
+ * A score is (q - zero_point) * scale with a positive scale, so it grows
+ * with q and the argmax and the order of the scores are those of the int8
+ * values. score_q_init() turns a score threshold into the smallest q whose
+ * score reaches it, computed with the same float expression as the
+ * dequantization, so that score_q_above() decides exactly like a compare of
+ * the dequantized score. Only the scores that are reported are dequantized,
+ * with score_q_value().
+ *
+ * score_q_argmax() runs the Helium kernel of CMSIS-DSP on the CM55. Ties go
+ * to the lower index, like a scan with a strict compare.
+ */
+
+#ifndef SCORE_Q_H_
+#define SCORE_Q_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Threshold no int8 value reaches */
+#define SCORE_Q_NEVER               (INT8_MAX + 1)
+
+#define SCORE_Q_RET_SUCCESS         (0)
+#define SCORE_Q_RET_ERROR           (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float       scale;              /* Of the model output, > 0 */
+    int32_t     zero_point;
+    int16_t     threshold;          /* Smallest q at the score threshold, SCORE_Q_NEVER if none */
+} score_q_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int    score_q_init(score_q_t* sq, float scale, int32_t zero_point, float threshold);
+int    score_q_argmax(const int8_t* q, int count);
+int    score_q_top_k(const int8_t* q, int count, int* index, int k);
+int8_t score_q_quantize(const score_q_t* sq, float score);
+
+/*******************************************************************************
+* Inline Functions
+*******************************************************************************/
+static inline bool score_q_above(const score_q_t* sq, int8_t q)
+{
+    return (int16_t)q >= sq->threshold;
+}
+
+static inline float score_q_value(const score_q_t* sq, int8_t q)
+{
+    return (float)((int32_t)q - sq->zero_point) * sq->scale;
+}
+
+#endif /* SCORE_Q_H_ */
@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Health of the audio input, to spot dying microphones and mis-tuned gain.
+ *
+ * audio_health_frame() takes every raw PDM frame before any processing and
+ * adds up per microphone the sum (DC offset), the sum of squares (RMS), the
+ * peak and the samples at full scale. The quietest frame of a period gives
+ * the noise floor. On the CM55 a one microphone frame costs three Helium
+ * kernels of CMSIS-DSP; the samples at full scale are only counted when the
+ * peak reached it.
+ *
+ * The CM55 adds the FIFO errors counted in the PDM interrupt and the samples
+ * the AGC soft limited, sends the report to the CM33 every
+ * AUDIO_HEALTH_PERIOD_MS and the CM33 publishes it as telemetry.
+ *
+ * Built with APP_AUDIO_HEALTH, AUDIO_HEALTH=1 in common.mk.
+ */
+
+#ifndef AUDIO_HEALTH_H_
+#define AUDIO_HEALTH_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Period of the reports */
+#ifndef AUDIO_HEALTH_PERIOD_MS
+#define AUDIO_HEALTH_PERIOD_MS      (10000u)
+#endif
+
+/* Magnitude from which a sample counts as clipped */
+#ifndef AUDIO_HEALTH_CLIP_LEVEL
+#define AUDIO_HEALTH_CLIP_LEVEL     (32767)
+#endif
+
+/* Levels of silence, a dead microphone reads this instead of minus infinity */
+#define AUDIO_HEALTH_MIN_DBFS       (-120.0f)
+
+#define AUDIO_HEALTH_MAX_CHANNELS   (2u)
+
+/* Keep AUDIO_HEALTH_FIFO_NAMES in the same order */
+#define AUDIO_HEALTH_FIFO_NAMES     { "rx_overflow", "fir_overflow", "if_overflow", "underflow" }
+
+#define AUDIO_HEALTH_RET_SUCCESS    (0)
+#define AUDIO_HEALTH_RET_ERROR      (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Error interrupts of the PDM PCM block */
+typedef enum
+{
+    AUDIO_HEALTH_FIFO_RX_OVERFLOW = 0,  /* RX FIFO full, samples lost */
+    AUDIO_HEALTH_FIFO_FIR_OVERFLOW,     /* Decimation filter saturated */
+    AUDIO_HEALTH_FIFO_IF_OVERFLOW,      /* Interface, PDM data lost */
+    AUDIO_HEALTH_FIFO_UNDERFLOW,        /* RX FIFO read while empty */
+    AUDIO_HEALTH_FIFO_COUNT
+} audio_health_fifo_t;
+
+typedef struct
+{
+    int64_t     sum;
+    uint64_t    power;              /* Sum of squares */
+    uint64_t    min_frame_power;    /* Of the quietest frame */
+    uint32_t    min_frame_samples;
+    uint32_t    peak;
+    uint32_t    clipped;
+} audio_health_channel_t;
+
+typedef struct
+{
+    uint32_t                channels;
+    uint32_t                frames;
+    uint32_t                samples;            /* Per channel */
+    audio_health_channel_t  ch[AUDIO_HEALTH_MAX_CHANNELS];
+} audio_health_t;
+
+/* Result of a period, levels in dB relative to full scale */
+typedef struct
+{
+    float       rms_dbfs;
+    float       floor_dbfs;         /* RMS of the quietest frame */
+    float       peak_dbfs;
+    float       dc_offset;          /* Mean, relative to full scale */
+    uint32_t    clipped;            /* Samples at AUDIO_HEALTH_CLIP_LEVEL */
+} audio_health_channel_report_t;
+
+typedef struct
+{
+    uint32_t                        period_ms;
+    uint32_t                        samples;        /* Per channel */
+    uint32_t                        channels;
+    audio_health_channel_report_t   ch[AUDIO_HEALTH_MAX_CHANNELS];
+    uint32_t                        fifo[AUDIO_HEALTH_FIFO_COUNT];  /* Errors in the period */
+    uint32_t                        agc_limited;    /* Samples the AGC soft limited */
+} audio_health_report_t;
+
+/* printf compatible sink for audio_health_print() */
+typedef int (*audio_health_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  audio_health_init(audio_health_t* health, uint32_t channels);
+void audio_health_frame(audio_health_t* health, const int16_t* pcm, uint32_t count);
+void audio_health_summarize(const audio_health_t* health, uint32_t sample_rate, audio_health_report_t* report);
+void audio_health_reset(audio_health_t* health);
+void audio_health_print(const audio_health_report_t* report, audio_health_print_fn print);
+
+#endif /* AUDIO_HEALTH_H_ */
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Free running cycle counter used for the processing budgets.
+ *
+ * On the target this is the DWT cycle counter of the running core. Host builds
+ * (no COMPONENT_CM33/COMPONENT_CM55) count nanoseconds of the monotonic clock
+ * instead, so the numbers are comparable between runs but not with the target.
+ * The counter wraps; always compare differences of two uint32_t readings.
+ */
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include <stdint.h>
+
+#if defined(COMPONENT_CM55) || defined(COMPONENT_CM33)
+
+#include "cybsp.h"
+
+static inline void cycle_counter_init(void)
+{
+#if defined(DCB)
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else
+
+#include <time.h>
+
+static inline void cycle_counter_init(void)
+{
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+#endif /* COMPONENT_CM55 || COMPONENT_CM33 */
+
+#endif /* CYCLE_COUNTER_H_ */
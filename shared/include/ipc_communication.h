@@ -53,12 +53,19 @@
 #include "cybsp.h"
 #include "cy_pdl.h"
 #include "cy_ipc_pipe.h"
+#include "prof.h"
+#include "record_stream.h"
+#include "log_stream.h"
+#include "rt_stats.h"
+#include "latency_trace.h"
+#include "audio_health.h"
+#include "model_profile.h"
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
 #define CY_IPC_MAX_ENDPOINTS            (5UL)
-#define CY_IPC_CYPIPE_CLIENT_CNT        (8UL)
+#define CY_IPC_CYPIPE_CLIENT_CNT        (12UL)
 
 #define CY_IPC_CHAN_CYPIPE_EP1          (4UL)
 #define CY_IPC_INTR_CYPIPE_EP1          (4UL)
@@ -72,6 +79,13 @@
 #define CY_IPC_INTR_CYPIPE_MUX_EP1      (CY_IPC0_INTR_MUX(CY_IPC_INTR_CYPIPE_EP1))
 #define CM33_IPC_PIPE_EP_ADDR           (1UL)
 #define CM33_IPC_PIPE_CLIENT_ID         (3UL)
+#define CM33_IPC_PIPE_DIAG_CLIENT_ID    (4UL)
+#define CM33_IPC_PIPE_CLIP_CLIENT_ID    (6UL)
+#define CM33_IPC_PIPE_RECORD_CLIENT_ID  (7UL)
+#define CM33_IPC_PIPE_LOG_CLIENT_ID     (8UL)
+#define CM33_IPC_PIPE_RT_STATS_CLIENT_ID (9UL)
+#define CM33_IPC_PIPE_HEALTH_CLIENT_ID  (10UL)
+#define CM33_IPC_PIPE_MODEL_PROFILE_CLIENT_ID (11UL)
 
 /* IPC Pipe Endpoint-2 config */
 #define CY_IPC_CYPIPE_CHAN_MASK_EP2     CY_IPC_CH_MASK(CY_IPC_CHAN_CYPIPE_EP2)
@@ -93,8 +107,20 @@ typedef struct {
     uint32_t    label_id;
     char        label[256];
     float       confidence;
+    float       agc_gain_db;    /* Input gain of the CM55 AGC */
+    uint32_t    windows;        /* Model windows so far */
+    uint32_t    model_runs;     /* Of those classified by the model, the rest exited early */
+    uint32_t    audio_ms;       /* Audio processed up to the window */
+    latency_trace_t trace;      /* Stamped up to LATENCY_STAMP_RESULT by the CM55 */
 } ipc_payload_t;
 
+/* First members of every message below, which the pipe reads */
+typedef struct
+{
+    uint8_t         client_id;
+    uint16_t        intr_mask;
+} ipc_msg_header_t;
+
 /* IPC Message structure */
 /* Pointer to this structure will be shared through IPC Pipe */
 typedef struct
@@ -104,6 +130,85 @@ typedef struct
     ipc_payload_t   payload;
 } ipc_msg_t;
 
+/* Diagnostics of the CM55, sent periodically when profiling is enabled */
+typedef struct {
+    uint32_t        core_clock_hz;  /* Counter ticks per second */
+    uint32_t        period_ms;      /* Period the statistics cover */
+    prof_summary_t  stages[PROF_STAGE_COUNT];
+} ipc_diag_payload_t;
+
+typedef struct
+{
+    uint8_t             client_id; /* This must be a part of the IPC structure */
+    uint16_t            intr_mask; /* This must be a part of the IPC structure */
+    ipc_diag_payload_t  payload;
+} ipc_diag_msg_t;
+
+/* Audio clip around a detection, frozen in the CM55 ring in shared memory.
+ * The samples are length 16 bit PCM samples from index start of the ring,
+ * wrapping at capacity. The ring stays frozen until the CM33 releases it. */
+typedef struct {
+    const int16_t*  samples;
+    uint32_t        capacity;
+    uint32_t        start;
+    uint32_t        length;
+    uint32_t        sample_rate;
+    uint32_t        trigger;        /* Samples from the clip start to the detection */
+    uint32_t        sequence;       /* Clip number, from 1 */
+    uint32_t        dropped;        /* Detections without a clip so far */
+    uint32_t        label_id;
+    float           confidence;
+} ipc_clip_payload_t;
+
+typedef struct
+{
+    uint8_t             client_id; /* This must be a part of the IPC structure */
+    uint16_t            intr_mask; /* This must be a part of the IPC structure */
+    ipc_clip_payload_t  payload;
+    volatile uint32_t   released;  /* Set by the CM33 when done with the samples */
+} ipc_clip_msg_t;
+
+/* Announces the raw audio ring of the recording mode, sent once */
+typedef struct
+{
+    uint8_t             client_id; /* This must be a part of the IPC structure */
+    uint16_t            intr_mask; /* This must be a part of the IPC structure */
+    record_ring_t*      ring;      /* In CM55 shared memory */
+} ipc_record_msg_t;
+
+/* Announces the log stream of the CM55 and asks for the time of the CM33,
+ * sent again for every clock synchronization */
+typedef struct
+{
+    uint8_t             client_id; /* This must be a part of the IPC structure */
+    uint16_t            intr_mask; /* This must be a part of the IPC structure */
+    log_stream_t*       stream;    /* In CM55 shared memory */
+} ipc_log_msg_t;
+
+/* Task and heap statistics of the CM55, sent every RT_STATS_PERIOD_MS */
+typedef struct
+{
+    uint8_t             client_id; /* This must be a part of the IPC structure */
+    uint16_t            intr_mask; /* This must be a part of the IPC structure */
+    rt_stats_t          payload;
+} ipc_rt_stats_msg_t;
+
+/* Audio input health of the CM55, sent every AUDIO_HEALTH_PERIOD_MS */
+typedef struct
+{
+    uint8_t                 client_id; /* This must be a part of the IPC structure */
+    uint16_t                intr_mask; /* This must be a part of the IPC structure */
+    audio_health_report_t   payload;
+} ipc_health_msg_t;
+
+/* Operator profile of the CM55 model, sent once after boot */
+typedef struct
+{
+    uint8_t                 client_id; /* This must be a part of the IPC structure */
+    uint16_t                intr_mask; /* This must be a part of the IPC structure */
+    model_profile_report_t  payload;
+} ipc_model_profile_msg_t;
+
 /*******************************************************************************
 * Function prototypes
 *******************************************************************************/
@@ -122,8 +227,41 @@ void cm33_ipc_safe_copy_last_payload(ipc_payload_t* target);
    */
 bool cm33_ipc_safe_get_and_clear_cached_detection(ipc_payload_t* target);
 
-/* App functions for cm55 */
-ipc_payload_t* cm55_ipc_get_payload_ptr(void);
-void cm55_ipc_send_to_cm33(void);
+/* Returns true and copies the diagnostics if new ones arrived since the last call */
+bool cm33_ipc_safe_get_and_clear_diagnostics(ipc_diag_payload_t* target);
+
+/* Returns true and copies the clip if a new one arrived since the last call.
+ * The samples stay valid until cm33_ipc_release_clip(). */
+bool cm33_ipc_safe_get_and_clear_clip(ipc_clip_payload_t* target);
+void cm33_ipc_release_clip(void);
+
+/* Raw audio ring of the recording mode, NULL until the CM55 announced it */
+record_ring_t* cm33_ipc_get_record_ring(void);
+
+/* Log records of the CM55, NULL until the CM55 announced them */
+log_stream_t* cm33_ipc_get_log_stream(void);
+
+/* Returns true and copies the statistics if new ones arrived since the last call */
+bool cm33_ipc_safe_get_and_clear_rt_stats(rt_stats_t* target);
+
+/* Returns true and copies the report if a new one arrived since the last call */
+bool cm33_ipc_safe_get_and_clear_audio_health(audio_health_report_t* target);
+
+/* Returns true and copies the report if it arrived since the last call */
+bool cm33_ipc_safe_get_and_clear_model_profile(model_profile_report_t* target);
+
+/* App functions for cm55. The senders return false if the pipe is busy with
+ * the previous message; the caller retries later. */
+bool cm55_ipc_send_to_cm33(const ipc_payload_t* payload);
+bool cm55_ipc_send_diag_to_cm33(const ipc_diag_payload_t* diag);
+bool cm55_ipc_send_clip_to_cm33(const ipc_clip_payload_t* clip);
+bool cm55_ipc_send_record_to_cm33(record_ring_t* ring);
+bool cm55_ipc_send_log_to_cm33(log_stream_t* stream);
+bool cm55_ipc_send_rt_stats_to_cm33(const rt_stats_t* stats);
+bool cm55_ipc_send_audio_health_to_cm33(const audio_health_report_t* report);
+bool cm55_ipc_send_model_profile_to_cm33(const model_profile_report_t* report);
+
+/* Returns true once the CM33 released the last clip sent */
+bool cm55_ipc_clip_released(void);
 
 #endif /* SOURCE_IPC_COMMUNICATION_H */
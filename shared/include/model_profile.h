@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Operator level profile of the TFLM graph of a model.
+ *
+ * model_profile_init() walks the TFLite flatbuffer of the model and lists the
+ * operators of its main subgraph in execution order, each with its name and
+ * where it runs: the custom ethos-u operator of a Vela compiled model on the
+ * NPU, every other operator on the CPU as a fallback. This needs no runtime
+ * and also works on the host, on the linked model or an exported .tflite.
+ *
+ * With APP_MODEL_PROFILE (MODEL_PROFILE=1 in common.mk) the CM55
+ * runs the model MODEL_PROFILE_RUNS times at boot in a TFLM interpreter of
+ * its own with a micro profiler attached, model_profile_run(), which records
+ * the cycles of every operator and of every inference and the arena the
+ * interpreter used. The mtb-ml runtime of the application builds its
+ * interpreter internally, so the profiling interpreter borrows the arena of
+ * the model instance before that is initialized. The report is sent to the
+ * CM33 once, which logs it and publishes it as telemetry.
+ */
+
+#ifndef MODEL_PROFILE_H_
+#define MODEL_PROFILE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Operators with statistics, the rest is only counted */
+#define MODEL_PROFILE_MAX_OPS       (32u)
+
+/* Operator names longer than this are truncated */
+#define MODEL_PROFILE_NAME_SIZE     (20u)
+
+/* Inferences of the boot time profile */
+#ifndef MODEL_PROFILE_RUNS
+#define MODEL_PROFILE_RUNS          (20u)
+#endif
+
+/* Custom operator of Vela, runs the command stream on the Ethos-U */
+#define MODEL_PROFILE_NPU_OP        "ethos-u"
+
+#define MODEL_PROFILE_RET_SUCCESS   (0)
+#define MODEL_PROFILE_RET_ERROR     (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Operator of the graph, cycles per invocation */
+typedef struct
+{
+    char        name[MODEL_PROFILE_NAME_SIZE];  /* TFLM name, e.g. CONV_2D */
+    uint32_t    npu;                /* 1 on the NPU, 0 on the CPU */
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    mean;
+    uint32_t    max;
+} model_profile_op_t;
+
+typedef struct
+{
+    uint32_t            core_clock_hz;  /* Counter ticks per second */
+    uint32_t            weights_size;   /* Bytes of the flatbuffer */
+    uint32_t            arena_size;     /* Bytes allocated */
+    uint32_t            arena_used;     /* Bytes the interpreter used, 0 if not run */
+    uint32_t            op_count;       /* Operators of the graph */
+    uint32_t            npu_ops;        /* Of those on the NPU */
+    uint32_t            runs;           /* Inferences measured */
+    uint32_t            inference_min;  /* Cycles of Invoke() */
+    uint32_t            inference_mean;
+    uint32_t            inference_max;
+    model_profile_op_t  ops[MODEL_PROFILE_MAX_OPS];
+} model_profile_report_t;
+
+/* Accumulates the measurements of model_profile_run() */
+typedef struct
+{
+    model_profile_report_t  report;     /* Means are set by model_profile_summarize() */
+    uint64_t                op_total[MODEL_PROFILE_MAX_OPS];
+    uint64_t                inference_total;
+} model_profile_t;
+
+/* printf compatible sink for model_profile_print() */
+typedef int (*model_profile_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  model_profile_init(model_profile_t* prof, const uint8_t* model, uint32_t model_size, uint32_t arena_size);
+void model_profile_op(model_profile_t* prof, uint32_t index, uint32_t cycles);
+void model_profile_inference(model_profile_t* prof, uint32_t cycles);
+void model_profile_summarize(model_profile_t* prof);
+void model_profile_print(const model_profile_report_t* report, model_profile_print_fn print);
+
+/* TFLM interpreter with the micro profiler, CM55 with APP_MODEL_PROFILE only.
+ * The arena must not be in use; its contents are lost. */
+int  model_profile_run(model_profile_t* prof, const uint8_t* model, uint8_t* arena, uint32_t runs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MODEL_PROFILE_H_ */
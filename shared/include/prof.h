@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Stage profiler of the audio pipeline.
+ *
+ * The hooks measure a stage with the cycle counter of cycle_counter.h and
+ * accumulate count, min, max, sum and a log2 histogram per stage, from which
+ * the mean and the 99th percentile are derived. The 99th percentile is the
+ * upper bound of its histogram bucket (a quarter octave), so it overestimates
+ * by at most 25%.
+ *
+ * The hooks compile to nothing unless APP_PROFILING is defined (PROFILING=1 in
+ * proj_cm55/Makefile). Each stage must be recorded from one context only; the
+ * PDM ISR owns PROF_STAGE_PDM_ISR, the inference task PROF_STAGE_INFERENCE
+ * with AUDIO_ASYNC_INFERENCE, the audio task all others.
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include <stdint.h>
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Keep PROF_STAGE_NAMES in the same order */
+typedef enum
+{
+    PROF_STAGE_PDM_ISR = 0,         /* pdm_pcm_event_handler() */
+    PROF_STAGE_BEAMFORM,            /* Two microphone beamformer of one hop */
+    PROF_STAGE_PCM_CONVERT,         /* int16 to float, DC blocker and AGC of one hop */
+    PROF_STAGE_HANN,                /* Front end kernels of one frame */
+    PROF_STAGE_FFT,
+    PROF_STAGE_NORM,
+    PROF_STAGE_DENOISE,             /* Noise suppression, only with AUDIO_DENOISE */
+    PROF_STAGE_MEL,
+    PROF_STAGE_CLIP,
+    PROF_STAGE_LN,
+    PROF_STAGE_ENQUEUE,             /* Model feature window, per frame */
+    PROF_STAGE_WINDOW,              /* Model feature window, per inference */
+    PROF_STAGE_INFERENCE,           /* Quantization, NPU and dequantization */
+    PROF_STAGE_FRAME,               /* pdm_data_process() of one PDM frame */
+    PROF_STAGE_COUNT
+} prof_stage_t;
+
+/* Result of one stage over a reporting period, in counter ticks */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    mean;
+    uint32_t    max;
+    uint32_t    p99;
+} prof_summary_t;
+
+/* printf compatible sink for prof_print() */
+typedef int (*prof_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PROF_STAGE_NAMES            { "pdm_isr", "beamform", "pcm_convert", "hann", "fft", "norm", \
+                                      "denoise", "mel", "clip", "ln", "enqueue", "window", "inference", \
+                                      "frame" }
+
+#ifdef APP_PROFILING
+/* Starts a measurement into the local variable t */
+#define PROF_BEGIN(t)               uint32_t t = cycle_counter_get()
+/* Records the time since t to stage */
+#define PROF_END(t, stage)          prof_record((stage), cycle_counter_get() - (t))
+/* Records the time since t to stage and restarts t for the next stage */
+#define PROF_LAP(t, stage)          do { uint32_t prof_now_ = cycle_counter_get(); \
+                                         prof_record((stage), prof_now_ - (t)); \
+                                         (t) = prof_now_; } while (0)
+#else
+#define PROF_BEGIN(t)
+#define PROF_END(t, stage)
+#define PROF_LAP(t, stage)
+#endif /* APP_PROFILING */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void prof_record(prof_stage_t stage, uint32_t ticks);
+void prof_summarize(prof_summary_t summary[PROF_STAGE_COUNT]);
+void prof_reset(void);
+void prof_print(const prof_summary_t summary[PROF_STAGE_COUNT], prof_print_fn print);
+
+#endif /* PROF_H_ */
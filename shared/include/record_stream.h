@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Raw audio stream of the recording mode, from the CM55 to the CM33.
+ *
+ * A ring of whole PDM frames in shared memory with one writer, the CM55
+ * (record_stream_write() in shared/audio/record_stream.c), and one reader,
+ * the CM33 (record_stream_peek() and record_stream_consume() below). The
+ * reader sends a frame straight from its slot and the writer never touches
+ * a slot that was not consumed yet: a frame that finds the ring full is
+ * dropped and counted as an overrun. Every frame carries its capture
+ * sequence number, so the receiver sees the drops as gaps.
+ */
+
+#ifndef RECORD_STREAM_H_
+#define RECORD_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frames of the ring, 1 s of 1024 sample frames at 16 kHz */
+#ifndef RECORD_RING_FRAMES
+#define RECORD_RING_FRAMES          (16u)
+#endif
+
+#define RECORD_STREAM_RET_SUCCESS   (0)
+#define RECORD_STREAM_RET_ERROR     (-2)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    int16_t*            samples;        /* frames x frame_samples x channels, interleaved */
+    uint32_t            frames;
+    uint32_t            frame_samples;  /* Samples per channel of a frame */
+    uint32_t            channels;
+    uint32_t            sample_rate;
+    uint32_t            captured;       /* Frames offered to the ring, by the writer */
+    volatile uint32_t   written;        /* Frames in the ring so far, by the writer */
+    volatile uint32_t   consumed;       /* Frames sent so far, by the reader */
+    volatile uint32_t   overruns;       /* Frames dropped for a full ring, by the writer */
+    volatile uint32_t   sequence[RECORD_RING_FRAMES];
+} record_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  record_stream_init(record_ring_t* ring, int16_t* samples, uint32_t frames,
+                        uint32_t frame_samples, uint32_t channels, uint32_t sample_rate);
+bool record_stream_write(record_ring_t* ring, const int16_t* pcm);
+
+/* Oldest frame not sent yet and its sequence number, NULL if there is none.
+ * The frame stays valid until record_stream_consume(). */
+static inline const int16_t* record_stream_peek(const record_ring_t* ring, uint32_t* sequence)
+{
+    uint32_t consumed = ring->consumed;
+    uint32_t slot;
+
+    if (consumed == ring->written)
+    {
+        return NULL;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    slot = consumed % ring->frames;
+    *sequence = ring->sequence[slot];
+    return &ring->samples[(size_t)slot * ring->frame_samples * ring->channels];
+}
+
+static inline void record_stream_consume(record_ring_t* ring)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->consumed = ring->consumed + 1u;
+}
+
+/* Discards the frames in the ring, while there is nobody to send them to */
+static inline void record_stream_skip(record_ring_t* ring)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->consumed = ring->written;
+}
+
+#endif /* RECORD_STREAM_H_ */
@@ -0,0 +1,559 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "app_log.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define APP_LOG_RING_MASK           (APP_LOG_RING_SIZE - 1u)
+#define APP_LOG_SPEC_SIZE           (24u)
+#define APP_LOG_NO_TEXT             (0xFFFFu)
+
+#if (0u != (APP_LOG_RING_SIZE & APP_LOG_RING_MASK))
+#error "APP_LOG_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Argument classes of a conversion, by the type va_arg() has to read */
+typedef enum
+{
+    APP_LOG_ARG_NONE = 0,       /* %% */
+    APP_LOG_ARG_INT,
+    APP_LOG_ARG_LONG,
+    APP_LOG_ARG_LLONG,
+    APP_LOG_ARG_SIZE,
+    APP_LOG_ARG_DOUBLE,
+    APP_LOG_ARG_LDOUBLE,
+    APP_LOG_ARG_STRING,
+    APP_LOG_ARG_POINTER
+} app_log_arg_class_t;
+
+/* One conversion of a format */
+typedef struct
+{
+    const char*         start;  /* The '%' */
+    uint32_t            length;
+    app_log_arg_class_t arg;
+    uint8_t             stars;  /* Width and precision given as int arguments */
+} app_log_spec_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static app_log_record_t log_ring[APP_LOG_RING_SIZE];
+static uint32_t log_enqueue;
+static uint32_t log_dequeue;
+static app_log_port_t log_port;
+static volatile app_log_level_t log_level;
+static volatile bool log_ready;
+static app_log_stats_t log_stats;
+static uint32_t log_reported_drops;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: app_log_init
+********************************************************************************
+* Summary:
+*  Empties the ring and sets the output. Records logged before are dropped.
+*
+* Parameters:
+*  port:  clock and output of the platform
+*  level: most verbose level recorded, see also APP_LOG_MAX_LEVEL
+*
+*******************************************************************************/
+void app_log_init(const app_log_port_t* port, app_log_level_t level)
+{
+    for (uint32_t i = 0; i < APP_LOG_RING_SIZE; i++)
+    {
+        log_ring[i].sequence = i;
+    }
+    log_enqueue = 0u;
+    log_dequeue = 0u;
+    log_port = *port;
+    log_level = level;
+    __atomic_store_n(&log_ready, true, __ATOMIC_RELEASE);
+}
+
+void app_log_set_level(app_log_level_t level)
+{
+    log_level = level;
+}
+
+/* Finds the next conversion of a format, NULL at its end */
+static const char* app_log_next_spec(const char* format, app_log_spec_t* spec)
+{
+    const char* f = strchr(format, '%');
+    uint32_t longs = 0u;
+
+    if (NULL == f)
+    {
+        return NULL;
+    }
+    spec->start = f++;
+    spec->stars = 0u;
+    spec->arg = APP_LOG_ARG_INT;
+
+    while ((NULL != strchr("-+ #0", *f)) && ('\0' != *f))
+    {
+        f++;
+    }
+    for (uint32_t part = 0; part < 2u; part++)
+    {
+        if ('*' == *f)
+        {
+            spec->stars++;
+            f++;
+        }
+        while ((*f >= '0') && (*f <= '9'))
+        {
+            f++;
+        }
+        if ((0u == part) && ('.' == *f))
+        {
+            f++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    for (;; f++)
+    {
+        if ('l' == *f)
+        {
+            longs++;
+        }
+        else if (('j' == *f) || ('q' == *f))
+        {
+            longs = 2u;
+        }
+        else if (('z' == *f) || ('t' == *f))
+        {
+            spec->arg = APP_LOG_ARG_SIZE;
+        }
+        else if ('L' == *f)
+        {
+            spec->arg = APP_LOG_ARG_LDOUBLE;
+        }
+        else if ('h' != *f)
+        {
+            break;
+        }
+    }
+
+    switch (*f)
+    {
+        case '%':
+            spec->arg = APP_LOG_ARG_NONE;
+            break;
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            if (APP_LOG_ARG_SIZE != spec->arg)
+            {
+                spec->arg = (0u == longs) ? APP_LOG_ARG_INT :
+                            (1u == longs) ? APP_LOG_ARG_LONG : APP_LOG_ARG_LLONG;
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec->arg = (APP_LOG_ARG_LDOUBLE == spec->arg) ? APP_LOG_ARG_LDOUBLE : APP_LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            spec->arg = APP_LOG_ARG_STRING;
+            break;
+        case 'p':
+            spec->arg = APP_LOG_ARG_POINTER;
+            break;
+        case '\0':
+            /* A '%' at the end, printed as is */
+            spec->arg = APP_LOG_ARG_NONE;
+            spec->length = (uint32_t)(f - spec->start);
+            return f;
+        default:
+            /* %n and unknown conversions take no argument here */
+            spec->arg = APP_LOG_ARG_NONE;
+            break;
+    }
+    f++;
+    spec->length = (uint32_t)(f - spec->start);
+    return f;
+}
+
+/* Copies a %s argument into the record, returns its offset */
+static uint16_t app_log_copy_text(app_log_record_t* record, uint32_t* used, const char* text)
+{
+    uint32_t offset = *used;
+    uint32_t length;
+
+    if (offset >= APP_LOG_TEXT_SIZE)
+    {
+        return APP_LOG_NO_TEXT;
+    }
+    text = (NULL != text) ? text : "(null)";
+    length = (uint32_t)strnlen(text, APP_LOG_TEXT_SIZE - offset - 1u);
+    memcpy(&record->text[offset], text, length);
+    record->text[offset + length] = '\0';
+    *used = offset + length + 1u;
+    return (uint16_t)offset;
+}
+
+/* Stores the arguments of the format, up to APP_LOG_MAX_ARGS */
+static void app_log_capture(app_log_record_t* record, const char* format, va_list args)
+{
+    app_log_spec_t spec;
+    uint32_t argc = 0u;
+    uint32_t used = 0u;
+
+    while ((NULL != (format = app_log_next_spec(format, &spec))))
+    {
+        if (APP_LOG_ARG_NONE == spec.arg)
+        {
+            continue;
+        }
+        if (argc + spec.stars + 1u > APP_LOG_MAX_ARGS)
+        {
+            break;
+        }
+        for (uint32_t i = 0; i < spec.stars; i++)
+        {
+            record->args[argc++].i = va_arg(args, int);
+        }
+
+        app_log_arg_t* arg = &record->args[argc++];
+        switch (spec.arg)
+        {
+            case APP_LOG_ARG_LONG:    arg->i = va_arg(args, long); break;
+            case APP_LOG_ARG_LLONG:   arg->i = va_arg(args, long long); break;
+            case APP_LOG_ARG_SIZE:    arg->i = (int64_t)va_arg(args, size_t); break;
+            case APP_LOG_ARG_DOUBLE:  arg->d = va_arg(args, double); break;
+            case APP_LOG_ARG_LDOUBLE: arg->d = (double)va_arg(args, long double); break;
+            case APP_LOG_ARG_STRING:  arg->text = app_log_copy_text(record, &used, va_arg(args, const char*)); break;
+            case APP_LOG_ARG_POINTER: arg->p = va_arg(args, const void*); break;
+            default:                  arg->i = va_arg(args, int); break;
+        }
+    }
+    record->argc = (uint8_t)argc;
+}
+
+static bool app_log_record(app_log_level_t level, const char* format, va_list args)
+{
+    app_log_record_t* record;
+    uint32_t pos;
+
+    if (!__atomic_load_n(&log_ready, __ATOMIC_ACQUIRE))
+    {
+        __atomic_fetch_add(&log_stats.dropped, 1u, __ATOMIC_RELAXED);
+        return false;
+    }
+    if (level > log_level)
+    {
+        __atomic_fetch_add(&log_stats.filtered, 1u, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    /* Claim a free cell: its sequence equals the position while it is free */
+    pos = __atomic_load_n(&log_enqueue, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        record = &log_ring[pos & APP_LOG_RING_MASK];
+        int32_t diff = (int32_t)(__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) - pos);
+        if (0 == diff)
+        {
+            if (__atomic_compare_exchange_n(&log_enqueue, &pos, pos + 1u, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            __atomic_fetch_add(&log_stats.dropped, 1u, __ATOMIC_RELAXED);
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&log_enqueue, __ATOMIC_RELAXED);
+        }
+    }
+
+    record->timestamp = log_port.now_ms();
+    record->format = format;
+    record->level = (uint8_t)level;
+    record->core = (uint8_t)log_port.core;
+    app_log_capture(record, format, args);
+
+    __atomic_store_n(&record->sequence, pos + 1u, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&log_stats.logged, 1u, __ATOMIC_RELAXED);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: app_log
+********************************************************************************
+* Summary:
+*  Queues a message for the drain. Safe from any task and interrupt, never
+*  blocks.
+*
+* Parameters:
+*  level:  level of the message
+*  format: printf format, kept by pointer
+*
+* Return:
+*  false if the message was dropped or filtered
+*
+*******************************************************************************/
+bool app_log(app_log_level_t level, const char* format, ...)
+{
+    va_list args;
+    bool ret;
+
+    va_start(args, format);
+    ret = app_log_record(level, format, args);
+    va_end(args);
+    return ret;
+}
+
+int app_log_printf(const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    (void)app_log_record(APP_LOG_LEVEL_INFO, format, args);
+    va_end(args);
+    return 0;
+}
+
+int app_log_vprintf(const char* format, va_list args)
+{
+    (void)app_log_record(APP_LOG_LEVEL_INFO, format, args);
+    return 0;
+}
+
+/* Timestamp, core and level in front of every line */
+static int app_log_prefix(char* line, uint32_t size, uint32_t timestamp, uint32_t core, uint32_t level)
+{
+    static const char* const cores[] = { "cm33", "cm55" };
+    static const char levels[] = "EWID";
+
+    return snprintf(line, size, "[%5lu.%03lu] %s %c ", (unsigned long)(timestamp / 1000u),
+                    (unsigned long)(timestamp % 1000u), cores[core & 1u], levels[level & 3u]);
+}
+
+/*******************************************************************************
+* Function Name: app_log_format
+********************************************************************************
+* Summary:
+*  Formats a record into one line that ends with a newline.
+*
+* Parameters:
+*  record: record of the ring or of a log_stream_t
+*  line:   output
+*  size:   size of line, APP_LOG_LINE_SIZE is enough
+*
+* Return:
+*  Length of the line
+*
+*******************************************************************************/
+uint32_t app_log_format(const app_log_record_t* record, char* line, uint32_t size)
+{
+    const char* format = record->format;
+    const char* next;
+    app_log_spec_t spec;
+    uint32_t argc = 0u;
+    int length;
+
+    length = app_log_prefix(line, size, record->timestamp, record->core, record->level);
+
+    while (((uint32_t)length < size) && (NULL != (next = app_log_next_spec(format, &spec))))
+    {
+        char conversion[APP_LOG_SPEC_SIZE];
+        uint32_t literal = (uint32_t)(spec.start - format);
+        int star[2] = { 0, 0 };
+        char* out = &line[length];
+        uint32_t room = size - (uint32_t)length;
+        int n;
+
+        literal = (literal < room) ? literal : room - 1u;
+        memcpy(out, format, literal);
+        out += literal;
+        room -= literal;
+        length += (int)literal;
+        format = next;
+
+        if ((spec.length > 1u) && ('%' == spec.start[spec.length - 1u]))
+        {
+            n = snprintf(out, room, "%%");
+            length += (n > 0) ? n : 0;
+            continue;
+        }
+        if ((APP_LOG_ARG_NONE == spec.arg) || (argc + spec.stars + 1u > record->argc) ||
+            (spec.length >= APP_LOG_SPEC_SIZE))
+        {
+            /* Unsupported, or its argument was cut off: the conversion as written */
+            n = snprintf(out, room, "%.*s", (int)spec.length, spec.start);
+            length += (n > 0) ? n : 0;
+            continue;
+        }
+
+        memcpy(conversion, spec.start, spec.length);
+        conversion[spec.length] = '\0';
+        if (APP_LOG_ARG_LDOUBLE == spec.arg)
+        {
+            char* l = strchr(conversion, 'L');
+            memmove(l, l + 1, strlen(l));
+        }
+        for (uint32_t i = 0; i < spec.stars; i++)
+        {
+            star[i] = (int)record->args[argc++].i;
+        }
+
+        const app_log_arg_t* arg = &record->args[argc++];
+        #define APP_LOG_FORMAT(value) \
+            ((0u == spec.stars) ? snprintf(out, room, conversion, value) : \
+             (1u == spec.stars) ? snprintf(out, room, conversion, star[0], value) : \
+                                  snprintf(out, room, conversion, star[0], star[1], value))
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wformat-nonliteral"
+        switch (spec.arg)
+        {
+            case APP_LOG_ARG_LONG:    n = APP_LOG_FORMAT((long)arg->i); break;
+            case APP_LOG_ARG_LLONG:   n = APP_LOG_FORMAT((long long)arg->i); break;
+            case APP_LOG_ARG_SIZE:    n = APP_LOG_FORMAT((size_t)arg->i); break;
+            case APP_LOG_ARG_DOUBLE:
+            case APP_LOG_ARG_LDOUBLE: n = APP_LOG_FORMAT(arg->d); break;
+            case APP_LOG_ARG_STRING:
+                n = APP_LOG_FORMAT((APP_LOG_NO_TEXT == arg->text) ? "" : &record->text[arg->text]);
+                break;
+            case APP_LOG_ARG_POINTER: n = APP_LOG_FORMAT(arg->p); break;
+            default:                  n = APP_LOG_FORMAT((int)arg->i); break;
+        }
+        #pragma GCC diagnostic pop
+        #undef APP_LOG_FORMAT
+        length += (n > 0) ? n : 0;
+    }
+
+    if ((uint32_t)length < size)
+    {
+        length += snprintf(&line[length], size - (uint32_t)length, "%s", format);
+    }
+    length = ((uint32_t)length < size) ? length : (int)size - 1;
+
+    /* One message per line */
+    if ((length > 0) && ('\n' != line[length - 1]))
+    {
+        if ((uint32_t)length + 1u >= size)
+        {
+            length--;
+        }
+        line[length++] = '\n';
+        line[length] = '\0';
+    }
+    return (uint32_t)length;
+}
+
+/*******************************************************************************
+* Function Name: app_log_forward
+********************************************************************************
+* Summary:
+*  Takes the queued records out of the ring, oldest first, and passes them
+*  to sink. Call from one context only, normally a low priority task.
+*
+* Parameters:
+*  sink:        takes a record, false to keep it in the ring and stop
+*  arg:         passed to sink
+*  max_records: records to take at most, 0 for all
+*
+* Return:
+*  Records taken
+*
+*******************************************************************************/
+uint32_t app_log_forward(app_log_sink_fn sink, void* arg, uint32_t max_records)
+{
+    uint32_t taken = 0u;
+
+    if (!__atomic_load_n(&log_ready, __ATOMIC_ACQUIRE))
+    {
+        return 0u;
+    }
+
+    while ((0u == max_records) || (taken < max_records))
+    {
+        app_log_record_t* record = &log_ring[log_dequeue & APP_LOG_RING_MASK];
+        if ((__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != log_dequeue + 1u) ||
+            !sink(record, arg))
+        {
+            break;
+        }
+
+        /* Free the cell for the producers one lap ahead */
+        __atomic_store_n(&record->sequence, log_dequeue + APP_LOG_RING_SIZE, __ATOMIC_RELEASE);
+        log_dequeue++;
+        taken++;
+    }
+    return taken;
+}
+
+static bool app_log_write_record(const app_log_record_t* record, void* arg)
+{
+    char* line = (char*)arg;
+
+    log_port.write(line, app_log_format(record, line, APP_LOG_LINE_SIZE));
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: app_log_drain
+********************************************************************************
+* Summary:
+*  Formats and writes the queued records, oldest first. Call from one
+*  context only, normally a low priority task.
+*
+* Parameters:
+*  max_records: records to write at most, 0 for all
+*
+* Return:
+*  Records written
+*
+*******************************************************************************/
+uint32_t app_log_drain(uint32_t max_records)
+{
+    static char line[APP_LOG_LINE_SIZE];
+    uint32_t dropped;
+
+    if (!__atomic_load_n(&log_ready, __ATOMIC_ACQUIRE) || (NULL == log_port.write))
+    {
+        return 0u;
+    }
+
+    dropped = __atomic_load_n(&log_stats.dropped, __ATOMIC_RELAXED);
+    if (dropped != log_reported_drops)
+    {
+        int length = app_log_prefix(line, sizeof(line), log_port.now_ms(), log_port.core, APP_LOG_LEVEL_WARN);
+        length += snprintf(&line[length], sizeof(line) - (uint32_t)length, "log: %lu messages dropped\n",
+                           (unsigned long)(dropped - log_reported_drops));
+        log_port.write(line, (uint32_t)length);
+        log_reported_drops = dropped;
+    }
+
+    return app_log_forward(app_log_write_record, line, max_records);
+}
+
+void app_log_get_stats(app_log_stats_t* stats)
+{
+    stats->logged = __atomic_load_n(&log_stats.logged, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&log_stats.dropped, __ATOMIC_RELAXED);
+    stats->filtered = __atomic_load_n(&log_stats.filtered, __ATOMIC_RELAXED);
+}
+
+/* [] END OF FILE */
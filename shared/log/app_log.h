@@ -0,0 +1,140 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Deferred logging.
+ *
+ * app_log() takes a printf format but does not format: it stores the format
+ * pointer, the timestamp and the raw arguments as a binary record in a
+ * lock-free ring and returns. Strings passed for %s are copied into the
+ * record, everything else is stored by value. A low priority drain
+ * (app_log_drain()) formats the records later and writes them to the
+ * output of the platform, so the caller never waits for the UART.
+ *
+ * Any number of tasks and interrupts may log at the same time; the ring is
+ * a bounded multi-producer queue without locks. A record that finds the
+ * ring full is dropped and counted, the drain reports the count.
+ *
+ * The format must be a string literal or stay valid until drained.
+ * Arguments beyond APP_LOG_MAX_ARGS and string bytes beyond
+ * APP_LOG_TEXT_SIZE per record are cut off. %n is not supported.
+ */
+
+#ifndef APP_LOG_H_
+#define APP_LOG_H_
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records of the ring, a power of two */
+#ifndef APP_LOG_RING_SIZE
+#define APP_LOG_RING_SIZE           (64u)
+#endif
+#ifndef APP_LOG_MAX_ARGS
+#define APP_LOG_MAX_ARGS            (8u)
+#endif
+/* Bytes for the copies of the %s arguments of a record */
+#ifndef APP_LOG_TEXT_SIZE
+#define APP_LOG_TEXT_SIZE           (64u)
+#endif
+/* Longest formatted line */
+#ifndef APP_LOG_LINE_SIZE
+#define APP_LOG_LINE_SIZE           (256u)
+#endif
+
+/* Levels above this one are compiled out */
+#ifndef APP_LOG_MAX_LEVEL
+#define APP_LOG_MAX_LEVEL           APP_LOG_LEVEL_INFO
+#endif
+
+#define APP_LOG(level, ...)         do { if ((level) <= APP_LOG_MAX_LEVEL) { app_log((level), __VA_ARGS__); } } while (0)
+#define APP_LOG_ERROR(...)          APP_LOG(APP_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define APP_LOG_WARN(...)           APP_LOG(APP_LOG_LEVEL_WARN, __VA_ARGS__)
+#define APP_LOG_INFO(...)           APP_LOG(APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#define APP_LOG_DEBUG(...)          APP_LOG(APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    APP_LOG_LEVEL_ERROR = 0,
+    APP_LOG_LEVEL_WARN,
+    APP_LOG_LEVEL_INFO,
+    APP_LOG_LEVEL_DEBUG
+} app_log_level_t;
+
+/* Core a record was logged on, shown in every line */
+typedef enum
+{
+    APP_LOG_CORE_CM33 = 0,
+    APP_LOG_CORE_CM55
+} app_log_core_t;
+
+/* Output of the platform */
+typedef struct
+{
+    uint32_t    (*now_ms)(void);                        /* Timestamp of a record, interrupt safe */
+    void        (*write)(const char* text, uint32_t size);  /* Called by the drain only, NULL when forwarded */
+    app_log_core_t core;
+} app_log_port_t;
+
+typedef union
+{
+    int64_t     i;
+    double      d;
+    const void* p;
+    uint16_t    text;           /* Offset of a string copy in the record */
+} app_log_arg_t;
+
+/* A record as queued: the format by pointer, the arguments by value. The
+ * sequence is private to the ring. */
+typedef struct
+{
+    volatile uint32_t   sequence;
+    uint32_t            timestamp;  /* ms */
+    const char*         format;
+    uint8_t             level;
+    uint8_t             core;
+    uint8_t             argc;
+    app_log_arg_t       args[APP_LOG_MAX_ARGS];
+    char                text[APP_LOG_TEXT_SIZE];
+} app_log_record_t;
+
+/* Takes a record out of the ring, false to leave it and stop */
+typedef bool (*app_log_sink_fn)(const app_log_record_t* record, void* arg);
+
+typedef struct
+{
+    uint32_t    logged;
+    uint32_t    dropped;        /* Records that found the ring full */
+    uint32_t    filtered;       /* Records below the runtime level */
+} app_log_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void     app_log_init(const app_log_port_t* port, app_log_level_t level);
+void     app_log_set_level(app_log_level_t level);
+bool     app_log(app_log_level_t level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+uint32_t app_log_drain(uint32_t max_records);
+void     app_log_get_stats(app_log_stats_t* stats);
+
+/* Hands the records to sink instead of writing them, for log_stream.h.
+ * Same context rules as app_log_drain(). */
+uint32_t app_log_forward(app_log_sink_fn sink, void* arg, uint32_t max_records);
+
+/* Formats one record as app_log_drain() writes it, returns the length */
+uint32_t app_log_format(const app_log_record_t* record, char* line, uint32_t size);
+
+/* printf compatible, logs at APP_LOG_LEVEL_INFO. For the print callbacks of
+ * prof_print() and friends. */
+int      app_log_printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+int      app_log_vprintf(const char* format, va_list args) __attribute__((format(printf, 1, 0)));
+
+#endif /* APP_LOG_H_ */
@@ -0,0 +1,186 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "latency_trace.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t latency_bounds[LATENCY_BUCKETS - 1u] = LATENCY_BUCKET_BOUNDS_MS;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: latency_capture_ms
+********************************************************************************
+* Summary:
+*  Time a sample was captured, from the time the frame that holds it was
+*  complete.
+*
+* Parameters:
+*  frame_end_ms:     time the last sample of the frame was captured
+*  frame_end_sample: samples captured up to the end of the frame
+*  sample:           samples captured up to the one to stamp, in the frame
+*  sample_rate:      samples per second
+*
+* Return:
+*  Time of the sample, same clock as frame_end_ms
+*
+*******************************************************************************/
+uint32_t latency_capture_ms(uint32_t frame_end_ms, uint32_t frame_end_sample, uint32_t sample,
+                            uint32_t sample_rate)
+{
+    return frame_end_ms - (uint32_t)(((uint64_t)(frame_end_sample - sample) * 1000u) / sample_rate);
+}
+
+static void latency_hop_record(latency_hop_stats_t* s, int32_t delta_ms)
+{
+    /* The clocks of the two cores agree to about a millisecond */
+    uint32_t ms = (delta_ms > 0) ? (uint32_t)delta_ms : 0u;
+    uint32_t bucket = 0;
+
+    while ((bucket < LATENCY_BUCKETS - 1u) && (ms > latency_bounds[bucket]))
+    {
+        bucket++;
+    }
+    if ((0u == s->count) || (ms < s->min))
+    {
+        s->min = ms;
+    }
+    if (ms > s->max)
+    {
+        s->max = ms;
+    }
+    s->count++;
+    s->total += ms;
+    s->hist[bucket]++;
+}
+
+/*******************************************************************************
+* Function Name: latency_stats_record
+********************************************************************************
+* Summary:
+*  Adds the hops of a trace with all its stamps. A trace stamped before the
+*  clocks of the cores were synchronized is ignored.
+*
+* Parameters:
+*  stats: statistics
+*  trace: trace up to LATENCY_STAMP_PUBLISHED
+*
+*******************************************************************************/
+void latency_stats_record(latency_stats_t* stats, const latency_trace_t* trace)
+{
+    if (!trace->synced)
+    {
+        return;
+    }
+    for (uint32_t hop = 0; hop < LATENCY_HOP_TOTAL; hop++)
+    {
+        latency_hop_record(&stats->hops[hop], (int32_t)(trace->stamps[hop + 1u] - trace->stamps[hop]));
+    }
+    latency_hop_record(&stats->hops[LATENCY_HOP_TOTAL],
+                       (int32_t)(trace->stamps[LATENCY_STAMP_PUBLISHED] - trace->stamps[LATENCY_STAMP_CAPTURE]));
+}
+
+/* Upper bound of the smallest bucket holding rank samples, at most max */
+static uint32_t latency_percentile(const latency_hop_stats_t* s, uint32_t rank)
+{
+    uint32_t seen = 0;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKETS - 1u; i++)
+    {
+        seen += s->hist[i];
+        if (seen >= rank)
+        {
+            return (latency_bounds[i] < s->max) ? latency_bounds[i] : s->max;
+        }
+    }
+    return s->max;
+}
+
+/*******************************************************************************
+* Function Name: latency_stats_summarize
+********************************************************************************
+* Summary:
+*  Computes count, min, mean, median, 99th percentile and max of every hop.
+*
+* Parameters:
+*  stats:   statistics
+*  summary: receives one entry per hop
+*
+*******************************************************************************/
+void latency_stats_summarize(const latency_stats_t* stats, latency_summary_t summary[LATENCY_HOP_COUNT])
+{
+    for (uint32_t hop = 0; hop < LATENCY_HOP_COUNT; hop++)
+    {
+        const latency_hop_stats_t* s = &stats->hops[hop];
+        latency_summary_t* out = &summary[hop];
+
+        memset(out, 0, sizeof(*out));
+        if (0u == s->count)
+        {
+            continue;
+        }
+        out->count = s->count;
+        out->min = s->min;
+        out->max = s->max;
+        out->mean = (uint32_t)(s->total / s->count);
+        out->p50 = latency_percentile(s, (s->count + 1u) / 2u);
+        out->p99 = latency_percentile(s, s->count - s->count / 100u);
+    }
+}
+
+void latency_stats_reset(latency_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+/*******************************************************************************
+* Function Name: latency_stats_print
+********************************************************************************
+* Summary:
+*  Prints one line per hop and the histogram of the total.
+*
+* Parameters:
+*  stats: statistics
+*  print: printf compatible output function
+*
+*******************************************************************************/
+void latency_stats_print(const latency_stats_t* stats, latency_print_fn print)
+{
+    static const char* const names[LATENCY_HOP_COUNT] = LATENCY_HOP_NAMES;
+    const latency_hop_stats_t* total = &stats->hops[LATENCY_HOP_TOTAL];
+    latency_summary_t summary[LATENCY_HOP_COUNT];
+
+    latency_stats_summarize(stats, summary);
+    print("  hop (ms)   count     min       mean      p50       p99       max\r\n");
+    for (uint32_t hop = 0; hop < LATENCY_HOP_COUNT; hop++)
+    {
+        const latency_summary_t* s = &summary[hop];
+        print("  %-9s  %-8lu  %-8lu  %-8lu  %-8lu  %-8lu  %lu\r\n", names[hop],
+              (unsigned long)s->count, (unsigned long)s->min, (unsigned long)s->mean,
+              (unsigned long)s->p50, (unsigned long)s->p99, (unsigned long)s->max);
+    }
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        if (0u == total->hist[i])
+        {
+            continue;
+        }
+        if (i < LATENCY_BUCKETS - 1u)
+        {
+            print("  total <= %-5lu  %lu\r\n", (unsigned long)latency_bounds[i], (unsigned long)total->hist[i]);
+        }
+        else
+        {
+            print("  total >  %-5lu  %lu\r\n", (unsigned long)latency_bounds[i - 1u], (unsigned long)total->hist[i]);
+        }
+    }
+}
+
+/* [] END OF FILE */
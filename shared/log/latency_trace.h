@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Microphone to cloud latency of the model decisions.
+ *
+ * Every decision carries a latency_trace_t: the newest sample of its feature
+ * window and the time it passed each hop on the way to the cloud. All stamps
+ * are in milliseconds of the CM33 clock (the tick count, as the log); the
+ * CM55 moves its own with the offset the log forwarding measures. The
+ * capture stamp is derived from the sample: the PDM interrupt stamps the end
+ * of every frame and the samples after the newest one of the window are
+ * taken off at the sample rate.
+ *
+ *   capture    newest sample of the window captured
+ *   pickup     its PDM frame taken up by cm55_task
+ *   window     feature window complete, inference starts
+ *   result     decision of the model
+ *   received   decision in the IPC interrupt of the CM33
+ *   report     decision in a telemetry message
+ *   published  MQTT publish of the message returned
+ *
+ * latency_stats_t collects the hops between consecutive stamps and the
+ * total in histograms with fixed bounds in ms, so that the device, which
+ * publishes them, and host/audio_replay, which replays the same timing
+ * offline, give the same breakdown.
+ */
+
+#ifndef LATENCY_TRACE_H_
+#define LATENCY_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Upper bounds of the histogram buckets in ms, a last bucket takes the rest */
+#define LATENCY_BUCKET_BOUNDS_MS    { 1u, 2u, 3u, 5u, 7u, 10u, 15u, 20u, 30u, 50u, 70u, 100u, 150u, 200u, \
+                                      300u, 500u, 700u, 1000u, 1500u, 2000u, 3000u, 5000u, 7000u, 10000u }
+#define LATENCY_BUCKETS             (25u)
+
+/* Keep LATENCY_HOP_NAMES in the same order */
+#define LATENCY_HOP_NAMES           { "frame", "frontend", "inference", "ipc", "report", "publish", "total" }
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    LATENCY_STAMP_CAPTURE = 0,
+    LATENCY_STAMP_PICKUP,
+    LATENCY_STAMP_WINDOW,
+    LATENCY_STAMP_RESULT,
+    LATENCY_STAMP_RECEIVED,
+    LATENCY_STAMP_REPORT,
+    LATENCY_STAMP_PUBLISHED,
+    LATENCY_STAMP_COUNT
+} latency_stamp_t;
+
+/* Hop i lies between stamp i and stamp i + 1 */
+typedef enum
+{
+    LATENCY_HOP_FRAME = 0,          /* Rest of the PDM frame and the wait for cm55_task */
+    LATENCY_HOP_FRONTEND,           /* Front end up to the end of the window */
+    LATENCY_HOP_INFERENCE,
+    LATENCY_HOP_IPC,
+    LATENCY_HOP_REPORT,             /* Wait for the next telemetry message */
+    LATENCY_HOP_PUBLISH,
+    LATENCY_HOP_TOTAL,              /* Capture to published */
+    LATENCY_HOP_COUNT
+} latency_hop_t;
+
+typedef struct
+{
+    uint32_t    sample;             /* Samples captured up to the newest of the window */
+    uint32_t    stamps[LATENCY_STAMP_COUNT];
+    bool        synced;             /* The CM55 stamps are in the CM33 clock */
+} latency_trace_t;
+
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    total;
+    uint32_t    hist[LATENCY_BUCKETS];
+} latency_hop_stats_t;
+
+typedef struct
+{
+    latency_hop_stats_t hops[LATENCY_HOP_COUNT];
+} latency_stats_t;
+
+/* Result of one hop, in ms. The percentiles are the upper bound of their
+ * bucket, at most max. */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    mean;
+    uint32_t    p50;
+    uint32_t    p99;
+    uint32_t    max;
+} latency_summary_t;
+
+/* printf compatible sink for latency_stats_print() */
+typedef int (*latency_print_fn)(const char* format, ...);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t latency_capture_ms(uint32_t frame_end_ms, uint32_t frame_end_sample, uint32_t sample,
+                            uint32_t sample_rate);
+void     latency_stats_record(latency_stats_t* stats, const latency_trace_t* trace);
+void     latency_stats_summarize(const latency_stats_t* stats, latency_summary_t summary[LATENCY_HOP_COUNT]);
+void     latency_stats_reset(latency_stats_t* stats);
+void     latency_stats_print(const latency_stats_t* stats, latency_print_fn print);
+
+#endif /* LATENCY_TRACE_H_ */
@@ -0,0 +1,186 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#include <string.h>
+#include "log_stream.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+void log_stream_init(log_stream_t* stream)
+{
+    memset(stream, 0, sizeof(*stream));
+}
+
+/*******************************************************************************
+* Function Name: log_stream_write
+********************************************************************************
+* Summary:
+*  Copies a record into the next free slot, with its format, and moves its
+*  timestamp to the clock of the reader. An app_log_sink_fn.
+*
+* Parameters:
+*  record: record of the app_log ring of the writer
+*  stream: log_stream_t
+*
+* Return:
+*  false if the stream is full or not synchronized yet; the record stays
+*  with the caller
+*
+*******************************************************************************/
+bool log_stream_write(const app_log_record_t* record, void* stream)
+{
+    log_stream_t* s = (log_stream_t*)stream;
+    const uint32_t written = s->written;
+    log_stream_slot_t* slot;
+    uint32_t length;
+
+    if (!s->synced || ((written - s->consumed) >= LOG_STREAM_RECORDS))
+    {
+        return false;
+    }
+
+    /* The reader is done with the slot once it has advanced consumed */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    slot = &s->slots[written % LOG_STREAM_RECORDS];
+    slot->record = *record;
+    slot->record.format = slot->format;
+    slot->record.timestamp = record->timestamp + (uint32_t)s->offset_ms;
+    length = (uint32_t)strnlen(record->format, LOG_STREAM_FORMAT_SIZE - 1u);
+    memcpy(slot->format, record->format, length);
+    slot->format[length] = '\0';
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    s->written = written + 1u;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: log_stream_report_drops
+********************************************************************************
+* Summary:
+*  Forwards a warning with the records the app_log ring of the writer has
+*  dropped since the last report, when there is room for it.
+*
+* Parameters:
+*  stream:  stream
+*  dropped: app_log_stats_t.dropped of the writer
+*  now_ms:  writer clock
+*
+*******************************************************************************/
+void log_stream_report_drops(log_stream_t* stream, uint32_t dropped, uint32_t now_ms)
+{
+    app_log_record_t record;
+
+    if (dropped == stream->reported)
+    {
+        return;
+    }
+    memset(&record, 0, sizeof(record));
+    record.timestamp = now_ms;
+    record.format = "log: %lu messages dropped";
+    record.level = APP_LOG_LEVEL_WARN;
+    record.core = APP_LOG_CORE_CM55;
+    record.argc = 1u;
+    record.args[0].i = (int64_t)(dropped - stream->reported);
+    if (log_stream_write(&record, stream))
+    {
+        stream->reported = dropped;
+    }
+}
+
+/*******************************************************************************
+* Function Name: log_stream_sync_begin
+********************************************************************************
+* Summary:
+*  Starts a measurement of the clock offset. Send the stream to the reader
+*  right after and call log_stream_sync_end() until it succeeds.
+*
+* Return:
+*  The request to pass to log_stream_sync_end()
+*
+*******************************************************************************/
+uint32_t log_stream_sync_begin(log_stream_t* stream)
+{
+    uint32_t request = stream->sync_request + 1u;
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    stream->sync_request = request;
+    return request;
+}
+
+/*******************************************************************************
+* Function Name: log_stream_sync_end
+********************************************************************************
+* Summary:
+*  Takes the answer of the reader. The reader answers from the interrupt of
+*  the request, so its time is taken as the time of the send, however late
+*  the answer is picked up.
+*
+* Parameters:
+*  stream:  stream
+*  request: of log_stream_sync_begin()
+*  sent_ms: writer clock when the request was sent
+*
+* Return:
+*  true once the reader has answered, the offset is updated
+*
+*******************************************************************************/
+bool log_stream_sync_end(log_stream_t* stream, uint32_t request, uint32_t sent_ms)
+{
+    if (stream->sync_ack != request)
+    {
+        return false;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    stream->offset_ms = (int32_t)(stream->sync_ms - sent_ms);
+    stream->synced = true;
+    return true;
+}
+
+/* The reader side of the measurement, from the interrupt of the request */
+void log_stream_sync_reply(log_stream_t* stream, uint32_t now_ms)
+{
+    stream->sync_ms = now_ms;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    stream->sync_ack = stream->sync_request;
+}
+
+/*******************************************************************************
+* Function Name: log_stream_drain
+********************************************************************************
+* Summary:
+*  Formats and writes the forwarded records, oldest first.
+*
+* Parameters:
+*  stream:      stream
+*  write:       output of the reader
+*  max_records: records to write at most, 0 for all
+*
+* Return:
+*  Records written
+*
+*******************************************************************************/
+uint32_t log_stream_drain(log_stream_t* stream, void (*write)(const char* text, uint32_t size),
+                          uint32_t max_records)
+{
+    static char line[APP_LOG_LINE_SIZE];
+    uint32_t drained = 0u;
+
+    while (((0u == max_records) || (drained < max_records)) && (stream->consumed != stream->written))
+    {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        const log_stream_slot_t* slot = &stream->slots[stream->consumed % LOG_STREAM_RECORDS];
+        write(line, app_log_format(&slot->record, line, sizeof(line)));
+
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        stream->consumed = stream->consumed + 1u;
+        drained++;
+    }
+    return drained;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Log records of the CM55, forwarded to the log output of the CM33.
+ *
+ * A ring of binary records in shared memory with one writer, the CM55,
+ * and one reader, the CM33. The CM55 moves the records of its app_log ring
+ * into the stream with app_log_forward(log_stream_write, ...): the
+ * arguments are copied as they are and the format string is copied next
+ * to them, so nothing is formatted on the CM55. The CM33 formats the
+ * records with app_log_format() in its log task (log_stream_drain()).
+ *
+ * A full stream refuses the record, which stays in the app_log ring of the
+ * CM55; if that one fills up as well, the CM55 drops and counts records,
+ * it never waits for the CM33. The count is forwarded as a record of its
+ * own (log_stream_report_drops()).
+ *
+ * Timestamps are moved to the clock of the CM33 when forwarded. The offset
+ * between the clocks is measured by a round trip: the CM55 asks with
+ * log_stream_sync_begin() and an IPC message, the CM33 answers with its
+ * time from the interrupt of that message (log_stream_sync_reply()) and the
+ * CM55 takes that time as its own at the send (log_stream_sync_end()).
+ * Records are held back until the first answer.
+ */
+
+#ifndef LOG_STREAM_H_
+#define LOG_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_log.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records of the stream */
+#ifndef LOG_STREAM_RECORDS
+#define LOG_STREAM_RECORDS          (32u)
+#endif
+
+/* Longest format forwarded, longer ones are cut off */
+#ifndef LOG_STREAM_FORMAT_SIZE
+#define LOG_STREAM_FORMAT_SIZE      (96u)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    app_log_record_t    record;     /* record.format points at format */
+    char                format[LOG_STREAM_FORMAT_SIZE];
+} log_stream_slot_t;
+
+typedef struct
+{
+    volatile uint32_t   written;        /* Records in the stream so far, by the writer */
+    volatile uint32_t   consumed;       /* Records formatted so far, by the reader */
+    uint32_t            reported;       /* Drops of the writer core reported so far, by the writer */
+    int32_t             offset_ms;      /* Writer clock to reader clock, by the writer */
+    bool                synced;
+    volatile uint32_t   sync_request;   /* By the writer */
+    volatile uint32_t   sync_ack;       /* By the reader, sync_request when answered */
+    volatile uint32_t   sync_ms;        /* Reader clock at the answer */
+    log_stream_slot_t   slots[LOG_STREAM_RECORDS];
+} log_stream_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Writer */
+void     log_stream_init(log_stream_t* stream);
+bool     log_stream_write(const app_log_record_t* record, void* stream);
+void     log_stream_report_drops(log_stream_t* stream, uint32_t dropped, uint32_t now_ms);
+uint32_t log_stream_sync_begin(log_stream_t* stream);
+bool     log_stream_sync_end(log_stream_t* stream, uint32_t request, uint32_t sent_ms);
+
+/* Reader */
+void     log_stream_sync_reply(log_stream_t* stream, uint32_t now_ms);
+uint32_t log_stream_drain(log_stream_t* stream, void (*write)(const char* text, uint32_t size),
+                          uint32_t max_records);
+
+#endif /* LOG_STREAM_H_ */
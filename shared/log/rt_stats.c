@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+#ifdef APP_RUNTIME_STATS
+
+#include <malloc.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_log.h"
+#include "rt_stats.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Stack left below which a task is reported with a warning */
+#define RT_STATS_STACK_WARN_BYTES   (256u)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    UBaseType_t number;         /* xTaskNumber, unique per task */
+    uint32_t    run_time;
+} rt_stats_sample_t;
+
+/* Bounds of the newlib heap, from the linker script. heap_3 of
+ * FreeRTOSConfig.h serves pvPortMalloc() with malloc(), so the FreeRTOS heap
+ * is this one and configTOTAL_HEAP_SIZE is unused. */
+extern uint8_t __HeapBase[];
+extern uint8_t __HeapLimit[];
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static mtb_hal_lptimer_t* rt_timer;
+
+/* Of the previous snapshot, for the shares over the period */
+static TaskStatus_t rt_status[RT_STATS_MAX_TASKS];
+static rt_stats_sample_t rt_previous[RT_STATS_MAX_TASKS];
+static UBaseType_t rt_previous_count;
+static uint32_t rt_previous_total;
+
+/* Most newlib ever took from the heap region */
+static uint32_t rt_heap_peak;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+void rt_stats_init(mtb_hal_lptimer_t* timer)
+{
+    rt_timer = timer;
+}
+
+/* portGET_RUN_TIME_COUNTER_VALUE(), also called by the kernel with the
+ * interrupts masked */
+uint32_t rt_stats_counter(void)
+{
+    return (NULL != rt_timer) ? mtb_hal_lptimer_read(rt_timer) : 0u;
+}
+
+static uint32_t previous_run_time(UBaseType_t number)
+{
+    for (UBaseType_t i = 0; i < rt_previous_count; i++)
+    {
+        if (rt_previous[i].number == number)
+        {
+            return rt_previous[i].run_time;
+        }
+    }
+
+    /* Created during the period */
+    return 0u;
+}
+
+static void collect_heap(rt_stats_t* stats)
+{
+    const struct mallinfo info = mallinfo();
+
+    /* arena only grows with sbrk(), but newlib may trim it back */
+    if ((uint32_t)info.arena > rt_heap_peak)
+    {
+        rt_heap_peak = (uint32_t)info.arena;
+    }
+
+    /* Blocks freed inside the arena can be reused, the rest of the region
+     * is still free for sbrk() */
+    stats->heap_size = (uint32_t)(__HeapLimit - __HeapBase);
+    stats->heap_free = stats->heap_size - (uint32_t)info.uordblks;
+    stats->heap_min_free = stats->heap_size - rt_heap_peak;
+}
+
+/*******************************************************************************
+* Function Name: rt_stats_collect
+********************************************************************************
+* Summary:
+*  Takes a snapshot of all tasks of the core: the share of the CPU of each
+*  since the previous call, the stack high-water marks and the heap. The
+*  first call covers the time since the start.
+*
+* Parameters:
+*  stats: filled in
+*
+* Return:
+*  false if the core has more than RT_STATS_MAX_TASKS tasks
+*
+*******************************************************************************/
+bool rt_stats_collect(rt_stats_t* stats)
+{
+    uint32_t total = 0u;
+    UBaseType_t count = uxTaskGetSystemState(rt_status, RT_STATS_MAX_TASKS, &total);
+    const uint32_t elapsed = total - rt_previous_total;
+
+    if (0u == count)
+    {
+        return false;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->period_ms = (uint32_t)(((uint64_t)elapsed * 1000u) / Cy_SysClk_ClkLfGetFrequency());
+    stats->task_count = (uint16_t)count;
+    collect_heap(stats);
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t* status = &rt_status[i];
+        rt_stats_task_t* task = &stats->tasks[i];
+        uint32_t run_time = status->ulRunTimeCounter - previous_run_time(status->xTaskNumber);
+        uint32_t permille = (0u != elapsed) ? (uint32_t)(((uint64_t)run_time * 1000u) / elapsed) : 0u;
+
+        /* The counter of the running task lags until its next switch */
+        task->cpu_permille = (uint16_t)((permille > 1000u) ? 1000u : permille);
+        task->priority = (uint16_t)status->uxCurrentPriority;
+        task->stack_free = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+        strncpy(task->name, status->pcTaskName, RT_STATS_NAME_SIZE - 1u);
+        if (0 == strcmp(status->pcTaskName, configIDLE_TASK_NAME))
+        {
+            stats->idle_permille = task->cpu_permille;
+        }
+
+        rt_previous[i].number = status->xTaskNumber;
+        rt_previous[i].run_time = status->ulRunTimeCounter;
+    }
+    rt_previous_count = count;
+    rt_previous_total = total;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: rt_stats_log
+********************************************************************************
+* Summary:
+*  Logs a snapshot: a summary, a warning for every task short of stack and
+*  one line per task at debug level.
+*
+* Parameters:
+*  core:  name of the core of the snapshot
+*  stats: snapshot
+*
+*******************************************************************************/
+void rt_stats_log(const char* core, const rt_stats_t* stats)
+{
+    APP_LOG_INFO("%s: %u tasks, idle %u.%u%% over %lu ms, heap %lu free, lowest %lu of %lu",
+                 core, stats->task_count, stats->idle_permille / 10u, stats->idle_permille % 10u,
+                 (unsigned long)stats->period_ms, (unsigned long)stats->heap_free,
+                 (unsigned long)stats->heap_min_free, (unsigned long)stats->heap_size);
+
+    for (uint32_t i = 0; i < stats->task_count; i++)
+    {
+        const rt_stats_task_t* task = &stats->tasks[i];
+
+        if (task->stack_free < RT_STATS_STACK_WARN_BYTES)
+        {
+            APP_LOG_WARN("%s: %s has %lu bytes of stack left", core, task->name,
+                         (unsigned long)task->stack_free);
+        }
+        APP_LOG_DEBUG("%s: %-16s prio %2u cpu %3u.%u%% stack %5lu free", core, task->name,
+                      task->priority, task->cpu_permille / 10u, task->cpu_permille % 10u,
+                      (unsigned long)task->stack_free);
+    }
+}
+
+#endif /* APP_RUNTIME_STATS */
+
+/* [] END OF FILE */
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: MIT
+ * Copyright (C) 2025 Avnet
+ * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
+ */
+
+/* Per task CPU load, stack and heap high-water marks of a core.
+ *
+ * FreeRTOS adds up the run time of every task at each context switch with
+ * portGET_RUN_TIME_COUNTER_VALUE(), here rt_stats_counter(): the LPTimer of
+ * the core, 32768 counts per second. Unlike the 1 ms tick it resolves the
+ * short runs of the tasks, and unlike the cycle counter it keeps counting
+ * while the idle task sleeps in tickless idle. It wraps after 36 hours. A
+ * context switch costs one more register read.
+ *
+ * rt_stats_collect() takes a snapshot of all tasks with
+ * uxTaskGetSystemState() and computes the share of the CPU of each since
+ * the previous snapshot. It scans every stack for its high-water mark with
+ * the scheduler suspended, so it is called every RT_STATS_PERIOD_MS only,
+ * from one task of the core. The CM55 sends its snapshot to the CM33, which
+ * publishes both as telemetry.
+ *
+ * Built with APP_RUNTIME_STATS, RUNTIME_STATS=1 in common.mk.
+ */
+
+#ifndef RT_STATS_H_
+#define RT_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Period of the snapshots */
+#ifndef RT_STATS_PERIOD_MS
+#define RT_STATS_PERIOD_MS          (30000u)
+#endif
+
+/* Tasks of a snapshot, at least the tasks of either core */
+#ifndef RT_STATS_MAX_TASKS
+#define RT_STATS_MAX_TASKS          (24u)
+#endif
+
+/* configMAX_TASK_NAME_LEN of both cores */
+#define RT_STATS_NAME_SIZE          (16u)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    char        name[RT_STATS_NAME_SIZE];
+    uint16_t    cpu_permille;   /* Share of the CPU over the period */
+    uint16_t    priority;
+    uint32_t    stack_free;     /* Bytes of stack never used since the start */
+} rt_stats_task_t;
+
+typedef struct
+{
+    uint32_t        period_ms;      /* Period the CPU shares cover */
+    uint16_t        idle_permille;  /* Share of the idle task, sleep included */
+    uint16_t        task_count;
+    uint32_t        heap_size;      /* newlib heap, in bytes */
+    uint32_t        heap_free;
+    uint32_t        heap_min_free;  /* Heap never taken by newlib */
+    rt_stats_task_t tasks[RT_STATS_MAX_TASKS];
+} rt_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* timer: LPTimer of the tickless idle, set up */
+void     rt_stats_init(mtb_hal_lptimer_t* timer);
+uint32_t rt_stats_counter(void);
+bool     rt_stats_collect(rt_stats_t* stats);
+void     rt_stats_log(const char* core, const rt_stats_t* stats);
+
+#endif /* RT_STATS_H_ */
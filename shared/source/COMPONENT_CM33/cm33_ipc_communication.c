@@ -46,6 +46,7 @@
 #include <string.h>
 #include "cybsp.h"
 #include "FreeRTOS.h"
+#include "task.h"
 #include "retarget_io_init.h"
 #include "ipc_communication.h"
 
@@ -72,6 +73,19 @@ static ipc_msg_t ipc_recv_msg = {0};
 static ipc_payload_t ipc_last_detection_payload = {0};
 static bool ipc_has_saved_detection = false; // will be set upon receipt. reset when value is checked
 static bool ipc_has_received_message = false; // will be set upon receipt. reset when value is checked
+static ipc_diag_payload_t ipc_last_diag_payload = {0};
+static bool ipc_has_diag = false; // will be set upon receipt. reset when value is checked
+static ipc_clip_msg_t* ipc_clip_msg = NULL; // in CM55 shared memory, the samples stay frozen until released
+static ipc_clip_payload_t ipc_last_clip_payload = {0};
+static bool ipc_has_clip = false; // will be set upon receipt. reset when value is checked
+static record_ring_t* volatile ipc_record_ring = NULL; // in CM55 shared memory, announced once
+static log_stream_t* volatile ipc_log_stream = NULL; // in CM55 shared memory, announced with every sync
+static rt_stats_t ipc_last_rt_stats = {0};
+static bool ipc_has_rt_stats = false; // will be set upon receipt. reset when value is checked
+static audio_health_report_t ipc_last_health = {0};
+static bool ipc_has_health = false; // will be set upon receipt. reset when value is checked
+static model_profile_report_t ipc_last_model_profile = {0};
+static bool ipc_has_model_profile = false; // will be set upon receipt. reset when value is checked
 
 
 /*******************************************************************************
@@ -84,6 +98,7 @@ static void cm33_msg_callback(uint32_t * msg_data)
     if (msg_data != NULL) {
         /* Copy the message received into our own copy IPC structure */
         memcpy(&ipc_recv_msg, (void *) msg_data, sizeof(ipc_recv_msg));
+        ipc_recv_msg.payload.trace.stamps[LATENCY_STAMP_RECEIVED] = (uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS);
         if (ipc_recv_msg.payload.label_id != 0) {
             memcpy(&ipc_last_detection_payload, &ipc_recv_msg.payload, sizeof(ipc_payload_t));
             ipc_has_saved_detection = true;
@@ -92,6 +107,102 @@ static void cm33_msg_callback(uint32_t * msg_data)
     }
 }
 
+/*******************************************************************************
+* Function Name: cm33_diag_msg_callback
+********************************************************************************
+* Callback for receipt of diagnostics from cm55
+*******************************************************************************/
+static void cm33_diag_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        memcpy(&ipc_last_diag_payload, &((ipc_diag_msg_t *) msg_data)->payload, sizeof(ipc_diag_payload_t));
+        ipc_has_diag = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_clip_msg_callback
+********************************************************************************
+* Callback for receipt of an audio clip from cm55
+*******************************************************************************/
+static void cm33_clip_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        ipc_clip_msg = (ipc_clip_msg_t *) msg_data;
+        memcpy(&ipc_last_clip_payload, &ipc_clip_msg->payload, sizeof(ipc_clip_payload_t));
+        ipc_has_clip = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_record_msg_callback
+********************************************************************************
+* Callback for the announcement of the raw audio ring by cm55
+*******************************************************************************/
+static void cm33_record_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        ipc_record_ring = ((ipc_record_msg_t *) msg_data)->ring;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_log_msg_callback
+********************************************************************************
+* Callback for the log stream of cm55: answers its clock synchronization with
+* the time of the CM33, right from the interrupt to keep the round trip short
+*******************************************************************************/
+static void cm33_log_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        log_stream_t* stream = ((ipc_log_msg_t *) msg_data)->stream;
+        // the tick count is not running yet before the scheduler, the CM55 asks again later
+        if (taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState()) {
+            log_stream_sync_reply(stream, (uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS));
+        }
+        ipc_log_stream = stream;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_rt_stats_msg_callback
+********************************************************************************
+* Callback for receipt of the task statistics from cm55
+*******************************************************************************/
+static void cm33_rt_stats_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        memcpy(&ipc_last_rt_stats, &((ipc_rt_stats_msg_t *) msg_data)->payload, sizeof(rt_stats_t));
+        ipc_has_rt_stats = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_health_msg_callback
+********************************************************************************
+* Callback for receipt of the audio health report from cm55
+*******************************************************************************/
+static void cm33_health_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        memcpy(&ipc_last_health, &((ipc_health_msg_t *) msg_data)->payload, sizeof(audio_health_report_t));
+        ipc_has_health = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: cm33_model_profile_msg_callback
+********************************************************************************
+* Callback for receipt of the operator profile of the model from cm55
+*******************************************************************************/
+static void cm33_model_profile_msg_callback(uint32_t * msg_data)
+{
+    if (msg_data != NULL) {
+        memcpy(&ipc_last_model_profile, &((ipc_model_profile_msg_t *) msg_data)->payload, sizeof(model_profile_report_t));
+        ipc_has_model_profile = true;
+    }
+}
+
 /*******************************************************************************
 * Function Name: cm33_ipc_pipe_isr
 ********************************************************************************
@@ -173,6 +284,48 @@ void cm33_ipc_communication_setup(void)
         handle_app_error();
     }
 
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_diag_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_DIAG_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_clip_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_CLIP_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_record_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_RECORD_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_log_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_LOG_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_rt_stats_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_RT_STATS_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_health_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_HEALTH_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
+    pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_model_profile_msg_callback,
+                                              (uint32_t)CM33_IPC_PIPE_MODEL_PROFILE_CLIENT_ID);
+    if (CY_IPC_PIPE_SUCCESS != pipe_status) {
+        handle_app_error();
+    }
+
 }
 
 bool cm33_ipc_has_received_message(void)
@@ -206,3 +359,82 @@ bool cm33_ipc_safe_get_and_clear_cached_detection(ipc_payload_t* target)
         return false;
     }
 }
+
+bool cm33_ipc_safe_get_and_clear_diagnostics(ipc_diag_payload_t* target)
+{
+    taskENTER_CRITICAL();
+    bool ret = ipc_has_diag;
+    if (ipc_has_diag) {
+        memcpy(target, &ipc_last_diag_payload, sizeof(ipc_diag_payload_t));
+        ipc_has_diag = false;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+bool cm33_ipc_safe_get_and_clear_clip(ipc_clip_payload_t* target)
+{
+    taskENTER_CRITICAL();
+    bool ret = ipc_has_clip;
+    if (ipc_has_clip) {
+        memcpy(target, &ipc_last_clip_payload, sizeof(ipc_clip_payload_t));
+        ipc_has_clip = false;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+void cm33_ipc_release_clip(void)
+{
+    taskENTER_CRITICAL();
+    if (ipc_clip_msg != NULL) {
+        ipc_clip_msg->released = 1u;
+    }
+    taskEXIT_CRITICAL();
+}
+
+record_ring_t* cm33_ipc_get_record_ring(void)
+{
+    return ipc_record_ring;
+}
+
+log_stream_t* cm33_ipc_get_log_stream(void)
+{
+    return ipc_log_stream;
+}
+
+bool cm33_ipc_safe_get_and_clear_rt_stats(rt_stats_t* target)
+{
+    taskENTER_CRITICAL();
+    bool ret = ipc_has_rt_stats;
+    if (ipc_has_rt_stats) {
+        memcpy(target, &ipc_last_rt_stats, sizeof(rt_stats_t));
+        ipc_has_rt_stats = false;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+bool cm33_ipc_safe_get_and_clear_audio_health(audio_health_report_t* target)
+{
+    taskENTER_CRITICAL();
+    bool ret = ipc_has_health;
+    if (ipc_has_health) {
+        memcpy(target, &ipc_last_health, sizeof(audio_health_report_t));
+        ipc_has_health = false;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+bool cm33_ipc_safe_get_and_clear_model_profile(model_profile_report_t* target)
+{
+    taskENTER_CRITICAL();
+    bool ret = ipc_has_model_profile;
+    if (ipc_has_model_profile) {
+        memcpy(target, &ipc_last_model_profile, sizeof(model_profile_report_t));
+        ipc_has_model_profile = false;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
@@ -43,6 +43,7 @@
  * Authors: Nikola Markovic <nikola.markovic@avnet.com>, Shu Liu <shu.liu@avnet.com> et al.
  */
 
+#include <string.h>
 #include "ipc_communication.h"
 
 /*******************************************************************************
@@ -54,7 +55,18 @@ static cy_stc_ipc_pipe_ep_t cm55_ipc_pipe_array[CY_IPC_MAX_ENDPOINTS];
 /* CB Array for EP2 */
 static cy_ipc_pipe_callback_ptr_t ep2_cb_array[CY_IPC_CYPIPE_CLIENT_CNT];
 
-CY_SECTION_SHAREDMEM static ipc_msg_t cm55_msg_data;
+/* Two result messages used in turn: the pipe only accepts a message once the
+ * CM33 released the previous one, so the message sent before the last one is
+ * always free to be written */
+CY_SECTION_SHAREDMEM static ipc_msg_t cm55_msg_data[2];
+static uint32_t cm55_msg_next;
+CY_SECTION_SHAREDMEM static ipc_diag_msg_t cm55_diag_msg_data;
+CY_SECTION_SHAREDMEM static ipc_clip_msg_t cm55_clip_msg_data;
+CY_SECTION_SHAREDMEM static ipc_record_msg_t cm55_record_msg_data;
+CY_SECTION_SHAREDMEM static ipc_log_msg_t cm55_log_msg_data;
+CY_SECTION_SHAREDMEM static ipc_rt_stats_msg_t cm55_rt_stats_msg_data;
+CY_SECTION_SHAREDMEM static ipc_health_msg_t cm55_health_msg_data;
+CY_SECTION_SHAREDMEM static ipc_model_profile_msg_t cm55_model_profile_msg_data;
 
 
 __STATIC_INLINE void handle_app_error(void)
@@ -142,22 +154,106 @@ void cm55_ipc_communication_setup(void)
 }
 
 
-ipc_payload_t* cm55_ipc_get_payload_ptr(void)
-{
-    return &cm55_msg_data.payload;
-}
-
-void cm55_ipc_send_to_cm33(void)
+/*******************************************************************************
+* Function Name: cm55_ipc_send
+********************************************************************************
+* Summary:
+*  Sends a message to the CM33 client of the pipe. The message stays in
+*  shared memory until the CM33 released it.
+*
+* Parameters:
+*  client_id: CM33 client of the message
+*  msg:       message, starting with an ipc_msg_header_t
+*
+* Return:
+*  false if the pipe is still busy with the previous message
+*
+*******************************************************************************/
+static bool cm55_ipc_send(uint8_t client_id, void* msg)
 {
+    ipc_msg_header_t* header = (ipc_msg_header_t*)msg;
     cy_en_ipc_pipe_status_t pipe_status;
 
-    cm55_msg_data.client_id = CM33_IPC_PIPE_CLIENT_ID;
-    cm55_msg_data.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP2;
+    header->client_id = client_id;
+    header->intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP2;
 
     pipe_status = Cy_IPC_Pipe_SendMessage(CM33_IPC_PIPE_EP_ADDR,
                              CM55_IPC_PIPE_EP_ADDR,
-                             (void *) &cm55_msg_data, 0);
+                             msg, 0);
+    if (CY_IPC_PIPE_ERROR_SEND_BUSY == pipe_status) {
+        return false;
+    }
     if (CY_IPC_PIPE_SUCCESS != pipe_status) {
         handle_app_error();
     }
-}
\ No newline at end of file
+    return true;
+}
+
+bool cm55_ipc_send_to_cm33(const ipc_payload_t* payload)
+{
+    ipc_msg_t* msg = &cm55_msg_data[cm55_msg_next];
+
+    memcpy(&msg->payload, payload, sizeof(ipc_payload_t));
+    if (!cm55_ipc_send(CM33_IPC_PIPE_CLIENT_ID, msg)) {
+        return false;
+    }
+    cm55_msg_next ^= 1u;
+    return true;
+}
+
+bool cm55_ipc_send_diag_to_cm33(const ipc_diag_payload_t* diag)
+{
+    /* Diagnostics are sent rarely, the previous message has long been copied
+     * out by the CM33 when this one is written */
+    memcpy(&cm55_diag_msg_data.payload, diag, sizeof(ipc_diag_payload_t));
+    return cm55_ipc_send(CM33_IPC_PIPE_DIAG_CLIENT_ID, &cm55_diag_msg_data);
+}
+
+bool cm55_ipc_send_clip_to_cm33(const ipc_clip_payload_t* clip)
+{
+    /* Only one clip is outstanding, the CM33 has copied the previous message
+     * out before it released that clip */
+    memcpy(&cm55_clip_msg_data.payload, clip, sizeof(ipc_clip_payload_t));
+    cm55_clip_msg_data.released = 0u;
+    return cm55_ipc_send(CM33_IPC_PIPE_CLIP_CLIENT_ID, &cm55_clip_msg_data);
+}
+
+bool cm55_ipc_clip_released(void)
+{
+    return (0u != cm55_clip_msg_data.released);
+}
+
+bool cm55_ipc_send_record_to_cm33(record_ring_t* ring)
+{
+    cm55_record_msg_data.ring = ring;
+    return cm55_ipc_send(CM33_IPC_PIPE_RECORD_CLIENT_ID, &cm55_record_msg_data);
+}
+
+bool cm55_ipc_send_log_to_cm33(log_stream_t* stream)
+{
+    cm55_log_msg_data.stream = stream;
+    return cm55_ipc_send(CM33_IPC_PIPE_LOG_CLIENT_ID, &cm55_log_msg_data);
+}
+
+bool cm55_ipc_send_rt_stats_to_cm33(const rt_stats_t* stats)
+{
+    /* Sent every RT_STATS_PERIOD_MS, the CM33 has copied the previous message
+     * out long before */
+    memcpy(&cm55_rt_stats_msg_data.payload, stats, sizeof(rt_stats_t));
+    return cm55_ipc_send(CM33_IPC_PIPE_RT_STATS_CLIENT_ID, &cm55_rt_stats_msg_data);
+}
+
+bool cm55_ipc_send_audio_health_to_cm33(const audio_health_report_t* report)
+{
+    /* Sent every AUDIO_HEALTH_PERIOD_MS, the CM33 has copied the previous
+     * message out long before */
+    memcpy(&cm55_health_msg_data.payload, report, sizeof(audio_health_report_t));
+    return cm55_ipc_send(CM33_IPC_PIPE_HEALTH_CLIENT_ID, &cm55_health_msg_data);
+}
+
+bool cm55_ipc_send_model_profile_to_cm33(const model_profile_report_t* report)
+{
+    /* Sent once, the message is not touched again */
+    memcpy(&cm55_model_profile_msg_data.payload, report, sizeof(model_profile_report_t));
+    return cm55_ipc_send(CM33_IPC_PIPE_MODEL_PROFILE_CLIENT_ID, &cm55_model_profile_msg_data);
+}